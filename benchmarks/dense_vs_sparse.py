@@ -0,0 +1,123 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid a implements a c++ backend targeting the Grid2Op platform.
+
+"""
+This benchmark compares the time spent in the solver when using a dense LU decomposition
+(`DenseLU` / `DenseLUDC`) compared to a sparse one (`KLU` / `KLUDC` if available, otherwise
+`SparseLU` / `DC`) for grids of increasing size.
+
+It allows to find the grid size where the sparse solver becomes faster than the dense one.
+"""
+import time
+import warnings
+import numpy as np
+import pandapower as pp
+import pandapower.networks as pn
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import SolverType
+
+TABULATE_AVAIL = False
+try:
+    from tabulate import tabulate
+    TABULATE_AVAIL = True
+except ImportError:
+    print("The tabulate package is not installed. Some output might not work properly")
+
+NB_POWERFLOW = 1000
+MAX_ITER = 10
+TOL = 1e-8
+
+case_names = ["case14",
+              "case30",
+              "case39",
+              "case57",
+              "case89pegase",
+              "case118",
+              "case_illinois200",
+              "case300",
+              ]
+
+
+def get_solver_time(pp_net, solver_type, nb_powerflow=NB_POWERFLOW, dc=False):
+    """return the average time (in ms) spent in the solver for one powerflow"""
+    with warnings.catch_warnings():
+        warnings.filterwarnings("ignore")
+        grid_model = init(pp_net)
+    grid_model.change_solver(solver_type)
+    nb_bus = grid_model.total_bus()
+    V0 = np.full(nb_bus, fill_value=1.0, dtype=complex)
+
+    total_time = 0.
+    for _ in range(nb_powerflow):
+        if dc:
+            V = grid_model.dc_pf(V0, MAX_ITER, TOL)
+            total_time += grid_model.get_dc_computation_time()
+        else:
+            V = grid_model.ac_pf(V0, MAX_ITER, TOL)
+            total_time += grid_model.get_computation_time()
+        if V.shape[0] == 0:
+            raise RuntimeError(f"Powerflow diverged with solver {solver_type}")
+        # force the recomputation of everything (including the symbolic analysis for the sparse solvers)
+        grid_model.tell_topo_changed()
+    return 1000. * total_time / nb_powerflow
+
+
+def main(nb_powerflow=NB_POWERFLOW):
+    available_solvers = init(pn.case14()).available_solvers()
+    if SolverType.KLU in available_solvers:
+        sparse_ac, sparse_dc, sparse_name = SolverType.KLU, SolverType.KLUDC, "KLU"
+    else:
+        sparse_ac, sparse_dc, sparse_name = SolverType.SparseLU, SolverType.DC, "SparseLU"
+
+    tab = []
+    crossover_ac = None
+    crossover_dc = None
+    for case_name in case_names:
+        pp_net = getattr(pn, case_name)()
+        pp.runpp(pp_net)  # make sure the grid is "valid"
+        nb_bus = pp_net.bus.shape[0]
+        time_dense_ac = get_solver_time(pp_net, SolverType.DenseLU, nb_powerflow)
+        time_sparse_ac = get_solver_time(pp_net, sparse_ac, nb_powerflow)
+        time_dense_dc = get_solver_time(pp_net, SolverType.DenseLUDC, nb_powerflow, dc=True)
+        time_sparse_dc = get_solver_time(pp_net, sparse_dc, nb_powerflow, dc=True)
+        if crossover_ac is None and time_sparse_ac < time_dense_ac:
+            crossover_ac = (case_name, nb_bus)
+        if crossover_dc is None and time_sparse_dc < time_dense_dc:
+            crossover_dc = (case_name, nb_bus)
+        tab.append([case_name, nb_bus,
+                    f"{time_dense_ac:.2e}", f"{time_sparse_ac:.2e}",
+                    f"{time_dense_dc:.2e}", f"{time_sparse_dc:.2e}"])
+
+    hds = ["grid", "nb bus",
+           "DenseLU (ms)", f"{sparse_name} (ms)",
+           "DenseLUDC (ms)", f"{sparse_name} DC (ms)"]
+    if TABULATE_AVAIL:
+        print(tabulate(tab, headers=hds, tablefmt="rst"))
+    else:
+        print(hds)
+        for row in tab:
+            print(row)
+    print()
+    if crossover_ac is not None:
+        print(f"AC: {sparse_name} becomes faster than DenseLU for {crossover_ac[0]} ({crossover_ac[1]} buses)")
+    else:
+        print(f"AC: DenseLU is faster than {sparse_name} for all the grids tested")
+    if crossover_dc is not None:
+        print(f"DC: {sparse_name} becomes faster than DenseLU for {crossover_dc[0]} ({crossover_dc[1]} buses)")
+    else:
+        print(f"DC: DenseLU is faster than {sparse_name} for all the grids tested")
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser(description="Compare dense and sparse linear solvers for grids of different sizes")
+    parser.add_argument("--number", type=int, default=NB_POWERFLOW,
+                        help="Number of powerflows computed for each grid and each solver.")
+    args = parser.parse_args()
+    main(args.number)
@@ -6,6 +6,7 @@
 # SPDX-License-Identifier: MPL-2.0
 # This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
 
-__all__ = ["init", "GridModel"]
+__all__ = ["init", "GridModel", "ResultType", "TerminalType", "ElementAttribute"]
 
 from lightsim2grid.gridmodel.initGridModel import init, GridModel
+from lightsim2grid_cpp import ResultType, TerminalType, ElementAttribute
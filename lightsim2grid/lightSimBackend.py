@@ -107,6 +107,7 @@ class LightSimBackend(Backend):
         self._backend_action_class = None
         self.cst_1 = dt_float(1.0)
         self.__me_at_init = None
+        self.__init_snapshot = None
         self.__init_topo_vect = None
 
         # available solver in lightsim
@@ -125,22 +126,17 @@ class LightSimBackend(Backend):
         # backend SHOULD not do these kind of stuff
         self._idx_hack_storage = []
 
-    def _fill_theta(self):
-        # line_or_theta = np.empty(self.n_line)
-        self.line_or_theta[:self.__nb_powerline] = self._grid.get_lineor_theta()
-        self.line_or_theta[self.__nb_powerline:] = self._grid.get_trafohv_theta()
-
-        # line_ex_theta = np.empty(self.n_line)
-        self.line_ex_theta[:self.__nb_powerline] = self._grid.get_lineex_theta()
-        self.line_ex_theta[self.__nb_powerline:] = self._grid.get_trafolv_theta()
-
-        # line_or_theta = np.concatenate((self._grid.get_lineor_theta(), self._grid.get_trafohv_theta()))
-        # line_ex_theta = np.concatenate((self._grid.get_lineex_theta(), self._grid.get_trafolv_theta()))
-        self.load_theta[:] = self._grid.get_load_theta()
-        self.gen_theta[:] = self._grid.get_gen_theta()
-
+    def _register_res_buffers(self):
+        """the results of the powerflows are directly written (by the c++ side, in the grid2op units) in the
+        numpy arrays of this backend. This must be done each time self._grid is replaced."""
+        self._grid.set_line_res_buffers(self.p_or, self.q_or, self.v_or, self.a_or, self.line_or_theta,
+                                        self.p_ex, self.q_ex, self.v_ex, self.a_ex, self.line_ex_theta)
+        self._grid.set_load_res_buffers(self.load_p, self.load_q, self.load_v, self.load_theta)
+        self._grid.set_gen_res_buffers(self.prod_p, self.prod_q, self.prod_v, self.gen_theta)
         if self.__has_storage:
-            self.storage_theta[:] = self._grid.get_storage_theta()
+            self._grid.set_storage_res_buffers(self.storage_p, self.storage_q, self.storage_v, self.storage_theta)
+        if self.shunts_data_available:
+            self._grid.set_shunt_res_buffers(self.sh_p, self.sh_q, self.sh_v, self.sh_bus)
 
     def get_theta(self):
         """
@@ -208,6 +204,7 @@ class LightSimBackend(Backend):
 
         - for SolverType.SparseLU: 10
         - for SolverType.GaussSeidel: 10000
+        - for SolverType.GaussSeidelColored: 10000
         - for SolverType.DC: this has no effect
         - for SolverType.SparseKLU: 10
 
@@ -424,6 +421,8 @@ class LightSimBackend(Backend):
             self._sh_vnkv = self.init_pp_backend._sh_vnkv
 
         self.shunts_data_available = self.init_pp_backend.shunts_data_available
+        if self.shunts_data_available:
+            self._grid.set_shunt_to_subid(self.shunt_to_subid)
 
         # number of object per bus, to activate, deactivate them
         self.nb_obj_per_bus = np.zeros(2 * self.__nb_bus_before, dtype=dt_int)
@@ -467,8 +466,11 @@ class LightSimBackend(Backend):
             self.storage_theta = np.full(self.n_storage, dtype=dt_float, fill_value=np.NaN)
 
         self._count_object_per_bus()
+        self._register_res_buffers()
         self._grid.tell_topo_changed()
         self.__me_at_init = self._grid.copy()
+        # the grid is restored to this state (in O(number of changes)) when the environment is reset
+        self.__init_snapshot = self._grid.snapshot()
         self.__init_topo_vect = np.ones(self.dim_topo, dtype=dt_int)
         self.__init_topo_vect[:] = self.topo_vect
 
@@ -550,41 +552,28 @@ class LightSimBackend(Backend):
         """
         active_bus, *_, topo__, shunts__ = backendAction()
 
-        # update the injections
-        self._grid.update_gens_p(backendAction.prod_p.changed,
-                                 backendAction.prod_p.values)
-        self._grid.update_gens_v(backendAction.prod_v.changed,
-                                 backendAction.prod_v.values / self.prod_pu_to_kv)
-        self._grid.update_loads_p(backendAction.load_p.changed,
-                                  backendAction.load_p.values)
-        self._grid.update_loads_q(backendAction.load_q.changed,
-                                  backendAction.load_q.values)
+        # storage units and shunts are not always available, in this case nothing is modified for them
+        no_change_bool = np.zeros(0, dtype=bool)
+        no_change_float = np.zeros(0, dtype=np.float32)
+        no_change_int = np.zeros(0, dtype=np.int32)
         if self.__has_storage:
             # TODO
             # reactivate the storage that i deactivate because of the "hack". See
             # for stor_id in self._idx_hack_storage:
             #     self._grid.reactivate_storage(stor_id)
-            self._grid.update_storages_p(backendAction.storage_power.changed,
-                                         backendAction.storage_power.values)
+            storage_p = backendAction.storage_power
+            storage_p_changed, storage_p_values = storage_p.changed, storage_p.values
+        else:
+            storage_p_changed, storage_p_values = no_change_bool, no_change_float
 
-        # handle shunts
         if self.shunts_data_available:
             shunt_p, shunt_q, shunt_bus = backendAction.shunt_p, backendAction.shunt_q, backendAction.shunt_bus
-            # shunt topology
-            # (need to be done before to avoid error like "impossible to set reactive value of a disconnected shunt")
-            for sh_id, new_bus in shunt_bus:
-                if new_bus == -1:
-                    self._grid.deactivate_shunt(sh_id)
-                else:
-                    self._grid.reactivate_shunt(sh_id)
-                    self._grid.change_bus_shunt(sh_id, self.shunt_to_subid[sh_id] * new_bus)
-
-            for sh_id, new_p in shunt_p:
-                self._grid.change_p_shunt(sh_id, new_p)
-            for sh_id, new_q in shunt_q:
-                self._grid.change_q_shunt(sh_id, new_q)
+            shunt_args = (shunt_p.changed, shunt_p.values,
+                          shunt_q.changed, shunt_q.values,
+                          shunt_bus.changed, shunt_bus.values)
+        else:
+            shunt_args = (no_change_bool, no_change_float) * 2 + (no_change_bool, no_change_int)
 
-        # and now change the overall topology
         # TODO hack for storage units: if 0. production i pretend they are disconnected on the
         # TODO c++ side
         # this is to deal with the test that "if a storage unit is alone on a bus, but produces 0, then it's fine)
@@ -599,9 +588,17 @@ class LightSimBackend(Backend):
         #     self._idx_hack_storage = []
         #     chgt = backendAction.current_topo.changed
         #     my_val = backendAction.current_topo.values
-        # self._grid.update_topo(changed, my_val)
         chgt = backendAction.current_topo.changed
-        self._grid.update_topo(chgt, backendAction.current_topo.values)
+
+        # injections, shunts (topology first, to avoid error like "impossible to set reactive value of a
+        # disconnected shunt") and then the overall topology, in a single call
+        self._grid.apply_action_packed(backendAction.prod_p.changed, backendAction.prod_p.values,
+                                       backendAction.prod_v.changed, backendAction.prod_v.values,
+                                       backendAction.load_p.changed, backendAction.load_p.values,
+                                       backendAction.load_q.changed, backendAction.load_q.values,
+                                       storage_p_changed, storage_p_values,
+                                       *shunt_args,
+                                       chgt, backendAction.current_topo.values)
         self.topo_vect[chgt] = backendAction.current_topo.values[chgt]
         # TODO c++ side: have a check to be sure that the set_***_pos_topo_vect and set_***_to_sub_id
         # TODO have been correctly called before calling the function self._grid.update_topo
@@ -617,7 +614,7 @@ class LightSimBackend(Backend):
                 self.V = np.ones(self.nb_bus_total, dtype=np.complex_) #  * self._grid.get_init_vm_pu()
                 V = self._grid.dc_pf(self.V, self.max_it, self.tol)
                 if V.shape[0] == 0:
-                    raise DivergingPowerFlow(f"Divergence of DC powerflow (non connected grid). Detailed error: {self._grid.get_dc_solver().get_error()}")
+                    raise DivergingPowerFlow(f"Divergence of DC powerflow (non connected grid). Detailed error: {self._grid.get_dc_error()}")
             else:
                 if (self.V is None) or (self.V.shape[0] == 0):
                     # create the vector V as it is not created
@@ -633,13 +630,13 @@ class LightSimBackend(Backend):
                     self._grid.reactivate_result_computation()
                     # self._grid.change_solver(self.__current_solver_type)
                     if Vdc.shape[0] == 0:
-                        raise DivergingPowerFlow(f"Divergence of DC powerflow (non connected grid) at the initialization of AC powerflow. Detailed error: {self._grid.get_dc_solver().get_error()}")
+                        raise DivergingPowerFlow(f"Divergence of DC powerflow (non connected grid) at the initialization of AC powerflow. Detailed error: {self._grid.get_dc_error()}")
                     V_init = Vdc
                 else:
                     V_init = copy.deepcopy(self.V)
                 V = self._grid.ac_pf(V_init, self.max_it, self.tol)
                 if V.shape[0] == 0:
-                    raise DivergingPowerFlow(f"Divergence of AC powerflow. Detailed error: {self._grid.get_solver().get_error()}")
+                    raise DivergingPowerFlow(f"Divergence of AC powerflow. Detailed error: {self._grid.get_error()}")
 
             if is_dc:
                 self.comp_time += self._grid.get_dc_computation_time()
@@ -647,35 +644,8 @@ class LightSimBackend(Backend):
                 self.comp_time += self._grid.get_computation_time()
                 
             self.V[:] = V
-            (self.p_or[:self.__nb_powerline],
-             self.q_or[:self.__nb_powerline],
-             self.v_or[:self.__nb_powerline],
-             self.a_or[:self.__nb_powerline]) = self._grid.get_lineor_res()
-            (self.p_or[self.__nb_powerline:],
-             self.q_or[self.__nb_powerline:],
-             self.v_or[self.__nb_powerline:],
-             self.a_or[self.__nb_powerline:]) = self._grid.get_trafohv_res()
-            (self.p_ex[:self.__nb_powerline],
-             self.q_ex[:self.__nb_powerline],
-             self.v_ex[:self.__nb_powerline],
-             self.a_ex[:self.__nb_powerline]) = self._grid.get_lineex_res()
-            (self.p_ex[self.__nb_powerline:],
-             self.q_ex[self.__nb_powerline:],
-             self.v_ex[self.__nb_powerline:],
-             self.a_ex[self.__nb_powerline:]) = self._grid.get_trafolv_res()
-
-            self.a_or *= 1000.  # kA in lightsim, A expected in grid2op
-            self.a_ex *= 1000.  # kA in lightsim, A expected in grid2op
-
-            self.a_or[~np.isfinite(self.a_or)] = 0.
-            self.v_or[~np.isfinite(self.v_or)] = 0.
-            self.a_ex[~np.isfinite(self.a_ex)] = 0.
-            self.v_ex[~np.isfinite(self.v_ex)] = 0.
-
-            self.load_p[:], self.load_q[:], self.load_v[:] = self._grid.get_loads_res()
-            self.prod_p[:], self.prod_q[:], self.prod_v[:] = self._grid.get_gen_res()
-            if self.__has_storage:
-                self.storage_p[:], self.storage_q[:], self.storage_v[:] = self._grid.get_storages_res()
+            # the results (flows, injections, theta and shunts) have been written in the numpy arrays of this backend
+            # by self._grid (see self._register_res_buffers)
             self.next_prod_p[:] = self.prod_p
 
             if np.any(~np.isfinite(self.load_v)) or np.any(self.load_v <= 0.):
@@ -688,11 +658,6 @@ class LightSimBackend(Backend):
                 raise DivergingPowerFlow(f"At least one generator is disconnected (check loads {gen_disco})")
             # TODO storage case of divergence !
 
-            if self.shunts_data_available:
-                self._set_shunt_info()
-            
-            self._fill_theta()
-
             res = True
             self._grid.unset_topo_changed()
         except Exception as exc_:
@@ -831,13 +796,15 @@ class LightSimBackend(Backend):
 
 
         # handle the most complicated
-        res._grid = mygrid.copy()
+        res._grid = mygrid.copy(keep_solver_state=True)
         res.__me_at_init = __me_at_init.copy()  # this is const
+        res.__init_snapshot = self.__init_snapshot  # the snapshots are copied with the grid
         res.init_pp_backend = inippbackend  # this is const
         res._init_action_to_set = copy.deepcopy(self._init_action_to_set)
         res._backend_action_class = self._backend_action_class  # this is const
         res.__init_topo_vect = self.__init_topo_vect
         res.available_solvers = self.available_solvers
+        res._register_res_buffers()
 
         self._grid = mygrid
         self.init_pp_backend = inippbackend
@@ -886,14 +853,6 @@ class LightSimBackend(Backend):
     def shunt_info(self):
         return self.cst_1 * self.sh_p, self.cst_1 * self.sh_q, self.cst_1 * self.sh_v, self.sh_bus
 
-    def _set_shunt_info(self):
-        self.sh_p[:], self.sh_q[:], self.sh_v[:]  = self._grid.get_shunts_res()
-        shunt_bus = np.array([self._grid.get_bus_shunt(i) for i in range(self.n_shunt)], dtype=dt_int)
-        res_bus = np.ones(shunt_bus.shape[0], dtype=dt_int)  # by default all shunts are on bus one
-        res_bus[shunt_bus >= self.__nb_bus_before] = 2  # except the one that are connected to bus 2
-        res_bus[shunt_bus == -1] = -1  # or the one that are disconnected
-        self.sh_bus[:] = res_bus
-
     def _disconnect_line(self, id_):
         self.topo_vect[self.line_ex_pos_topo_vect[id_]] = -1
         self.topo_vect[self.line_or_pos_topo_vect[id_]] = -1
@@ -907,8 +866,15 @@ class LightSimBackend(Backend):
 
     def reset(self, grid_path, grid_filename=None):
         self._fill_nans()
-        self._grid = self.__me_at_init.copy()
-        self._grid.tell_topo_changed()
-        self._grid.change_solver(self.__current_solver_type)
+        if self.__init_snapshot is not None and self._grid.has_snapshot(self.__init_snapshot):
+            self._grid.restore(self.__init_snapshot)
+        else:
+            # the snapshot is not available (anymore), the grid is copied instead
+            self._grid = self.__me_at_init.copy()
+            self._register_res_buffers()
+            self._grid.tell_topo_changed()
+            self.__init_snapshot = self._grid.snapshot()
+        if self._grid.get_solver_type() != self.__current_solver_type:
+            self._grid.change_solver(self.__current_solver_type)
         self.topo_vect[:] = self.__init_topo_vect
         self.comp_time = 0.
@@ -124,3 +124,35 @@ class PhysicalLawChecker:
         self._this_backend.update_from_obs(grid2op_obs)
         res = self._this_backend._grid.check_solution(vcomplex, with_qlim)
         return res
+
+    def check_solutions(self, vcomplex, grid2op_obs, with_qlim=False):
+        """
+        Same as :func:`PhysicalLawChecker.check_solution` for many complex voltage vectors at once, given for the
+        same grid2op observation. The computation is made entirely in c++: it is much faster than calling
+        `check_solution` on each of them.
+
+        Parameters
+        ----------
+        vcomplex:
+            A numpy complex matrix with one row per voltage vector to check (each row is given like the `vcomplex`
+            vector of :func:`PhysicalLawChecker.check_solution`)
+
+        grid2op_obs:
+            A grid2op observation representing the state of the grid
+
+        with_qlim:
+            Whether to take into account the reactive limits for the generators
+
+        Returns
+        -------
+        res:
+            A numpy array (complex) that has the same shape as `vcomplex`: its row `i` is the power mismatch at each
+            bus of the grid for the vector `vcomplex[i]`.
+        """
+        if len(vcomplex.shape) != 2 or vcomplex.shape[1] != 2 * self.init_env.n_sub:
+            raise RuntimeError(f"The input matrix vcomplex needs to have one row per voltage vector and one column per "
+                               f"possible bus on the grid (so basically 2 * env.n_sub = {2 * self.init_env.n_sub}). "
+                               f"Its shape is {vcomplex.shape}.")
+        self._this_backend.update_from_obs(grid2op_obs)
+        res = self._this_backend._grid.check_solutions(vcomplex, with_qlim)
+        return res
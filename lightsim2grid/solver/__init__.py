@@ -12,9 +12,19 @@ __all__ = ["SolverType",
            "AnySolver",  
            "GaussSeidelSolver",
            "GaussSeidelSynchSolver",
+           "GaussSeidelColoredSolver",
            "SparseLUSolver",
            "SparseLUSolverSingleSlack",
-           "DCSolver"]
+           "DCSolver",
+           "DenseLUSolver",
+           "DenseLUSolverSingleSlack",
+           "DenseLUDCSolver",
+           "BiCGSTABSolver",
+           "BiCGSTABSolverSingleSlack",
+           "BiCGSTABDCSolver",
+           "LDLTDCSolver",
+           "KLUSolverConfig",
+           "KLUSolverStats"]
 
 from lightsim2grid_cpp import SolverType
 from lightsim2grid_cpp import ErrorType
@@ -22,9 +32,19 @@ from lightsim2grid_cpp import AnySolver
 
 from lightsim2grid_cpp import GaussSeidelSolver
 from lightsim2grid_cpp import GaussSeidelSynchSolver
+from lightsim2grid_cpp import GaussSeidelColoredSolver
 from lightsim2grid_cpp import SparseLUSolver
 from lightsim2grid_cpp import SparseLUSolverSingleSlack
 from lightsim2grid_cpp import DCSolver
+from lightsim2grid_cpp import DenseLUSolver
+from lightsim2grid_cpp import DenseLUSolverSingleSlack
+from lightsim2grid_cpp import DenseLUDCSolver
+from lightsim2grid_cpp import BiCGSTABSolver
+from lightsim2grid_cpp import BiCGSTABSolverSingleSlack
+from lightsim2grid_cpp import BiCGSTABDCSolver
+from lightsim2grid_cpp import LDLTDCSolver
+from lightsim2grid_cpp import KLUSolverConfig
+from lightsim2grid_cpp import KLUSolverStats
 
 try:
     from lightsim2grid_cpp import KLUSolver
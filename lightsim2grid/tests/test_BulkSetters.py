@@ -0,0 +1,82 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init, TerminalType, ElementAttribute
+
+
+class TestBulkSetters(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+            self.ref = init(pn.case118())
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+
+    def _aux_compare(self):
+        V = self.model.ac_pf(self.V0, 10, 1e-8)
+        V_ref = self.ref.ac_pf(self.V0, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.max(np.abs(V - V_ref)) <= 1e-10
+
+    def test_ids(self):
+        load_ids = np.array([0, 3, 5])
+        new_p = np.array([10., 20., 30.], dtype=np.float32)
+        self.model.set_values(TerminalType.Load, ElementAttribute.P, load_ids, new_p)
+        for load_id, p in zip(load_ids, new_p):
+            self.ref.change_p_load(int(load_id), float(p))
+        assert np.array_equal(self.model.get_loads().target_p_mw[load_ids], new_p)
+
+        gen_ids = np.array([1, 2])
+        self.model.set_values(TerminalType.Gen, ElementAttribute.V, gen_ids, np.array([1.01, 0.99]))
+        self.ref.change_v_gen(1, 1.01)
+        self.ref.change_v_gen(2, 0.99)
+        self._aux_compare()
+
+    def test_mask(self):
+        nb_line = len(self.model.get_lines())
+        mask = np.zeros(nb_line, dtype=bool)
+        mask[[3, 5]] = True
+        self.model.set_values_mask(TerminalType.LineOr, ElementAttribute.Status, mask, np.zeros(nb_line))
+        self.ref.deactivate_powerline(3)
+        self.ref.deactivate_powerline(5)
+        assert not self.model.get_lines().connected[3]
+        assert not self.model.get_lines().connected[5]
+        self._aux_compare()
+
+    def test_bus(self):
+        # the load 0 is moved to the bus of the load 1
+        new_bus = self.model.get_loads()[1].bus_id
+        self.model.set_values(TerminalType.Load, ElementAttribute.Bus, np.array([0]), np.array([new_bus]))
+        self.ref.change_bus_load(0, new_bus)
+        assert self.model.get_loads()[0].bus_id == new_bus
+        self._aux_compare()
+
+    def test_errors_nothing_changed(self):
+        p_before = self.model.get_loads().target_p_mw.copy()
+        with self.assertRaises(IndexError):
+            # the second load does not exist
+            self.model.set_values(TerminalType.Load, ElementAttribute.P, np.array([0, 10000]), np.array([1., 2.]))
+        with self.assertRaises(RuntimeError):
+            # the generators have no reactive setpoint
+            self.model.set_values(TerminalType.Gen, ElementAttribute.Q, np.array([0]), np.array([1.]))
+        with self.assertRaises(RuntimeError):
+            self.model.set_values(TerminalType.Load, ElementAttribute.P, np.array([0, 1]), np.array([1.]))
+        self.model.deactivate_load(1)
+        with self.assertRaises(RuntimeError):
+            # the load 1 is disconnected
+            self.model.set_values(TerminalType.Load, ElementAttribute.P, np.array([0, 1]), np.array([1., 2.]))
+        assert np.array_equal(self.model.get_loads().target_p_mw, p_before)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -52,9 +52,22 @@ class MakeTestsCase14(unittest.TestCase):
         assert mismatch.shape == (2*self.nb_bus, )
         assert np.any(np.abs(mismatch) > tol)
 
+    def aux_test_check_batch(self, qlim=False):
+        V = self.env.backend.V
+        Vs = np.stack([V, 2*V, np.ones(V.shape[0], dtype=complex)])
+        mismatches = self.env.backend._grid.check_solutions(Vs, qlim)
+        assert mismatches.shape == (3, 2*self.nb_bus)
+        # same results as checking the vectors one by one
+        for V_candidate, mismatch in zip(Vs, mismatches):
+            assert np.max(np.abs(mismatch - self.env.backend._grid.check_solution(V_candidate, qlim))) <= 1e-10
+
     def test_check_withoutqlims(self):
         self.aux_test_check(False)
 
+    def test_check_batch(self):
+        self.aux_test_check_batch(False)
+        self.aux_test_check_batch(True)
+
     def test_check_withqlims(self):
         with self.assertRaises(AssertionError):
             # this should raise because Q lim are not met
@@ -102,3 +102,121 @@ class TestComputers(unittest.TestCase):
             obs, *_ = env.step(env.action_space())
             if np.max(np.abs(ampss[1 + it_num] - obs.a_or * 1e-3))  > 1e-6:
                 raise RuntimeError(f"error at it {it_num}")
+
+    def test_optional_injections(self):
+        env_name = "l2rpn_case14_sandbox"
+        param = Parameters()
+        param.NO_OVERFLOW_DISCONNECTION = True
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            env = grid2op.make(env_name, backend=LightSimBackend(), param=param, test=True)
+
+        obs = env.reset()
+        grid = env.backend._grid
+        Vinit = env.backend.V
+        prod_p = 1.0 * env.chronics_handler.real_data.data.prod_p
+        load_p = 1.0 * env.chronics_handler.real_data.data.load_p
+        load_q = 1.0 * env.chronics_handler.real_data.data.load_q
+        nb_step = prod_p.shape[0]
+        sgen_p = np.zeros((nb_step, 0))
+
+        computer = Computers(grid)
+        status = computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        assert status == 1
+        Vs_ref = 1.0 * computer.get_voltages()
+
+        # same setpoints / shunts values as in the grid model: same results
+        gen_v = np.tile(np.array([el.target_vm_pu for el in grid.get_generators()]), (nb_step, 1))
+        shunt_q = np.tile(np.array([el.target_q_mvar for el in grid.get_shunts()]), (nb_step, 1))
+        computer = Computers(grid)
+        status = computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol,
+                                     gen_v=gen_v, shunt_q=shunt_q)
+        assert status == 1
+        assert np.max(np.abs(computer.get_voltages() - Vs_ref)) <= 1e-6
+
+        # voltage setpoints are used
+        gen_v_mod = 1.0 * gen_v
+        gen_v_mod[nb_step // 2:, :] *= 1.01
+        status = computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol,
+                                     gen_v=gen_v_mod)
+        assert status == 1
+        Vs = computer.get_voltages()
+        gen_bus = np.array([el.bus_id for el in grid.get_generators()])
+        assert np.max(np.abs(np.abs(Vs[:, gen_bus]) - gen_v_mod)) <= 1e-6
+        assert np.max(np.abs(Vs[:nb_step // 2] - Vs_ref[:nb_step // 2])) <= 1e-6
+
+        # shunts are used
+        shunt_q_mod = 1.0 * shunt_q
+        shunt_q_mod[nb_step // 2:, :] -= 10.
+        status = computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol,
+                                     shunt_q=shunt_q_mod)
+        assert status == 1
+        Vs = computer.get_voltages()
+        assert np.max(np.abs(Vs[:nb_step // 2] - Vs_ref[:nb_step // 2])) <= 1e-6
+        assert np.max(np.abs(Vs[nb_step // 2:] - Vs_ref[nb_step // 2:])) > 1e-4
+
+        # wrong shape are detected
+        with self.assertRaises(RuntimeError):
+            computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol,
+                                gen_v=gen_v[:, 1:])
+
+    def test_async(self):
+        env_name = "l2rpn_case14_sandbox"
+        param = Parameters()
+        param.NO_OVERFLOW_DISCONNECTION = True
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            env = grid2op.make(env_name, backend=LightSimBackend(), param=param, test=True)
+
+        obs = env.reset()
+        grid = env.backend._grid
+        Vinit = env.backend.V
+        prod_p = 1.0 * env.chronics_handler.real_data.data.prod_p
+        load_p = 1.0 * env.chronics_handler.real_data.data.load_p
+        load_q = 1.0 * env.chronics_handler.real_data.data.load_q
+        sgen_p = np.zeros((prod_p.shape[0], 0))
+
+        computer = Computers(grid)
+        status = computer.compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        assert status == 1
+        Vs_ref = 1.0 * computer.get_voltages()
+
+        computer_async = Computers(grid)
+        computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        status = computer_async.result()
+        assert status == 1
+        assert not computer_async.is_running()
+        nb_done, nb_failed, solver_time = computer_async.get_progress()
+        assert nb_done == prod_p.shape[0]
+        assert nb_failed == 0
+        assert solver_time > 0.
+        assert np.max(np.abs(computer_async.get_voltages() - Vs_ref)) <= 1e-8
+
+        # cancel the computation
+        computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        computer_async.cancel()
+        computer_async.wait()
+        nb_done, nb_failed, solver_time = computer_async.get_progress()
+        assert nb_done <= prod_p.shape[0]
+        if nb_done < prod_p.shape[0]:
+            assert computer_async.get_status() == 0
+
+        # errors are raised when waiting
+        computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit[1:], env.backend.max_it, env.backend.tol)
+        with self.assertRaises(RuntimeError):
+            computer_async.wait()
+
+        # a new computation cannot be started before the error of the previous one is retrieved
+        computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit[1:], env.backend.max_it, env.backend.tol)
+        while computer_async.is_running():
+            pass
+        with self.assertRaises(RuntimeError):
+            computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        with self.assertRaises(RuntimeError):
+            computer_async.wait()
+        computer_async.start_compute_Vs(prod_p, sgen_p, load_p, load_q, Vinit, env.backend.max_it, env.backend.tol)
+        assert computer_async.result() == 1
+
+
+if __name__ == "__main__":
+    unittest.main()
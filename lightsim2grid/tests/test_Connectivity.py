@@ -0,0 +1,79 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestConnectivity(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.n_line = len(self.model.get_lines())
+        self.n_branch = self.n_line + len(self.model.get_trafos())
+
+    def _aux_disconnect(self, model, branch_id):
+        if branch_id < self.n_line:
+            model.deactivate_powerline(branch_id)
+        else:
+            model.deactivate_trafo(branch_id - self.n_line)
+
+    def test_bridges(self):
+        assert self.model.nb_connected_components() == 1
+        bridges = self.model.get_bridges()
+        assert len(bridges) == self.n_branch
+        assert np.any(bridges), "case118 has some radial branches"
+        for branch_id in range(self.n_branch):
+            model = self.model.copy()
+            self._aux_disconnect(model, branch_id)
+            assert (model.nb_connected_components() > 1) == bridges[branch_id], f"error for branch {branch_id}"
+            assert self.model.is_islanding([branch_id]) == bridges[branch_id]
+
+    def test_islands(self):
+        bridge_id = int(np.where(self.model.get_bridges())[0][0])
+        self._aux_disconnect(self.model, bridge_id)
+        assert self.model.nb_connected_components() == 2
+        islands = self.model.get_bus_islands()
+        assert islands.shape[0] == self.model.total_bus()
+        assert set(islands) == {0, 1}
+
+        # reconnect it
+        if bridge_id < self.n_line:
+            self.model.reactivate_powerline(bridge_id)
+        else:
+            self.model.reactivate_trafo(bridge_id - self.n_line)
+        assert self.model.nb_connected_components() == 1
+        assert np.all(self.model.get_bus_islands() == 0)
+
+    def test_nk(self):
+        bridges = self.model.get_bridges()
+        non_bridges = [int(el) for el in np.where(~np.array(bridges))[0]]
+        assert not self.model.is_islanding(non_bridges[:1])
+        # disconnect all the powerlines of one bus (without trafo) that is not a "leaf"
+        bus_from = np.array([el.bus_or_id for el in self.model.get_lines()])
+        bus_to = np.array([el.bus_ex_id for el in self.model.get_lines()])
+        trafo_buses = set([el.bus_hv_id for el in self.model.get_trafos()] +
+                          [el.bus_lv_id for el in self.model.get_trafos()])
+        for bus_id in range(self.model.total_bus()):
+            if bus_id in trafo_buses:
+                continue
+            branch_ids = [int(el) for el in np.where((bus_from == bus_id) | (bus_to == bus_id))[0]]
+            if len(branch_ids) >= 2 and not np.any(np.array(bridges)[branch_ids]):
+                break
+        assert self.model.is_islanding(branch_ids)
+        with self.assertRaises(RuntimeError):
+            self.model.is_islanding([self.n_branch])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,96 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestElementColumns(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.model.deactivate_powerline(0)
+        V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.V = self.model.ac_pf(V0, 10, 1e-8)
+        assert self.V.shape[0] > 0, "powerflow diverged"
+
+    def _aux_check(self, data, attr_names):
+        for attr_nm in attr_names:
+            column = getattr(data, attr_nm)
+            assert column.shape[0] == len(data), f"wrong size for {attr_nm}"
+            assert np.array_equal(column, [getattr(el, attr_nm) for el in data]), f"wrong values for {attr_nm}"
+
+    def test_same_as_iterator(self):
+        res = ["res_p_mw", "res_q_mvar", "res_v_kv", "res_theta_deg"]
+        self._aux_check(self.model.get_lines(),
+                        ["connected", "bus_or_id", "bus_ex_id", "r_pu", "x_pu", "h_pu",
+                         "res_p_or_mw", "res_q_or_mvar", "res_v_or_kv", "res_a_or_ka",
+                         "res_p_ex_mw", "res_q_ex_mvar", "res_v_ex_kv", "res_a_ex_ka",
+                         "res_theta_or_deg", "res_theta_ex_deg"])
+        self._aux_check(self.model.get_trafos(),
+                        ["connected", "bus_hv_id", "bus_lv_id", "r_pu", "x_pu", "h_pu", "is_tap_hv_side", "ratio",
+                         "shift_rad", "res_p_hv_mw", "res_q_hv_mvar", "res_v_hv_kv", "res_a_hv_ka",
+                         "res_p_lv_mw", "res_q_lv_mvar", "res_v_lv_kv", "res_a_lv_ka", "res_theta_hv_deg",
+                         "res_theta_lv_deg"])
+        self._aux_check(self.model.get_generators(),
+                        ["connected", "bus_id", "is_slack", "slack_weight", "target_p_mw", "target_vm_pu",
+                         "min_q_mvar", "max_q_mvar"] + res)
+        self._aux_check(self.model.get_loads(), ["connected", "bus_id", "target_p_mw", "target_q_mvar"] + res)
+        self._aux_check(self.model.get_shunts(), ["connected", "bus_id", "target_p_mw", "target_q_mvar"] + res)
+
+    def test_read_only_view(self):
+        lines = self.model.get_lines()
+        p_or = lines.res_p_or_mw
+        assert not p_or.flags.writeable
+        assert not lines.connected[0]
+        with self.assertRaises(ValueError):
+            p_or[0] = 1.
+        # the same memory is used each time, the table is not copied
+        assert np.shares_memory(p_or, lines.res_p_or_mw)
+        assert np.shares_memory(p_or, self.model.get_lines().res_p_or_mw)
+        # the arrays can be used after the object is deleted
+        del lines
+        assert np.array_equal(p_or, self.model.get_lines().res_p_or_mw)
+
+    def test_view_updated(self):
+        p_or = self.model.get_lines().res_p_or_mw
+        p_or_before = np.array(p_or)
+        load = self.model.get_loads()[0]
+        self.model.change_p_load(0, 2. * load.target_p_mw)
+        V = self.model.ac_pf(self.V, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        # the memory is reused by the new powerflow: the table has the new results
+        p_or_after = self.model.get_lines().res_p_or_mw
+        assert np.shares_memory(p_or, p_or_after)
+        assert np.max(np.abs(p_or_after - p_or_before)) > 1e-3
+
+    def test_view_after_divergence(self):
+        p_or = self.model.get_lines().res_p_or_mw
+        load_p = self.model.get_loads()[0].target_p_mw
+        self.model.change_p_load(0, 1e5)
+        V = self.model.ac_pf(self.V, 10, 1e-8)
+        assert V.shape[0] == 0, "powerflow should have diverged"
+        # the memory of the results is kept (and set to nan), the array can still be read
+        assert np.shares_memory(p_or, self.model.get_lines().res_p_or_mw)
+        assert np.all(np.isnan(p_or))
+        assert not self.model.get_lines()[1].has_res
+        # and it is updated by the next powerflow
+        self.model.change_p_load(0, load_p)
+        V = self.model.ac_pf(self.V, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert not np.any(np.isnan(p_or))
+        assert np.array_equal(p_or, self.model.get_lines().res_p_or_mw)
+
+
+if __name__ == "__main__":
+    unittest.main()
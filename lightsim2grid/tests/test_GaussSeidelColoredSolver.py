@@ -0,0 +1,83 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import SolverType
+
+
+class TestGaussSeidelColored(unittest.TestCase):
+    def setUp(self):
+        self.max_it_nr = 10
+        self.max_it_gs = 10000
+        self.tol = 1e-8
+        self.tol_gs = 1e-6  # gauss seidel converges slowly
+        self.tol_test = 1e-4
+
+    def _aux_get_model(self, net):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            model = init(net)
+        return model
+
+    def _aux_compare(self, net, nb_thread=1, omega=1.8, adaptive=True):
+        model = self._aux_get_model(net)
+        V0 = np.ones(model.total_bus(), dtype=complex)
+
+        model.change_solver(SolverType.SparseLUSingleSlack)
+        V_nr = model.ac_pf(V0, self.max_it_nr, self.tol)
+        assert V_nr.shape[0] > 0, "reference powerflow diverged"
+
+        model.change_solver(SolverType.GaussSeidelColored)
+        model.set_gauss_seidel_colored_config(nb_thread, omega, adaptive)
+        assert model.get_gauss_seidel_colored_config() == (nb_thread, omega, adaptive)
+        assert model.get_solver().get_gauss_seidel_colored_config() == (nb_thread, omega, adaptive)
+        V_gs = model.ac_pf(V0, self.max_it_gs, self.tol_gs)
+        assert V_gs.shape[0] > 0, "powerflow diverged with GaussSeidelColored"
+        assert np.max(np.abs(V_gs - V_nr)) <= self.tol_test, "wrong voltages"
+        return model.get_solver().get_nb_iter()
+
+    def test_case14(self):
+        self._aux_compare(pn.case14())
+
+    def test_case118(self):
+        self._aux_compare(pn.case118())
+
+    def test_threads(self):
+        self._aux_compare(pn.case118(), nb_thread=4)
+
+    def test_sor(self):
+        nb_iter_gs = self._aux_compare(pn.case118(), omega=1.0, adaptive=False)
+        nb_iter_sor = self._aux_compare(pn.case118(), omega=1.8, adaptive=True)
+        assert nb_iter_sor <= nb_iter_gs, "adaptive SOR should not be slower than the standard gauss seidel"
+
+    def test_wrong_config(self):
+        model = self._aux_get_model(pn.case14())
+        config = model.get_gauss_seidel_colored_config()
+        with self.assertRaises(RuntimeError):
+            model.set_gauss_seidel_colored_config(0, 1.5, True)
+        with self.assertRaises(RuntimeError):
+            model.set_gauss_seidel_colored_config(1, 2.0, True)
+        with self.assertRaises(RuntimeError):
+            model.set_gauss_seidel_colored_config(2, 0.5, True)
+        # nothing has been changed
+        assert model.get_gauss_seidel_colored_config() == config
+
+    def test_copy(self):
+        model = self._aux_get_model(pn.case14())
+        model.set_gauss_seidel_colored_config(3, 1.5, False)
+        model_cpy = model.copy()
+        assert model_cpy.get_gauss_seidel_colored_config() == (3, 1.5, False)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,84 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import copy
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import SolverType
+
+
+class TestGridModelCopy(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+
+    def test_same_results(self):
+        V_ref = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V_ref.shape[0] > 0, "powerflow diverged"
+        for model_cpy in [self.model.copy(), copy.deepcopy(self.model)]:
+            V_cpy = model_cpy.ac_pf(self.V0, self.max_it, self.tol)
+            assert V_cpy.shape[0] > 0, "powerflow diverged on the copy"
+            assert np.max(np.abs(V_cpy - V_ref)) <= self.tol_test, "wrong voltages on the copy"
+
+    def test_modif_independant(self):
+        V_ref = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        model_cpy = self.model.copy()
+        model_cpy.deactivate_powerline(0)
+        model_cpy.change_p_load(0, 2. * self.model.get_loads()[0].target_p_mw)
+        V_cpy = model_cpy.ac_pf(self.V0, self.max_it, self.tol)
+        assert V_cpy.shape[0] > 0, "powerflow diverged on the copy"
+        assert np.max(np.abs(V_cpy - V_ref)) > self.tol_test, "the copy has not been modified"
+
+        # the original model is not affected
+        V_orig = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert np.max(np.abs(V_orig - V_ref)) <= self.tol_test, "the original model has been modified"
+        assert self.model.get_lines()[0].connected
+
+    def test_keep_solver_state(self):
+        for solver_type in [SolverType.SparseLU, SolverType.SparseLUSingleSlack, SolverType.DenseLU, SolverType.KLU]:
+            if solver_type not in self.model.available_solvers():
+                continue
+            self.model.change_solver(solver_type)
+            V_ref = self.model.ac_pf(self.V0, self.max_it, self.tol)
+            assert V_ref.shape[0] > 0, f"powerflow diverged for {solver_type}"
+            self.model.unset_topo_changed()
+
+            model_cpy = self.model.copy(keep_solver_state=True)
+            assert model_cpy.get_solver_type() == solver_type
+            # the state of the solver is available without running a powerflow
+            assert model_cpy.get_solver().get_J().shape == self.model.get_solver().get_J().shape
+
+            # the copy gives the same results as the original model, even after a modification
+            for model in [self.model, model_cpy]:
+                model.change_p_load(0, 2. * self.model.get_loads()[0].target_p_mw)
+            V_orig = self.model.ac_pf(self.V0, self.max_it, self.tol)
+            V_cpy = model_cpy.ac_pf(self.V0, self.max_it, self.tol)
+            assert V_cpy.shape[0] > 0, f"powerflow diverged on the copy for {solver_type}"
+            assert np.max(np.abs(V_cpy - V_orig)) <= self.tol_test, f"wrong voltages on the copy for {solver_type}"
+            for model in [self.model, model_cpy]:
+                model.change_p_load(0, 0.5 * self.model.get_loads()[0].target_p_mw)
+
+            # a change of topology on the copy is taken into account
+            model_cpy.deactivate_powerline(0)
+            model_cpy.tell_topo_changed()
+            V_cpy = model_cpy.ac_pf(self.V0, self.max_it, self.tol)
+            assert V_cpy.shape[0] > 0, f"powerflow diverged on the copy for {solver_type}"
+            assert np.max(np.abs(V_cpy - V_ref)) > self.tol_test, "the copy has not been modified"
+
+
+if __name__ == "__main__":
+    unittest.main()
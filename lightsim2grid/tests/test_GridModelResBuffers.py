@@ -0,0 +1,85 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestGridModelResBuffers(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-4  # results are stored in float32
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.n_line = len(self.model.get_lines())
+        n_branch = self.n_line + len(self.model.get_trafos())
+        n_load = len(self.model.get_loads())
+        n_gen = len(self.model.get_generators())
+        self.line_res = [np.full(n_branch, np.NaN, dtype=np.float32) for _ in range(10)]
+        self.load_res = [np.full(n_load, np.NaN, dtype=np.float32) for _ in range(4)]
+        self.gen_res = [np.full(n_gen, np.NaN, dtype=np.float32) for _ in range(4)]
+        self.model.set_line_res_buffers(*self.line_res)
+        self.model.set_load_res_buffers(*self.load_res)
+        self.model.set_gen_res_buffers(*self.gen_res)
+
+    def _aux_check(self, buffer, res, factor=1.):
+        res = factor * np.array(res)
+        res[~np.isfinite(res)] = 0.
+        assert np.max(np.abs(buffer - res)) <= self.tol_test * max(1., np.max(np.abs(res)))
+
+    def test_results_written(self):
+        self.model.deactivate_powerline(0)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        p_or, q_or, v_or, a_or, theta_or, p_ex, q_ex, v_ex, a_ex, theta_ex = self.line_res
+        nl = self.n_line
+        lor_p, lor_q, lor_v, lor_a = self.model.get_lineor_res()
+        thv_p, thv_q, thv_v, thv_a = self.model.get_trafohv_res()
+        self._aux_check(p_or[:nl], lor_p)
+        self._aux_check(q_or[:nl], lor_q)
+        self._aux_check(v_or[:nl], lor_v)
+        self._aux_check(a_or[:nl], lor_a, factor=1000.)  # in A
+        self._aux_check(theta_or[:nl], self.model.get_lineor_theta())
+        self._aux_check(p_or[nl:], thv_p)
+        self._aux_check(a_or[nl:], thv_a, factor=1000.)
+        lex_p, *_ = self.model.get_lineex_res()
+        self._aux_check(p_ex[:nl], lex_p)
+        self._aux_check(theta_ex[nl:], self.model.get_trafolv_theta())
+        assert a_or[0] == 0. and v_or[0] == 0., "disconnected powerline should have 0. flows"
+
+        for buffer, res in zip(self.load_res, list(self.model.get_loads_res()) + [self.model.get_load_theta()]):
+            self._aux_check(buffer, res)
+        for buffer, res in zip(self.gen_res, list(self.model.get_gen_res()) + [self.model.get_gen_theta()]):
+            self._aux_check(buffer, res)
+
+    def test_copy_and_clear(self):
+        model_cpy = self.model.copy()
+        V = model_cpy.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.all(np.isnan(self.load_res[0])), "the buffers should not be registered on the copy"
+        self.model.clear_res_buffers()
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert np.all(np.isnan(self.load_res[0])), "the buffers should not be written after clear_res_buffers"
+
+    def test_wrong_buffers(self):
+        with self.assertRaises(RuntimeError):
+            self.model.set_load_res_buffers(np.zeros(3, dtype=np.float32), *self.load_res[1:])
+        with self.assertRaises(TypeError):
+            # a copy would be needed: not possible
+            self.model.set_load_res_buffers(np.zeros(self.load_res[0].shape, dtype=np.float64), *self.load_res[1:])
+
+
+if __name__ == "__main__":
+    unittest.main()
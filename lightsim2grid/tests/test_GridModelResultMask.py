@@ -0,0 +1,63 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init, ResultType
+
+
+class TestGridModelResultMask(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.model_ref = self.model.copy()
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+        V = self.model_ref.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+
+    def _aux_check_same(self, res, res_ref):
+        for el, el_ref in zip(res, res_ref):
+            assert np.max(np.abs(el - el_ref)) <= self.tol_test
+
+    def test_lazy(self):
+        assert self.model.get_result_mask() == int(ResultType.All)
+        self.model.set_result_mask(ResultType.Lines | ResultType.Trafos)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        self._aux_check_same(self.model.get_lineor_res(), self.model_ref.get_lineor_res())
+        self._aux_check_same(self.model.get_trafohv_res(), self.model_ref.get_trafohv_res())
+        # computed on demand
+        self._aux_check_same(self.model.get_gen_res(), self.model_ref.get_gen_res())
+        self._aux_check_same(self.model.get_loads_res(), self.model_ref.get_loads_res())
+        self._aux_check_same([self.model.get_load_theta()], [self.model_ref.get_load_theta()])
+
+    def test_dropped_after_modification(self):
+        self.model.set_result_mask(ResultType.Lines)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        self.model.change_p_load(0, 10.)
+        # the results of the loads would not be the ones of the last powerflow
+        assert np.all(np.isnan(self.model.get_loads_res()[0]))
+        assert not np.any(np.isnan(self.model.get_lineor_res()[0]))
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert not np.any(np.isnan(self.model.get_loads_res()[0]))
+
+    def test_wrong_mask(self):
+        with self.assertRaises(RuntimeError):
+            self.model.set_result_mask(1000)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,85 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import os
+import pickle
+import tempfile
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init, GridModel
+
+
+class TestGridModelSerialization(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.model.deactivate_powerline(0)
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+
+    def _aux_check_same(self, model_loaded):
+        V_ref = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V_ref.shape[0] > 0, "powerflow diverged"
+        V_loaded = model_loaded.ac_pf(self.V0, self.max_it, self.tol)
+        assert V_loaded.shape[0] > 0, "powerflow diverged on the loaded model"
+        assert np.max(np.abs(V_loaded - V_ref)) <= self.tol_test, "wrong voltages on the loaded model"
+        assert not model_loaded.get_lines()[0].connected
+
+    def test_bytes(self):
+        data = self.model.to_bytes()
+        assert isinstance(data, bytes)
+        assert data[:8] == b"LS2GRID\x00"
+        model_loaded = GridModel.from_bytes(data)
+        self._aux_check_same(model_loaded)
+        assert model_loaded.to_bytes() == data
+
+    def test_layout(self):
+        data = self.model.to_bytes()
+        nb_block = int(np.frombuffer(data, dtype="<u4", count=1, offset=12)[0])
+        # every block starts at an offset multiple of 8 bytes, the whole data are covered by the blocks
+        pos = 32
+        for _ in range(nb_block):
+            assert pos % 8 == 0
+            dtype = int(np.frombuffer(data, dtype="<u4", count=1, offset=pos)[0])
+            nb_el = int(np.frombuffer(data, dtype="<u8", count=1, offset=pos + 8)[0])
+            el_size = {1: 4, 2: 8, 3: 4, 4: 16, 5: 8, 6: 1}[dtype]
+            pos += 16 + nb_el * el_size
+            pos += (8 - pos % 8) % 8
+        assert pos == len(data)
+
+    def test_file(self):
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "case118.ls2g")
+            self.model.save(path)
+            model_loaded = GridModel.load(path)
+        self._aux_check_same(model_loaded)
+
+    def test_pickle(self):
+        model_loaded = pickle.loads(pickle.dumps(self.model))
+        self._aux_check_same(model_loaded)
+        assert isinstance(self.model.__getstate__()[0], bytes)
+
+    def test_corrupted(self):
+        data = self.model.to_bytes()
+        with self.assertRaises(RuntimeError):
+            GridModel.from_bytes(data[:-24])
+        with self.assertRaises(RuntimeError):
+            GridModel.from_bytes(b"X" + data[1:])
+        with self.assertRaises(RuntimeError):
+            # wrong version of the binary format
+            GridModel.from_bytes(data[:8] + (1000).to_bytes(4, "little") + data[12:])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,110 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestGridModelSnapshot(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.V_ref = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert self.V_ref.shape[0] > 0, "powerflow diverged"
+        self.model.unset_topo_changed()
+        self.data_ref = self.model.to_bytes()
+
+    def _aux_modify(self):
+        model = self.model
+        model.deactivate_powerline(0)
+        model.change_p_load(1, 2. * model.get_loads()[1].target_p_mw)
+        model.change_v_gen(2, 1.02)
+        # change the value of an element and disconnect it afterwards
+        model.change_q_load(3, 10.)
+        model.deactivate_load(3)
+        model.change_bus_load(4, model.get_loads()[5].bus_id)
+        V = model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged on the modified grid"
+        model.unset_topo_changed()
+        assert np.max(np.abs(V - self.V_ref)) > self.tol_test, "the grid has not been modified"
+
+    def _aux_check_restored(self):
+        assert self.model.to_bytes() == self.data_ref, "the grid has not been restored"
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged after the restoration"
+        assert np.max(np.abs(V - self.V_ref)) <= self.tol_test, "wrong voltages after the restoration"
+        self.model.unset_topo_changed()
+
+    def test_restore(self):
+        snapshot_id = self.model.snapshot()
+        for _ in range(3):
+            # a snapshot can be restored multiple times
+            self._aux_modify()
+            self.model.restore(snapshot_id)
+            self._aux_check_restored()
+
+    def test_shunt(self):
+        # the shunts are part of the admittance matrix: it must be recomputed after the restoration
+        snapshot_id = self.model.snapshot()
+        self.model.change_p_shunt(0, 10.)
+        self.model.change_q_shunt(0, 30.)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged on the modified grid"
+        self.model.unset_topo_changed()
+        assert np.max(np.abs(V - self.V_ref)) > self.tol_test, "the grid has not been modified"
+        self.model.restore(snapshot_id)
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            model_ref = init(pn.case118())
+        V_fresh = model_ref.ac_pf(self.V0, self.max_it, self.tol)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged after the restoration"
+        assert np.max(np.abs(V - V_fresh)) <= self.tol_test, "wrong voltages after the restoration"
+
+    def test_nested(self):
+        snapshot_id = self.model.snapshot()
+        self.model.deactivate_powerline(1)
+        snapshot_id2 = self.model.snapshot()
+        self._aux_modify()
+        self.model.restore(snapshot_id2)
+        assert not self.model.get_lines()[1].connected
+        assert self.model.get_lines()[0].connected
+        self.model.restore(snapshot_id)
+        self._aux_check_restored()
+        with self.assertRaises(RuntimeError):
+            # discarded by the restoration of an older snapshot
+            self.model.restore(snapshot_id2)
+
+    def test_copy(self):
+        snapshot_id = self.model.snapshot()
+        self._aux_modify()
+        model_cpy = self.model.copy()
+        model_cpy.restore(snapshot_id)
+        assert model_cpy.to_bytes() == self.data_ref
+        assert not self.model.get_lines()[0].connected, "the original model has been modified"
+
+    def test_clear(self):
+        snapshot_id = self.model.snapshot()
+        assert self.model.has_snapshot(snapshot_id)
+        self.model.clear_snapshots()
+        assert not self.model.has_snapshot(snapshot_id)
+        with self.assertRaises(RuntimeError):
+            self.model.restore(snapshot_id)
+
+
+if __name__ == "__main__":
+    unittest.main()
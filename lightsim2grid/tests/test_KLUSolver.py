@@ -127,5 +127,76 @@ class MakeTests(unittest.TestCase):
         assert nb_tested == 5, "incorrect number of test cases found, found {} while there should be 5".format(nb_tested)
 
 
+class TestKLUConfig(unittest.TestCase):
+    def setUp(self):
+        if not KLU_AVAILBLE:
+            self.skipTest("KLU is not installed")
+        import warnings
+        import pandapower.networks as pn
+        from lightsim2grid.gridmodel import init
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+
+    def test_config(self):
+        from lightsim2grid.solver import KLUSolverConfig, SolverType
+        self.model.change_solver(SolverType.KLU)
+        V_ref = self.model.ac_pf(self.V0, 10, 1e-8)
+        assert V_ref.shape[0] > 0, "powerflow diverged"
+        stats_ref = self.model.get_solver().get_klu_stats()
+        assert stats_ref.nb_factor == 1
+        assert stats_ref.nb_refactor == self.model.get_solver().get_nb_iter() - 1
+        assert stats_ref.lnz > 0
+        assert stats_ref.unz > 0
+        assert stats_ref.flops > 0.
+
+        config = KLUSolverConfig()
+        config.ordering = 1
+        config.btf = False
+        config.scale = 1
+        self.model.set_klu_config(config)
+        config_after = self.model.get_klu_config()
+        assert config_after.ordering == 1
+        assert not config_after.btf
+        assert config_after.scale == 1
+        V = self.model.ac_pf(self.V0, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.max(np.abs(V - V_ref)) <= 1e-6
+        # the ordering is not the same, so is the fill in
+        stats = self.model.get_solver().get_klu_stats()
+        assert (stats.lnz, stats.unz) != (stats_ref.lnz, stats_ref.unz)
+
+        # the config is kept when the model is copied
+        model_copy = self.model.copy()
+        assert model_copy.get_klu_config().ordering == 1
+        assert not model_copy.get_klu_config().btf
+        V = model_copy.ac_pf(self.V0, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        stats_copy = model_copy.get_solver().get_klu_stats()
+        assert (stats_copy.lnz, stats_copy.unz) == (stats.lnz, stats.unz)
+
+        # no check of the refactorizations: klu_factor is called only once
+        config.check_refactor = False
+        self.model.set_klu_config(config)
+        V = self.model.ac_pf(self.V0, 10, 1e-8)
+        assert V.shape[0] > 0, "powerflow diverged"
+        stats = self.model.get_solver().get_klu_stats()
+        assert stats.nb_factor == 1
+        assert stats.nb_fallback == 0
+
+        config.ordering = 3
+        with self.assertRaises(RuntimeError):
+            self.model.set_klu_config(config)
+        assert self.model.get_klu_config().ordering == 1
+
+    def test_stats_wrong_solver(self):
+        from lightsim2grid.solver import SolverType
+        self.model.change_solver(SolverType.SparseLU)
+        self.model.ac_pf(self.V0, 10, 1e-8)
+        with self.assertRaises(RuntimeError):
+            self.model.get_solver().get_klu_stats()
+
+
 if __name__ == "__main__":
     unittest.main()
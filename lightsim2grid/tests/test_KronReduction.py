@@ -0,0 +1,69 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestKronReduction(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-6
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+
+    def _aux_compare(self, model_ref):
+        V_ref = model_ref.ac_pf(self.V0, self.max_it, self.tol)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.max(np.abs(V - V_ref)) <= self.tol_test
+        p_or_ref = 1. * model_ref.get_lineor_res()[0]
+        p_or = 1. * self.model.get_lineor_res()[0]
+        assert np.max(np.abs(p_or - p_or_ref)) <= self.tol_test
+        return V
+
+    def test_same_results(self):
+        model_ref = self.model.copy()
+        assert not self.model.get_kron_reduction()
+        self.model.set_kron_reduction(True)
+        assert self.model.get_kron_reduction()
+        V = self._aux_compare(model_ref)
+        assert self.model.nb_kron_eliminated() > 0, "case118 has some buses without injection"
+        assert np.max(np.abs(self.model.check_solution(V, False))) <= self.tol_test
+
+        # more buses without injection
+        nb_elim = self.model.nb_kron_eliminated()
+        for model in [self.model, model_ref]:
+            model.change_p_load(0, 0.)
+            model.change_q_load(0, 0.)
+        self._aux_compare(model_ref)
+        assert self.model.nb_kron_eliminated() >= nb_elim
+
+        # deactivated again
+        self.model.set_kron_reduction(False)
+        self._aux_compare(model_ref)
+        assert self.model.nb_kron_eliminated() == 0
+
+    def test_split_grid(self):
+        n_line = len(self.model.get_lines())
+        bridge_id = int(np.where(self.model.get_bridges()[:n_line])[0][0])
+        self.model.deactivate_powerline(bridge_id)
+        model_ref = self.model.copy()
+        self.model.set_kron_reduction(True)
+        self._aux_compare(model_ref)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,82 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import SolverType
+
+
+class TestLDLTDC(unittest.TestCase):
+    def setUp(self):
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+
+    def _aux_get_model(self, net):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            model = init(net)
+        return model
+
+    def _aux_compare(self, net):
+        model = self._aux_get_model(net)
+        V0 = np.ones(model.total_bus(), dtype=complex)
+
+        model.change_solver(SolverType.DC)
+        V_lu = model.dc_pf(V0, self.max_it, self.tol)
+        assert V_lu.shape[0] > 0, "reference DC powerflow diverged"
+
+        model.change_solver(SolverType.LDLTDC)
+        assert model.get_dc_solver_type() == SolverType.LDLTDC
+        V_ldlt = model.dc_pf(V0, self.max_it, self.tol)
+        assert V_ldlt.shape[0] > 0, "DC powerflow diverged with LDLTDC"
+        assert np.max(np.abs(V_ldlt - V_lu)) <= self.tol_test, "wrong voltages"
+
+        # a second powerflow (refactorization of the matrix) gives the same results
+        V_ldlt2 = model.dc_pf(V0, self.max_it, self.tol)
+        assert np.max(np.abs(V_ldlt2 - V_lu)) <= self.tol_test, "wrong voltages after refactorization"
+
+    def test_available(self):
+        model = self._aux_get_model(pn.case14())
+        assert SolverType.LDLTDC in model.available_solvers()
+        # it is not the default dc solver
+        assert model.get_dc_solver_type() == SolverType.DC
+
+    def test_case14(self):
+        self._aux_compare(pn.case14())
+
+    def test_case118(self):
+        self._aux_compare(pn.case118())
+
+    def test_case300(self):
+        # this grid has phase shifting transformers
+        self._aux_compare(pn.case300())
+
+    def test_solve_many(self):
+        model = self._aux_get_model(pn.case14())
+        V0 = np.ones(model.total_bus(), dtype=complex)
+        V = model.dc_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        dc_solver = model.get_dc_solver()
+
+        slack_id = model.get_slack_ids()[0]
+        dcYbus = model.get_dcYbus().real.tocsc()
+        keep = np.arange(dcYbus.shape[0]) != slack_id
+        dcYbus = dcYbus[keep, :][:, keep]
+        np.random.seed(0)
+        B = np.random.randn(dcYbus.shape[0], 5)
+        X = dc_solver.solve_many(B, nb_thread=2)
+        assert np.max(np.abs(dcYbus @ X - B)) <= self.tol_test, "wrong solutions"
+
+
+if __name__ == "__main__":
+    unittest.main()
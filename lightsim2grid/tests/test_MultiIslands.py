@@ -0,0 +1,88 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import ErrorType
+
+
+class TestMultiIslands(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-6
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.n_line = len(self.model.get_lines())
+        # split the grid
+        self.bridge_id = int(np.where(self.model.get_bridges()[:self.n_line])[0][0])
+        self.model.deactivate_powerline(self.bridge_id)
+        assert self.model.nb_connected_components() == 2
+
+        slack_buses = [el.bus_id for el in self.model.get_generators() if el.is_slack]
+        islands = self.model.get_bus_islands()
+        self.live = islands == islands[slack_buses[0]]
+        self.dead = (~self.live) & (islands >= 0)
+
+    def _aux_check(self, V, ac=True):
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.all(V[self.dead] == 0.), "the island without slack bus should be de-energized"
+        assert np.all(np.abs(V[self.live]) > 0.)
+        if ac:
+            mismatch = self.model.check_solution(V, False)
+            assert np.max(np.abs(mismatch[self.live])) <= self.tol_test
+        p_or, q_or, v_or, a_or = self.model.get_lineor_res()
+        assert np.all(np.isfinite(p_or)) and np.all(np.isfinite(a_or)), "the flows should not be NaN"
+        lines_dead = np.array([self.dead[el.bus_or_id] for el in self.model.get_lines()])
+        assert np.all(p_or[lines_dead] == 0.)
+        assert np.all(a_or[lines_dead] == 0.)
+
+    def test_ac(self):
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        self._aux_check(V)
+
+    def test_dc(self):
+        V = self.model.dc_pf(self.V0, self.max_it, self.tol)
+        self._aux_check(V, ac=False)
+
+    def test_getters(self):
+        # the results come from the solvers of the islands, not from the (unused) solver of the whole grid
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        self._aux_check(V)
+        id_solver_to_me = self.model.id_ac_solver_to_me()
+        assert np.max(np.abs(self.model.get_V() - V[id_solver_to_me])) <= self.tol_test
+        assert np.max(np.abs(self.model.get_Vm() - np.abs(V[id_solver_to_me]))) <= self.tol_test
+        assert self.model.get_error() == ErrorType.NoError
+        assert self.model.get_computation_time() > 0.
+        with self.assertRaises(RuntimeError):
+            # no jacobian matrix for the whole grid
+            self.model.get_J()
+
+        V = self.model.dc_pf(self.V0, self.max_it, self.tol)
+        assert self.model.get_dc_error() == ErrorType.NoError
+        assert self.model.get_dc_computation_time() > 0.
+        # the ac results are kept
+        assert np.max(np.abs(self.model.get_V() - V[id_solver_to_me])) > self.tol_test
+
+    def test_reconnect(self):
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        self._aux_check(V)
+        self.model.reactivate_powerline(self.bridge_id)
+        V = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert np.all(np.abs(V) > 0.)
+
+
+if __name__ == "__main__":
+    unittest.main()
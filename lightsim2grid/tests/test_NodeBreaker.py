@@ -0,0 +1,173 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower as pp
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init, TerminalType
+
+
+class TestNodeBreaker(unittest.TestCase):
+    def setUp(self):
+        net = pn.case14()
+        # a second (unused) bus in the substation of the first load
+        self.bus_id = int(net.load["bus"].iloc[0])
+        pp.create_bus(net, vn_kv=net.bus["vn_kv"].iloc[self.bus_id], in_service=False)
+        self.net = net
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(net)
+            self.model_ref = init(net)
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-6
+        n_bus = self.model.total_bus()
+        self.bus_2_id = n_bus - 1
+        self.model_ref.deactivate_bus(self.bus_2_id)
+
+        # one node per bus (the second bus is a busbar of the substation of the first load), the first load and one
+        # side of a powerline are connected to their own node, linked to the two busbars by breakers
+        self.line_id = [el.id for el in self.model.get_lines() if el.bus_or_id == self.bus_id][0]
+        self.load_node = n_bus
+        self.line_node = n_bus + 1
+        load_nodes = [el.bus_id for el in self.model.get_loads()]
+        load_nodes[0] = self.load_node
+        line_or_nodes = [el.bus_or_id for el in self.model.get_lines()]
+        line_or_nodes[self.line_id] = self.line_node
+        self.terminals = [(TerminalType.Load, load_nodes),
+                          (TerminalType.Gen, [el.bus_id for el in self.model.get_generators()]),
+                          (TerminalType.LineOr, line_or_nodes),
+                          (TerminalType.LineEx, [el.bus_ex_id for el in self.model.get_lines()]),
+                          (TerminalType.TrafoHv, [el.bus_hv_id for el in self.model.get_trafos()]),
+                          (TerminalType.TrafoLv, [el.bus_lv_id for el in self.model.get_trafos()]),
+                          ]
+        self._aux_init_node_breaker(self.model)
+        for terminal_type, nodes in self.terminals:
+            self.model.set_node_breaker_terminals(terminal_type, nodes)
+
+    def _aux_init_node_breaker(self, model):
+        n_bus = model.total_bus()
+        node_to_sub = list(range(n_bus - 1)) + [self.bus_id, self.bus_id, self.bus_id]
+        sub_buses = [[bus_id] for bus_id in range(n_bus - 1)]
+        sub_buses[self.bus_id].append(self.bus_2_id)
+        bb_2 = n_bus - 1
+        # switches: load - busbar 1, load - busbar 2, line - busbar 1, line - busbar 2
+        model.init_node_breaker(node_to_sub=node_to_sub,
+                                sub_buses=sub_buses,
+                                switch_node_1=[self.load_node, self.load_node, self.line_node, self.line_node],
+                                switch_node_2=[self.bus_id, bb_2, self.bus_id, bb_2],
+                                switch_closed=[True, False, True, False])
+
+    def _aux_check_same(self):
+        V0 = np.ones(self.model.total_bus(), dtype=complex)
+        V = self.model.ac_pf(V0, self.max_it, self.tol)
+        V_ref = self.model_ref.ac_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert V_ref.shape[0] > 0, "reference powerflow diverged"
+        assert np.all((self.model.get_bus_islands() >= 0) == (self.model_ref.get_bus_islands() >= 0))
+        assert np.max(np.abs(self.model.get_lineor_res()[0] - self.model_ref.get_lineor_res()[0])) <= self.tol_test
+        assert np.max(np.abs(self.model.get_gen_res()[0] - self.model_ref.get_gen_res()[0])) <= self.tol_test
+
+    def test_init(self):
+        assert self.model.get_switches() == [True, False, True, False]
+        node_bus = self.model.get_node_bus()
+        assert node_bus[self.load_node] == self.bus_id
+        assert node_bus[self.line_node] == self.bus_id
+        assert node_bus[self.bus_2_id] == -1
+        self._aux_check_same()
+
+    def test_disconnect(self):
+        # the load is alone on the second busbar: it is disconnected
+        self.model.set_switches([0, 1], [False, True])
+        assert not self.model.get_loads()[0].connected
+        self.model_ref.deactivate_load(0)
+        self._aux_check_same()
+
+        # and reconnected
+        self.model.set_switch(0, True)
+        self.model.set_switch(1, False)
+        assert self.model.get_loads()[0].connected
+        self.model_ref.reactivate_load(0)
+        self._aux_check_same()
+
+    def test_split(self):
+        has_changed = np.ones(4, dtype=bool)
+        self.model.update_switches(has_changed, np.array([False, True, False, True]))
+        assert self.model.get_node_bus()[self.load_node] == self.bus_2_id
+        self.model_ref.reactivate_bus(self.bus_2_id)
+        self.model_ref.change_bus_load(0, self.bus_2_id)
+        self.model_ref.change_bus_powerline_or(self.line_id, self.bus_2_id)
+        self._aux_check_same()
+
+    def test_restore(self):
+        snapshot_id = self.model.snapshot()
+        self.model.set_switches([0, 1, 2, 3], [False, True, False, True])
+        self.model.restore(snapshot_id)
+        assert self.model.get_switches() == [True, False, True, False]
+        assert self.model.get_node_bus()[self.load_node] == self.bus_id
+        self._aux_check_same()
+
+    def test_partial_registration(self):
+        # the elements that are not registered stay on their bus: registering the types one by one never
+        # disconnects anything
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(self.net)
+        self._aux_init_node_breaker(self.model)
+        for terminal_type, nodes in self.terminals:
+            self.model.set_node_breaker_terminals(terminal_type, nodes)
+            assert np.all(self.model.get_bus_islands() == self.model_ref.get_bus_islands())
+            assert all(el.connected for el in self.model.get_loads())
+            assert all(el.connected for el in self.model.get_lines())
+
+    def test_only_loads(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(self.net)
+        self._aux_init_node_breaker(self.model)
+        self.model.set_node_breaker_terminals(*self.terminals[0])
+        self._aux_check_same()
+
+        # the node of the line is isolated, but the line is not handled by the processor: it stays on the first busbar
+        self.model.set_switches([0, 1, 2], [True, False, False])
+        assert self.model.get_loads()[0].connected
+        assert self.model.get_node_bus()[self.bus_id] == self.bus_id
+        self._aux_check_same()
+
+    def test_isolated_section(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(self.net)
+        self._aux_init_node_breaker(self.model)
+        self.model.set_node_breaker_terminals(*self.terminals[0])
+
+        # the first busbar (and the node of the line, not handled by the processor) is isolated: it has no handled
+        # element, so it does not use a bus and the load is connected with the elements not handled by the processor
+        self.model.set_switches([0, 1, 2], [False, True, False])
+        node_bus = self.model.get_node_bus()
+        assert node_bus[self.bus_id] == -1
+        assert node_bus[self.line_node] == -1
+        assert node_bus[self.load_node] == self.bus_id
+        assert node_bus[self.bus_2_id] == self.bus_id
+        assert self.model.get_loads()[0].connected
+        assert self.model.get_loads()[0].bus_id == self.bus_id
+        self._aux_check_same()
+
+    def test_errors(self):
+        with self.assertRaises(RuntimeError):
+            # two nodes of different substations
+            self.model.init_node_breaker([0, 1], [[0], [1]], [0], [1], [True])
+        with self.assertRaises(RuntimeError):
+            self.model.set_switch(4, True)
+
+
+if __name__ == "__main__":
+    unittest.main()
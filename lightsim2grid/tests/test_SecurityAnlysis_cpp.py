@@ -206,6 +206,42 @@ class TestSecurityAnalysisCPP(unittest.TestCase):
             assert np.max(np.abs(Vref[:nb_sub] - res_SA[cont_id, :nb_sub])) <= 1e-6, f"error in V when disconnecting line {l_id} (contingency nb {cont_id})"
             assert np.max(np.abs(res_flows[cont_id] - sim_obs.a_or*1e-3)) <= 1e-6, f"error in flows when disconnecting line {l_id} (contingency nb {cont_id})"
     
+    def test_async(self):
+        lid_cont = [0, 1, 2, 3]
+        SA = SecurityAnalysisCPP(self.env.backend._grid)
+        SA.add_multiple_n1(lid_cont)
+        SA.compute(self.env.backend.V, self.env.backend.max_it, self.env.backend.tol)
+        Vs_ref = 1.0 * SA.get_voltages()
+
+        SA_async = SecurityAnalysisCPP(self.env.backend._grid)
+        SA_async.add_multiple_n1(lid_cont)
+        SA_async.start_compute(self.env.backend.V, self.env.backend.max_it, self.env.backend.tol)
+        SA_async.wait()
+        assert not SA_async.is_running()
+        nb_done, nb_failed, solver_time = SA_async.get_progress()
+        assert nb_done == len(lid_cont)
+        assert nb_failed == 0
+        assert np.max(np.abs(SA_async.get_voltages() - Vs_ref)) <= 1e-8
+
+        # cancel the computation
+        SA_async.start_compute(self.env.backend.V, self.env.backend.max_it, self.env.backend.tol)
+        SA_async.cancel()
+        SA_async.wait()
+        nb_done, nb_failed, solver_time = SA_async.get_progress()
+        assert nb_done <= len(lid_cont)
+
+        # errors are raised when waiting, and must be retrieved before starting a new computation
+        SA_async.start_compute(self.env.backend.V[1:], self.env.backend.max_it, self.env.backend.tol)
+        while SA_async.is_running():
+            pass
+        with self.assertRaises(RuntimeError):
+            SA_async.start_compute(self.env.backend.V, self.env.backend.max_it, self.env.backend.tol)
+        with self.assertRaises(RuntimeError):
+            SA_async.wait()
+        SA_async.start_compute(self.env.backend.V, self.env.backend.max_it, self.env.backend.tol)
+        SA_async.wait()
+        assert np.max(np.abs(SA_async.get_voltages() - Vs_ref)) <= 1e-8
+
     def test_compute_nonconnected_graph(self):
         SA = SecurityAnalysisCPP(self.env.backend._grid)
         lid_cont = [17, 18, 19]  # 17 is ok, 18 lead to divergence, i need to check then that 19 is correct (no divergence)
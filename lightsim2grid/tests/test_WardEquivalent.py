@@ -0,0 +1,100 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+
+
+class TestWardEquivalent(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(pn.case118())
+        self.max_it = 10
+        self.tol = 1e-10
+        self.tol_test = 1e-7
+        self.V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.V_full = self.model.ac_pf(self.V0, self.max_it, self.tol)
+        assert self.V_full.shape[0] > 0, "powerflow diverged"
+
+        # the internal area: the buses "close" to the slack bus
+        slack_bus = [el.bus_id for el in self.model.get_generators() if el.is_slack][0]
+        neighbors = {bus_id: set() for bus_id in range(self.model.total_bus())}
+        for el in list(self.model.get_lines()) + list(self.model.get_trafos()):
+            bus_1, bus_2 = (el.bus_or_id, el.bus_ex_id) if hasattr(el, "bus_or_id") else (el.bus_hv_id, el.bus_lv_id)
+            neighbors[bus_1].add(bus_2)
+            neighbors[bus_2].add(bus_1)
+        internal = {slack_bus}
+        for _ in range(4):
+            internal |= set().union(*[neighbors[bus_id] for bus_id in internal])
+        self.internal = np.array(sorted(internal))
+
+    def _aux_test(self, extended):
+        reduced = self.model.ward_equivalent(self.internal, self.V_full, extended)
+        ids = reduced.get_ward_ids()
+        boundary = reduced.get_ward_boundary_buses()
+        assert len(boundary) > 0
+        assert len(reduced.get_ward_injections()) == len(boundary)
+        assert ids.nb_bus_full == self.model.total_bus()
+        # only the kept buses are in the reduced grid, in the order of their ids
+        assert reduced.total_bus() == len(self.internal) + len(boundary)
+        assert reduced.total_bus() < self.model.total_bus()
+        assert np.all(np.diff(ids.bus) > 0)
+        assert np.all(np.isin(self.internal, ids.bus))
+        assert not np.any(np.isin(np.array(ids.bus)[boundary], self.internal))
+
+        # exact for the base case
+        V0 = np.ones(reduced.total_bus(), dtype=complex)
+        V = reduced.ac_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged on the reduced grid"
+        assert np.max(np.abs(V - self.V_full[ids.bus])) <= self.tol_test
+
+        # the powerlines inside the area have the same flows
+        bus_or = np.array([el.bus_or_id for el in self.model.get_lines()])
+        bus_ex = np.array([el.bus_ex_id for el in self.model.get_lines()])
+        inside = np.isin(bus_or, self.internal) & np.isin(bus_ex, self.internal)
+        line_ids = np.array(ids.line)
+        assert np.all(np.isin(np.where(inside)[0], line_ids))
+        p_full = self.model.get_lineor_res()[0]
+        p_red = reduced.get_lineor_res()[0][line_ids >= 0]
+        inside_red = inside[line_ids[line_ids >= 0]]
+        assert np.max(np.abs(p_red[inside_red] - p_full[line_ids[line_ids >= 0]][inside_red])) <= 1e-5
+        # the equivalent elements are after the kept ones
+        assert np.all(line_ids[len(line_ids) - np.sum(line_ids < 0):] == -1)
+
+        # the injections are fitted again on another state of the grid (modified outside the area)
+        load_id = [el.id for el in self.model.get_loads() if el.bus_id not in self.internal][0]
+        self.model.change_p_load(load_id, 2. * self.model.get_loads()[load_id].target_p_mw)
+        V_full_2 = self.model.ac_pf(self.V_full, self.max_it, self.tol)
+        assert V_full_2.shape[0] > 0, "powerflow diverged"
+        reduced.refit_ward_injections(V_full_2)
+        V = reduced.ac_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged on the reduced grid"
+        assert np.max(np.abs(V - V_full_2[ids.bus])) <= self.tol_test
+
+    def test_ward(self):
+        self._aux_test(extended=False)
+
+    def test_extended_ward(self):
+        self._aux_test(extended=True)
+
+    def test_errors(self):
+        with self.assertRaises(RuntimeError):
+            # no slack bus in the internal area
+            others = np.array([bus_id for bus_id in range(self.model.total_bus()) if bus_id not in self.internal])
+            self.model.ward_equivalent(others[:5], self.V_full)
+        with self.assertRaises(RuntimeError):
+            self.model.refit_ward_injections(self.V_full)
+
+
+if __name__ == "__main__":
+    unittest.main()
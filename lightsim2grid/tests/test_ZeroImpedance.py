@@ -0,0 +1,115 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import copy
+import unittest
+import numpy as np
+import pandapower as pp
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid_cpp import SecurityAnalysisCPP
+
+
+class TestZeroImpedance(unittest.TestCase):
+    def setUp(self):
+        self.net = pn.case14()
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-6
+
+        # the bus of the first load is split in two buses, connected by a bus coupler, the load is moved to the new bus
+        self.net_split = copy.deepcopy(self.net)
+        self.load_id = 0
+        self.bus_id = int(self.net.load["bus"].values[self.load_id])
+        self.new_bus = pp.create_bus(self.net_split, vn_kv=self.net.bus["vn_kv"].values[self.bus_id])
+        self.net_split.load.loc[self.net_split.load.index[self.load_id], "bus"] = self.new_bus
+        self.coupler_id = pp.create_line_from_parameters(self.net_split, from_bus=self.bus_id, to_bus=self.new_bus,
+                                                         length_km=1., r_ohm_per_km=0., x_ohm_per_km=0.,
+                                                         c_nf_per_km=0., max_i_ka=1.)
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(self.net)
+            self.model_split = init(self.net_split)
+
+    def test_ac(self):
+        V_ref = self.model.ac_pf(np.ones(self.model.total_bus(), dtype=complex), self.max_it, self.tol)
+        V = self.model_split.ac_pf(np.ones(self.model_split.total_bus(), dtype=complex), self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        # the two buses are the same bus for the solver
+        assert self.model_split.get_Ybus().shape == self.model.get_Ybus().shape
+        assert np.abs(V[self.new_bus] - V[self.bus_id]) <= self.tol_test
+        assert np.max(np.abs(V[:self.model.total_bus()] - V_ref)) <= self.tol_test
+
+        # the flow on the coupler is the consumption of the load
+        p_or, q_or, v_or, a_or = self.model_split.get_lineor_res()
+        p_ex, q_ex, v_ex, a_ex = self.model_split.get_lineex_res()
+        load_p, load_q, load_v = self.model_split.get_loads_res()
+        assert np.all(np.isfinite(p_or)) and np.all(np.isfinite(a_or))
+        assert np.abs(p_or[self.coupler_id] - load_p[self.load_id]) <= self.tol_test
+        assert np.abs(q_or[self.coupler_id] - load_q[self.load_id]) <= self.tol_test
+        assert np.abs(p_ex[self.coupler_id] + load_p[self.load_id]) <= self.tol_test
+        assert a_or[self.coupler_id] > 0.
+        # the other flows are not modified
+        p_or_ref = self.model.get_lineor_res()[0]
+        assert np.max(np.abs(p_or[:p_or_ref.shape[0]] - p_or_ref)) <= self.tol_test
+
+    def test_dc(self):
+        self.model.dc_pf(np.ones(self.model.total_bus(), dtype=complex), self.max_it, self.tol)
+        V = self.model_split.dc_pf(np.ones(self.model_split.total_bus(), dtype=complex), self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        p_or = self.model_split.get_lineor_res()[0]
+        load_p = self.model_split.get_loads_res()[0]
+        assert np.abs(p_or[self.coupler_id] - load_p[self.load_id]) <= self.tol_test
+        p_or_ref = self.model.get_lineor_res()[0]
+        assert np.max(np.abs(p_or[:p_or_ref.shape[0]] - p_or_ref)) <= self.tol_test
+
+    def test_open_coupler(self):
+        self.model_split.deactivate_powerline(self.coupler_id)
+        V = self.model_split.ac_pf(np.ones(self.model_split.total_bus(), dtype=complex), self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        assert V[self.new_bus] == 0., "the load is isolated"
+        assert self.model_split.get_lineor_res()[0][self.coupler_id] == 0.
+
+    def test_security_analysis(self):
+        # a powerline of the first bus is moved to the new bus too, so opening the coupler does not isolate the load
+        line_id = int(np.where(self.net_split.line["from_bus"].values == self.bus_id)[0][0])
+        self.net_split.line.loc[self.net_split.line.index[line_id], "from_bus"] = self.new_bus
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            model_split = init(self.net_split)
+        V_init = model_split.ac_pf(np.ones(model_split.total_bus(), dtype=complex), self.max_it, self.tol)
+        assert V_init.shape[0] > 0, "powerflow diverged"
+
+        SA = SecurityAnalysisCPP(model_split)
+        SA.add_n1(self.coupler_id)
+        SA.add_n1(line_id)
+        SA.compute(V_init, self.max_it, self.tol)
+        Vs = SA.get_voltages()
+        p_flows = SA.compute_power_flows()
+        for cont_id, (branch_id, ) in enumerate(SA.my_defaults()):
+            with warnings.catch_warnings():
+                warnings.filterwarnings("ignore")
+                ref = init(self.net_split)
+            ref.deactivate_powerline(branch_id)
+            V_ref = ref.ac_pf(V_init, self.max_it, self.tol)
+            assert V_ref.shape[0] > 0, "powerflow diverged"
+            assert np.max(np.abs(Vs[cont_id] - V_ref)) <= self.tol_test
+            # the flows of the coupler cannot be computed from the voltages (it is 0. when it is disconnected)
+            if branch_id == self.coupler_id:
+                assert p_flows[cont_id, self.coupler_id] == 0.
+            else:
+                assert np.isnan(p_flows[cont_id, self.coupler_id])
+        # the buses of the coupler are not merged when it is disconnected
+        cont_coupler = [el[0] for el in SA.my_defaults()].index(self.coupler_id)
+        assert np.abs(Vs[cont_coupler, self.new_bus] - Vs[cont_coupler, self.bus_id]) > self.tol_test
+
+
+if __name__ == "__main__":
+    unittest.main()
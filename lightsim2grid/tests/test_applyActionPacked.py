@@ -0,0 +1,92 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import warnings
+import numpy as np
+import grid2op
+
+from lightsim2grid import LightSimBackend
+
+
+class TestApplyActionPacked(unittest.TestCase):
+    def setUp(self):
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.env = grid2op.make("l2rpn_case14_sandbox", backend=LightSimBackend(), test=True)
+        self.n_sub = self.env.n_sub
+
+    def tearDown(self):
+        self.env.close()
+
+    def test_same_as_separate_calls(self):
+        grid_ref = self.env.backend._grid.copy()
+        n_gen, n_load, n_shunt = self.env.n_gen, self.env.n_load, self.env.n_shunt
+        gen_p_changed = np.zeros(n_gen, dtype=bool)
+        gen_p_changed[[0, 2]] = True
+        gen_p = np.full(n_gen, 50., dtype=np.float32)
+        gen_v_changed = np.zeros(n_gen, dtype=bool)
+        gen_v_changed[1] = True
+        gen_v_kv = np.full(n_gen, 1.02, dtype=np.float32) * self.env.backend.prod_pu_to_kv.astype(np.float32)
+        load_p_changed = np.ones(n_load, dtype=bool)
+        load_p = np.full(n_load, 10., dtype=np.float32)
+        load_q_changed = np.zeros(n_load, dtype=bool)
+        load_q_changed[3] = True
+        load_q = np.full(n_load, 3., dtype=np.float32)
+        storage_p_changed = np.zeros(0, dtype=bool)
+        storage_p = np.zeros(0, dtype=np.float32)
+        shunt_p_changed = np.zeros(n_shunt, dtype=bool)
+        shunt_p = np.zeros(n_shunt, dtype=np.float32)
+        shunt_q_changed = np.ones(n_shunt, dtype=bool)
+        shunt_q = np.full(n_shunt, -10., dtype=np.float32)
+        shunt_bus_changed = np.zeros(n_shunt, dtype=bool)
+        shunt_bus = np.ones(n_shunt, dtype=np.int32)
+        topo_changed = np.zeros(self.env.dim_topo, dtype=bool)
+        topo_changed[self.env.line_or_pos_topo_vect[3]] = True
+        topo_values = np.ones(self.env.dim_topo, dtype=np.int32)
+        topo_values[self.env.line_or_pos_topo_vect[3]] = -1
+
+        grid_ref.update_gens_p(gen_p_changed, gen_p)
+        # the voltage setpoints are given in kV to apply_action_packed
+        gen_v = gen_v_kv.astype(float) / self.env.backend.prod_pu_to_kv
+        for gen_id in np.where(gen_v_changed)[0]:
+            grid_ref.change_v_gen(gen_id, gen_v[gen_id])
+        grid_ref.update_loads_p(load_p_changed, load_p)
+        grid_ref.update_loads_q(load_q_changed, load_q)
+        for sh_id in np.where(shunt_q_changed)[0]:
+            grid_ref.change_q_shunt(sh_id, shunt_q[sh_id])
+        grid_ref.update_topo(topo_changed, topo_values)
+
+        grid = self.env.backend._grid
+        grid.apply_action_packed(gen_p_changed, gen_p, gen_v_changed, gen_v_kv,
+                                 load_p_changed, load_p, load_q_changed, load_q,
+                                 storage_p_changed, storage_p,
+                                 shunt_p_changed, shunt_p, shunt_q_changed, shunt_q,
+                                 shunt_bus_changed, shunt_bus,
+                                 topo_changed, topo_values)
+        assert grid.to_bytes() == grid_ref.to_bytes()
+        assert not grid.get_lines()[3].connected
+        assert np.abs(grid.get_generators()[1].target_vm_pu - 1.02) <= 1e-6
+
+    def test_shunt_bus(self):
+        sh_id = 0
+        sub_id = self.env.shunt_to_subid[sh_id]
+        act = self.env.action_space({"shunt": {"shunt_bus": [(sh_id, 2)]},
+                                     "set_bus": {"substations_id": [(sub_id, np.full(self.env.sub_info[sub_id], 2))]}})
+        obs, reward, done, info = self.env.step(act)
+        assert not done
+        assert self.env.backend._grid.get_shunts()[sh_id].bus_id == sub_id + self.n_sub
+
+        act = self.env.action_space({"shunt": {"shunt_bus": [(sh_id, -1)]}})
+        obs, reward, done, info = self.env.step(act)
+        assert not done
+        assert not self.env.backend._grid.get_shunts()[sh_id].connected
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,78 @@
+# Copyright (c) 2020, RTE (https://www.rte-france.com)
+# See AUTHORS.txt
+# This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+# If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+# you can obtain one at http://mozilla.org/MPL/2.0/.
+# SPDX-License-Identifier: MPL-2.0
+# This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+import unittest
+import numpy as np
+import pandapower.networks as pn
+import warnings
+
+from lightsim2grid.gridmodel import init
+from lightsim2grid.solver import SolverType
+
+
+class TestSolveMany(unittest.TestCase):
+    def setUp(self):
+        self.net = pn.case14()
+        with warnings.catch_warnings():
+            warnings.filterwarnings("ignore")
+            self.model = init(self.net)
+        self.max_it = 10
+        self.tol = 1e-8
+        self.tol_test = 1e-8
+        self.nb_rhs = 7
+        np.random.seed(0)
+
+    def _aux_test_ac(self, solver_type):
+        self.model.change_solver(solver_type)
+        V0 = np.ones(self.model.total_bus(), dtype=complex)
+        V = self.model.ac_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        solver = self.model.get_solver()
+        J = solver.get_J()
+        B = np.random.randn(J.shape[0], self.nb_rhs)
+        X = solver.solve_many(B)
+        assert X.shape == B.shape
+        assert np.max(np.abs(J @ X - B)) <= self.tol_test, "wrong solutions"
+        X_th = solver.solve_many(B, nb_thread=3)
+        assert np.max(np.abs(X_th - X)) <= self.tol_test, "wrong solutions when using multiple threads"
+
+        with self.assertRaises(RuntimeError):
+            # wrong number of rows
+            solver.solve_many(B[:-1,:])
+
+    def test_ac(self):
+        for solver_type in [SolverType.SparseLU, SolverType.DenseLU, SolverType.BiCGSTAB]:
+            self._aux_test_ac(solver_type)
+        if SolverType.KLU in self.model.available_solvers():
+            self._aux_test_ac(SolverType.KLU)
+
+    def test_dc(self):
+        V0 = np.ones(self.model.total_bus(), dtype=complex)
+        V = self.model.dc_pf(V0, self.max_it, self.tol)
+        assert V.shape[0] > 0, "powerflow diverged"
+        dc_solver = self.model.get_dc_solver()
+
+        # the factorized matrix is the dc admittance matrix without the slack bus
+        slack_id = self.model.get_slack_ids()[0]
+        dcYbus = self.model.get_dcYbus().real.tocsc()
+        keep = np.arange(dcYbus.shape[0]) != slack_id
+        dcYbus = dcYbus[keep, :][:, keep]
+        B = np.random.randn(dcYbus.shape[0], self.nb_rhs)
+        X = dc_solver.solve_many(B, nb_thread=2)
+        assert np.max(np.abs(dcYbus @ X - B)) <= self.tol_test, "wrong solutions"
+
+    def test_no_factorization(self):
+        self.model.change_solver(SolverType.GaussSeidel)
+        V0 = np.ones(self.model.total_bus(), dtype=complex)
+        self.model.ac_pf(V0, 1000, self.tol)
+        with self.assertRaises(RuntimeError):
+            self.model.get_solver().solve_many(np.ones((2 * self.model.total_bus(), 1)))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -83,6 +83,7 @@ class TimeSerie:
         self.prod_p = None
         self.load_p = None
         self.load_q = None
+        self.prod_v = None
         self.__computed = False
         
         self.available_solvers = self.computer.available_solvers()
@@ -103,11 +104,16 @@ class TimeSerie:
         self.__computed = False
         return self._extract_inj()
 
-    def compute_V_from_inj(self, prod_p, load_p, load_q, v_init=None, ignore_errors=False):
+    def compute_V_from_inj(self, prod_p, load_p, load_q, v_init=None, ignore_errors=False,
+                           prod_v=None, storage_p=None):
         """
         This function allows to compute the voltages, at each bus given a list of
         productions and loads.
 
+        Optionally, the voltage setpoint of the generators (`prod_v`, in kV) and the active consumption
+        of the storage units (`storage_p`, in MW) can be provided. If they are not, the generators
+        voltage setpoint are the one of `v_init` and the storage units are not taken into account.
+
         We do not recommend to use it directly, as the order of the load or generators might vary !
         """
 
@@ -136,15 +142,28 @@ class TimeSerie:
             raise RuntimeError(f"The number of loads on the grid {self.grid2op_env.n_load} "
                                f"is different that the number of columns of the provided load_q data: "
                                f"load_q.shape[1] = {load_q.shape[1]}")
+        if prod_v is not None and prod_v.shape != prod_p.shape:
+            raise RuntimeError(f"prod_v should have the same shape as prod_p. We found: "
+                               f"prod_v.shape = {prod_v.shape} and prod_p.shape = {prod_p.shape}")
+        if storage_p is not None and storage_p.shape != (prod_p.shape[0], self.grid2op_env.n_storage):
+            raise RuntimeError(f"storage_p should have {prod_p.shape[0]} rows and {self.grid2op_env.n_storage} columns. "
+                               f"We found: storage_p.shape = {storage_p.shape}")
         if v_init is None:
             v_init = self.grid2op_env.backend.V
+        empty_ = np.zeros((0, 0))
+        gen_v = empty_
+        if prod_v is not None:
+            # grid2op gives the voltage setpoint in kV, lightsim2grid uses pair unit
+            gen_v = prod_v / self.grid2op_env.backend.prod_pu_to_kv
         status = self.computer.compute_Vs(prod_p,
                                           np.zeros((prod_p.shape[0], 0)),  # no static generators for now !
                                           load_p,
                                           load_q,
                                           v_init,
                                           self.grid2op_env.backend.max_it,
-                                          self.grid2op_env.backend.tol)
+                                          self.grid2op_env.backend.tol,
+                                          gen_v=gen_v,
+                                          storage_p=storage_p if storage_p is not None else empty_)
         if status != 1 and not ignore_errors:
             # raise an error if the powerflow diverged
             raise RuntimeError(f"Some error occurred, the powerflow has diverged after {self.computer.nb_solved()} step(s)")
@@ -164,7 +183,7 @@ class TimeSerie:
             As the topology is fixed, this class does not allow to simulate the effect of maintenance or attacks !
         """
         prod_p, load_p, load_q = self.get_injections(scenario_id=scenario_id, seed=seed)
-        Vs = self.compute_V_from_inj(prod_p, load_p, load_q, v_init, ignore_errors)
+        Vs = self.compute_V_from_inj(prod_p, load_p, load_q, v_init, ignore_errors, prod_v=self.prod_v)
         return Vs
 
     def compute_A(self):
@@ -206,4 +225,7 @@ class TimeSerie:
         self.prod_p = 1.0 * data_loader.prod_p
         self.load_p = 1.0 * data_loader.load_p
         self.load_q = 1.0 * data_loader.load_q
+        self.prod_v = None
+        if data_loader.prod_v is not None:
+            self.prod_v = 1.0 * data_loader.prod_v
         return self.prod_p, self.load_p, self.load_q
@@ -131,8 +131,15 @@ extra_compile_args += [f"-DVERSION_MAJOR={VERSION_MAJOR}",
 src_files = ['src/main.cpp',
              "src/help_fun_msg.cpp",
              "src/SparseLUSolver.cpp",
+             "src/DenseLUSolver.cpp",
+             "src/BiCGSTABSolver.cpp",
+             "src/LDLTSolver.cpp",
              "src/BaseConstants.cpp",
              "src/GridModel.cpp",
+             "src/BinaryState.cpp",
+             "src/Connectivity.cpp",
+             "src/NodeBreaker.cpp",
+             "src/BranchTable.cpp",
              "src/DataConverter.cpp",
              "src/DataLine.cpp",
              "src/DataGeneric.cpp",
@@ -147,6 +154,7 @@ src_files = ['src/main.cpp',
              "src/ChooseSolver.cpp",
              "src/GaussSeidelSolver.cpp",
              "src/GaussSeidelSynchSolver.cpp",
+             "src/GaussSeidelColoredSolver.cpp",
              "src/BaseSolver.cpp",
              "src/BaseMultiplePowerflow.cpp",
              "src/Computers.cpp",
@@ -7,6 +7,7 @@
 // This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
 
 #include "BaseMultiplePowerflow.h"
+#include <limits>
 
 /**
  V is modified at each call !
@@ -31,10 +32,19 @@ bool BaseMultiplePowerflow::compute_one_powerflow(const Eigen::SparseMatrix<cplx
     return conv;
 }
 
+void BaseMultiplePowerflow::wait()
+{
+    if(_job_thread.joinable()) _job_thread.join();
+    if(_job_exception){
+        std::exception_ptr exc_ = _job_exception;
+        _job_exception = nullptr;
+        std::rethrow_exception(exc_);
+    }
+}
+
 void BaseMultiplePowerflow::compute_flows_from_Vs(bool amps)
 {
-    // TODO find a way to factorize that with DataTrafo::compute_results
-    // TODO and DataLine::compute_results
+    check_no_job("compute_flows_from_Vs");
 
     if (_voltages.size() == 0)
     {
@@ -52,15 +62,45 @@ void BaseMultiplePowerflow::compute_flows_from_Vs(bool amps)
     // reset the results
     if (amps) _amps_flows = RealMat::Zero(nb_steps, n_total_);
     else _active_power_flows = RealMat::Zero(nb_steps, n_total_);
-    
-    // compute the flows for the powerlines
-    Eigen::Index lag_id = 0;
-    if (amps) compute_amps_flows(_grid_model.get_powerlines_as_data(), sn_mva, lag_id);
-    else compute_active_power_flows(_grid_model.get_powerlines_as_data(), sn_mva, lag_id);
-    // compute the flows for the trafos
-    lag_id = n_line_;
-    if (amps) compute_amps_flows(_grid_model.get_trafos_as_data(), sn_mva, lag_id);
-    else compute_active_power_flows(_grid_model.get_trafos_as_data(), sn_mva, lag_id);
+
+    // the powerlines and the trafos are handled in the same loop (the branch ids are the columns of the results)
+    const auto & branches = _grid_model.get_branches();
+    const auto & el_status = branches.get_status();
+    const auto & bus_from = branches.get_bus_from();
+    const auto & bus_to = branches.get_bus_to();
+    const auto & vn_kv_from = branches.get_vn_kv_from();
+    const auto & v_yac_ff = branches.yac_ff();
+    const auto & v_yac_ft = branches.yac_ft();
+    const real_type sqrt_3 = sqrt(3.);
+    const real_type nan_ = std::numeric_limits<real_type>::quiet_NaN();
+    for(Eigen::Index branch_id = 0; branch_id < branches.nb(); ++branch_id){
+        if(!el_status[branch_id]) continue;
+        if(branches.is_zero_impedance(branch_id)){
+            // both ends of a powerline without impedance have the same voltage: its flow would need the kirchhoff
+            // current law with the injections of each step (see GridModel::compute_coupler_flows), it is not computed
+            if(amps) _amps_flows.col(branch_id).setConstant(nan_);
+            else _active_power_flows.col(branch_id).setConstant(nan_);
+            continue;
+        }
+
+        // retrieve voltages
+        const auto Efrom = _voltages.col(bus_from(branch_id));  // vector (one voltages per step)
+        const auto Eto = _voltages.col(bus_to(branch_id));
+
+        // branch equations (to get the power at the "from" side)
+        CplxVect I_ft = v_yac_ff(branch_id) * Efrom + v_yac_ft(branch_id) * Eto;
+        I_ft = I_ft.array().conjugate();
+        const CplxVect S_ft = Efrom.array() * I_ft.array();
+
+        if(amps){
+            // now compute the current flow
+            RealVect res = S_ft.array().abs() * sn_mva;
+            res.array() /= sqrt_3 * Efrom.array().abs() * vn_kv_from(branch_id);
+            _amps_flows.col(branch_id) = res;
+        }else{
+            _active_power_flows.col(branch_id) = S_ft.array().real() * sn_mva;
+        }
+    }
 
     if (amps) _timer_compute_A = timer_compute.duration();
     else _timer_compute_P = timer_compute.duration();
@@ -9,6 +9,11 @@
 #ifndef BASEMULTIPLEPOWERFLOW_H
 #define BASEMULTIPLEPOWERFLOW_H
 
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <tuple>
+
 #include "GridModel.h"
 
 /**
@@ -32,7 +37,14 @@ class BaseMultiplePowerflow
             _nb_solved(0),
             _timer_compute_A(0.),
             _timer_compute_P(0.),
-            _timer_solver(0.)
+            _timer_solver(0.),
+            _job_thread(),
+            _job_exception(),
+            _job_running(false),
+            _cancel_requested(false),
+            _progress_nb_done(0),
+            _progress_nb_failed(0),
+            _progress_solver_time(0.)
             {
                 // make sure that my "grid_model" is ready to be used (for ac and dc)
                 Eigen::Index nb_bus = init_grid_model.total_bus();
@@ -47,9 +59,12 @@ class BaseMultiplePowerflow
             }
 
         BaseMultiplePowerflow(const BaseMultiplePowerflow&) = delete;
+
+        virtual ~BaseMultiplePowerflow() {stop_job();}
     
         // solver "control"
         void change_solver(const SolverType & type){
+            check_no_job("change_solver");
             _solver.change_solver(type);
         }
         std::vector<SolverType> available_solvers() {return _solver.available_solvers(); }
@@ -61,95 +76,83 @@ class BaseMultiplePowerflow
         int nb_solved() const {return _nb_solved;}
 
         // results
-        Eigen::Ref<const RealMat > get_flows() const {return _amps_flows;}
-        Eigen::Ref<const RealMat > get_power_flows() const {return _active_power_flows;}
-        Eigen::Ref<const CplxMat > get_voltages() const {return _voltages;}
+        Eigen::Ref<const RealMat > get_flows() const {check_no_job("get_flows"); return _amps_flows;}
+        Eigen::Ref<const RealMat > get_power_flows() const {check_no_job("get_power_flows"); return _active_power_flows;}
+        Eigen::Ref<const CplxMat > get_voltages() const {check_no_job("get_voltages"); return _voltages;}
+
+        // asynchronous computation (see Computers::start_compute_Vs and SecurityAnalysis::start_compute)
+        bool is_running() const {return _job_running.load();}
+        /**
+        Ask the computation running in the background to stop. This is cooperative: the current
+        powerflow is finished before the job stops. Call `wait()` to make sure the job is over.
+        **/
+        void cancel() {_cancel_requested.store(true);}
+        bool is_cancelled() const {return _cancel_requested.load();}
+        /**
+        Wait for the background job (if any) to finish. If the job raised an exception, it is
+        raised again here.
+        **/
+        void wait();
+        /**
+        Progress of the current (or last) computation: number of powerflows performed, 
+        number of powerflows that did not converge and time spent in the solver (in s).
+        It can be called safely while a job is running.
+        **/
+        std::tuple<int, int, double> get_progress() const {
+            return std::tuple<int, int, double>(_progress_nb_done.load(),
+                                                _progress_nb_failed.load(),
+                                                _progress_solver_time.load());
+        }
         
     protected:
-        template<class T>
-        void compute_amps_flows(const T & structure_data,
-                                real_type sn_mva,
-                                Eigen::Index lag_id) 
+        // start "fun" in a new thread, the object must not be used while the job is running (and the error of the
+        // previous job, if any, must have been retrieved with `wait()`)
+        template<class F>
+        void start_job(const std::string & fun_name, F fun)
         {
-            const auto & bus_vn_kv = _grid_model.get_bus_vn_kv();
-            const auto & el_status = structure_data.get_status();
-            const auto & bus_from = structure_data.get_bus_from();
-            const auto & bus_to = structure_data.get_bus_to();
-            const auto & v_yac_ff = structure_data.yac_ff();
-            const auto & v_yac_ft = structure_data.yac_ft();
-            Eigen::Index nb_el = structure_data.nb();
-            real_type sqrt_3 = sqrt(3.);
-
-            for(Eigen::Index el_id = 0; el_id < nb_el; ++el_id){
-                if(!el_status[el_id]) continue;
-
-                // retrieve which buses are used
-                int bus_from_me = bus_from(el_id);
-                int bus_to_me = bus_to(el_id);
-
-                // retrieve voltages
-                const auto Efrom = _voltages.col(bus_from_me);  // vector (one voltages per step)
-                const auto Eto = _voltages.col(bus_to_me);
-
-                const real_type bus_vn_kv_f = bus_vn_kv(bus_from_me);
-                const RealVect v_f_kv = Efrom.array().abs() * bus_vn_kv_f;
-
-                // retrieve physical parameters
-                const cplx_type yac_ff = v_yac_ff(el_id);  // scalar
-                const cplx_type yac_ft = v_yac_ft(el_id);
-
-                // trafo equations (to get the power at the "from" side)
-                CplxVect I_ft =  yac_ff * Efrom + yac_ft * Eto;
-                I_ft = I_ft.array().conjugate();
-                const CplxVect S_ft = Efrom.array() * I_ft.array();
-
-                // now compute the current flow
-                RealVect res = S_ft.array().abs() * sn_mva;
-                res.array() /= sqrt_3 * v_f_kv.array();
-                _amps_flows.col(el_id + lag_id) = res;
+            check_no_job(fun_name);
+            if(_job_thread.joinable()) _job_thread.join();
+            if(_job_exception){
+                // the error of the previous job would be lost otherwise
+                std::ostringstream exc_;
+                exc_ << "BaseMultiplePowerflow::" << fun_name << ": the previous computation raised an error that has not ";
+                exc_ << "been retrieved. Call `wait()` first (it raises this error).";
+                throw std::runtime_error(exc_.str());
             }
+            _cancel_requested.store(false);
+            _job_running.store(true);
+            _job_thread = std::thread([this, fun](){
+                try{
+                    fun();
+                }catch(...){
+                    _job_exception = std::current_exception();
+                }
+                _job_running.store(false);
+            });
         }
-        template<class T>
-        void compute_active_power_flows(const T & structure_data,
-                                        real_type sn_mva,
-                                        Eigen::Index lag_id) 
-        {
-            const auto & bus_vn_kv = _grid_model.get_bus_vn_kv();
-            const auto & el_status = structure_data.get_status();
-            const auto & bus_from = structure_data.get_bus_from();
-            const auto & bus_to = structure_data.get_bus_to();
-            const auto & v_yac_ff = structure_data.yac_ff();
-            const auto & v_yac_ft = structure_data.yac_ft();
-            Eigen::Index nb_el = structure_data.nb();
-
-            for(Eigen::Index el_id = 0; el_id < nb_el; ++el_id){
-                if(!el_status[el_id]) continue;
-
-                // retrieve which buses are used
-                int bus_from_me = bus_from(el_id);
-                int bus_to_me = bus_to(el_id);
-
-                // retrieve voltages
-                const auto Efrom = _voltages.col(bus_from_me);  // vector (one voltages per step)
-                const auto Eto = _voltages.col(bus_to_me);
-
-                const real_type bus_vn_kv_f = bus_vn_kv(bus_from_me);
-                const RealVect v_f_kv = Efrom.array().abs() * bus_vn_kv_f;
-
-                // retrieve physical parameters
-                const cplx_type yac_ff = v_yac_ff(el_id);  // scalar
-                const cplx_type yac_ft = v_yac_ft(el_id);
-
-                // trafo equations (to get the power at the "from" side)
-                CplxVect I_ft = yac_ff * Efrom + yac_ft * Eto;
-                I_ft = I_ft.array().conjugate();
-                const CplxVect S_ft = Efrom.array() * I_ft.array();
-
-                // now compute the current flow
-                RealVect res = S_ft.array().real() * sn_mva;
-                _active_power_flows.col(el_id + lag_id) = res;
+        // cancel (if any) the running job and wait for it to be over
+        void stop_job(){
+            cancel();
+            if(_job_thread.joinable()) _job_thread.join();
+        }
+        void check_no_job(const std::string & fun_name) const {
+            if(is_running()){
+                std::ostringstream exc_;
+                exc_ << "BaseMultiplePowerflow::" << fun_name << ": impossible to use this function while a computation ";
+                exc_ << "is running in the background. Call `wait()` (or `cancel()` then `wait()`) first.";
+                throw std::runtime_error(exc_.str());
             }
         }
+        void reset_progress(){
+            _progress_nb_done.store(0);
+            _progress_nb_failed.store(0);
+            _progress_solver_time.store(0.);
+        }
+        void update_progress(bool conv){
+            ++_progress_nb_done;
+            if(!conv) ++_progress_nb_failed;
+            _progress_solver_time.store(_timer_solver);
+        }
 
         bool compute_one_powerflow(const Eigen::SparseMatrix<cplx_type> & Ybus,
                                    CplxVect & V,
@@ -178,6 +181,20 @@ class BaseMultiplePowerflow
             }
             return Vinit_solver;
         }
+
+        // the opposite: put the voltages of the solver in the row "row_id" of _voltages (each bus of the grid, some
+        // of them can share the same solver bus, see GridModel::init_Ybus)
+        void set_voltages_from_Vsolver(Eigen::Index row_id,
+                                       const CplxVect & V_solver,
+                                       const std::vector<int> & id_me_to_ac_solver){
+            const Eigen::Index nb_total_bus = static_cast<Eigen::Index>(id_me_to_ac_solver.size());
+            Eigen::Index tmp;
+            for(Eigen::Index bus_id_grid = 0; bus_id_grid < nb_total_bus; ++bus_id_grid){
+                tmp = id_me_to_ac_solver[bus_id_grid];
+                if(tmp == GridModel::_deactivated_bus_id) continue;
+                _voltages(row_id, bus_id_grid) = V_solver(tmp);
+            }
+        }
     protected:
         // inputs
         GridModel _grid_model;
@@ -201,5 +218,13 @@ class BaseMultiplePowerflow
         double _timer_compute_P;
         double _timer_solver;
 
+        // asynchronous computation
+        std::thread _job_thread;
+        std::exception_ptr _job_exception;
+        std::atomic<bool> _job_running;
+        std::atomic<bool> _cancel_requested;
+        std::atomic<int> _progress_nb_done;
+        std::atomic<int> _progress_nb_failed;
+        std::atomic<double> _progress_solver_time;
 };
 #endif // BASEMULTIPLEPOWERFLOW_H
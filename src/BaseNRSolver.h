@@ -54,6 +54,24 @@ class BaseNRSolver : public BaseSolver
 
         virtual void reset();
 
+        // see BaseSolver::copy_state (the jacobian matrix and its sparsity pattern are copied)
+        virtual void copy_state(const BaseSolver & other);
+
+        virtual
+        ErrorType solve_many(Eigen::Ref<RealMatRhs> B, int nb_thread){
+            if(need_factorize_ || (n_ != J_.cols())){
+                std::ostringstream exc_;
+                exc_ << "BaseNRSolver::solve_many: the jacobian matrix has not been factorized. Have you run a powerflow ";
+                exc_ << "(that needed at least one iteration) since the last reset?";
+                throw std::runtime_error(exc_.str());
+            }
+            return _solve_many(_linear_solver, J_, B, nb_thread);
+        }
+
+        // access the underlying linear solver (for example to change its parameters)
+        LinearSolver & get_linear_solver() {return _linear_solver;}
+        const LinearSolver & get_linear_solver() const {return _linear_solver;}
+
     protected:
         virtual void reset_timer(){
             BaseSolver::reset_timer();
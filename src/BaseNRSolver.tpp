@@ -49,6 +49,7 @@ bool BaseNRSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
     reset_timer();
     auto timer = CustTimer();
     if(!is_linear_solver_valid()) return false;
+    _linear_solver.set_outer_tol(tol);  // used by the iterative linear solvers
 
     err_ = ErrorType::NoError;  // reset the error if previous error happened
 
@@ -163,6 +164,39 @@ void BaseNRSolver<LinearSolver>::reset(){
     if(reset_status != ErrorType::NoError) err_ = reset_status;
 }
 
+template<class LinearSolver>
+void BaseNRSolver<LinearSolver>::copy_state(const BaseSolver & other_base){
+    const BaseNRSolver<LinearSolver> * p_other = dynamic_cast<const BaseNRSolver<LinearSolver> *>(&other_base);
+    if(p_other == nullptr){
+        std::ostringstream exc_;
+        exc_ << "BaseNRSolver::copy_state: the state can only be copied from a solver of the same type.";
+        throw std::runtime_error(exc_.str());
+    }
+    const BaseNRSolver<LinearSolver> & other = *p_other;
+    reset();
+    BaseSolver::copy_state(other);
+
+    // the jacobian matrix is only reused if it has been factorized (and if the pointers of value_map_ can be translated)
+    if(other.need_factorize_ || !other.dS_dVm_.isCompressed() || !other.dS_dVa_.isCompressed()) return;
+    J_ = other.J_;
+    dS_dVm_ = other.dS_dVm_;
+    dS_dVa_ = other.dS_dVa_;
+
+    // value_map_ points to the coefficients of dS_dVm_ and dS_dVa_ (compressed, so with the same layout in the copy)
+    const cplx_type * other_dvm = other.dS_dVm_.valuePtr();
+    const cplx_type * other_dva = other.dS_dVa_.valuePtr();
+    const Eigen::Index nnz_dvm = other.dS_dVm_.nonZeros();
+    value_map_ = std::vector<cplx_type*>(other.value_map_.size());
+    for(std::size_t el_id = 0; el_id < value_map_.size(); ++el_id){
+        const cplx_type * other_ptr = other.value_map_[el_id];
+        if((other_ptr >= other_dvm) && (other_ptr < other_dvm + nnz_dvm)) value_map_[el_id] = dS_dVm_.valuePtr() + (other_ptr - other_dvm);
+        else value_map_[el_id] = dS_dVa_.valuePtr() + (other_ptr - other_dva);
+    }
+
+    // the factorization is reused if the linear solver allows it, otherwise it will be computed at the next powerflow
+    need_factorize_ = !_linear_solver.reuse_factorization(other._linear_solver);
+}
+
 template<class LinearSolver>
 void BaseNRSolver<LinearSolver>::_dSbus_dV(const Eigen::Ref<const Eigen::SparseMatrix<cplx_type> > & Ybus,
                              const Eigen::Ref<const CplxVect > & V){
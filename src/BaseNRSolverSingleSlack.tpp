@@ -43,6 +43,7 @@ bool BaseNRSolverSingleSlack<LinearSolver>::compute_pf(const Eigen::SparseMatrix
     BaseNRSolver<LinearSolver>::reset_timer();
     
     if(!BaseNRSolver<LinearSolver>::is_linear_solver_valid()) return false;
+    BaseNRSolver<LinearSolver>::_linear_solver.set_outer_tol(tol);  // used by the iterative linear solvers
 
     BaseNRSolver<LinearSolver>::err_ = ErrorType::NoError;  // reset the error if previous error happened
     auto timer = CustTimer();
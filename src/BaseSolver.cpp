@@ -21,6 +21,15 @@ void BaseSolver::reset(){
     err_ = ErrorType::NotInitError; //error message:
 }
 
+void BaseSolver::copy_state(const BaseSolver & other){
+    n_ = other.n_;
+    Vm_ = other.Vm_;
+    Va_ = other.Va_;
+    V_ = other.V_;
+    nr_iter_ = other.nr_iter_;
+    err_ = other.err_;
+}
+
 RealVect BaseSolver::_evaluate_Fx(const Eigen::SparseMatrix<cplx_type> &  Ybus,
                                   const CplxVect & V,
                                   const CplxVect & Sbus,
@@ -11,6 +11,9 @@
 
 #include <iostream>
 #include <vector>
+#include <sstream>
+#include <thread>
+#include <algorithm>  // for std::min
 #include <stdio.h>
 #include <cstdint> // for int32
 #include <chrono>
@@ -83,6 +86,29 @@ class BaseSolver : public BaseConstants
 
         virtual
         void reset();
+
+        /**
+        Copies the state of `other` (that must be a solver of the same type) in this solver: last results and, for the solvers
+        that factorize a matrix, everything needed so that the next powerflow is as fast as if it had been run by `other`
+        (sparsity pattern of the matrix, symbolic and / or numeric factorization when the linear solver allows it).
+        **/
+        virtual
+        void copy_state(const BaseSolver & other);
+
+        /**
+        Solves (in place) the linear systems M.X = B for all the columns of B, using the last factorization
+        computed by the solver (M is the jacobian matrix for the newton raphson solvers, and the dc admittance matrix
+        without the slack bus for the dc solvers). The matrix is NOT factorized again.
+
+        If the linear solver allows it, the columns of B are split in `nb_thread` blocks solved in parallel
+        (the factorization being shared read only between the threads).
+        **/
+        virtual
+        ErrorType solve_many(Eigen::Ref<RealMatRhs> /*B*/, int /*nb_thread*/){
+            std::ostringstream exc_;
+            exc_ << "BaseSolver::solve_many: this solver does not factorize any matrix.";
+            throw std::runtime_error(exc_.str());
+        }
         
     protected:
         virtual void reset_timer(){
@@ -92,6 +118,42 @@ class BaseSolver : public BaseConstants
             timer_total_nr_ = 0.;
         }
 
+        template<class LinearSolver>
+        ErrorType _solve_many(LinearSolver & linear_solver,
+                              const Eigen::SparseMatrix<real_type> & mat,
+                              Eigen::Ref<RealMatRhs> B,
+                              int nb_thread){
+            if(B.rows() != mat.rows()){
+                std::ostringstream exc_;
+                exc_ << "BaseSolver::solve_many: the right hand sides should have " << mat.rows() << " rows (one per row of ";
+                exc_ << "the factorized matrix). You provided " << B.rows() << " rows.";
+                throw std::runtime_error(exc_.str());
+            }
+            const Eigen::Index nb_col = B.cols();
+            if(nb_col == 0) return ErrorType::NoError;
+            if(!LinearSolver::SOLVE_MANY_THREAD_SAFE || (nb_thread <= 1) || (nb_col == 1)){
+                return linear_solver.solve_many(mat, B);
+            }
+
+            // split the columns in (almost) equal blocks, one per thread
+            const Eigen::Index nb_block = std::min(static_cast<Eigen::Index>(nb_thread), nb_col);
+            std::vector<ErrorType> errors(nb_block, ErrorType::NoError);
+            std::vector<std::thread> threads;
+            threads.reserve(nb_block);
+            for(Eigen::Index block_id = 0; block_id < nb_block; ++block_id){
+                const Eigen::Index col_beg = (block_id * nb_col) / nb_block;
+                const Eigen::Index col_end = ((block_id + 1) * nb_col) / nb_block;
+                threads.emplace_back([&linear_solver, &mat, &B, &errors, block_id, col_beg, col_end](){
+                    errors[block_id] = linear_solver.solve_many(mat, B.middleCols(col_beg, col_end - col_beg));
+                });
+            }
+            for(auto & thread : threads) thread.join();
+            for(const auto err : errors){
+                if(err != ErrorType::NoError) return err;
+            }
+            return ErrorType::NoError;
+        }
+
         bool is_linear_solver_valid(){
             // bool res = true;
             // if((err_ == ErrorType::NotInitError) || (err_ == ErrorType::LicenseError)) res = false;  // cannot use a non intialize solver
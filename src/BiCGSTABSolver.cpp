@@ -0,0 +1,156 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "BiCGSTABSolver.h"
+
+#include <algorithm>  // for std::max and std::min
+
+ErrorType BiCGSTABLinearSolver::initialize(const Eigen::SparseMatrix<real_type> & J){
+    if(J.rows() != J.cols()) return ErrorType::SolverAnalyze;
+    x_ = RealVect::Zero(J.cols());
+    n_ = J.cols();
+    precond_.analyzePattern(J);  // ordering, computed once
+    return build_preconditioner(J);
+}
+
+ErrorType BiCGSTABLinearSolver::build_preconditioner(const Eigen::SparseMatrix<real_type> & J){
+    precond_.factorize(J);
+    ++nb_precond_built_;
+    ref_iter_ = -1;  // will be set at the next solve
+    if(precond_.info() != Eigen::Success) return ErrorType::SolverFactor;
+    return ErrorType::NoError;
+}
+
+void BiCGSTABLinearSolver::set_parameters(real_type drop_tol, int fill_factor, int max_iter, real_type rebuild_factor){
+    if(drop_tol < 0.){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_parameters: drop_tol should be >= 0. You provided: " << drop_tol;
+        throw std::runtime_error(exc_.str());
+    }
+    if(fill_factor <= 0){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_parameters: fill_factor should be > 0. You provided: " << fill_factor;
+        throw std::runtime_error(exc_.str());
+    }
+    if(max_iter <= 0){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_parameters: max_iter should be > 0. You provided: " << max_iter;
+        throw std::runtime_error(exc_.str());
+    }
+    if(rebuild_factor < 1.){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_parameters: rebuild_factor should be >= 1. You provided: " << rebuild_factor;
+        throw std::runtime_error(exc_.str());
+    }
+    drop_tol_ = drop_tol;
+    fill_factor_ = fill_factor;
+    max_iter_ = max_iter;
+    rebuild_factor_ = rebuild_factor;
+    precond_.setDroptol(drop_tol_);
+    precond_.setFillfactor(fill_factor_);
+}
+
+void BiCGSTABLinearSolver::set_tolerance_coupling(real_type eta_max, real_type forcing, real_type safety, real_type exact_tol){
+    if((eta_max <= 0.) || (eta_max >= 1.)){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_tolerance_coupling: eta_max should be in ]0, 1[. You provided: " << eta_max;
+        throw std::runtime_error(exc_.str());
+    }
+    if((forcing < 0.) || (safety < 0.)){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_tolerance_coupling: forcing and safety should be >= 0. You provided: ";
+        exc_ << forcing << " and " << safety;
+        throw std::runtime_error(exc_.str());
+    }
+    if(exact_tol <= 0.){
+        std::ostringstream exc_;
+        exc_ << "BiCGSTABLinearSolver::set_tolerance_coupling: exact_tol should be > 0. You provided: " << exact_tol;
+        throw std::runtime_error(exc_.str());
+    }
+    eta_max_ = eta_max;
+    forcing_ = forcing;
+    safety_ = safety;
+    exact_tol_ = exact_tol;
+}
+
+real_type BiCGSTABLinearSolver::compute_tol(real_type b_norm) const{
+    if(nr_tol_ <= 0.) return exact_tol_;
+    real_type res = std::max(forcing_ * b_norm, safety_ * nr_tol_ / b_norm);
+    res = std::min(eta_max_, res);
+    return std::max(exact_tol_, res);
+}
+
+bool BiCGSTABLinearSolver::run_krylov(const Eigen::SparseMatrix<real_type> & J, const RealVect & b, real_type tol, int & nb_iter){
+    Eigen::Index iters = max_iter_;
+    real_type tol_error = tol;
+    x_.setZero();  // the newton step has nothing to do with the previous one
+    const bool ok = Eigen::internal::bicgstab(J, b, x_, precond_, iters, tol_error);
+    nb_iter = static_cast<int>(iters);
+    total_iter_ += nb_iter;
+    return ok && (tol_error <= tol) && x_.allFinite();
+}
+
+ErrorType BiCGSTABLinearSolver::solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized){
+    // solves (for x) the linear system J.x = b
+    // supposes that the solver has been initialized (call initialize() before calling that)
+    // the preconditioner is NOT recomputed here (even if has_just_been_inialized is false), 
+    // unless the Krylov method needs it
+    ErrorType err = ErrorType::NoError;
+    // whether the preconditioner has been computed with this matrix
+    bool fresh_precond = has_just_been_inialized;
+    if(J.cols() != n_){
+        // size of the system changed, the preconditioner cannot be used
+        err = initialize(J);
+        if(err != ErrorType::NoError) return err;
+        fresh_precond = true;
+    }
+    last_iter_ = 0;
+    const real_type b_norm = b.norm();
+    if(b_norm == 0.) return err;  // solution is 0., and b is already 0.
+
+    const real_type tol = compute_tol(b_norm);
+    int nb_iter = 0;
+    bool conv = run_krylov(J, b, tol, nb_iter);
+    int nb_iter_precond = nb_iter;  // number of iterations with the current preconditioner
+    if(!conv && !fresh_precond){
+        // preconditioner was computed with an older matrix, i try again (once) with a fresh one
+        err = build_preconditioner(J);
+        if(err == ErrorType::SolverFactor) return ErrorType::SolverReFactor;
+        conv = run_krylov(J, b, tol, nb_iter_precond);
+        nb_iter += nb_iter_precond;
+    }
+    last_iter_ = nb_iter;
+    if(!conv) return ErrorType::SolverSolve;
+
+    if(ref_iter_ < 0){
+        // first solve after the (re) build of the preconditioner
+        ref_iter_ = nb_iter_precond;
+    }else if(nb_iter > rebuild_factor_ * (ref_iter_ > MIN_REF_ITER_ ? ref_iter_ : MIN_REF_ITER_)){
+        // preconditioner is not good enough anymore, it is rebuilt for the next solves. The solution is valid even
+        // if this fails: the next solve will then not converge with it, and will try to rebuild it again
+        build_preconditioner(J);
+    }
+    b = x_;
+    return err;
+}
+
+ErrorType BiCGSTABLinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, without rebuilding the preconditioner
+    // nothing is written in the members of this class, so that it can be called from different threads
+    if(J.cols() != n_) return ErrorType::NotInitError;
+    RealVect x(n_);
+    for(Eigen::Index col_id = 0; col_id < B.cols(); ++col_id){
+        Eigen::Index iters = max_iter_;
+        real_type tol_error = exact_tol_;
+        x.setZero();
+        const bool ok = Eigen::internal::bicgstab(J, B.col(col_id), x, precond_, iters, tol_error);
+        if(!ok || (tol_error > exact_tol_) || !x.allFinite()) return ErrorType::SolverSolve;
+        B.col(col_id) = x;
+    }
+    return ErrorType::NoError;
+}
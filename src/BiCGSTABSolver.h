@@ -0,0 +1,158 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef BICGSTABSOLVER_H
+#define BICGSTABSOLVER_H
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <stdio.h>
+#include <cstdint> // for int32
+#include <chrono>
+#include <cmath>  // for PI
+
+// eigen is necessary to easily pass data from numpy to c++ without any copy.
+// and to optimize the matrix operations
+#include "Utils.h"
+#include "Eigen/Core"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "Eigen/IterativeLinearSolvers"
+
+#include "CustTimer.h"
+#include "BaseNRSolver.h"
+/**
+class to handle the solver using newton-raphson method, using an iterative (Krylov) method: the "BiCGSTAB"
+algorithm from Eigen, preconditioned with an incomplete LU decomposition ("IncompleteLUT").
+
+Contrary to the direct solvers (SparseLU, KLU, NICSLU...) the jacobian matrix is never factorized. Only the
+preconditioner is computed, and it is kept across the newton raphson iterations (and across consecutive calls
+to "compute_pf"). It is rebuilt (from the current matrix) only when the number of Krylov iterations needed to solve
+the system grows too much compared to the number of iterations needed just after the last rebuild
+(see "rebuild_factor") or when the Krylov method fails to converge.
+
+The tolerance used for each linear system is coupled to the tolerance of the newton raphson ("inexact newton"):
+when the residual of the powerflow equations is large, the newton step does not need to be computed precisely. The
+relative tolerance used to solve J.x = b is then:
+
+    eta = min(eta_max, max(forcing * ||b||, safety * nr_tol / ||b||))
+
+The first term makes the method converge super linearly, the second one prevents "over solving" the last iterations
+(there is no need for a linear residual much smaller than the tolerance of the newton raphson). When the outer
+tolerance is not known (*eg* in the DC approximation) the linear systems are solved up to "exact_tol".
+
+This is mainly interesting for very large grids where the fill-in of the direct methods makes each
+factorization expensive.
+
+As long as the admittance matrix of the sytem does not change, you can reuse the same solver.
+Reusing the same solver is possible, but "reset" method must be called.
+**/
+class BiCGSTABLinearSolver
+{
+    public:
+        typedef Eigen::IncompleteLUT<real_type> Preconditioner;
+
+        BiCGSTABLinearSolver():
+            precond_(),
+            x_(),
+            n_(-1),
+            drop_tol_(1e-4),
+            fill_factor_(10),
+            max_iter_(1000),
+            rebuild_factor_(2.),
+            eta_max_(1e-1),
+            forcing_(1e-1),
+            safety_(1e-1),
+            exact_tol_(1e-12),
+            nr_tol_(-1.),
+            ref_iter_(-1),
+            last_iter_(0),
+            total_iter_(0),
+            nb_precond_built_(0)
+            {
+                precond_.setDroptol(drop_tol_);
+                precond_.setFillfactor(fill_factor_);
+            }
+
+        // public api
+        ErrorType initialize(const Eigen::SparseMatrix<real_type> & J);
+        ErrorType solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized);
+        // solve J.X = B (in place) for all the columns of B up to "exact_tol", using the current preconditioner (never rebuilt here)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = true;  // the preconditioner is only read in "solve_many" (statistics are not updated)
+        ErrorType reset(){
+            // precond_ cannot be re assigned, it will be recomputed at the next "initialize"
+            x_ = RealVect();
+            n_ = -1;
+            ref_iter_ = -1;
+            last_iter_ = 0;
+            total_iter_ = 0;
+            nb_precond_built_ = 0;
+            return ErrorType::NoError;
+        }
+        // tolerance of the newton raphson, used to compute the tolerance of the linear systems
+        void set_outer_tol(real_type tol) {nr_tol_ = tol;}
+        // the preconditioner (Eigen::IncompleteLUT) cannot be copied: it will be built again by "initialize"
+        bool reuse_factorization(const BiCGSTABLinearSolver & /*other*/){ return false; }
+
+        // parameters of the method (they are used at the next (re) build of the preconditioner)
+        void set_parameters(real_type drop_tol, int fill_factor, int max_iter, real_type rebuild_factor);
+        std::tuple<real_type, int, int, real_type> get_parameters() const {
+            return std::tuple<real_type, int, int, real_type>(drop_tol_, fill_factor_, max_iter_, rebuild_factor_);
+        }
+
+        // parameters of the coupling with the newton raphson tolerance
+        void set_tolerance_coupling(real_type eta_max, real_type forcing, real_type safety, real_type exact_tol);
+        std::tuple<real_type, real_type, real_type, real_type> get_tolerance_coupling() const {
+            return std::tuple<real_type, real_type, real_type, real_type>(eta_max_, forcing_, safety_, exact_tol_);
+        }
+
+        // number of iterations of the last solve, total number of iterations, and number of time the preconditioner was built
+        std::tuple<int, int, int> get_stats() const {return std::tuple<int, int, int>(last_iter_, total_iter_, nb_precond_built_);}
+
+    protected:
+        // compute the preconditioner from the current matrix
+        ErrorType build_preconditioner(const Eigen::SparseMatrix<real_type> & J);
+
+        // run the Krylov method (with the current preconditioner) returns whether it converged
+        bool run_krylov(const Eigen::SparseMatrix<real_type> & J, const RealVect & b, real_type tol, int & nb_iter);
+
+        // relative tolerance used to solve the system (see the description of the class)
+        real_type compute_tol(real_type b_norm) const;
+
+    private:
+        Preconditioner precond_;
+        RealVect x_;  // buffer used to store the solution of the linear system
+        Eigen::Index n_;  // size of the system when the preconditioner was built
+
+        // parameters
+        real_type drop_tol_;  // drop tolerance of the incomplete LU
+        int fill_factor_;  // fill factor of the incomplete LU
+        int max_iter_;  // maximum number of Krylov iterations
+        real_type rebuild_factor_;  // rebuild the preconditioner if nb_iter > rebuild_factor * (nb_iter just after last rebuild)
+        real_type eta_max_;
+        real_type forcing_;
+        real_type safety_;
+        real_type exact_tol_;
+        real_type nr_tol_;  // tolerance of the outer newton raphson (negative: unknown)
+
+        // statistics
+        int ref_iter_;  // number of iterations needed just after the last rebuild of the preconditioner
+        int last_iter_;
+        int total_iter_;
+        int nb_precond_built_;
+
+        static const int MIN_REF_ITER_ = 5;  // avoid rebuilding the preconditioner too often when it is very good
+
+        // no copy allowed
+        BiCGSTABLinearSolver( const BiCGSTABLinearSolver & ) =delete ;
+        BiCGSTABLinearSolver & operator=( const BiCGSTABLinearSolver & ) =delete ;
+};
+
+#endif // BICGSTABSOLVER_H
@@ -0,0 +1,195 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "BinaryState.h"
+
+#include <cstring>  // for std::memcpy
+#include <algorithm>  // for std::reverse
+
+namespace {
+    bool is_little_endian(){
+        const uint16_t one = 1;
+        unsigned char first_byte;
+        std::memcpy(&first_byte, &one, 1);
+        return first_byte == 1;
+    }
+
+    // the data are stored in little endian: scalars are swapped if the machine is big endian
+    void to_little_endian(char * data, std::size_t nb_bytes, std::size_t scalar_size){
+        if(is_little_endian() || (scalar_size <= 1)) return;
+        for(std::size_t pos = 0; pos + scalar_size <= nb_bytes; pos += scalar_size){
+            std::reverse(data + pos, data + pos + scalar_size);
+        }
+    }
+
+    template<class T>
+    void append_scalar(std::string & buffer, T value){
+        char tmp[sizeof(T)];
+        std::memcpy(tmp, &value, sizeof(T));
+        to_little_endian(tmp, sizeof(T), sizeof(T));
+        buffer.append(tmp, sizeof(T));
+    }
+
+    template<class T>
+    T extract_scalar(const char * data){
+        char tmp[sizeof(T)];
+        std::memcpy(tmp, data, sizeof(T));
+        to_little_endian(tmp, sizeof(T), sizeof(T));
+        T res;
+        std::memcpy(&res, tmp, sizeof(T));
+        return res;
+    }
+
+    std::size_t padding(std::size_t nb_bytes){
+        return (8 - nb_bytes % 8) % 8;
+    }
+}
+
+const char BinaryStateWriter::MAGIC[8] = {'L', 'S', '2', 'G', 'R', 'I', 'D', '\0'};
+
+BinaryStateWriter::BinaryStateWriter():
+    nb_block_(0)
+{
+    // the number of blocks is written in finish()
+    buffer_.append(MAGIC, 8);
+    append_scalar<uint32_t>(buffer_, BINARY_FORMAT_VERSION);
+    append_scalar<uint32_t>(buffer_, 0);
+    append_scalar<int32_t>(buffer_, VERSION_MAJOR);
+    append_scalar<int32_t>(buffer_, VERSION_MEDIUM);
+    append_scalar<int32_t>(buffer_, VERSION_MINOR);
+    append_scalar<uint32_t>(buffer_, 0);  // reserved
+}
+
+void BinaryStateWriter::write(const std::vector<bool> & data){
+    // std::vector<bool> is not contiguous, it is stored as one byte per element
+    std::vector<unsigned char> tmp(data.begin(), data.end());
+    write_block(BOOL, tmp.data(), tmp.size(), 1, 1);
+}
+
+void BinaryStateWriter::write(int data){
+    write_block(INT32, &data, 1, sizeof(int), sizeof(int));
+}
+
+void BinaryStateWriter::write(real_type data){
+    write_block(block_type<real_type>(), &data, 1, sizeof(real_type), sizeof(real_type));
+}
+
+void BinaryStateWriter::write_block(uint32_t type, const void * data, std::size_t nb_el, std::size_t el_size, std::size_t scalar_size){
+    append_scalar<uint32_t>(buffer_, type);
+    append_scalar<uint32_t>(buffer_, 0);  // reserved
+    append_scalar<uint64_t>(buffer_, static_cast<uint64_t>(nb_el));
+
+    const std::size_t nb_bytes = nb_el * el_size;
+    const std::size_t beg = buffer_.size();
+    buffer_.append(static_cast<const char *>(data), nb_bytes);
+    to_little_endian(&buffer_[beg], nb_bytes, scalar_size);
+    buffer_.append(padding(nb_bytes), '\0');
+    ++nb_block_;
+}
+
+std::string BinaryStateWriter::finish(){
+    std::string nb_block;
+    append_scalar<uint32_t>(nb_block, nb_block_);
+    buffer_.replace(12, sizeof(uint32_t), nb_block);
+    return buffer_;
+}
+
+BinaryStateReader::BinaryStateReader(const char * data, std::size_t size):
+    data_(data),
+    size_(size),
+    pos_(0),
+    nb_block_read_(0)
+{
+    check_available(BinaryStateWriter::HEADER_SIZE, "the header");
+    if(std::memcmp(data_, BinaryStateWriter::MAGIC, 8) != 0){
+        throw std::runtime_error("BinaryStateReader: the data do not represent a lightsim2grid GridModel (wrong magic string).");
+    }
+    format_version_ = extract_scalar<uint32_t>(data_ + 8);
+    nb_block_ = extract_scalar<uint32_t>(data_ + 12);
+    version_major_ = extract_scalar<int32_t>(data_ + 16);
+    version_medium_ = extract_scalar<int32_t>(data_ + 20);
+    version_minor_ = extract_scalar<int32_t>(data_ + 24);
+    if(format_version_ != BinaryStateWriter::BINARY_FORMAT_VERSION){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: the data have been saved with the binary format version " << format_version_;
+        exc_ << " (lightsim2grid " << version_major_ << "." << version_medium_ << "." << version_minor_ << ")";
+        exc_ << " but this version of lightsim2grid only reads the version " << BinaryStateWriter::BINARY_FORMAT_VERSION;
+        exc_ << " of the binary format.";
+        throw std::runtime_error(exc_.str());
+    }
+    pos_ = BinaryStateWriter::HEADER_SIZE;
+}
+
+void BinaryStateReader::read(std::vector<bool> & data){
+    const std::size_t nb_el = read_block_header(BinaryStateWriter::BOOL, 1);
+    const char * tmp = data_ + pos_;
+    data.resize(nb_el);
+    for(std::size_t i = 0; i < nb_el; ++i) data[i] = tmp[i] != 0;
+    pos_ += nb_el + padding(nb_el);
+}
+
+void BinaryStateReader::read(int & data){
+    read_scalar(data);
+}
+
+void BinaryStateReader::read(real_type & data){
+    read_scalar(data);
+}
+
+std::size_t BinaryStateReader::read_block_header(uint32_t type, std::size_t el_size){
+    if(nb_block_read_ >= nb_block_){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: the data only have " << nb_block_ << " blocks, more were expected.";
+        throw std::runtime_error(exc_.str());
+    }
+    check_available(BinaryStateWriter::BLOCK_HEADER_SIZE, "a block header");
+    const uint32_t type_read = extract_scalar<uint32_t>(data_ + pos_);
+    const uint64_t nb_el = extract_scalar<uint64_t>(data_ + pos_ + 8);
+    if(type_read != type){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: wrong type for block " << nb_block_read_ << ": " << type_read;
+        exc_ << " was found but " << type << " was expected.";
+        throw std::runtime_error(exc_.str());
+    }
+    pos_ += BinaryStateWriter::BLOCK_HEADER_SIZE;
+    ++nb_block_read_;
+    // the data of the block must be available (this also prevents any overflow when computing its size)
+    if(nb_el > (size_ - pos_) / el_size){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: block " << nb_block_read_ - 1 << " has " << nb_el;
+        exc_ << " elements but the data are too short.";
+        throw std::runtime_error(exc_.str());
+    }
+    return static_cast<std::size_t>(nb_el);
+}
+
+void BinaryStateReader::read_data(void * res, std::size_t nb_el, std::size_t el_size, std::size_t scalar_size){
+    const std::size_t nb_bytes = nb_el * el_size;
+    if(nb_bytes > 0){
+        char * res_char = static_cast<char *>(res);
+        std::memcpy(res_char, data_ + pos_, nb_bytes);
+        to_little_endian(res_char, nb_bytes, scalar_size);  // little endian -> machine order (same swap)
+    }
+    pos_ += nb_bytes + padding(nb_bytes);
+}
+
+void BinaryStateReader::check_available(std::size_t nb_bytes, const std::string & what) const{
+    if((pos_ > size_) || (nb_bytes > size_ - pos_)){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: the data are too short to read " << what << " (" << size_ << " bytes).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void BinaryStateReader::finish() const{
+    if(nb_block_read_ != nb_block_){
+        std::ostringstream exc_;
+        exc_ << "BinaryStateReader: " << nb_block_read_ << " blocks have been read, but the data count " << nb_block_ << " blocks.";
+        throw std::runtime_error(exc_.str());
+    }
+}
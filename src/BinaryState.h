@@ -0,0 +1,163 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef BINARYSTATE_H
+#define BINARYSTATE_H
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+
+#include "Utils.h"
+
+/**
+Compact binary representation of the "state" (see the `StateRes` of GridModel and of the Data* classes) used
+to save / load a GridModel and to pickle it.
+
+The layout is:
+
+- a header of 32 bytes: the magic string "LS2GRID" (8 bytes, null terminated), the version of the binary format
+  (uint32), the number of blocks (uint32), the version of lightsim2grid that wrote it (3 x int32) and 4 reserved bytes
+- one "column block" per member of the state (a scalar being stored as a block of size 1). Each block has a header of
+  16 bytes: the type of the data (uint32, see `BlockType`), 4 reserved bytes and the number of elements (uint64)
+  followed by the data themselves, padded with 0 to a multiple of 8 bytes.
+
+Everything is stored in little endian and every block starts at an offset multiple of 8, so that the data can be
+read in place (for example with `numpy.frombuffer` on a memory mapped file).
+
+BINARY_FORMAT_VERSION must be increased each time the layout of the state of one of the element changes.
+**/
+class BinaryStateWriter
+{
+    public:
+        static const uint32_t BINARY_FORMAT_VERSION = 1;
+        static const char MAGIC[8];
+        static const std::size_t HEADER_SIZE = 32;
+        static const std::size_t BLOCK_HEADER_SIZE = 16;
+
+        enum BlockType {INT32 = 1, FLOAT64 = 2, FLOAT32 = 3, COMPLEX128 = 4, COMPLEX64 = 5, BOOL = 6};
+
+        BinaryStateWriter();
+
+        // write all the members of the tuple, starting at the member `Start`
+        template<std::size_t Start = 0, class... Args>
+        void write(const std::tuple<Args...> & state){
+            write_tuple<Start>(state, std::integral_constant<bool, Start < sizeof...(Args)>());
+        }
+        template<class T>
+        void write(const std::vector<T> & data){
+            write_block(block_type<T>(), data.data(), data.size(), sizeof(T), scalar_size<T>());
+        }
+        void write(const std::vector<bool> & data);
+        void write(int data);
+        void write(real_type data);
+
+        // the final bytes (the header is completed here)
+        std::string finish();
+
+        // type of the data stored in the blocks
+        template<class T> static uint32_t block_type();
+        // size of the scalars (that are swapped if the machine is big endian)
+        template<class T> static std::size_t scalar_size() {return sizeof(T);}
+
+    protected:
+        template<std::size_t I, class... Args>
+        void write_tuple(const std::tuple<Args...> & state, std::true_type){
+            write(std::get<I>(state));
+            write_tuple<I + 1>(state, std::integral_constant<bool, I + 1 < sizeof...(Args)>());
+        }
+        template<std::size_t I, class... Args>
+        void write_tuple(const std::tuple<Args...> & /*state*/, std::false_type){}
+
+        void write_block(uint32_t type, const void * data, std::size_t nb_el, std::size_t el_size, std::size_t scalar_size);
+
+    protected:
+        std::string buffer_;
+        uint32_t nb_block_;
+};
+
+class BinaryStateReader
+{
+    public:
+        // data is not copied, it must outlive the reader
+        BinaryStateReader(const char * data, std::size_t size);
+
+        // read all the members of the tuple, starting at the member `Start`
+        template<std::size_t Start = 0, class... Args>
+        void read(std::tuple<Args...> & state){
+            read_tuple<Start>(state, std::integral_constant<bool, Start < sizeof...(Args)>());
+        }
+        template<class T>
+        void read(std::vector<T> & data){
+            const std::size_t nb_el = read_block_header(BinaryStateWriter::block_type<T>(), sizeof(T));
+            data.resize(nb_el);
+            read_data(data.data(), nb_el, sizeof(T), BinaryStateWriter::scalar_size<T>());
+        }
+        void read(std::vector<bool> & data);
+        void read(int & data);
+        void read(real_type & data);
+
+        // check that all the data have been read
+        void finish() const;
+
+        uint32_t format_version() const {return format_version_;}
+        int version_major() const {return version_major_;}
+        int version_medium() const {return version_medium_;}
+        int version_minor() const {return version_minor_;}
+
+    protected:
+        template<std::size_t I, class... Args>
+        void read_tuple(std::tuple<Args...> & state, std::true_type){
+            read(std::get<I>(state));
+            read_tuple<I + 1>(state, std::integral_constant<bool, I + 1 < sizeof...(Args)>());
+        }
+        template<std::size_t I, class... Args>
+        void read_tuple(std::tuple<Args...> & /*state*/, std::false_type){}
+
+        template<class T>
+        void read_scalar(T & data){
+            const std::size_t nb_el = read_block_header(BinaryStateWriter::block_type<T>(), sizeof(T));
+            if(nb_el != 1){
+                std::ostringstream exc_;
+                exc_ << "BinaryStateReader: a scalar was expected for block " << nb_block_read_ - 1;
+                exc_ << " but it has " << nb_el << " elements.";
+                throw std::runtime_error(exc_.str());
+            }
+            read_data(&data, 1, sizeof(T), sizeof(T));
+        }
+
+        // check the block header and return the number of elements
+        std::size_t read_block_header(uint32_t type, std::size_t el_size);
+        void read_data(void * res, std::size_t nb_el, std::size_t el_size, std::size_t scalar_size);
+        void check_available(std::size_t nb_bytes, const std::string & what) const;
+
+    protected:
+        const char * data_;
+        std::size_t size_;
+        std::size_t pos_;
+        uint32_t format_version_;
+        uint32_t nb_block_;
+        uint32_t nb_block_read_;
+        int version_major_;
+        int version_medium_;
+        int version_minor_;
+};
+
+template<> inline uint32_t BinaryStateWriter::block_type<int>() {return INT32;}
+template<> inline uint32_t BinaryStateWriter::block_type<double>() {return FLOAT64;}
+template<> inline uint32_t BinaryStateWriter::block_type<float>() {return FLOAT32;}
+template<> inline uint32_t BinaryStateWriter::block_type<std::complex<double> >() {return COMPLEX128;}
+template<> inline uint32_t BinaryStateWriter::block_type<std::complex<float> >() {return COMPLEX64;}
+// complex numbers are swapped part by part
+template<> inline std::size_t BinaryStateWriter::scalar_size<std::complex<double> >() {return sizeof(double);}
+template<> inline std::size_t BinaryStateWriter::scalar_size<std::complex<float> >() {return sizeof(float);}
+
+#endif // BINARYSTATE_H
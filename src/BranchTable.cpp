@@ -0,0 +1,151 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "BranchTable.h"
+
+#include "DataLine.h"
+#include "DataTrafo.h"
+
+void BranchTable::init(const DataLine & powerlines, const DataTrafo & trafos, const RealVect & bus_vn_kv)
+{
+    nb_line_ = powerlines.nb();
+    const Eigen::Index nb_trafo = trafos.nb();
+    const Eigen::Index nb_branch = nb_line_ + nb_trafo;
+
+    bus_from_.resize(nb_branch);
+    bus_to_.resize(nb_branch);
+    bus_from_ << powerlines.get_bus_from(), trafos.get_bus_from();
+    bus_to_ << powerlines.get_bus_to(), trafos.get_bus_to();
+
+    status_ = powerlines.get_status();
+    status_.insert(status_.end(), trafos.get_status().begin(), trafos.get_status().end());
+    zero_impedance_.assign(nb_branch, false);
+    for(Eigen::Index line_id = 0; line_id < nb_line_; ++line_id){
+        zero_impedance_[line_id] = powerlines.is_zero_impedance(static_cast<int>(line_id));
+    }
+
+    vn_kv_from_.resize(nb_branch);
+    vn_kv_to_.resize(nb_branch);
+    for(Eigen::Index branch_id = 0; branch_id < nb_branch; ++branch_id){
+        vn_kv_from_(branch_id) = bus_vn_kv(bus_from_(branch_id));
+        vn_kv_to_(branch_id) = bus_vn_kv(bus_to_(branch_id));
+    }
+
+    yac_ff_.resize(nb_branch);
+    yac_ft_.resize(nb_branch);
+    yac_tf_.resize(nb_branch);
+    yac_tt_.resize(nb_branch);
+    yac_ff_ << powerlines.yac_ff(), trafos.yac_ff();
+    yac_ft_ << powerlines.yac_ft(), trafos.yac_ft();
+    yac_tf_ << powerlines.yac_tf(), trafos.yac_tf();
+    yac_tt_ << powerlines.yac_tt(), trafos.yac_tt();
+
+    ydc_ff_.resize(nb_branch);
+    ydc_ft_.resize(nb_branch);
+    ydc_tf_.resize(nb_branch);
+    ydc_tt_.resize(nb_branch);
+    ydc_ff_ << powerlines.ydc_ff(), trafos.ydc_ff();
+    ydc_ft_ << powerlines.ydc_ft(), trafos.ydc_ft();
+    ydc_tf_ << powerlines.ydc_tf(), trafos.ydc_tf();
+    ydc_tt_ << powerlines.ydc_tt(), trafos.ydc_tt();
+
+    dc_x_tau_shift_.resize(nb_branch);
+    dc_x_tau_shift_ << RealVect::Zero(nb_line_), trafos.dc_x_tau_shift();
+    initialized_ = true;
+}
+
+void BranchTable::set_branch(Eigen::Index branch_id, bool status, int bus_from, int bus_to, const RealVect & bus_vn_kv)
+{
+    status_[branch_id] = status;
+    bus_from_(branch_id) = bus_from;
+    bus_to_(branch_id) = bus_to;
+    vn_kv_from_(branch_id) = bus_vn_kv(bus_from);
+    vn_kv_to_(branch_id) = bus_vn_kv(bus_to);
+}
+
+void BranchTable::fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
+                           bool ac,
+                           const std::vector<int> & id_grid_to_solver) const
+{
+    const CplxVect & y_ff = ac ? yac_ff_ : ydc_ff_;
+    const CplxVect & y_ft = ac ? yac_ft_ : ydc_ft_;
+    const CplxVect & y_tf = ac ? yac_tf_ : ydc_tf_;
+    const CplxVect & y_tt = ac ? yac_tt_ : ydc_tt_;
+    for(Eigen::Index branch_id = 0; branch_id < nb(); ++branch_id){
+        // i only add this if the branch is connected
+        if(!status_[branch_id]) continue;
+
+        const int bus_from_solver_id = id_grid_to_solver[bus_from_(branch_id)];
+        check_connected("fillYbus", branch_id, bus_from_solver_id, true);
+        const int bus_to_solver_id = id_grid_to_solver[bus_to_(branch_id)];
+        check_connected("fillYbus", branch_id, bus_to_solver_id, false);
+
+        res.push_back(Eigen::Triplet<cplx_type> (bus_from_solver_id, bus_to_solver_id, y_ft(branch_id)));
+        res.push_back(Eigen::Triplet<cplx_type> (bus_to_solver_id, bus_from_solver_id, y_tf(branch_id)));
+        res.push_back(Eigen::Triplet<cplx_type> (bus_from_solver_id, bus_from_solver_id, y_ff(branch_id)));
+        res.push_back(Eigen::Triplet<cplx_type> (bus_to_solver_id, bus_to_solver_id, y_tt(branch_id)));
+    }
+}
+
+void BranchTable::compute_results(Eigen::Index first_id,
+                                  Eigen::Index nb_branch,
+                                  const Eigen::Ref<const RealVect> & Va,
+                                  const Eigen::Ref<const RealVect> & Vm,
+                                  const Eigen::Ref<const CplxVect> & V,
+                                  const std::vector<int> & id_grid_to_solver,
+                                  real_type sn_mva,
+                                  bool ac,
+                                  RealVect & p_from, RealVect & q_from, RealVect & v_from, RealVect & theta_from,
+                                  RealVect & p_to, RealVect & q_to, RealVect & v_to, RealVect & theta_to) const
+{
+    // it needs to be initialized at 0.
+    p_from.setConstant(nb_branch, my_zero_);  // in MW
+    q_from.setConstant(nb_branch, my_zero_);  // in MVar
+    v_from.setConstant(nb_branch, my_zero_);  // in kV
+    theta_from.setConstant(nb_branch, my_zero_);  // in degree
+    p_to.setConstant(nb_branch, my_zero_);  // in MW
+    q_to.setConstant(nb_branch, my_zero_);  // in MVar
+    v_to.setConstant(nb_branch, my_zero_);  // in kV
+    theta_to.setConstant(nb_branch, my_zero_);  // in degree
+    for(Eigen::Index el_id = 0; el_id < nb_branch; ++el_id){
+        const Eigen::Index branch_id = first_id + el_id;
+        // don't do anything if the element is disconnected
+        if(!status_[branch_id]) continue;
+
+        const int bus_from_solver_id = id_grid_to_solver[bus_from_(branch_id)];
+        check_connected("compute_results", branch_id, bus_from_solver_id, true);
+        const int bus_to_solver_id = id_grid_to_solver[bus_to_(branch_id)];
+        check_connected("compute_results", branch_id, bus_to_solver_id, false);
+
+        // voltages magnitude in kv instead of pu, and angles in degree instead of radian
+        v_from(el_id) = Vm(bus_from_solver_id) * vn_kv_from_(branch_id);
+        v_to(el_id) = Vm(bus_to_solver_id) * vn_kv_to_(branch_id);
+        theta_from(el_id) = Va(bus_from_solver_id) * 180. / my_pi;
+        theta_to(el_id) = Va(bus_to_solver_id) * 180. / my_pi;
+
+        if(ac){
+            // result of the ac powerflow
+            const cplx_type E_from = V(bus_from_solver_id);
+            const cplx_type E_to = V(bus_to_solver_id);
+            const cplx_type I_from = yac_ff_(branch_id) * E_from + yac_ft_(branch_id) * E_to;
+            const cplx_type I_to = yac_tt_(branch_id) * E_to + yac_tf_(branch_id) * E_from;
+            const cplx_type s_from = E_from * std::conj(I_from);
+            const cplx_type s_to = E_to * std::conj(I_to);
+            p_from(el_id) = std::real(s_from) * sn_mva;
+            q_from(el_id) = std::imag(s_from) * sn_mva;
+            p_to(el_id) = std::real(s_to) * sn_mva;
+            q_to(el_id) = std::imag(s_to) * sn_mva;
+        }else{
+            // result of the dc powerflow
+            const real_type va_from = Va(bus_from_solver_id);
+            const real_type va_to = Va(bus_to_solver_id);
+            p_from(el_id) = (std::real(ydc_ff_(branch_id)) * va_from + std::real(ydc_ft_(branch_id)) * va_to - dc_x_tau_shift_(branch_id)) * sn_mva;
+            p_to(el_id) = (std::real(ydc_tt_(branch_id)) * va_to + std::real(ydc_tf_(branch_id)) * va_from + dc_x_tau_shift_(branch_id)) * sn_mva;
+        }
+    }
+}
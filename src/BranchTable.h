@@ -0,0 +1,126 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef BRANCHTABLE_H
+#define BRANCHTABLE_H
+
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+#include "Utils.h"
+#include "Eigen/Core"
+#include "Eigen/SparseCore"
+
+#include "BaseConstants.h"
+#include "DataGeneric.h"
+
+class DataLine;
+class DataTrafo;
+
+/**
+All the branches of the grid (the powerlines then the transformers) stored in contiguous arrays: the branch with id
+`line_id` is the powerline `line_id` and the branch with id `nb_line() + trafo_id` is the transformer `trafo_id`
+(same convention as for the contingencies of the SecurityAnalysis).
+
+The "from" side is the "or" side of a powerline and the "hv" side of a transformer. The buses are given with the
+GridModel ids ("me" ids). Once filled (see `init`), the admittance matrix and the contingencies can be computed with
+one pass over all the branches, and the flows of the powerlines and of the trafos with the same code.
+
+The DataLine and DataTrafo own the data: this table is a cache derived from them. It is filled again only when their
+parameters (or the nominal voltages of the buses) change, the status and the buses of a branch are updated one by
+one with `set_branch` (see GridModel::get_branches).
+**/
+class BranchTable : public BaseConstants
+{
+    public:
+        BranchTable():nb_line_(0), initialized_(false) {}
+
+        void init(const DataLine & powerlines, const DataTrafo & trafos, const RealVect & bus_vn_kv);
+        bool is_init() const {return initialized_;}
+        // the table must be filled again (see init), eg after the parameters of the branches are modified
+        void clear() {initialized_ = false;}
+        // update the status and the buses of one branch (its parameters do not change)
+        void set_branch(Eigen::Index branch_id, bool status, int bus_from, int bus_to, const RealVect & bus_vn_kv);
+
+        Eigen::Index nb() const {return bus_from_.size();}
+        Eigen::Index nb_line() const {return nb_line_;}
+        Eigen::Index nb_trafo() const {return nb() - nb_line_;}
+
+        Eigen::Ref<const Eigen::VectorXi> get_bus_from() const {return bus_from_;}
+        Eigen::Ref<const Eigen::VectorXi> get_bus_to() const {return bus_to_;}
+        const std::vector<bool> & get_status() const {return status_;}
+        // the powerlines without impedance are merged with their buses (see GridModel::init_Ybus)
+        bool is_zero_impedance(Eigen::Index branch_id) const {return zero_impedance_[branch_id];}
+        Eigen::Ref<const RealVect> get_vn_kv_from() const {return vn_kv_from_;}
+        Eigen::Ref<const RealVect> get_vn_kv_to() const {return vn_kv_to_;}
+
+        Eigen::Ref<const CplxVect> yac_ff() const {return yac_ff_;}
+        Eigen::Ref<const CplxVect> yac_ft() const {return yac_ft_;}
+        Eigen::Ref<const CplxVect> yac_tf() const {return yac_tf_;}
+        Eigen::Ref<const CplxVect> yac_tt() const {return yac_tt_;}
+        Eigen::Ref<const CplxVect> ydc_ff() const {return ydc_ff_;}
+        Eigen::Ref<const CplxVect> ydc_ft() const {return ydc_ft_;}
+        Eigen::Ref<const CplxVect> ydc_tf() const {return ydc_tf_;}
+        Eigen::Ref<const CplxVect> ydc_tt() const {return ydc_tt_;}
+
+        void fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
+                      bool ac,
+                      const std::vector<int> & id_grid_to_solver) const;
+
+        /**
+        flows (MW, MVAr), voltages (kV) and voltage angles (degree) at both sides of the branches with ids
+        `first_id` to `first_id + nb_branch - 1`. The results are set to 0. for the disconnected branches.
+        **/
+        void compute_results(Eigen::Index first_id,
+                             Eigen::Index nb_branch,
+                             const Eigen::Ref<const RealVect> & Va,
+                             const Eigen::Ref<const RealVect> & Vm,
+                             const Eigen::Ref<const CplxVect> & V,
+                             const std::vector<int> & id_grid_to_solver,
+                             real_type sn_mva,
+                             bool ac,
+                             RealVect & p_from, RealVect & q_from, RealVect & v_from, RealVect & theta_from,
+                             RealVect & p_to, RealVect & q_to, RealVect & v_to, RealVect & theta_to) const;
+
+    protected:
+        void check_connected(const char * fun_name, Eigen::Index branch_id, int bus_solver_id, bool from_side) const{
+            if(bus_solver_id == DataGeneric::_deactivated_bus_id){
+                std::ostringstream exc_;
+                exc_ << "BranchTable::" << fun_name << ": the ";
+                if(branch_id < nb_line_) exc_ << "line with id " << branch_id;
+                else exc_ << "trafo with id " << branch_id - nb_line_;
+                exc_ << " is connected (" << (from_side ? "from" : "to") << " side) to a disconnected bus while being connected";
+                throw std::runtime_error(exc_.str());
+            }
+        }
+
+    protected:
+        Eigen::Index nb_line_;
+        bool initialized_;
+
+        Eigen::VectorXi bus_from_;
+        Eigen::VectorXi bus_to_;
+        std::vector<bool> status_;
+        std::vector<bool> zero_impedance_;
+        RealVect vn_kv_from_;
+        RealVect vn_kv_to_;
+
+        CplxVect yac_ff_;
+        CplxVect yac_ft_;
+        CplxVect yac_tf_;
+        CplxVect yac_tt_;
+        CplxVect ydc_ff_;
+        CplxVect ydc_ft_;
+        CplxVect ydc_tf_;
+        CplxVect ydc_tt_;
+        // power injected by the phase shifters in the dc approximation (0. for the powerlines)
+        RealVect dc_x_tau_shift_;
+};
+
+#endif // BRANCHTABLE_H
@@ -15,11 +15,17 @@
 #include "Solvers.h"
 #include "GaussSeidelSolver.h"
 #include "GaussSeidelSynchSolver.h"
+#include "GaussSeidelColoredSolver.h"
 #include "DCSolver.h"
+#include "KLUSolverConfig.h"
 
 enum class SolverType {SparseLU, KLU, GaussSeidel, DC, GaussSeidelSynch, NICSLU,
                        SparseLUSingleSlack, KLUSingleSlack, NICSLUSingleSlack,
-                       KLUDC, NICSLUDC};
+                       KLUDC, NICSLUDC,
+                       DenseLU, DenseLUSingleSlack, DenseLUDC,
+                       BiCGSTAB, BiCGSTABSingleSlack, BiCGSTABDC,
+                       LDLTDC,
+                       GaussSeidelColored};
 
 // TODO define a template class instead of these weird stuff !!!
 // TODO export all methods from base class !
@@ -40,13 +46,21 @@ class ChooseSolver
         std::vector<SolverType> available_solvers() const
         {
             std::vector<SolverType> res;
-            res.reserve(11);
+            res.reserve(19);
 
             res.push_back(SolverType::SparseLU);
             res.push_back(SolverType::GaussSeidel);
             res.push_back(SolverType::DC);
             res.push_back(SolverType::GaussSeidelSynch);
             res.push_back(SolverType::SparseLUSingleSlack);
+            res.push_back(SolverType::DenseLU);
+            res.push_back(SolverType::DenseLUSingleSlack);
+            res.push_back(SolverType::DenseLUDC);
+            res.push_back(SolverType::BiCGSTAB);
+            res.push_back(SolverType::BiCGSTABSingleSlack);
+            res.push_back(SolverType::BiCGSTABDC);
+            res.push_back(SolverType::LDLTDC);
+            res.push_back(SolverType::GaussSeidelColored);
             #ifdef KLU_SOLVER_AVAILABLE
                 res.push_back(SolverType::KLU);
                 res.push_back(SolverType::KLUSingleSlack);
@@ -62,7 +76,7 @@ class ChooseSolver
         
         bool is_dc(const SolverType & type){
             bool res;
-            res = (type == SolverType::DC) || (type == SolverType::KLUDC) || (type == SolverType::NICSLUDC);
+            res = (type == SolverType::DC) || (type == SolverType::KLUDC) || (type == SolverType::NICSLUDC) || (type == SolverType::DenseLUDC) || (type == SolverType::BiCGSTABDC) || (type == SolverType::LDLTDC);
             return res;
         }
         SolverType get_type() const {return _solver_type;}
@@ -99,6 +113,32 @@ class ChooseSolver
             return p_solver -> reset();
         }
 
+        // copy the state of the solver of other (that should be of the same type), see BaseSolver::copy_state
+        void copy_state(const ChooseSolver & other)
+        {
+            if(other._solver_type != _solver_type){
+                std::ostringstream exc_;
+                exc_ << "ChooseSolver::copy_state: the state can only be copied from a solver of the same type.";
+                throw std::runtime_error(exc_.str());
+            }
+            reset();
+            if(other._type_used_for_nr != other._solver_type) return;  // no powerflow has been run with this solver
+            _type_used_for_nr = other._type_used_for_nr;
+            auto p_solver = get_prt_solver("copy_state", true);
+            auto p_other = other.get_prt_solver("copy_state", true);
+            p_solver -> copy_state(*p_other);
+        }
+
+        // copy the settings (not the state) of all the solvers of other, see set_klu_config and set_gauss_seidel_colored_config
+        void copy_config(const ChooseSolver & other)
+        {
+            #ifdef KLU_SOLVER_AVAILABLE
+                set_klu_config(other.get_klu_config());
+            #endif  // KLU_SOLVER_AVAILABLE
+            const auto gs_config = other.get_gauss_seidel_colored_config();
+            set_gauss_seidel_colored_config(std::get<0>(gs_config), std::get<1>(gs_config), std::get<2>(gs_config));
+        }
+
         // benefit from dynamic stuff and inheritance by having a method that returns a BaseSolver *
         bool compute_pf(const Eigen::SparseMatrix<cplx_type> & Ybus,  // size (nb_bus, nb_bus)
                         CplxVect & V,  // size nb_bus
@@ -137,6 +177,14 @@ class ChooseSolver
             check_right_solver( "get_J");
             if(_solver_type == SolverType::SparseLU){
                 return _solver_lu.get_J();}
+            else if(_solver_type == SolverType::DenseLU){
+                return _solver_denselu.get_J();}
+            else if(_solver_type == SolverType::DenseLUSingleSlack){
+                return _solver_denselu_single.get_J();}
+            else if(_solver_type == SolverType::BiCGSTAB){
+                return _solver_bicgstab.get_J();}
+            else if(_solver_type == SolverType::BiCGSTABSingleSlack){
+                return _solver_bicgstab_single.get_J();}
             #ifdef KLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::KLU){
                 return _solver_klu.get_J();}
@@ -151,10 +199,12 @@ class ChooseSolver
             #endif // NICSLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::GaussSeidel){
                 throw std::runtime_error("ChooseSolver::get_J: There is not Jacobian matrix for the GaussSeidel powerflow.");}
-            else if(_solver_type == SolverType::DC){
+            else if((_solver_type == SolverType::DC) || (_solver_type == SolverType::DenseLUDC) || (_solver_type == SolverType::BiCGSTABDC) || (_solver_type == SolverType::LDLTDC)){
                 throw std::runtime_error("ChooseSolver::get_J: There is not Jacobian matrix for the DC powerflow.");}
             else if(_solver_type == SolverType::GaussSeidelSynch){
                 throw std::runtime_error("ChooseSolver::get_J: There is not Jacobian matrix for the GaussSeidelSynch powerflow.");}
+            else if(_solver_type == SolverType::GaussSeidelColored){
+                throw std::runtime_error("ChooseSolver::get_J: There is not Jacobian matrix for the GaussSeidelColored powerflow.");}
             else throw std::runtime_error("Unknown solver type encountered");
         }
 
@@ -185,6 +235,76 @@ class ChooseSolver
             return p_solver -> converged();
         }
 
+        // solves (in place) M.X = B using the last factorization computed by the solver (see BaseSolver::solve_many)
+        ErrorType solve_many(Eigen::Ref<RealMatRhs> B, int nb_thread){
+            auto p_solver = get_prt_solver("solve_many", true);
+            return p_solver -> solve_many(B, nb_thread);
+        }
+
+        // KLU settings (applied to all the KLU based solvers, that are reset)
+        void set_klu_config(const KLUSolverConfig & config){
+            #ifdef KLU_SOLVER_AVAILABLE
+                _solver_klu.get_linear_solver().set_config(config);
+                _solver_klu_single.get_linear_solver().set_config(config);
+                _solver_klu_dc.get_linear_solver().set_config(config);
+                _solver_klu.reset();
+                _solver_klu_single.reset();
+                _solver_klu_dc.reset();
+            #else
+                throw std::runtime_error("ChooseSolver::set_klu_config: KLU solver is not available on your platform.");
+            #endif  // KLU_SOLVER_AVAILABLE
+        }
+        KLUSolverConfig get_klu_config() const{
+            #ifdef KLU_SOLVER_AVAILABLE
+                return _solver_klu.get_linear_solver().get_config();
+            #else
+                throw std::runtime_error("ChooseSolver::get_klu_config: KLU solver is not available on your platform.");
+            #endif  // KLU_SOLVER_AVAILABLE
+        }
+        KLUSolverStats get_klu_stats() const{
+            #ifdef KLU_SOLVER_AVAILABLE
+            if(_solver_type == SolverType::KLU){
+                return _solver_klu.get_linear_solver().get_stats();}
+            else if(_solver_type == SolverType::KLUSingleSlack){
+                return _solver_klu_single.get_linear_solver().get_stats();}
+            else if(_solver_type == SolverType::KLUDC){
+                return _solver_klu_dc.get_linear_solver().get_stats();}
+            else throw std::runtime_error("ChooseSolver::get_klu_stats: the solver currently used is not based on KLU.");
+            #else
+                throw std::runtime_error("ChooseSolver::get_klu_stats: KLU solver is not available on your platform.");
+            #endif  // KLU_SOLVER_AVAILABLE
+        }
+
+        // GaussSeidelColored settings (see GaussSeidelColoredSolver::set_nb_thread and GaussSeidelColoredSolver::set_sor)
+        void set_gauss_seidel_colored_config(int nb_thread, real_type omega, bool adaptive){
+            // nothing is changed if one of the settings is not valid
+            const auto previous = get_gauss_seidel_colored_config();
+            try{
+                _solver_gaussseidelcolored.set_nb_thread(nb_thread);
+                _solver_gaussseidelcolored.set_sor(omega, adaptive);
+            }catch(...){
+                _solver_gaussseidelcolored.set_nb_thread(std::get<0>(previous));
+                _solver_gaussseidelcolored.set_sor(std::get<1>(previous), std::get<2>(previous));
+                throw;
+            }
+        }
+        std::tuple<int, real_type, bool> get_gauss_seidel_colored_config() const{
+            const auto sor = _solver_gaussseidelcolored.get_sor();
+            return std::tuple<int, real_type, bool>(_solver_gaussseidelcolored.get_nb_thread(), std::get<0>(sor), std::get<1>(sor));
+        }
+
+        /** python does not own the results, so a copy is made here **/
+        RealMatRhs solve_many_python(const Eigen::Ref<const RealMatRhs> & B, int nb_thread){
+            RealMatRhs res = B;
+            const ErrorType err = solve_many(res, nb_thread);
+            if(err != ErrorType::NoError){
+                std::ostringstream exc_;
+                exc_ << "ChooseSolver::solve_many: the linear solver failed to solve the systems (error " << static_cast<int>(err) << ").";
+                throw std::runtime_error(exc_.str());
+            }
+            return res;
+        }
+
     private:
         void check_right_solver(const std::string & error_msg) const
         {
@@ -227,6 +347,13 @@ class ChooseSolver
             if(_solver_type == SolverType::SparseLU){res = &_solver_lu;}
             else if(_solver_type == SolverType::SparseLUSingleSlack){res = &_solver_lu_single;}
             else if(_solver_type == SolverType::DC){res = &_solver_dc;}
+            else if(_solver_type == SolverType::DenseLU){res = &_solver_denselu;}
+            else if(_solver_type == SolverType::DenseLUSingleSlack){res = &_solver_denselu_single;}
+            else if(_solver_type == SolverType::DenseLUDC){res = &_solver_denselu_dc;}
+            else if(_solver_type == SolverType::BiCGSTAB){res = &_solver_bicgstab;}
+            else if(_solver_type == SolverType::BiCGSTABSingleSlack){res = &_solver_bicgstab_single;}
+            else if(_solver_type == SolverType::BiCGSTABDC){res = &_solver_bicgstab_dc;}
+            else if(_solver_type == SolverType::LDLTDC){res = &_solver_ldlt_dc;}
             #ifdef KLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::KLU){res = & _solver_klu;}
             else if(_solver_type == SolverType::KLUSingleSlack){res = &_solver_klu_single;}
@@ -239,6 +366,7 @@ class ChooseSolver
             #endif // NICSLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::GaussSeidel){res = &_solver_gaussseidel;}
             else if(_solver_type == SolverType::GaussSeidelSynch){res = &_solver_gaussseidelsynch;}
+            else if(_solver_type == SolverType::GaussSeidelColored){res = &_solver_gaussseidelcolored;}
             else throw std::runtime_error("Unknown solver type encountered");
             return res;
         }
@@ -248,6 +376,13 @@ class ChooseSolver
             if(_solver_type == SolverType::SparseLU){res = &_solver_lu;}
             else if(_solver_type == SolverType::SparseLUSingleSlack){res = &_solver_lu_single;}
             else if(_solver_type == SolverType::DC){res = &_solver_dc;}
+            else if(_solver_type == SolverType::DenseLU){res = &_solver_denselu;}
+            else if(_solver_type == SolverType::DenseLUSingleSlack){res = &_solver_denselu_single;}
+            else if(_solver_type == SolverType::DenseLUDC){res = &_solver_denselu_dc;}
+            else if(_solver_type == SolverType::BiCGSTAB){res = &_solver_bicgstab;}
+            else if(_solver_type == SolverType::BiCGSTABSingleSlack){res = &_solver_bicgstab_single;}
+            else if(_solver_type == SolverType::BiCGSTABDC){res = &_solver_bicgstab_dc;}
+            else if(_solver_type == SolverType::LDLTDC){res = &_solver_ldlt_dc;}
             #ifdef KLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::KLU){res = & _solver_klu;}
             else if(_solver_type == SolverType::KLUSingleSlack){res = &_solver_klu_single;}
@@ -260,6 +395,7 @@ class ChooseSolver
             #endif // NICSLU_SOLVER_AVAILABLE
             else if(_solver_type == SolverType::GaussSeidel){res = &_solver_gaussseidel;}
             else if(_solver_type == SolverType::GaussSeidelSynch){res = &_solver_gaussseidelsynch;}
+            else if(_solver_type == SolverType::GaussSeidelColored){res = &_solver_gaussseidelcolored;}
             else throw std::runtime_error("Unknown solver type encountered");
             return res;
         }
@@ -271,8 +407,16 @@ class ChooseSolver
         // TODO have a way to use Union here https://en.cppreference.com/w/cpp/language/union
         SparseLUSolver _solver_lu;
         SparseLUSolverSingleSlack _solver_lu_single;
+        DenseLUSolver _solver_denselu;
+        DenseLUSolverSingleSlack _solver_denselu_single;
+        DenseLUDCSolver _solver_denselu_dc;
+        BiCGSTABSolver _solver_bicgstab;
+        BiCGSTABSolverSingleSlack _solver_bicgstab_single;
+        BiCGSTABDCSolver _solver_bicgstab_dc;
+        LDLTDCSolver _solver_ldlt_dc;
         GaussSeidelSolver _solver_gaussseidel;
         GaussSeidelSynchSolver _solver_gaussseidelsynch;
+        GaussSeidelColoredSolver _solver_gaussseidelcolored;
         DCSolver _solver_dc;
         #ifdef KLU_SOLVER_AVAILABLE
             KLUSolver _solver_klu;
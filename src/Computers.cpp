@@ -10,13 +10,44 @@
 #include <iostream>
 #include <sstream>
 
-int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
-                          Eigen::Ref<const RealMat> sgen_p,
-                          Eigen::Ref<const RealMat> load_p,
-                          Eigen::Ref<const RealMat> load_q,
-                          const CplxVect & Vinit,
-                          const int max_iter,
-                          const real_type tol)
+void Computers::start_compute_Vs(Eigen::Ref<const RealMat> gen_p,
+                                 Eigen::Ref<const RealMat> sgen_p,
+                                 Eigen::Ref<const RealMat> load_p,
+                                 Eigen::Ref<const RealMat> load_q,
+                                 const CplxVect & Vinit,
+                                 const int max_iter,
+                                 const real_type tol,
+                                 Eigen::Ref<const RealMat> gen_v,
+                                 Eigen::Ref<const RealMat> sgen_q,
+                                 Eigen::Ref<const RealMat> storage_p,
+                                 Eigen::Ref<const RealMat> storage_q,
+                                 Eigen::Ref<const RealMat> shunt_p,
+                                 Eigen::Ref<const RealMat> shunt_q)
+{
+    // the data are copied: they might not exist anymore when the computation is performed
+    const RealMat gen_p_ = gen_p, sgen_p_ = sgen_p, load_p_ = load_p, load_q_ = load_q;
+    const RealMat gen_v_ = gen_v, sgen_q_ = sgen_q, storage_p_ = storage_p, storage_q_ = storage_q;
+    const RealMat shunt_p_ = shunt_p, shunt_q_ = shunt_q;
+    const CplxVect Vinit_ = Vinit;
+    start_job("start_compute_Vs", [=](){
+        run_compute_Vs(gen_p_, sgen_p_, load_p_, load_q_, Vinit_, max_iter, tol,
+                       gen_v_, sgen_q_, storage_p_, storage_q_, shunt_p_, shunt_q_);
+    });
+}
+
+int Computers::run_compute_Vs(Eigen::Ref<const RealMat> gen_p,
+                              Eigen::Ref<const RealMat> sgen_p,
+                              Eigen::Ref<const RealMat> load_p,
+                              Eigen::Ref<const RealMat> load_q,
+                              const CplxVect & Vinit,
+                              const int max_iter,
+                              const real_type tol,
+                              Eigen::Ref<const RealMat> gen_v,
+                              Eigen::Ref<const RealMat> sgen_q,
+                              Eigen::Ref<const RealMat> storage_p,
+                              Eigen::Ref<const RealMat> storage_q,
+                              Eigen::Ref<const RealMat> shunt_p,
+                              Eigen::Ref<const RealMat> shunt_q)
 {
     auto timer = CustTimer();
     const Eigen::Index nb_total_bus = _grid_model.total_bus();
@@ -34,19 +65,40 @@ int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
     _timer_pre_proc = 0.;
     _timer_total = 0.;
     _timer_solver = 0.;
+    reset_progress();
 
     auto timer_preproc = CustTimer();
     const auto & sn_mva = _grid_model.get_sn_mva();
     Eigen::SparseMatrix<cplx_type> Ybus = _grid_model.get_Ybus(); 
     const auto & id_me_to_ac_solver = _grid_model.id_me_to_ac_solver();
-    const auto & id_ac_solver_to_me = _grid_model.id_ac_solver_to_me();
     const auto & generators = _grid_model.get_generators_as_data();
     const auto & s_generators = _grid_model.get_static_generators_as_data();
     const auto & loads = _grid_model.get_loads_as_data();
+    const auto & storages = _grid_model.get_storages_as_data();
+    const auto & shunts = _grid_model.get_shunts_as_data();
 
     const Eigen::Index nb_steps = gen_p.rows();
     const Eigen::Index nb_buses_solver = Ybus.cols();  // which is equal to Ybus.rows();
 
+    // optional inputs (empty matrix = not used)
+    const bool use_gen_v = check_temporal_data("gen_v", gen_v, nb_steps, generators.nb());
+    const bool use_sgen_q = check_temporal_data("sgen_q", sgen_q, nb_steps, s_generators.nb());
+    const bool use_storage_p = check_temporal_data("storage_p", storage_p, nb_steps, storages.nb());
+    const bool use_storage_q = check_temporal_data("storage_q", storage_q, nb_steps, storages.nb());
+    const bool use_shunt_p = check_temporal_data("shunt_p", shunt_p, nb_steps, shunts.nb());
+    const bool use_shunt_q = check_temporal_data("shunt_q", shunt_q, nb_steps, shunts.nb());
+
+    // shunts are part of Ybus, i keep track of the values currently used there
+    RealVect shunt_p_applied = RealVect::Zero(shunts.nb());
+    RealVect shunt_q_applied = RealVect::Zero(shunts.nb());
+    if(use_shunt_p || use_shunt_q){
+        for(int sh_id = 0; sh_id < shunts.nb(); ++sh_id){
+            const auto & sh_info = shunts[sh_id];
+            shunt_p_applied(sh_id) = sh_info.target_p_mw;
+            shunt_q_applied(sh_id) = sh_info.target_q_mvar;
+        }
+    }
+
     const Eigen::VectorXi & bus_pv = _grid_model.get_pv();
     const Eigen::VectorXi & bus_pq = _grid_model.get_pq();
     const Eigen::VectorXi & slack_ids = _grid_model.get_slack_ids();
@@ -63,6 +115,10 @@ int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
     add_ = false;
     fill_SBus_real(_Sbuses, loads, load_p, id_me_to_ac_solver, add_);
     fill_SBus_imag(_Sbuses, loads, load_q, id_me_to_ac_solver, add_);
+    if(use_storage_p) fill_SBus_real(_Sbuses, storages, storage_p, id_me_to_ac_solver, add_);
+    if(use_storage_q) fill_SBus_imag(_Sbuses, storages, storage_q, id_me_to_ac_solver, add_);
+    add_ = true;
+    if(use_sgen_q) fill_SBus_imag(_Sbuses, s_generators, sgen_q, id_me_to_ac_solver, add_);
     if(sn_mva != 1.0) _Sbuses.array() /= static_cast<cplx_type>(sn_mva);
 
     // init the results matrices
@@ -80,7 +136,17 @@ int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
     Eigen::Index step_diverge = -1;
     const real_type tol_ = tol / sn_mva; 
     for(Eigen::Index i = 0; i < nb_steps; ++i){
+        if(is_cancelled()){
+            // the computation has been stopped by the user (see `cancel()`)
+            _timer_total = timer.duration();
+            return _status;
+        }
         conv = false;
+        if(use_gen_v) set_vm_from_gen_v(V, generators, gen_v, i, id_me_to_ac_solver);
+        if(use_shunt_p || use_shunt_q){
+            update_Ybus_shunts(Ybus, shunt_p, shunt_q, use_shunt_p, use_shunt_q, i,
+                               shunt_p_applied, shunt_q_applied, id_me_to_ac_solver, sn_mva);
+        }
         conv = compute_one_powerflow(Ybus,
                                      V, 
                                      _Sbuses.row(i),
@@ -90,11 +156,12 @@ int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
                                      bus_pq,
                                      max_iter,
                                      tol_);
+        update_progress(conv);
         if(!conv){
             _timer_total = timer.duration();
             return _status;
         }
-        if(conv && step_diverge < 0) _voltages.row(i)(id_ac_solver_to_me) = V.array();
+        if(conv && step_diverge < 0) set_voltages_from_Vsolver(i, V, id_me_to_ac_solver);
         else step_diverge = i;
     }
     if(step_diverge > 0){
@@ -107,3 +174,36 @@ int Computers::compute_Vs(Eigen::Ref<const RealMat> gen_p,
     _timer_total = timer.duration();
     return _status;
 }
+
+void Computers::update_Ybus_shunts(Eigen::SparseMatrix<cplx_type> & Ybus,
+                                   const Eigen::Ref<const RealMat> & shunt_p,
+                                   const Eigen::Ref<const RealMat> & shunt_q,
+                                   bool use_shunt_p,
+                                   bool use_shunt_q,
+                                   Eigen::Index step,
+                                   RealVect & shunt_p_applied,
+                                   RealVect & shunt_q_applied,
+                                   const std::vector<int> & id_me_to_ac_solver,
+                                   real_type sn_mva) const
+{
+    const auto & shunts = _grid_model.get_shunts_as_data();
+    const auto nb_shunt = shunts.nb();
+    const auto & el_status = shunts.get_status();
+    const auto & el_bus_id = shunts.get_bus_id();
+    int bus_id_solver;
+    for(Eigen::Index sh_id = 0; sh_id < nb_shunt; ++sh_id){
+        if(!el_status[sh_id]) continue;
+        const real_type new_p = use_shunt_p ? shunt_p(step, sh_id) : shunt_p_applied(sh_id);
+        const real_type new_q = use_shunt_q ? shunt_q(step, sh_id) : shunt_q_applied(sh_id);
+        if((new_p == shunt_p_applied(sh_id)) && (new_q == shunt_q_applied(sh_id))) continue;
+
+        // same convention as in DataShunt::fillYbus: ybus_diag -= (p + j.q) / sn_mva
+        cplx_type delta = {new_p - shunt_p_applied(sh_id), new_q - shunt_q_applied(sh_id)};
+        if(sn_mva != 1.) delta /= sn_mva;
+        bus_id_solver = id_me_to_ac_solver[el_bus_id(sh_id)];
+        // the diagonal coefficient is always in Ybus for connected shunt (see DataShunt::fillYbus)
+        Ybus.coeffRef(bus_id_solver, bus_id_solver) -= delta;
+        shunt_p_applied(sh_id) = new_p;
+        shunt_q_applied(sh_id) = new_q;
+    }
+}
@@ -29,6 +29,8 @@ class Computers: public BaseMultiplePowerflow
 
         Computers(const Computers&) = delete;
 
+        ~Computers() {stop_job();}  // the job uses this object, it needs to be stopped before anything is destroyed
+
         // control on whether I compute the flows or not
         void deactivate_flow_computations() {_compute_flows = false;}
         void activate_flow_computations() {_compute_flows = true;}
@@ -38,13 +40,17 @@ class Computers: public BaseMultiplePowerflow
         double preprocessing_time() const {return _timer_pre_proc;}
 
         // status
-        int get_status() const {return _status;}
+        int get_status() const {check_no_job("get_status"); return _status;}
 
         /**
         This function computes the results of running as many powerflow when varying the 
         injection (Sbus). 
 
         Each line of `Sbuses` will be a time step, and each column with 
+
+        The last 6 matrices (gen_v, sgen_q, storage_p, storage_q, shunt_p and shunt_q) are optional: if they are empty (size 0)
+        the value stored in the grid model is used for every step (for shunts and generators voltage setpoint) or
+        they are not taken into account (for sgen_q and storage units).
         **/
         int compute_Vs(Eigen::Ref<const RealMat> gen_p,
                        Eigen::Ref<const RealMat> sgen_p,
@@ -52,9 +58,41 @@ class Computers: public BaseMultiplePowerflow
                        Eigen::Ref<const RealMat> load_q,
                        const CplxVect & Vinit,
                        const int max_iter,
-                       const real_type tol);
+                       const real_type tol,
+                       Eigen::Ref<const RealMat> gen_v,
+                       Eigen::Ref<const RealMat> sgen_q,
+                       Eigen::Ref<const RealMat> storage_p,
+                       Eigen::Ref<const RealMat> storage_q,
+                       Eigen::Ref<const RealMat> shunt_p,
+                       Eigen::Ref<const RealMat> shunt_q){
+            check_no_job("compute_Vs");
+            _cancel_requested.store(false);
+            return run_compute_Vs(gen_p, sgen_p, load_p, load_q, Vinit, max_iter, tol,
+                                  gen_v, sgen_q, storage_p, storage_q, shunt_p, shunt_q);
+        }
 
-        Eigen::Ref<const CplxMat > get_sbuses() const {return _Sbuses;}
+        /**
+        Same as `compute_Vs` but the computation is performed in a separate thread. This function returns
+        immediately (the input data are copied).
+
+        The progress can be followed with `get_progress()`, the computation can be stopped with `cancel()` and
+        `wait()` waits for the computation to be over. The results can be retrieved (as usual) once it is over.
+        **/
+        void start_compute_Vs(Eigen::Ref<const RealMat> gen_p,
+                              Eigen::Ref<const RealMat> sgen_p,
+                              Eigen::Ref<const RealMat> load_p,
+                              Eigen::Ref<const RealMat> load_q,
+                              const CplxVect & Vinit,
+                              const int max_iter,
+                              const real_type tol,
+                              Eigen::Ref<const RealMat> gen_v,
+                              Eigen::Ref<const RealMat> sgen_q,
+                              Eigen::Ref<const RealMat> storage_p,
+                              Eigen::Ref<const RealMat> storage_q,
+                              Eigen::Ref<const RealMat> shunt_p,
+                              Eigen::Ref<const RealMat> shunt_q);
+
+        Eigen::Ref<const CplxMat > get_sbuses() const {check_no_job("get_sbuses"); return _Sbuses;}
         Eigen::Ref<const RealMat > compute_flows() {
             compute_flows_from_Vs();
             return _amps_flows;
@@ -65,6 +103,84 @@ class Computers: public BaseMultiplePowerflow
         }
 
     protected:
+        // perform the computation of `compute_Vs` (used both when it is synchronous or in a separate thread)
+        int run_compute_Vs(Eigen::Ref<const RealMat> gen_p,
+                           Eigen::Ref<const RealMat> sgen_p,
+                           Eigen::Ref<const RealMat> load_p,
+                           Eigen::Ref<const RealMat> load_q,
+                           const CplxVect & Vinit,
+                           const int max_iter,
+                           const real_type tol,
+                           Eigen::Ref<const RealMat> gen_v,
+                           Eigen::Ref<const RealMat> sgen_q,
+                           Eigen::Ref<const RealMat> storage_p,
+                           Eigen::Ref<const RealMat> storage_q,
+                           Eigen::Ref<const RealMat> shunt_p,
+                           Eigen::Ref<const RealMat> shunt_q);
+
+        /**
+        Check that the temporal data (if provided) have the right shape. It returns `false` if the data are empty (not provided)
+        and `true` otherwise.
+        **/
+        bool check_temporal_data(const std::string & data_name,
+                                 const Eigen::Ref<const RealMat> & temporal_data,
+                                 Eigen::Index nb_steps,
+                                 Eigen::Index nb_el) const 
+        {
+            if(temporal_data.size() == 0) return false;
+            if((temporal_data.rows() != nb_steps) || (temporal_data.cols() != nb_el)){
+                std::ostringstream exc_;
+                exc_ << "Computers::compute_Vs: wrong shape for " << data_name << ". It should have ";
+                exc_ << nb_steps << " rows (one per step) and " << nb_el << " columns (one per element) but it has ";
+                exc_ << temporal_data.rows() << " rows and " << temporal_data.cols() << " columns.";
+                throw std::runtime_error(exc_.str());
+            }
+            return true;
+        }
+
+        /**
+        Set the voltage magnitude of the buses where a generator is connected, at the given step,
+        in the same way as DataGen::set_vm does (only the magnitude is changed, the angle is kept)
+        **/
+        void set_vm_from_gen_v(CplxVect & V,
+                               const DataGen & generators,
+                               const Eigen::Ref<const RealMat> & gen_v,
+                               Eigen::Index step,
+                               const std::vector<int> & id_me_to_ac_solver) const
+        {
+            const auto nb_gen = generators.nb();
+            const auto & el_status = generators.get_status();
+            const auto & el_bus_id = generators.get_bus_id();
+            int bus_id_solver;
+            for(Eigen::Index gen_id = 0; gen_id < nb_gen; ++gen_id){
+                if(!el_status[gen_id]) continue;
+                bus_id_solver = id_me_to_ac_solver[el_bus_id(gen_id)];
+                real_type tmp = std::abs(V(bus_id_solver));
+                if(tmp == 0.)
+                {
+                    V(bus_id_solver) = 1.0;
+                    tmp = 1.0;
+                }
+                V(bus_id_solver) *= gen_v(step, gen_id) / tmp;
+            }
+        }
+
+        /**
+        Update the diagonal coefficients of Ybus to reflect the shunts values at the given step.
+        `shunt_p_applied` and `shunt_q_applied` store the values currently in Ybus (they are updated by this function).
+        It supposes the diagonal coefficients are already in Ybus, so the sparsity pattern is never modified.
+        **/
+        void update_Ybus_shunts(Eigen::SparseMatrix<cplx_type> & Ybus,
+                                const Eigen::Ref<const RealMat> & shunt_p,
+                                const Eigen::Ref<const RealMat> & shunt_q,
+                                bool use_shunt_p,
+                                bool use_shunt_q,
+                                Eigen::Index step,
+                                RealVect & shunt_p_applied,
+                                RealVect & shunt_q_applied,
+                                const std::vector<int> & id_me_to_ac_solver,
+                                real_type sn_mva) const;
+
         template<class T>
         void fill_SBus_real(CplxMat & Sbuses,
                             const T & structure_data,
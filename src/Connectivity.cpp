@@ -0,0 +1,278 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "Connectivity.h"
+
+#include <algorithm>
+#include <numeric>  // std::iota
+
+const int Connectivity::_deactivated_bus_id = -1;
+
+void Connectivity::init(int nb_bus, const std::vector<int> & branch_from, const std::vector<int> & branch_to)
+{
+    if(branch_from.size() != branch_to.size()){
+        std::ostringstream exc_;
+        exc_ << "Connectivity::init: there are " << branch_from.size() << " \"from\" buses but ";
+        exc_ << branch_to.size() << " \"to\" buses.";
+        throw std::runtime_error(exc_.str());
+    }
+    parent_ = std::vector<int>(nb_bus);
+    rank_ = std::vector<int>(nb_bus);
+    branch_from_ = branch_from;
+    branch_to_ = branch_to;
+    initialized_ = true;
+    for(std::size_t branch_id = 0; branch_id < branch_from_.size(); ++branch_id){
+        check_bus("init", branch_from_[branch_id]);
+        check_bus("init", branch_to_[branch_id]);
+        if(branch_from_[branch_id] == _deactivated_bus_id || branch_to_[branch_id] == _deactivated_bus_id){
+            branch_from_[branch_id] = _deactivated_bus_id;
+            branch_to_[branch_id] = _deactivated_bus_id;
+        }
+    }
+    need_rebuild_ = true;
+    tarjan_ok_ = false;
+}
+
+void Connectivity::clear()
+{
+    initialized_ = false;
+    need_rebuild_ = true;
+    tarjan_ok_ = false;
+    branch_from_.clear();
+    branch_to_.clear();
+    parent_.clear();
+    rank_.clear();
+    bridges_.clear();
+    articulation_points_.clear();
+}
+
+void Connectivity::check_branch(const char * fun_name, int branch_id) const
+{
+    if(branch_id < 0 || branch_id >= static_cast<int>(branch_from_.size())){
+        std::ostringstream exc_;
+        exc_ << "Connectivity::" << fun_name << ": branch " << branch_id << " does not exist (there are ";
+        exc_ << branch_from_.size() << " branches).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void Connectivity::check_bus(const char * fun_name, int bus_id) const
+{
+    if(bus_id == _deactivated_bus_id) return;
+    if(bus_id < 0 || bus_id >= static_cast<int>(parent_.size())){
+        std::ostringstream exc_;
+        exc_ << "Connectivity::" << fun_name << ": bus " << bus_id << " does not exist (there are ";
+        exc_ << parent_.size() << " buses).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void Connectivity::set_branch(int branch_id, int bus_from, int bus_to)
+{
+    check_init("set_branch");
+    check_branch("set_branch", branch_id);
+    check_bus("set_branch", bus_from);
+    check_bus("set_branch", bus_to);
+    if(bus_from == _deactivated_bus_id || bus_to == _deactivated_bus_id){
+        bus_from = _deactivated_bus_id;
+        bus_to = _deactivated_bus_id;
+    }
+    int & my_from = branch_from_[branch_id];
+    int & my_to = branch_to_[branch_id];
+    if(my_from == bus_from && my_to == bus_to) return;
+
+    // the previous edge is removed: the components change only if it was a bridge
+    const bool was_edge = (my_from != _deactivated_bus_id) && (my_from != my_to);
+    if(was_edge && !(tarjan_ok_ && !bridges_[branch_id])) need_rebuild_ = true;
+    tarjan_ok_ = false;
+
+    my_from = bus_from;
+    my_to = bus_to;
+    // the new one is added (if the union-find is rebuilt, it will be taken into account there)
+    if(!need_rebuild_ && bus_from != _deactivated_bus_id) unite(bus_from, bus_to);
+}
+
+int Connectivity::find(int bus_id)
+{
+    check_init("find");
+    check_bus("find", bus_id);
+    if(bus_id == _deactivated_bus_id){
+        std::ostringstream exc_;
+        exc_ << "Connectivity::find: bus " << bus_id << " does not exist.";
+        throw std::runtime_error(exc_.str());
+    }
+    rebuild();
+    // path halving
+    while(parent_[bus_id] != bus_id){
+        parent_[bus_id] = parent_[parent_[bus_id]];
+        bus_id = parent_[bus_id];
+    }
+    return bus_id;
+}
+
+void Connectivity::unite(int bus_1_id, int bus_2_id)
+{
+    // union by rank, the structure is up to date when this is called
+    while(parent_[bus_1_id] != bus_1_id) bus_1_id = parent_[bus_1_id] = parent_[parent_[bus_1_id]];
+    while(parent_[bus_2_id] != bus_2_id) bus_2_id = parent_[bus_2_id] = parent_[parent_[bus_2_id]];
+    if(bus_1_id == bus_2_id) return;
+    if(rank_[bus_1_id] < rank_[bus_2_id]) std::swap(bus_1_id, bus_2_id);
+    parent_[bus_2_id] = bus_1_id;
+    if(rank_[bus_1_id] == rank_[bus_2_id]) ++rank_[bus_1_id];
+}
+
+void Connectivity::rebuild()
+{
+    if(!need_rebuild_) return;
+    std::iota(parent_.begin(), parent_.end(), 0);
+    std::fill(rank_.begin(), rank_.end(), 0);
+    const int nb_branch = static_cast<int>(branch_from_.size());
+    for(int branch_id = 0; branch_id < nb_branch; ++branch_id){
+        if(branch_from_[branch_id] == _deactivated_bus_id) continue;
+        unite(branch_from_[branch_id], branch_to_[branch_id]);
+    }
+    need_rebuild_ = false;
+}
+
+std::vector<int> Connectivity::get_components(const std::vector<bool> & bus_status)
+{
+    check_init("get_components");
+    const int nb_bus = static_cast<int>(parent_.size());
+    if(static_cast<int>(bus_status.size()) != nb_bus){
+        std::ostringstream exc_;
+        exc_ << "Connectivity::get_components: the status of " << bus_status.size() << " buses is given but ";
+        exc_ << "there are " << nb_bus << " buses.";
+        throw std::runtime_error(exc_.str());
+    }
+    std::vector<int> res(nb_bus, -1);
+    std::vector<int> root_label(nb_bus, -1);
+    int nb_label = 0;
+    for(int bus_id = 0; bus_id < nb_bus; ++bus_id){
+        if(!bus_status[bus_id]) continue;
+        int & label = root_label[find(bus_id)];
+        if(label == -1) label = nb_label++;
+        res[bus_id] = label;
+    }
+    return res;
+}
+
+int Connectivity::nb_components(const std::vector<bool> & bus_status)
+{
+    const std::vector<int> components = get_components(bus_status);
+    int res = 0;
+    for(auto label : components) res = std::max(res, label + 1);
+    return res;
+}
+
+void Connectivity::compute_bridges()
+{
+    check_init("compute_bridges");
+    if(tarjan_ok_) return;
+    const int nb_bus = static_cast<int>(parent_.size());
+    const int nb_branch = static_cast<int>(branch_from_.size());
+    bridges_ = std::vector<bool>(nb_branch, false);
+    articulation_points_ = std::vector<bool>(nb_bus, false);
+
+    // adjacency (in "compressed" format), the branch id is kept so that parallel branches are not bridges
+    std::vector<int> adj_start(nb_bus + 1, 0);
+    for(int branch_id = 0; branch_id < nb_branch; ++branch_id){
+        const int bus_from = branch_from_[branch_id];
+        const int bus_to = branch_to_[branch_id];
+        if(bus_from == _deactivated_bus_id || bus_from == bus_to) continue;
+        ++adj_start[bus_from + 1];
+        ++adj_start[bus_to + 1];
+    }
+    for(int bus_id = 0; bus_id < nb_bus; ++bus_id) adj_start[bus_id + 1] += adj_start[bus_id];
+    std::vector<int> adj_bus(adj_start[nb_bus]);
+    std::vector<int> adj_branch(adj_start[nb_bus]);
+    std::vector<int> next_pos(adj_start.begin(), adj_start.end() - 1);
+    for(int branch_id = 0; branch_id < nb_branch; ++branch_id){
+        const int bus_from = branch_from_[branch_id];
+        const int bus_to = branch_to_[branch_id];
+        if(bus_from == _deactivated_bus_id || bus_from == bus_to) continue;
+        adj_bus[next_pos[bus_from]] = bus_to;
+        adj_branch[next_pos[bus_from]++] = branch_id;
+        adj_bus[next_pos[bus_to]] = bus_from;
+        adj_branch[next_pos[bus_to]++] = branch_id;
+    }
+
+    // depth first search, with an explicit stack
+    std::vector<int> disc(nb_bus, -1);  // "time" of discovery of each bus
+    std::vector<int> low(nb_bus, -1);  // lowest discovery time reachable from the subtree of each bus
+    std::vector<int> parent_branch(nb_bus, -1);
+    std::vector<int> stack;
+    stack.reserve(nb_bus);
+    std::copy(adj_start.begin(), adj_start.end() - 1, next_pos.begin());
+    int timer = 0;
+    for(int root = 0; root < nb_bus; ++root){
+        if(disc[root] != -1) continue;
+        int nb_root_children = 0;
+        disc[root] = low[root] = timer++;
+        stack.push_back(root);
+        while(!stack.empty()){
+            const int bus_id = stack.back();
+            if(next_pos[bus_id] < adj_start[bus_id + 1]){
+                const int pos = next_pos[bus_id]++;
+                const int neighbor = adj_bus[pos];
+                const int branch_id = adj_branch[pos];
+                if(branch_id == parent_branch[bus_id]) continue;
+                if(disc[neighbor] == -1){
+                    parent_branch[neighbor] = branch_id;
+                    disc[neighbor] = low[neighbor] = timer++;
+                    stack.push_back(neighbor);
+                    if(bus_id == root) ++nb_root_children;
+                }else{
+                    low[bus_id] = std::min(low[bus_id], disc[neighbor]);
+                }
+            }else{
+                // all the neighbors of this bus have been visited
+                stack.pop_back();
+                if(stack.empty()) break;
+                const int parent = stack.back();
+                low[parent] = std::min(low[parent], low[bus_id]);
+                if(low[bus_id] > disc[parent]) bridges_[parent_branch[bus_id]] = true;
+                if(parent != root && low[bus_id] >= disc[parent]) articulation_points_[parent] = true;
+            }
+        }
+        if(nb_root_children > 1) articulation_points_[root] = true;
+    }
+    tarjan_ok_ = true;
+}
+
+bool Connectivity::is_islanding(const std::vector<int> & branch_ids)
+{
+    check_init("is_islanding");
+    for(auto branch_id : branch_ids) check_branch("is_islanding", branch_id);
+    compute_bridges();
+    for(auto branch_id : branch_ids){
+        if(bridges_[branch_id]) return true;
+    }
+    if(branch_ids.size() <= 1) return false;
+
+    // none of the branches is a bridge, but together they might split a component: the union-find is computed
+    // without them, the component is split if (and only if) the two buses of one of them are not connected anymore
+    std::vector<bool> removed(branch_from_.size(), false);
+    for(auto branch_id : branch_ids) removed[branch_id] = true;
+    const int nb_bus = static_cast<int>(parent_.size());
+    std::vector<int> parent(nb_bus);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto my_find = [&parent](int bus_id){
+        while(parent[bus_id] != bus_id) bus_id = parent[bus_id] = parent[parent[bus_id]];
+        return bus_id;
+    };
+    const int nb_branch = static_cast<int>(branch_from_.size());
+    for(int branch_id = 0; branch_id < nb_branch; ++branch_id){
+        if(removed[branch_id] || branch_from_[branch_id] == _deactivated_bus_id) continue;
+        parent[my_find(branch_from_[branch_id])] = my_find(branch_to_[branch_id]);
+    }
+    for(auto branch_id : branch_ids){
+        if(branch_from_[branch_id] == _deactivated_bus_id) continue;
+        if(my_find(branch_from_[branch_id]) != my_find(branch_to_[branch_id])) return true;
+    }
+    return false;
+}
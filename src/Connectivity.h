@@ -0,0 +1,102 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+/**
+Connected components of the graph "buses / branches" (powerlines and transformers) of a grid.
+
+The components are maintained incrementally with a union-find structure: connecting a branch (or moving it to other
+buses) merges the two components in almost constant time. A union-find cannot split a component, so the disconnection
+of a branch triggers a rebuild of the structure the next time it is queried, unless the branch is known not to be a
+bridge (see below) in which case the components do not change.
+
+The bridges (branches whose disconnection splits a component) and the articulation points (buses whose removal
+splits a component) are computed, with the Tarjan algorithm, for the current topology the first time they are needed
+and kept until the topology changes. The disconnection of a single branch can then be checked in constant time.
+
+The branches are identified by an integer (in GridModel: the powerlines first, then the transformers) and a
+disconnected branch has its two buses equal to `_deactivated_bus_id`.
+**/
+class Connectivity
+{
+    public:
+        static const int _deactivated_bus_id;
+
+        Connectivity():initialized_(false), need_rebuild_(true), tarjan_ok_(false) {}
+
+        // the graph is given entirely (the previous information are discarded)
+        void init(int nb_bus, const std::vector<int> & branch_from, const std::vector<int> & branch_to);
+        bool is_init() const {return initialized_;}
+        // forget the graph, it needs to be given again with "init"
+        void clear();
+
+        // the branch is now connected to bus_from and bus_to (or disconnected if they are `_deactivated_bus_id`)
+        void set_branch(int branch_id, int bus_from, int bus_to);
+
+        // the "root" bus of the component of this bus
+        int find(int bus_id);
+        bool same_component(int bus_1_id, int bus_2_id) {return find(bus_1_id) == find(bus_2_id);}
+
+        /**
+        label (from 0 to nb_components - 1, in the order of the buses) of the component of each bus. Only the buses with
+        a status `true` are considered, the other ones are labelled -1 (and a component with only such buses is
+        ignored).
+        **/
+        std::vector<int> get_components(const std::vector<bool> & bus_status);
+        int nb_components(const std::vector<bool> & bus_status);
+
+        // for each branch, whether its disconnection would split one component
+        const std::vector<bool> & get_bridges() {compute_bridges(); return bridges_;}
+        // for each bus, whether its removal would split one component
+        const std::vector<bool> & get_articulation_points() {compute_bridges(); return articulation_points_;}
+
+        // whether the disconnection of all these branches would split one component
+        bool is_islanding(const std::vector<int> & branch_ids);
+
+    protected:
+        void check_init(const char * fun_name) const{
+            if(!initialized_){
+                std::ostringstream exc_;
+                exc_ << "Connectivity::" << fun_name << ": the graph has not been initialized.";
+                throw std::runtime_error(exc_.str());
+            }
+        }
+        void check_branch(const char * fun_name, int branch_id) const;
+        void check_bus(const char * fun_name, int bus_id) const;
+
+        // compute the union-find from scratch if a branch has been disconnected since the last time
+        void rebuild();
+        void unite(int bus_1_id, int bus_2_id);
+        // Tarjan algorithm (iterative, the grids can be large) on the current topology, if it changed
+        void compute_bridges();
+
+    protected:
+        bool initialized_;
+        bool need_rebuild_;  // a branch has been disconnected, the union-find is not up to date
+        bool tarjan_ok_;  // the bridges and articulation points are the ones of the current topology
+
+        // the graph
+        std::vector<int> branch_from_;
+        std::vector<int> branch_to_;
+
+        // union-find
+        std::vector<int> parent_;
+        std::vector<int> rank_;
+
+        // results of the Tarjan algorithm
+        std::vector<bool> bridges_;
+        std::vector<bool> articulation_points_;
+};
+
+#endif // CONNECTIVITY_H
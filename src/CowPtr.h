@@ -0,0 +1,47 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef COWPTR_H
+#define COWPTR_H
+
+#include <memory>
+
+/**
+"copy on write" pointer, used to share the data that (almost) never change between the copies of a GridModel
+(physical parameters of the elements, model coefficients etc.)
+
+Copying a CowPtr only copies a (reference counted) pointer. The data are read with `operator->` or `get()`
+(that never copy anything) and they must be modified through `mut()` only: the data are cloned at this point
+if (and only if) they are shared with another instance.
+**/
+template<class T>
+class CowPtr
+{
+    public:
+        CowPtr():ptr_(std::make_shared<T>()){}
+
+        const T & get() const {return *ptr_;}
+        const T & operator*() const {return *ptr_;}
+        const T * operator->() const {return ptr_.get();}
+
+        // access to the data for modification, they are cloned first if they are shared
+        T & mut(){
+            if(ptr_.use_count() > 1) ptr_ = std::make_shared<T>(*ptr_);
+            return *ptr_;
+        }
+
+        // whether the data are shared with another instance
+        bool is_shared() const {return ptr_.use_count() > 1;}
+        // whether the data are the same (same address) as the ones of other
+        bool same_data(const CowPtr<T> & other) const {return ptr_ == other.ptr_;}
+
+    private:
+        std::shared_ptr<T> ptr_;
+};
+
+#endif // COWPTR_H
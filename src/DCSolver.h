@@ -15,12 +15,15 @@ template<class LinearSolver>
 class BaseDCSolver: public BaseSolver
 {
     public:
-        BaseDCSolver():BaseSolver(), _linear_solver(), need_factorize_(true){};
+        BaseDCSolver():BaseSolver(), _linear_solver(), need_factorize_(true), dcYbus_(){};
 
         ~BaseDCSolver(){}
 
         virtual void reset();
 
+        // see BaseSolver::copy_state
+        virtual void copy_state(const BaseSolver & other);
+
         // TODO SLACK : this should be handled in Sbus by the gridmodel maybe ?
         virtual
         bool compute_pf(const Eigen::SparseMatrix<cplx_type> & Ybus,
@@ -34,6 +37,21 @@ class BaseDCSolver: public BaseSolver
                         real_type tol
                         );
 
+        virtual
+        ErrorType solve_many(Eigen::Ref<RealMatRhs> B, int nb_thread){
+            if(need_factorize_){
+                std::ostringstream exc_;
+                exc_ << "BaseDCSolver::solve_many: the dc admittance matrix has not been factorized. Have you run a powerflow ";
+                exc_ << "since the last reset?";
+                throw std::runtime_error(exc_.str());
+            }
+            return _solve_many(_linear_solver, dcYbus_, B, nb_thread);
+        }
+
+        // access the underlying linear solver (for example to change its parameters)
+        LinearSolver & get_linear_solver() {return _linear_solver;}
+        const LinearSolver & get_linear_solver() const {return _linear_solver;}
+
     private:
         // no copy allowed
         BaseDCSolver( const BaseSolver & ) =delete ;
@@ -42,6 +60,7 @@ class BaseDCSolver: public BaseSolver
     protected:
         LinearSolver  _linear_solver;
         bool need_factorize_;
+        Eigen::SparseMatrix<real_type> dcYbus_;  // dc admittance matrix (without the slack bus), last matrix factorized
 
 };
 
@@ -26,6 +26,7 @@ bool BaseDCSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
     // V is used the following way: at pq buses it's completely ignored. For pv bus only the magnitude is used,
     //   and for the slack bus both the magnitude and the angle are used.
 
+    err_ = ErrorType::NoError;
     auto timer = CustTimer();
     // std::cout << "entering DCSolver::compute_pf" << std::endl;
     const int nb_bus_solver = static_cast<int>(Ybus.rows());
@@ -34,7 +35,7 @@ bool BaseDCSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
     #ifdef __COUT_TIMES
         auto timer_preproc = CustTimer();
     #endif // __COUT_TIMES
-    Eigen::SparseMatrix<real_type> dcYbus = Eigen::SparseMatrix<real_type>(nb_bus_solver - 1, nb_bus_solver - 1);
+    dcYbus_ = Eigen::SparseMatrix<real_type>(nb_bus_solver - 1, nb_bus_solver - 1);
 
     // Eigen::SparseMatrix<cplx_type> dcYbus_tmp = Ybus;
     // dcYbus_tmp.makeCompressed();
@@ -66,8 +67,8 @@ bool BaseDCSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
             tripletList.push_back(Eigen::Triplet<real_type> (row_res, col_res, std::real(it.value())));
         }
     }
-    dcYbus.setFromTriplets(tripletList.begin(), tripletList.end());
-    dcYbus.makeCompressed();
+    dcYbus_.setFromTriplets(tripletList.begin(), tripletList.end());
+    dcYbus_.makeCompressed();
     // std::cout << "dcYbus made" << std::endl;
     #ifdef __COUT_TIMES
         std::cout << "\t dc: preproc: " << 1000. * timer_preproc.duration() << "ms" << std::endl;
@@ -80,7 +81,7 @@ bool BaseDCSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
     bool just_factorize = false;
     if(need_factorize_){
         // dc_solver_.analyzePattern(dcYbus);
-        ErrorType status_init = _linear_solver.initialize(dcYbus);
+        ErrorType status_init = _linear_solver.initialize(dcYbus_);
         if(status_init != ErrorType::NoError){
             err_ = status_init;
             return false;
@@ -118,7 +119,7 @@ bool BaseDCSolver<LinearSolver>::compute_pf(const Eigen::SparseMatrix<cplx_type>
     // }
     // std::cout << std::endl;
 
-    ErrorType error = _linear_solver.solve(dcYbus, Va_dc_without_slack, just_factorize);
+    ErrorType error = _linear_solver.solve(dcYbus_, Va_dc_without_slack, just_factorize);
     if(error != ErrorType::NoError){
         err_ = error;
         timer_total_nr_ += timer.duration();
@@ -178,4 +179,23 @@ void BaseDCSolver<LinearSolver>::reset(){
     BaseSolver::reset();
     _linear_solver.reset();
     need_factorize_ = true;
+    dcYbus_ = Eigen::SparseMatrix<real_type>();
+}
+
+template<class LinearSolver>
+void BaseDCSolver<LinearSolver>::copy_state(const BaseSolver & other_base){
+    const BaseDCSolver<LinearSolver> * p_other = dynamic_cast<const BaseDCSolver<LinearSolver> *>(&other_base);
+    if(p_other == nullptr){
+        std::ostringstream exc_;
+        exc_ << "BaseDCSolver::copy_state: the state can only be copied from a solver of the same type.";
+        throw std::runtime_error(exc_.str());
+    }
+    const BaseDCSolver<LinearSolver> & other = *p_other;
+    reset();
+    BaseSolver::copy_state(other);
+    if(other.need_factorize_) return;
+    dcYbus_ = other.dcYbus_;
+
+    // the factorization is reused if the linear solver allows it, otherwise it will be computed at the next powerflow
+    need_factorize_ = !_linear_solver.reuse_factorization(other._linear_solver);
 }
@@ -62,8 +62,6 @@ DataGen::StateRes DataGen::get_state() const
 }
 void DataGen::set_state(DataGen::StateRes & my_state )
 {
-    reset_results();
-
     std::vector<real_type> & p_mw = std::get<0>(my_state);
     std::vector<real_type> & vm_pu = std::get<1>(my_state);
     std::vector<real_type> & min_q = std::get<2>(my_state);
@@ -83,6 +81,7 @@ void DataGen::set_state(DataGen::StateRes & my_state )
     status_ = status;
     gen_slackbus_ = slack_bus;
     gen_slack_weight_ = slack_weight;
+    reset_results();
 }
 
 RealVect DataGen::get_slack_weights(Eigen::Index nb_bus_solver, const std::vector<int> & id_grid_to_solver){
@@ -174,14 +173,17 @@ void DataGen::compute_results(const Eigen::Ref<const RealVect> & Va,
     v_kv_from_vpu(Va, Vm, status_, nb_gen, bus_id_, id_grid_to_solver, bus_vn_kv, res_v_);
     v_deg_from_va(Va, Vm, status_, nb_gen, bus_id_, id_grid_to_solver, bus_vn_kv, res_theta_);
     res_p_ = p_mw_;
+    has_results_ = true;
 }
 
 void DataGen::reset_results(){
-    res_p_ = RealVect();  // in MW
-    res_q_ = RealVect();  // in MVar
-    res_v_ = RealVect();  // in kV
-    res_theta_ = RealVect();  // in deg
+    const int nb_gen = nb();
+    _reset_res(res_p_, nb_gen);  // in MW
+    _reset_res(res_q_, nb_gen);  // in MVar
+    _reset_res(res_v_, nb_gen);  // in kV
+    _reset_res(res_theta_, nb_gen);  // in deg
     bus_slack_weight_ = RealVect();
+    has_results_ = false;
 }
 
 void DataGen::get_vm_for_dc(RealVect & Vm){
@@ -295,16 +297,17 @@ void DataGen::set_p_slack(const RealVect& node_mismatch,
     }
 }
 
-void DataGen::init_q_vector(int nb_bus_total)  // total number of bus on the grid
+void DataGen::init_q_vector(int nb_bus_solver, const std::vector<int> & id_grid_to_solver)
 {
+    // the reactive power is shared among the generators of the same solver bus (buses of the grid can be merged)
     const int nb_gen = nb();
-    total_q_min_per_bus_ = RealVect::Constant(nb_bus_total, 0.);
-    total_q_max_per_bus_ = RealVect::Constant(nb_bus_total, 0.);
-    total_gen_per_bus_ = Eigen::VectorXi::Constant(nb_bus_total, 0);
+    total_q_min_per_bus_ = RealVect::Constant(nb_bus_solver, 0.);
+    total_q_max_per_bus_ = RealVect::Constant(nb_bus_solver, 0.);
+    total_gen_per_bus_ = Eigen::VectorXi::Constant(nb_bus_solver, 0);
     for(int gen_id = 0; gen_id < nb_gen; ++gen_id)
     {
         if(!status_[gen_id]) continue;
-        int bus_id = bus_id_(gen_id);
+        int bus_id = id_grid_to_solver[bus_id_(gen_id)];
         total_q_min_per_bus_(bus_id) += min_q_(gen_id);
         total_q_max_per_bus_(bus_id) += max_q_(gen_id);
         total_gen_per_bus_(bus_id) += 1;
@@ -314,7 +317,7 @@ void DataGen::init_q_vector(int nb_bus_total)  // total number of bus on the gri
 void DataGen::set_q(const RealVect & reactive_mismatch, const std::vector<int> & id_grid_to_solver, bool ac)
 {
     const int nb_gen = nb();
-    res_q_ = RealVect::Constant(nb_gen, 0.);
+    res_q_.setConstant(nb_gen, 0.);
     if(!ac) return;  // do not consider Q values in dc mode
     real_type eps_q = 1e-8;
     for(int gen_id = 0; gen_id < nb_gen; ++gen_id)
@@ -327,9 +330,9 @@ void DataGen::set_q(const RealVect & reactive_mismatch, const std::vector<int> &
         real_type q_to_absorb = reactive_mismatch[bus_solver];
         real_type max_q_me = max_q_(gen_id);
         real_type min_q_me = min_q_(gen_id);
-        real_type max_q_bus = total_q_max_per_bus_(bus_id);
-        real_type min_q_bus = total_q_min_per_bus_(bus_id);
-        int nb_gen_with_me = total_gen_per_bus_(bus_id);
+        real_type max_q_bus = total_q_max_per_bus_(bus_solver);
+        real_type min_q_bus = total_q_min_per_bus_(bus_solver);
+        int nb_gen_with_me = total_gen_per_bus_(bus_solver);
         if(nb_gen_with_me == 1){
             real_q = q_to_absorb;
         }else{
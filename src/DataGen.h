@@ -83,7 +83,7 @@ class DataGen: public DataGeneric
                     min_q_mvar = r_data_gen.min_q_.coeff(my_id);
                     max_q_mvar = r_data_gen.max_q_.coeff(my_id);
 
-                    has_res = r_data_gen.res_p_.size() > 0;
+                    has_res = r_data_gen.has_results();
                     if(has_res)
                     {
                         res_p_mw = r_data_gen.res_p_.coeff(my_id);
@@ -180,7 +180,7 @@ class DataGen: public DataGeneric
                         std::vector<bool> & has_bus_been_added,
                         Eigen::VectorXi & slack_bus_id_solver,
                         const std::vector<int> & id_grid_to_solver) const;
-    void init_q_vector(int nb_bus); // delta_q_per_gen_
+    void init_q_vector(int nb_bus_solver, const std::vector<int> & id_grid_to_solver); // delta_q_per_gen_
 
     void compute_results(const Eigen::Ref<const RealVect> & Va,
                          const Eigen::Ref<const RealVect> & Vm,
@@ -204,6 +204,16 @@ class DataGen: public DataGeneric
 
     const std::vector<bool>& get_status() const {return status_;}
     const Eigen::VectorXi & get_bus_id() const {return bus_id_;}
+    // columns of the table (the results are empty when they are not computed)
+    Eigen::Ref<const RealVect> get_p_mw() const {return p_mw_;}
+    Eigen::Ref<const RealVect> get_vm_pu() const {return vm_pu_;}
+    Eigen::Ref<const RealVect> get_min_q() const {return min_q_;}
+    Eigen::Ref<const RealVect> get_max_q() const {return max_q_;}
+    const std::vector<bool> & get_is_slack() const {return gen_slackbus_;}
+    Eigen::Map<const RealVect> get_slack_weight() const {return Eigen::Map<const RealVect>(gen_slack_weight_.data(), gen_slack_weight_.size());}
+    Eigen::Ref<const RealVect> get_res_p() const {return res_p_;}
+    Eigen::Ref<const RealVect> get_res_q() const {return res_q_;}
+    Eigen::Ref<const RealVect> get_res_v() const {return res_v_;}
 
     void cout_v(){
         for(const auto & el : vm_pu_){
@@ -225,7 +235,7 @@ class DataGen: public DataGeneric
         std::vector<bool> gen_slackbus_;  // say for each generator if it's a slack or not
         std::vector<real_type> gen_slack_weight_;
 
-        // intermediate data
+        // intermediate data (for each bus of the solver)
         RealVect total_q_min_per_bus_;
         RealVect total_q_max_per_bus_;
         Eigen::VectorXi total_gen_per_bus_;
@@ -15,16 +15,14 @@ const int DataGeneric::_deactivated_bus_id = -1;
 // TODO all functions bellow are generic ! Make a base class for that
 void DataGeneric::_get_amps(RealVect & a, const RealVect & p, const RealVect & q, const RealVect & v){
     const real_type _1_sqrt_3 = 1.0 / std::sqrt(3.);
-    RealVect p2q2 = p.array() * p.array() + q.array() * q.array();
-    p2q2 = p2q2.array().cwiseSqrt();
-
-    // modification in case of disconnected powerlines
-    // because i don't want to divide by 0. below
-    RealVect v_tmp = v;
-    for(auto & el: v_tmp){
-        if(el == 0.) el = 1.0;
+    const int nb_el = static_cast<int>(p.size());
+    a.resize(nb_el);  // no allocation if the size did not change
+    for(int el_id = 0; el_id < nb_el; ++el_id){
+        // modification in case of disconnected powerlines
+        // because i don't want to divide by 0. below
+        const real_type v_el = v(el_id) == 0. ? 1.0 : v(el_id);
+        a(el_id) = std::sqrt(p(el_id) * p(el_id) + q(el_id) * q(el_id)) * _1_sqrt_3 / v_el;
     }
-    a = p2q2.array() * _1_sqrt_3 / v_tmp.array();
 }
 void DataGeneric::_reactivate(int el_id, std::vector<bool> & status, bool & need_reset){
     bool val = status.at(el_id);
@@ -104,7 +102,7 @@ void DataGeneric::v_kv_from_vpu(const Eigen::Ref<const RealVect> & Va,
                                 const std::vector<int> & id_grid_to_solver,
                                 const RealVect & bus_vn_kv,
                                 RealVect & v){
-    v = RealVect::Constant(nb_element, -1.0);
+    v.setConstant(nb_element, -1.0);
     for(int el_id = 0; el_id < nb_element; ++el_id){
         // if the element is disconnected, i leave it like that
         if(!status[el_id]) continue;
@@ -132,7 +130,7 @@ void DataGeneric::v_deg_from_va(const Eigen::Ref<const RealVect> & Va,
                                 const std::vector<int> & id_grid_to_solver,
                                 const RealVect & bus_vn_kv,
                                 RealVect & theta){
-    theta = RealVect::Constant(nb_element, 0.0);
+    theta.setConstant(nb_element, 0.0);
     for(int el_id = 0; el_id < nb_element; ++el_id){
         // if the element is disconnected, i leave it like that
         if(!status[el_id]) continue;
@@ -10,6 +10,7 @@
 #define DATAGENERIC_H
 
 #include <algorithm>  // for std::find
+#include <limits>  // for the NaN of the results
 
 #include "Utils.h"
 
@@ -84,10 +85,21 @@ class DataGeneric : public BaseConstants
     
         static const int _deactivated_bus_id;
 
+        // whether the results (res_*) are the ones of the last powerflow (they are nan otherwise)
+        bool has_results() const {return has_results_;}
+
         /**"define" the destructor for compliance with clang (otherwise lots of warnings)**/
         virtual ~DataGeneric() {};
         
     protected:
+        /**
+        reset a result vector in place (to nan): its memory is kept, so the numpy arrays that view it remain valid.
+        It is only reallocated when the number of elements changes.
+        **/
+        static void _reset_res(RealVect & res, int nb_element){
+            res.setConstant(nb_element, std::numeric_limits<real_type>::quiet_NaN());
+        }
+
         /**
         activation / deactivation of elements
         **/
@@ -140,6 +152,8 @@ class DataGeneric : public BaseConstants
         **/
         template<class T>  // a std::vector, or an Eigen::Vector                                                 
         bool is_in_vect(int val, const T & cont) const {return std::find(cont.begin(), cont.end(), val) != cont.end();}
+
+        bool has_results_ = false;
 };
 
 #endif // DATAGENERIC_H
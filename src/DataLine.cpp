@@ -30,18 +30,19 @@ void DataLine::init(const RealVect & branch_r,
 
     bus_or_id_ = branch_from_id;
     bus_ex_id_ = branch_to_id;
-    powerlines_h_ = branch_h;
-    powerlines_r_ = branch_r;
-    powerlines_x_ = branch_x;
+    StaticData & static_data = static_.mut();  // static data are cloned here if they are shared with another instance
+    static_data.powerlines_h = branch_h;
+    static_data.powerlines_r = branch_r;
+    static_data.powerlines_x = branch_x;
     status_ = std::vector<bool>(branch_r.size(), true); // by default everything is connected
     _update_model_coeffs();
 }
 
 DataLine::StateRes DataLine::get_state() const
 {
-     std::vector<real_type> branch_r(powerlines_r_.begin(), powerlines_r_.end());
-     std::vector<real_type> branch_x(powerlines_x_.begin(), powerlines_x_.end());
-     std::vector<cplx_type > branch_h(powerlines_h_.begin(), powerlines_h_.end());
+     std::vector<real_type> branch_r(static_->powerlines_r.begin(), static_->powerlines_r.end());
+     std::vector<real_type> branch_x(static_->powerlines_x.begin(), static_->powerlines_x.end());
+     std::vector<cplx_type > branch_h(static_->powerlines_h.begin(), static_->powerlines_h.end());
      std::vector<int > branch_from_id(bus_or_id_.begin(), bus_or_id_.end());
      std::vector<int > branch_to_id(bus_ex_id_.begin(), bus_ex_id_.end());
      std::vector<bool> status = status_;
@@ -50,8 +51,6 @@ DataLine::StateRes DataLine::get_state() const
 }
 void DataLine::set_state(DataLine::StateRes & my_state)
 {
-    reset_results();
-
     std::vector<real_type> & branch_r = std::get<0>(my_state);
     std::vector<real_type> & branch_x = std::get<1>(my_state);
     std::vector<cplx_type > & branch_h = std::get<2>(my_state);
@@ -61,9 +60,10 @@ void DataLine::set_state(DataLine::StateRes & my_state)
     // TODO check sizes
 
     // now assign the values
-    powerlines_r_ = RealVect::Map(&branch_r[0], branch_r.size());
-    powerlines_x_ = RealVect::Map(&branch_x[0], branch_x.size());
-    powerlines_h_ = CplxVect::Map(&branch_h[0], branch_h.size());
+    StaticData & static_data = static_.mut();  // static data are cloned here if they are shared with another instance
+    static_data.powerlines_r = RealVect::Map(&branch_r[0], branch_r.size());
+    static_data.powerlines_x = RealVect::Map(&branch_x[0], branch_x.size());
+    static_data.powerlines_h = CplxVect::Map(&branch_h[0], branch_h.size());
 
     // input data
     bus_or_id_ = Eigen::VectorXi::Map(&branch_from_id[0], branch_from_id.size());
@@ -71,40 +71,46 @@ void DataLine::set_state(DataLine::StateRes & my_state)
     status_ = status;
 
     _update_model_coeffs();
+    reset_results();
 }
 
 void DataLine::_update_model_coeffs()
 {
-    const auto my_size = powerlines_r_.size();
-
-    yac_ff_ = CplxVect::Zero(my_size);
-    yac_ft_ = CplxVect::Zero(my_size);
-    yac_tf_ = CplxVect::Zero(my_size);
-    yac_tt_ = CplxVect::Zero(my_size);
-
-    ydc_ff_ = CplxVect::Zero(my_size);
-    ydc_ft_ = CplxVect::Zero(my_size);
-    ydc_tf_ = CplxVect::Zero(my_size);
-    ydc_tt_ = CplxVect::Zero(my_size);
+    StaticData & static_data = static_.mut();  // static data are cloned here if they are shared with another instance
+    const auto my_size = static_data.powerlines_r.size();
+
+    static_data.yac_ff = CplxVect::Zero(my_size);
+    static_data.yac_ft = CplxVect::Zero(my_size);
+    static_data.yac_tf = CplxVect::Zero(my_size);
+    static_data.yac_tt = CplxVect::Zero(my_size);
+
+    static_data.ydc_ff = CplxVect::Zero(my_size);
+    static_data.ydc_ft = CplxVect::Zero(my_size);
+    static_data.ydc_tf = CplxVect::Zero(my_size);
+    static_data.ydc_tt = CplxVect::Zero(my_size);
     for(int i = 0; i < my_size; ++i)
     {
+        // the powerlines without impedance (bus couplers) only keep their shunt part: their two buses are merged
+        // in the solver (see GridModel::init_Ybus)
+        const bool zero_impedance = is_zero_impedance(i);
+
         // for AC
         // see https://matpower.org/docs/MATPOWER-manual.pdf eq. 3.2
-        const cplx_type ys = 1. / (powerlines_r_(i) + my_i * powerlines_x_(i));
-        const cplx_type h = my_i * powerlines_h_(i) * 0.5;
-        yac_ff_(i) = (ys + h);
-        yac_tt_(i) = (ys + h);
-        yac_tf_(i) = -ys;
-        yac_ft_(i) = -ys;
+        const cplx_type ys = zero_impedance ? cplx_type(0.) : 1. / (static_data.powerlines_r(i) + my_i * static_data.powerlines_x(i));
+        const cplx_type h = my_i * static_data.powerlines_h(i) * 0.5;
+        static_data.yac_ff(i) = (ys + h);
+        static_data.yac_tt(i) = (ys + h);
+        static_data.yac_tf(i) = -ys;
+        static_data.yac_ft(i) = -ys;
 
         // for DC
         // see https://matpower.org/docs/MATPOWER-manual.pdf eq. 3.21
         // except here I only care about the real part, so I remove the "1/j"
-        cplx_type tmp = 1. / (powerlines_x_(i));
-        ydc_ff_(i) = tmp;
-        ydc_tt_(i) = tmp;
-        ydc_tf_(i) = -tmp;
-        ydc_ft_(i) = -tmp;
+        cplx_type tmp = zero_impedance ? cplx_type(0.) : 1. / (static_data.powerlines_x(i));
+        static_data.ydc_ff(i) = tmp;
+        static_data.ydc_tt(i) = tmp;
+        static_data.ydc_tf(i) = -tmp;
+        static_data.ydc_ft(i) = -tmp;
     }
 }
 
@@ -120,7 +126,7 @@ void DataLine::fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
 {
     // fill the matrix
     //TODO template here instead of "if" for ac / dc
-    const Eigen::Index nb_line = static_cast<int>(powerlines_r_.size());
+    const Eigen::Index nb_line = static_cast<int>(static_->powerlines_r.size());
     cplx_type yft, ytf, yff, ytt;
 
     //diagonal coefficients
@@ -151,16 +157,16 @@ void DataLine::fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
         
         if(ac){
             // ac mode
-            yft = yac_ft_(line_id);
-            ytf = yac_tf_(line_id);
-            yff = yac_ff_(line_id);
-            ytt = yac_tt_(line_id);
+            yft = static_->yac_ft(line_id);
+            ytf = static_->yac_tf(line_id);
+            yff = static_->yac_ff(line_id);
+            ytt = static_->yac_tt(line_id);
         }else{
             // dc mode
-            yft = ydc_ft_(line_id);
-            ytf = ydc_tf_(line_id);
-            yff = ydc_ff_(line_id);
-            ytt = ydc_tt_(line_id);
+            yft = static_->ydc_ft(line_id);
+            ytf = static_->ydc_tf(line_id);
+            yff = static_->ydc_ff(line_id);
+            ytt = static_->ydc_tt(line_id);
         }
         res.push_back(Eigen::Triplet<cplx_type> (bus_or_solver_id, bus_ex_solver_id, yft));
         res.push_back(Eigen::Triplet<cplx_type> (bus_ex_solver_id, bus_or_solver_id, ytf));
@@ -171,103 +177,45 @@ void DataLine::fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
 
 void DataLine::reset_results()
 {
-    res_powerline_por_ = RealVect();  // in MW
-    res_powerline_qor_ = RealVect();  // in MVar
-    res_powerline_vor_ = RealVect();  // in kV
-    res_powerline_aor_ = RealVect();  // in kA
-    res_powerline_pex_ = RealVect();  // in MW
-    res_powerline_qex_ = RealVect();  // in MVar
-    res_powerline_vex_ = RealVect();  // in kV
-    res_powerline_aex_ = RealVect();  // in kA
+    const int nb_line = nb();
+    _reset_res(res_powerline_por_, nb_line);  // in MW
+    _reset_res(res_powerline_qor_, nb_line);  // in MVar
+    _reset_res(res_powerline_vor_, nb_line);  // in kV
+    _reset_res(res_powerline_aor_, nb_line);  // in kA
+    _reset_res(res_powerline_thetaor_, nb_line);  // in deg
+    _reset_res(res_powerline_pex_, nb_line);  // in MW
+    _reset_res(res_powerline_qex_, nb_line);  // in MVar
+    _reset_res(res_powerline_vex_, nb_line);  // in kV
+    _reset_res(res_powerline_aex_, nb_line);  // in kA
+    _reset_res(res_powerline_thetaex_, nb_line);  // in deg
+    has_results_ = false;
 }
 
 
-void DataLine::compute_results(const Eigen::Ref<const RealVect> & Va,
+void DataLine::compute_results(const BranchTable & branches,
+                               const Eigen::Ref<const RealVect> & Va,
                                const Eigen::Ref<const RealVect> & Vm,
                                const Eigen::Ref<const CplxVect> & V,
                                const std::vector<int> & id_grid_to_solver,
-                               const RealVect & bus_vn_kv,
                                real_type sn_mva,
                                bool ac)
 {
-    // it needs to be initialized at 0.
-    Eigen::Index nb_element = nb();
-    res_powerline_por_ = RealVect::Constant(nb_element, my_zero_);  // in MW
-    res_powerline_qor_ = RealVect::Constant(nb_element, my_zero_);  // in MVar
-    res_powerline_vor_ = RealVect::Constant(nb_element, my_zero_);  // in kV
-    res_powerline_aor_ = RealVect::Constant(nb_element, my_zero_);  // in kA
-    res_powerline_pex_ = RealVect::Constant(nb_element, my_zero_);  // in MW
-    res_powerline_qex_ = RealVect::Constant(nb_element, my_zero_);  // in MVar
-    res_powerline_vex_ = RealVect::Constant(nb_element, my_zero_);  // in kV
-    res_powerline_aex_ = RealVect::Constant(nb_element, my_zero_);  // in kA
-    res_powerline_thetaor_ = RealVect::Constant(nb_element, my_zero_);  // in kV
-    res_powerline_thetaex_ = RealVect::Constant(nb_element, my_zero_);  // in kV
-    for(Eigen::Index line_id = 0; line_id < nb_element; ++line_id){
-        // don't do anything if the element is disconnected
-        if(!status_[line_id]) continue;
-
-        // connectivity
-        int bus_or_id_me = bus_or_id_(line_id);
-        int bus_or_solver_id = id_grid_to_solver[bus_or_id_me];
-        if(bus_or_solver_id == _deactivated_bus_id){
-            std::ostringstream exc_;
-            exc_ << "DataLine::compute_results: the line with id ";
-            exc_ << line_id;
-            exc_ << " is connected (or side) to a disconnected bus while being connected";
-            throw std::runtime_error(exc_.str());
-        }
-        int bus_ex_id_me = bus_ex_id_(line_id);
-        int bus_ex_solver_id = id_grid_to_solver[bus_ex_id_me];
-        if(bus_ex_solver_id == _deactivated_bus_id){
-            std::ostringstream exc_;
-            exc_ << "DataLine::compute_results: the line with id ";
-            exc_ << line_id;
-            exc_ << " is connected (ex side) to a disconnected bus while being connected";
-            throw std::runtime_error(exc_.str());
-        }
-
-        // retrieve voltages magnitude in kv instead of pu
-        real_type v_or = Vm(bus_or_solver_id);
-        real_type v_ex = Vm(bus_ex_solver_id);
-        real_type bus_vn_kv_or = bus_vn_kv(bus_or_id_me);
-        real_type bus_vn_kv_ex = bus_vn_kv(bus_ex_id_me);
-        
-        // for the voltage
-        res_powerline_vor_(line_id) = v_or * bus_vn_kv_or;
-        res_powerline_vex_(line_id) = v_ex * bus_vn_kv_ex;
-
-        // retrieve the voltage angle in degree (instead of radian)
-        res_powerline_thetaor_(line_id) = Va(bus_or_solver_id) * 180. / my_pi;
-        res_powerline_thetaex_(line_id) = Va(bus_ex_solver_id) * 180. / my_pi;
-
-        // results of the powerflow
-        cplx_type Eor = V(bus_or_solver_id);
-        cplx_type Eex = V(bus_ex_solver_id);
-
-        if(ac){
-            // result of the ac powerflow
-            cplx_type I_orex =  yac_ff_(line_id) * Eor + yac_ft_(line_id) * Eex;
-            cplx_type I_exor =  yac_tt_(line_id) * Eex + yac_tf_(line_id) * Eor;
-
-            I_orex = std::conj(I_orex);
-            I_exor = std::conj(I_exor);
-            cplx_type s_orex = Eor * I_orex;
-            cplx_type s_exor = Eex * I_exor;
-
-            res_powerline_por_(line_id) = std::real(s_orex) * sn_mva;
-            res_powerline_qor_(line_id) = std::imag(s_orex) * sn_mva;
-            res_powerline_pex_(line_id) = std::real(s_exor) * sn_mva;
-            res_powerline_qex_(line_id) = std::imag(s_exor) * sn_mva;
-
-        }else{
-            // result of the dc powerflow
-            res_powerline_por_(line_id) = (std::real(ydc_ff_(line_id)) * Va(bus_or_solver_id) + std::real(ydc_ft_(line_id)) * Va(bus_ex_solver_id)) * sn_mva;
-            res_powerline_pex_(line_id) = (std::real(ydc_tt_(line_id)) * Va(bus_ex_solver_id) + std::real(ydc_tf_(line_id)) * Va(bus_or_solver_id)) * sn_mva;   
+    branches.compute_results(0, nb(), Va, Vm, V, id_grid_to_solver, sn_mva, ac,
+                             res_powerline_por_, res_powerline_qor_, res_powerline_vor_, res_powerline_thetaor_,
+                             res_powerline_pex_, res_powerline_qex_, res_powerline_vex_, res_powerline_thetaex_);
+    _get_amps(res_powerline_aor_, res_powerline_por_, res_powerline_qor_, res_powerline_vor_);
+    _get_amps(res_powerline_aex_, res_powerline_pex_, res_powerline_qex_, res_powerline_vex_);
+    has_results_ = true;
+}
 
-            // for the voltage (by hypothesis vm = 1)
-            // res_powerline_vor_(line_id) = bus_vn_kv_or;
-            // res_powerline_vex_(line_id) = bus_vn_kv_ex;        
-        }
+void DataLine::add_coupler_flows(const std::vector<int> & line_ids, const std::vector<cplx_type> & s_or_ex)
+{
+    for(std::size_t i = 0; i < line_ids.size(); ++i){
+        const int line_id = line_ids[i];
+        res_powerline_por_(line_id) += std::real(s_or_ex[i]);
+        res_powerline_qor_(line_id) += std::imag(s_or_ex[i]);
+        res_powerline_pex_(line_id) -= std::real(s_or_ex[i]);
+        res_powerline_qex_(line_id) -= std::imag(s_or_ex[i]);
     }
     _get_amps(res_powerline_aor_, res_powerline_por_, res_powerline_qor_, res_powerline_vor_);
     _get_amps(res_powerline_aex_, res_powerline_pex_, res_powerline_qex_, res_powerline_vex_);
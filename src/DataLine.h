@@ -19,6 +19,8 @@
 #include "Eigen/SparseLU"
 
 #include "DataGeneric.h"
+#include "BranchTable.h"
+#include "CowPtr.h"
 
 /**
 This class is a container for all the powerlines on the grid.
@@ -83,11 +85,11 @@ class DataLine : public DataGeneric
                         connected = r_data_line.status_[my_id];
                         bus_or_id = r_data_line.bus_or_id_.coeff(my_id);
                         bus_ex_id = r_data_line.bus_ex_id_.coeff(my_id);
-                        r_pu = r_data_line.powerlines_r_.coeff(my_id);
-                        x_pu = r_data_line.powerlines_x_.coeff(my_id);
-                        h_pu = r_data_line.powerlines_h_.coeff(my_id);
+                        r_pu = r_data_line.static_->powerlines_r.coeff(my_id);
+                        x_pu = r_data_line.static_->powerlines_x.coeff(my_id);
+                        h_pu = r_data_line.static_->powerlines_h.coeff(my_id);
 
-                        has_res = r_data_line.res_powerline_por_.size() > 0;
+                        has_res = r_data_line.has_results();
                         if(has_res)
                         {
                             res_p_or_mw = r_data_line.res_powerline_por_.coeff(my_id);
@@ -144,7 +146,7 @@ class DataLine : public DataGeneric
         }
     }
 
-    int nb() const { return static_cast<int>(powerlines_r_.size()); }
+    int nb() const { return static_cast<int>(static_->powerlines_r.size()); }
 
     // make it iterable
     typedef DataLineConstIterator const_iterator_type;
@@ -176,11 +178,12 @@ class DataLine : public DataGeneric
                           );
     virtual void fillYbus_spmat(Eigen::SparseMatrix<cplx_type> & res, bool ac, const std::vector<int> & id_grid_to_solver);
 
-    void compute_results(const Eigen::Ref<const RealVect> & Va,
+    // the flows are computed on the table of all the branches (the powerlines are its first branches)
+    void compute_results(const BranchTable & branches,
+                         const Eigen::Ref<const RealVect> & Va,
                          const Eigen::Ref<const RealVect> & Vm,
                          const Eigen::Ref<const CplxVect> & V,
                          const std::vector<int> & id_grid_to_solver,
-                         const RealVect & bus_vn_kv,
                          real_type sn_mva,
                          bool ac);
     void reset_results();
@@ -190,24 +193,67 @@ class DataLine : public DataGeneric
 
     Eigen::Ref<const RealVect> get_theta_or() const {return res_powerline_thetaor_;}
     Eigen::Ref<const RealVect> get_theta_ex() const {return res_powerline_thetaex_;}
+    // columns of the table (the results are empty when they are not computed)
+    Eigen::Ref<const RealVect> get_r() const {return static_->powerlines_r;}
+    Eigen::Ref<const RealVect> get_x() const {return static_->powerlines_x;}
+    Eigen::Ref<const CplxVect> get_h() const {return static_->powerlines_h;}
+    Eigen::Ref<const RealVect> get_res_p_or() const {return res_powerline_por_;}
+    Eigen::Ref<const RealVect> get_res_q_or() const {return res_powerline_qor_;}
+    Eigen::Ref<const RealVect> get_res_v_or() const {return res_powerline_vor_;}
+    Eigen::Ref<const RealVect> get_res_a_or() const {return res_powerline_aor_;}
+    Eigen::Ref<const RealVect> get_res_p_ex() const {return res_powerline_pex_;}
+    Eigen::Ref<const RealVect> get_res_q_ex() const {return res_powerline_qex_;}
+    Eigen::Ref<const RealVect> get_res_v_ex() const {return res_powerline_vex_;}
+    Eigen::Ref<const RealVect> get_res_a_ex() const {return res_powerline_aex_;}
     const std::vector<bool>& get_status() const {return status_;}
     Eigen::Ref<const Eigen::VectorXi> get_bus_from() const {return bus_or_id_;}
+    // the powerlines without impedance (eg bus couplers): their two buses are merged in the solver
+    bool is_zero_impedance(int line_id) const {
+        return (static_->powerlines_r(line_id) == 0.) && (static_->powerlines_x(line_id) == 0.);
+    }
+    /**
+    the flows on the powerlines without impedance do not depend on the voltages, they are given by the kirchhoff
+    current law (see GridModel::compute_coupler_flows). s_or_ex (MW, MVAr) is the power going from "or" to "ex".
+    **/
+    void add_coupler_flows(const std::vector<int> & line_ids, const std::vector<cplx_type> & s_or_ex);
     Eigen::Ref<const Eigen::VectorXi> get_bus_to() const {return bus_ex_id_;}
 
     // model paramters
-    Eigen::Ref<const CplxVect> yac_ff() const {return yac_ff_;}
-    Eigen::Ref<const CplxVect> yac_ft() const {return yac_ft_;}
-    Eigen::Ref<const CplxVect> yac_tf() const {return yac_tf_;}
-    Eigen::Ref<const CplxVect> yac_tt() const {return yac_tt_;}
+    Eigen::Ref<const CplxVect> yac_ff() const {return static_->yac_ff;}
+    Eigen::Ref<const CplxVect> yac_ft() const {return static_->yac_ft;}
+    Eigen::Ref<const CplxVect> yac_tf() const {return static_->yac_tf;}
+    Eigen::Ref<const CplxVect> yac_tt() const {return static_->yac_tt;}
+    Eigen::Ref<const CplxVect> ydc_ff() const {return static_->ydc_ff;}
+    Eigen::Ref<const CplxVect> ydc_ft() const {return static_->ydc_ft;}
+    Eigen::Ref<const CplxVect> ydc_tf() const {return static_->ydc_tf;}
+    Eigen::Ref<const CplxVect> ydc_tt() const {return static_->ydc_tt;}
 
     protected:
         void _update_model_coeffs();
 
     protected:
-        // physical properties
-        RealVect powerlines_r_;
-        RealVect powerlines_x_;
-        CplxVect powerlines_h_;
+        // physical properties and model coefficients: they do not change after "init" and are shared
+        // between the copies of this instance (cloned only when modified, see CowPtr)
+        class StaticData
+        {
+            public:
+                // physical properties
+                RealVect powerlines_r;
+                RealVect powerlines_x;
+                CplxVect powerlines_h;
+
+                // model coefficients
+                CplxVect yac_ff;
+                CplxVect yac_ft;
+                CplxVect yac_tf;
+                CplxVect yac_tt;
+
+                CplxVect ydc_ff;
+                CplxVect ydc_ft;
+                CplxVect ydc_tf;
+                CplxVect ydc_tt;
+        };
+        CowPtr<StaticData> static_;
 
         // input data
         Eigen::VectorXi bus_or_id_;
@@ -225,17 +271,6 @@ class DataLine : public DataGeneric
         RealVect res_powerline_aex_;  // in kA
         RealVect res_powerline_thetaor_; // in degree
         RealVect res_powerline_thetaex_; // in degree
-
-        // model coefficients
-        CplxVect yac_ff_;
-        CplxVect yac_ft_;
-        CplxVect yac_tf_;
-        CplxVect yac_tt_;
-
-        CplxVect ydc_ff_;
-        CplxVect ydc_ft_;
-        CplxVect ydc_tf_;
-        CplxVect ydc_tt_;
 };
 
 #endif  //DATALINE_H
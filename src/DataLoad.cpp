@@ -31,8 +31,6 @@ DataLoad::StateRes DataLoad::get_state() const
 }
 void DataLoad::set_state(DataLoad::StateRes & my_state )
 {
-    reset_results();
-
     std::vector<real_type> & p_mw = std::get<0>(my_state);
     std::vector<real_type> & q_mvar = std::get<1>(my_state);
     std::vector<int> & bus_id = std::get<2>(my_state);
@@ -44,6 +42,7 @@ void DataLoad::set_state(DataLoad::StateRes & my_state )
     q_mvar_ = RealVect::Map(&q_mvar[0], q_mvar.size());
     bus_id_ = Eigen::VectorXi::Map(&bus_id[0], bus_id.size());
     status_ = status;
+    reset_results();
 }
 
 
@@ -83,12 +82,16 @@ void DataLoad::compute_results(const Eigen::Ref<const RealVect> & Va,
     v_deg_from_va(Va, Vm, status_, nb_load, bus_id_, id_grid_to_solver, bus_vn_kv, res_theta_);
     res_p_ = p_mw_;
     res_q_ = q_mvar_;
+    has_results_ = true;
 }
 
 void DataLoad::reset_results(){
-    res_p_ = RealVect();  // in MW
-    res_q_ =  RealVect();  // in MVar
-    res_v_ = RealVect();  // in kV
+    const int nb_load = nb();
+    _reset_res(res_p_, nb_load);  // in MW
+    _reset_res(res_q_, nb_load);  // in MVar
+    _reset_res(res_v_, nb_load);  // in kV
+    _reset_res(res_theta_, nb_load);  // in deg
+    has_results_ = false;
 }
 
 void DataLoad::change_p(int load_id, real_type new_p, bool & need_reset)
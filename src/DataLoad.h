@@ -76,7 +76,7 @@ class DataLoad : public DataGeneric
                         target_p_mw = r_data_load.p_mw_.coeff(my_id);
                         target_q_mvar = r_data_load.q_mvar_.coeff(my_id);
 
-                        has_res = r_data_load.res_p_.size() > 0;
+                        has_res = r_data_load.has_results();
                         if(has_res)
                         {
                             res_p_mw = r_data_load.res_p_.coeff(my_id);
@@ -154,6 +154,12 @@ class DataLoad : public DataGeneric
     Eigen::Ref<const RealVect> get_theta() const {return res_theta_;}
     const std::vector<bool>& get_status() const {return status_;}
     const Eigen::VectorXi & get_bus_id() const {return bus_id_;}
+    // columns of the table (the results are empty when they are not computed)
+    Eigen::Ref<const RealVect> get_p_mw() const {return p_mw_;}
+    Eigen::Ref<const RealVect> get_q_mvar() const {return q_mvar_;}
+    Eigen::Ref<const RealVect> get_res_p() const {return res_p_;}
+    Eigen::Ref<const RealVect> get_res_q() const {return res_q_;}
+    Eigen::Ref<const RealVect> get_res_v() const {return res_v_;}
 
     protected:
         // physical properties
@@ -50,8 +50,6 @@ DataSGen::StateRes DataSGen::get_state() const
 }
 void DataSGen::set_state(DataSGen::StateRes & my_state )
 {
-    reset_results();
-
     std::vector<real_type> & p_mw = std::get<0>(my_state);
     std::vector<real_type> & q_mvar = std::get<1>(my_state);
     std::vector<real_type> & p_min = std::get<2>(my_state);
@@ -79,6 +77,7 @@ void DataSGen::set_state(DataSGen::StateRes & my_state )
     q_max_mvar_ = RealVect::Map(&q_max[0], size);
     bus_id_ = Eigen::VectorXi::Map(&bus_id[0], bus_id.size());
     status_ = status;
+    reset_results();
 }
 
 
@@ -118,13 +117,17 @@ void DataSGen::compute_results(const Eigen::Ref<const RealVect> & Va,
     v_deg_from_va(Va, Vm, status_, nb_sgen, bus_id_, id_grid_to_solver, bus_vn_kv, res_theta_);
     res_p_ = p_mw_;
     if(ac) res_q_ = q_mvar_;
-    else res_q_ = RealVect::Zero(nb_sgen);
+    else res_q_.setZero(nb_sgen);
+    has_results_ = true;
 }
 
 void DataSGen::reset_results(){
-    res_p_ = RealVect();  // in MW
-    res_q_ =  RealVect();  // in MVar
-    res_v_ = RealVect();  // in kV
+    const int nb_sgen = nb();
+    _reset_res(res_p_, nb_sgen);  // in MW
+    _reset_res(res_q_, nb_sgen);  // in MVar
+    _reset_res(res_v_, nb_sgen);  // in kV
+    _reset_res(res_theta_, nb_sgen);  // in deg
+    has_results_ = false;
 }
 
 void DataSGen::change_p(int sgen_id, real_type new_p, bool & need_reset)
@@ -31,8 +31,6 @@ DataShunt::StateRes DataShunt::get_state() const
 }
 void DataShunt::set_state(DataShunt::StateRes & my_state )
 {
-    reset_results();
-
     std::vector<real_type> & p_mw = std::get<0>(my_state);
     std::vector<real_type> & q_mvar = std::get<1>(my_state);
     std::vector<int> & bus_id = std::get<2>(my_state);
@@ -44,6 +42,7 @@ void DataShunt::set_state(DataShunt::StateRes & my_state )
     q_mvar_ = RealVect::Map(&q_mvar[0], q_mvar.size());
     bus_id_ = Eigen::VectorXi::Map(&bus_id[0], bus_id.size());
     status_ = status;
+    reset_results();
 }
 
 void DataShunt::fillYbus(std::vector<Eigen::Triplet<cplx_type> > & res,
@@ -127,8 +126,8 @@ void DataShunt::compute_results(const Eigen::Ref<const RealVect> & Va,
     const int nb_shunt = static_cast<int>(p_mw_.size());
     v_kv_from_vpu(Va, Vm, status_, nb_shunt, bus_id_, id_grid_to_solver, bus_vn_kv, res_v_);
     v_deg_from_va(Va, Vm, status_, nb_shunt, bus_id_, id_grid_to_solver, bus_vn_kv, res_theta_);
-    res_p_ = RealVect::Constant(nb_shunt, my_zero_);
-    res_q_ = RealVect::Constant(nb_shunt, my_zero_);
+    res_p_.setConstant(nb_shunt, my_zero_);
+    res_q_.setConstant(nb_shunt, my_zero_);
     for(int shunt_id = 0; shunt_id < nb_shunt; ++shunt_id){
         if(!status_[shunt_id]) continue;
         int bus_id_me = bus_id_(shunt_id);
@@ -144,12 +143,16 @@ void DataShunt::compute_results(const Eigen::Ref<const RealVect> & Va,
         res_p_(shunt_id) = std::real(s) * sn_mva;
         if(ac) res_q_(shunt_id) = std::imag(s) * sn_mva;
     }
+    has_results_ = true;
 }
 
 void DataShunt::reset_results(){
-    res_p_ = RealVect();  // in MW
-    res_q_ = RealVect();  // in MVar
-    res_v_ = RealVect();  // in kV
+    const int nb_shunt = nb();
+    _reset_res(res_p_, nb_shunt);  // in MW
+    _reset_res(res_q_, nb_shunt);  // in MVar
+    _reset_res(res_v_, nb_shunt);  // in kV
+    _reset_res(res_theta_, nb_shunt);  // in deg
+    has_results_ = false;
 }
 
 void DataShunt::change_p(int shunt_id, real_type new_p, bool & need_reset)
@@ -70,7 +70,7 @@ class DataShunt : public DataGeneric
                         target_p_mw = r_data_shunt.p_mw_.coeff(my_id);
                         target_q_mvar = r_data_shunt.q_mvar_.coeff(my_id);
 
-                        has_res = r_data_shunt.res_p_.size() > 0;
+                        has_res = r_data_shunt.has_results();
                         if(has_res)
                         {
                             res_p_mw = r_data_shunt.res_p_.coeff(my_id);
@@ -151,6 +151,13 @@ class DataShunt : public DataGeneric
     tuple3d get_res() const {return tuple3d(res_p_, res_q_, res_v_);}
     Eigen::Ref<const RealVect> get_theta() const {return res_theta_;}
     const std::vector<bool>& get_status() const {return status_;}
+    const Eigen::VectorXi & get_bus_id() const {return bus_id_;}
+    // columns of the table (the results are empty when they are not computed)
+    Eigen::Ref<const RealVect> get_p_mw() const {return p_mw_;}
+    Eigen::Ref<const RealVect> get_q_mvar() const {return q_mvar_;}
+    Eigen::Ref<const RealVect> get_res_p() const {return res_p_;}
+    Eigen::Ref<const RealVect> get_res_q() const {return res_q_;}
+    Eigen::Ref<const RealVect> get_res_v() const {return res_v_;}
 
     protected:
         // physical properties
@@ -18,6 +18,8 @@
 
 
 #include "DataGeneric.h"
+#include "BranchTable.h"
+#include "CowPtr.h"
 
 /**
 This class is a container for all transformers on the grid.
@@ -89,14 +91,14 @@ class DataTrafo : public DataGeneric
                         connected = r_data_trafo.status_[my_id];
                         bus_hv_id = r_data_trafo.bus_hv_id_.coeff(my_id);
                         bus_lv_id = r_data_trafo.bus_lv_id_.coeff(my_id);
-                        r_pu = r_data_trafo.r_.coeff(my_id);
-                        x_pu = r_data_trafo.x_.coeff(my_id);
-                        h_pu = r_data_trafo.h_.coeff(my_id);
-                        is_tap_hv_side = r_data_trafo.is_tap_hv_side_[my_id];
-                        ratio = r_data_trafo.ratio_.coeff(my_id);
-                        shift_rad = r_data_trafo.shift_.coeff(my_id);
-
-                        has_res = r_data_trafo.res_p_hv_.size() > 0;
+                        r_pu = r_data_trafo.static_->r.coeff(my_id);
+                        x_pu = r_data_trafo.static_->x.coeff(my_id);
+                        h_pu = r_data_trafo.static_->h.coeff(my_id);
+                        is_tap_hv_side = r_data_trafo.static_->is_tap_hv_side[my_id];
+                        ratio = r_data_trafo.static_->ratio.coeff(my_id);
+                        shift_rad = r_data_trafo.static_->shift.coeff(my_id);
+
+                        has_res = r_data_trafo.has_results();
                         if(has_res)
                         {
                             res_p_hv_mw = r_data_trafo.res_p_hv_.coeff(my_id);
@@ -107,8 +109,8 @@ class DataTrafo : public DataGeneric
                             res_q_lv_mvar = r_data_trafo.res_q_lv_.coeff(my_id);
                             res_v_lv_kv = r_data_trafo.res_v_lv_.coeff(my_id);
                             res_a_lv_ka = r_data_trafo.res_a_lv_.coeff(my_id);
-                            res_theta_hv_deg = r_data_trafo.res_theta_lv_.coeff(my_id);
-                            res_theta_lv_deg = r_data_trafo.res_theta_hv_.coeff(my_id);
+                            res_theta_hv_deg = r_data_trafo.res_theta_hv_.coeff(my_id);
+                            res_theta_lv_deg = r_data_trafo.res_theta_lv_.coeff(my_id);
                         }
                     }
                 }
@@ -148,7 +150,7 @@ class DataTrafo : public DataGeneric
     DataTrafo::StateRes get_state() const;
     void set_state(DataTrafo::StateRes & my_state );
 
-    int nb() const { return static_cast<int>(r_.size()); }
+    int nb() const { return static_cast<int>(static_->r.size()); }
 
     // make it iterable
     typedef DataTrafoConstIterator const_iterator_type;
@@ -182,11 +184,12 @@ class DataTrafo : public DataGeneric
                           real_type sn_mva);
     virtual void hack_Sbus_for_dc_phase_shifter(CplxVect & Sbus, bool ac, const std::vector<int> & id_grid_to_solver);  // needed for dc mode
 
-    void compute_results(const Eigen::Ref<const RealVect> & Va,
+    // the flows are computed on the table of all the branches (the trafos are its last branches)
+    void compute_results(const BranchTable & branches,
+                         const Eigen::Ref<const RealVect> & Va,
                          const Eigen::Ref<const RealVect> & Vm,
                          const Eigen::Ref<const CplxVect> & V,
                          const std::vector<int> & id_grid_to_solver,
-                         const RealVect & bus_vn_kv,
                          real_type sn_mva,
                          bool ac);
     void reset_results();
@@ -195,14 +198,34 @@ class DataTrafo : public DataGeneric
     tuple4d get_res_lv() const {return tuple4d(res_p_lv_, res_q_lv_, res_v_lv_, res_a_lv_);}
     Eigen::Ref<const RealVect> get_theta_hv() const {return res_theta_hv_;}
     Eigen::Ref<const RealVect> get_theta_lv() const {return res_theta_lv_;}
+    // columns of the table (the results are empty when they are not computed)
+    Eigen::Ref<const RealVect> get_r() const {return static_->r;}
+    Eigen::Ref<const RealVect> get_x() const {return static_->x;}
+    Eigen::Ref<const CplxVect> get_h() const {return static_->h;}
+    Eigen::Ref<const RealVect> get_ratio() const {return static_->ratio;}
+    Eigen::Ref<const RealVect> get_shift() const {return static_->shift;}
+    const std::vector<bool> & get_is_tap_hv_side() const {return static_->is_tap_hv_side;}
+    Eigen::Ref<const RealVect> get_res_p_hv() const {return res_p_hv_;}
+    Eigen::Ref<const RealVect> get_res_q_hv() const {return res_q_hv_;}
+    Eigen::Ref<const RealVect> get_res_v_hv() const {return res_v_hv_;}
+    Eigen::Ref<const RealVect> get_res_a_hv() const {return res_a_hv_;}
+    Eigen::Ref<const RealVect> get_res_p_lv() const {return res_p_lv_;}
+    Eigen::Ref<const RealVect> get_res_q_lv() const {return res_q_lv_;}
+    Eigen::Ref<const RealVect> get_res_v_lv() const {return res_v_lv_;}
+    Eigen::Ref<const RealVect> get_res_a_lv() const {return res_a_lv_;}
     Eigen::Ref<const Eigen::VectorXi> get_bus_from() const {return bus_hv_id_;}
     Eigen::Ref<const Eigen::VectorXi> get_bus_to() const {return bus_lv_id_;}
 
     // model paramters
-    Eigen::Ref<const CplxVect> yac_ff() const {return yac_ff_;}
-    Eigen::Ref<const CplxVect> yac_ft() const {return yac_ft_;}
-    Eigen::Ref<const CplxVect> yac_tf() const {return yac_tf_;}
-    Eigen::Ref<const CplxVect> yac_tt() const {return yac_tt_;}
+    Eigen::Ref<const CplxVect> yac_ff() const {return static_->yac_ff;}
+    Eigen::Ref<const CplxVect> yac_ft() const {return static_->yac_ft;}
+    Eigen::Ref<const CplxVect> yac_tf() const {return static_->yac_tf;}
+    Eigen::Ref<const CplxVect> yac_tt() const {return static_->yac_tt;}
+    Eigen::Ref<const CplxVect> ydc_ff() const {return static_->ydc_ff;}
+    Eigen::Ref<const CplxVect> ydc_ft() const {return static_->ydc_ft;}
+    Eigen::Ref<const CplxVect> ydc_tf() const {return static_->ydc_tf;}
+    Eigen::Ref<const CplxVect> ydc_tt() const {return static_->ydc_tt;}
+    Eigen::Ref<const RealVect> dc_x_tau_shift() const {return static_->dc_x_tau_shift;}
 
     const std::vector<bool>& get_status() const {return status_;}
 
@@ -210,18 +233,37 @@ class DataTrafo : public DataGeneric
         void _update_model_coeffs();
         
     protected:
-        // physical properties
-        RealVect r_;
-        RealVect x_;
-        CplxVect h_;
-        std::vector<bool> is_tap_hv_side_;  // whether the tap is hav side or not
+        // physical properties and model coefficients: they do not change after "init" and are shared
+        // between the copies of this instance (cloned only when modified, see CowPtr)
+        class StaticData
+        {
+            public:
+                // physical properties
+                RealVect r;
+                RealVect x;
+                CplxVect h;
+                std::vector<bool> is_tap_hv_side;  // whether the tap is hav side or not
+                RealVect ratio;  // transformer ratio
+                RealVect shift;  // phase shifter (in radian !)
+
+                // model coefficients
+                CplxVect yac_ff;
+                CplxVect yac_ft;
+                CplxVect yac_tf;
+                CplxVect yac_tt;
+
+                CplxVect ydc_ff;
+                CplxVect ydc_ft;
+                CplxVect ydc_tf;
+                CplxVect ydc_tt;
+                RealVect dc_x_tau_shift;
+        };
+        CowPtr<StaticData> static_;
 
         // input data
         Eigen::VectorXi bus_hv_id_;
         Eigen::VectorXi bus_lv_id_;
         std::vector<bool> status_;
-        RealVect ratio_;  // transformer ratio
-        RealVect shift_;  // phase shifter (in radian !)
 
         //output data
         RealVect res_p_hv_;  // in MW
@@ -234,18 +276,6 @@ class DataTrafo : public DataGeneric
         RealVect res_a_lv_;  // in kA
         RealVect res_theta_hv_;  // in degree
         RealVect res_theta_lv_;  // in degree
-
-        // model coefficients
-        CplxVect yac_ff_;
-        CplxVect yac_ft_;
-        CplxVect yac_tf_;
-        CplxVect yac_tt_;
-
-        CplxVect ydc_ff_;
-        CplxVect ydc_ft_;
-        CplxVect ydc_tf_;
-        CplxVect ydc_tt_;
-        RealVect dc_x_tau_shift_;
 };
 
 #endif  //DATATRAFO_H
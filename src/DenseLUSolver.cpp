@@ -0,0 +1,69 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "DenseLUSolver.h"
+
+ErrorType DenseLULinearSolver::initialize(const Eigen::SparseMatrix<real_type> & J){
+    // allocate the memory once and for all (as long as the size of J does not change)
+    const auto n = J.cols();
+    if((J.rows() != n) || (n == 0)) return ErrorType::SolverAnalyze;
+    dense_J_ = RealDenseMat::Zero(n, n);
+    x_ = RealVect::Zero(n);
+    solver_ = Eigen::PartialPivLU<RealDenseMat>(n);
+    return factorize(J);
+}
+
+ErrorType DenseLULinearSolver::factorize(const Eigen::SparseMatrix<real_type> & J){
+    const auto n = J.cols();
+    if((dense_J_.rows() != n) || (dense_J_.cols() != n)) return ErrorType::NotInitError;
+
+    // copy J into the dense buffer (no allocation here)
+    dense_J_.setZero();
+    for (Eigen::Index col_id = 0; col_id < J.outerSize(); ++col_id){
+        for (Eigen::SparseMatrix<real_type>::InnerIterator it(J, col_id); it; ++it){
+            dense_J_(it.row(), it.col()) = it.value();
+        }
+    }
+
+    // no allocation either: the decomposition has already the right size
+    solver_.compute(dense_J_);
+
+    // PartialPivLU does not check for singular matrices, so i do it here
+    const auto & diag_U = solver_.matrixLU().diagonal();
+    if(!diag_U.array().isFinite().all()) return ErrorType::SolverFactor;
+    if(diag_U.cwiseAbs().minCoeff() == 0.) return ErrorType::SingularMatrix;
+    return ErrorType::NoError;
+}
+
+ErrorType DenseLULinearSolver::solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized){
+    // solves (for x) the linear system J.x = b
+    // supposes that the solver has been initialized (call initialize() before calling that)
+    ErrorType err = ErrorType::NoError;
+    if(!has_just_been_inialized){
+        // if the call to "initialize" has been made this iteration, there is no need
+        // to re factor again the matrix
+        // i'm in the case where it has not
+        err = factorize(J);
+        if(err == ErrorType::SolverFactor) err = ErrorType::SolverReFactor;
+    }
+    if(err == ErrorType::NoError){
+        x_.noalias() = solver_.solve(b);
+        if(!x_.array().isFinite().all()) err = ErrorType::SolverSolve;
+        b = x_;
+    }
+    return err;
+}
+
+ErrorType DenseLULinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, with the decomposition already computed
+    if(solver_.rows() != J.rows()) return ErrorType::NotInitError;
+    RealMatRhs X = solver_.solve(B);
+    if(!X.allFinite()) return ErrorType::SolverSolve;
+    B = X;
+    return ErrorType::NoError;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef DENSELUSOLVER_H
+#define DENSELUSOLVER_H
+
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <cstdint> // for int32
+#include <chrono>
+#include <cmath>  // for PI
+
+// eigen is necessary to easily pass data from numpy to c++ without any copy.
+// and to optimize the matrix operations
+#include "Utils.h"
+#include "Eigen/Core"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "Eigen/LU"
+
+#include "CustTimer.h"
+#include "BaseNRSolver.h"
+/**
+class to handle the solver using newton-raphson method, using a dense "PartialPivLU" algorithm from Eigen.
+
+The (sparse) matrix is copied into a dense matrix before being factorized. This dense matrix (and the 
+decomposition) are allocated only once in "initialize" and then reused for all the subsequent calls to "solve"
+(as long as the size of the system does not change), so no memory allocation happens in the newton raphson loop.
+
+This is only interesting for small grids (a few hundreds buses at most) where the "bookkeeping" of the
+sparse solvers (symbolic analysis, indirections etc.) costs more than the dense factorization. For larger grids, prefer
+the sparse solvers (KLU, NICSLU or SparseLU).
+
+As long as the admittance matrix of the sytem does not change, you can reuse the same solver.
+Reusing the same solver is possible, but "reset" method must be called.
+**/
+class DenseLULinearSolver
+{
+    public:
+        typedef Eigen::Matrix<real_type, Eigen::Dynamic, Eigen::Dynamic> RealDenseMat;
+
+        DenseLULinearSolver():dense_J_(),x_(),solver_(){}
+        
+        // public api
+        ErrorType initialize(const Eigen::SparseMatrix<real_type> & J);
+        ErrorType solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized);
+        // solve J.X = B (in place) for all the columns of B, using the last factorization (J is not factorized again)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = true;  // the decomposition is only read in "solve_many" (buffer x_ is not used)
+        ErrorType reset(){ 
+            dense_J_ = RealDenseMat();
+            x_ = RealVect();
+            solver_ = Eigen::PartialPivLU<RealDenseMat>();
+            return ErrorType::NoError;
+        }
+        void set_outer_tol(real_type /*tol*/) {}  // direct solver: the linear system is solved exactly
+        // the decomposition (and the buffers) of other are copied, "initialize" is not needed afterwards
+        bool reuse_factorization(const DenseLULinearSolver & other){
+            if(other.solver_.rows() == 0) return false;
+            dense_J_ = other.dense_J_;
+            x_ = other.x_;
+            solver_ = other.solver_;
+            return true;
+        }
+
+    protected:
+        // copy the sparse matrix in the (already allocated) dense buffer and factorize it
+        ErrorType factorize(const Eigen::SparseMatrix<real_type> & J);
+
+    private:
+        RealDenseMat dense_J_;  // buffer used to store the dense version of J
+        RealVect x_;  // buffer used to store the solution of the linear system
+        Eigen::PartialPivLU<RealDenseMat> solver_;
+
+        // no copy allowed
+        DenseLULinearSolver( const DenseLULinearSolver & ) =delete ;
+        DenseLULinearSolver & operator=( const DenseLULinearSolver & ) =delete ;
+};
+
+#endif // DENSELUSOLVER_H
@@ -0,0 +1,379 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "GaussSeidelColoredSolver.h"
+
+#include <algorithm>  // for std::max and std::min
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace {
+    // all the threads wait for each other before the next color is updated
+    class ColorBarrier
+    {
+        public:
+            explicit ColorBarrier(int nb_thread):nb_thread_(nb_thread), nb_waiting_(0), generation_(0){}
+
+            void wait(){
+                std::unique_lock<std::mutex> lock(mutex_);
+                const unsigned long generation = generation_;
+                ++nb_waiting_;
+                if(nb_waiting_ == nb_thread_){
+                    nb_waiting_ = 0;
+                    ++generation_;
+                    cv_.notify_all();
+                }else{
+                    cv_.wait(lock, [this, generation]{return generation != generation_;});
+                }
+            }
+
+        private:
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            const int nb_thread_;
+            int nb_waiting_;
+            unsigned long generation_;
+    };
+}
+
+/**
+nb_thread - 1 threads waiting for a job. The calling thread is the worker 0: "run" starts the job on all
+the threads and returns once they are all done. The threads are stopped (and joined) by the destructor.
+**/
+class GaussSeidelColoredSolver::Workers
+{
+    public:
+        explicit Workers(int nb_thread):
+            nb_thread_(nb_thread),
+            job_(nullptr),
+            generation_(0),
+            nb_done_(0),
+            stop_(false)
+        {
+            threads_.reserve(nb_thread - 1);
+            for(int thread_id = 1; thread_id < nb_thread; ++thread_id){
+                threads_.emplace_back(&Workers::loop, this, thread_id);
+            }
+        }
+
+        ~Workers(){
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_start_.notify_all();
+            for(auto & thread : threads_) thread.join();
+        }
+
+        int nb_thread() const {return nb_thread_;}
+
+        // call job(thread_id) on all the threads (job should not throw)
+        void run(const std::function<void(int)> & job){
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = &job;
+                nb_done_ = 0;
+                ++generation_;
+            }
+            cv_start_.notify_all();
+            job(0);
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_done_.wait(lock, [this]{return nb_done_ == nb_thread_ - 1;});
+            job_ = nullptr;
+        }
+
+    private:
+        void loop(int thread_id){
+            unsigned long generation = 0;
+            while(true){
+                const std::function<void(int)> * job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_start_.wait(lock, [this, generation]{return stop_ || (generation != generation_);});
+                    if(stop_) return;
+                    generation = generation_;
+                    job = job_;
+                }
+                (*job)(thread_id);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ++nb_done_;
+                }
+                cv_done_.notify_one();
+            }
+        }
+
+    private:
+        const int nb_thread_;
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable cv_start_;
+        std::condition_variable cv_done_;
+        const std::function<void(int)> * job_;
+        unsigned long generation_;
+        int nb_done_;
+        bool stop_;
+};
+
+GaussSeidelColoredSolver::GaussSeidelColoredSolver():
+    GaussSeidelSolver(),
+    nb_thread_(1),
+    omega_param_(1.8),
+    adaptive_(true),
+    omega_(1.),
+    rho_(-1.),
+    prev_delta_(-1.),
+    ref_delta_(-1.),
+    nb_estimate_(0),
+    need_coloring_(true)
+{}
+
+GaussSeidelColoredSolver::~GaussSeidelColoredSolver(){}
+
+void GaussSeidelColoredSolver::reset(){
+    GaussSeidelSolver::reset();
+    omega_ = 1.;
+    rho_ = -1.;
+    prev_delta_ = -1.;
+    ref_delta_ = -1.;
+    nb_estimate_ = 0;
+    Ybus_csr_ = Eigen::SparseMatrix<cplx_type, Eigen::RowMajor>();
+    diag_inv_ = CplxVect();
+    is_pv_.clear();
+    need_coloring_ = true;
+    color_buses_.clear();
+    color_start_.clear();
+}
+
+void GaussSeidelColoredSolver::set_nb_thread(int nb_thread){
+    if(nb_thread < 1){
+        std::ostringstream exc_;
+        exc_ << "GaussSeidelColoredSolver::set_nb_thread: nb_thread should be >= 1. You provided: " << nb_thread;
+        throw std::runtime_error(exc_.str());
+    }
+    nb_thread_ = nb_thread;
+}
+
+void GaussSeidelColoredSolver::set_sor(real_type omega, bool adaptive){
+    if(!std::isfinite(omega) || (omega <= 0.) || (omega >= 2.)){
+        std::ostringstream exc_;
+        exc_ << "GaussSeidelColoredSolver::set_sor: omega should be in ]0, 2[. You provided: " << omega;
+        throw std::runtime_error(exc_.str());
+    }
+    if(adaptive && (omega < 1.)){
+        std::ostringstream exc_;
+        exc_ << "GaussSeidelColoredSolver::set_sor: in adaptive mode, omega (the maximum relaxation factor) should be >= 1. You provided: " << omega;
+        throw std::runtime_error(exc_.str());
+    }
+    omega_param_ = omega;
+    adaptive_ = adaptive;
+}
+
+bool GaussSeidelColoredSolver::compute_pf(const Eigen::SparseMatrix<cplx_type> & Ybus,
+                                          CplxVect & V,
+                                          const CplxVect & Sbus,
+                                          const Eigen::VectorXi & slack_ids,
+                                          const RealVect & slack_weights,  // currently unused
+                                          const Eigen::VectorXi & pv,
+                                          const Eigen::VectorXi & pq,
+                                          int max_iter,
+                                          real_type tol
+                                          )
+{
+    // the row major copy (and the diagonal) are updated at each powerflow: this is O(nnz) and the
+    // coefficients of Ybus might have changed
+    Ybus_csr_ = Ybus;
+    Ybus_csr_.makeCompressed();
+    diag_inv_ = Ybus.diagonal();
+    diag_inv_ = diag_inv_.array().inverse();
+
+    // the pv / pq buses might have changed, buses will be colored again at the first iteration
+    need_coloring_ = true;
+
+    // relaxation factor is estimated again for each powerflow
+    omega_ = adaptive_ ? 1. : omega_param_;
+    rho_ = -1.;
+    prev_delta_ = -1.;
+    ref_delta_ = -1.;
+    nb_estimate_ = 0;
+
+    // the threads (if any) are created at the first iteration and stopped at the end of the powerflow
+    bool res;
+    try{
+        res = GaussSeidelSolver::compute_pf(Ybus, V, Sbus, slack_ids, slack_weights, pv, pq, max_iter, tol);
+    }catch(...){
+        workers_.reset();
+        throw;
+    }
+    workers_.reset();
+    return res;
+}
+
+void GaussSeidelColoredSolver::color_buses(const Eigen::VectorXi & pv,
+                                           const Eigen::VectorXi & pq)
+{
+    const Eigen::Index nb_bus = Ybus_csr_.rows();
+    is_pv_.assign(nb_bus, false);
+    std::vector<bool> to_update(nb_bus, false);
+    for(Eigen::Index i = 0; i < pv.size(); ++i){
+        is_pv_[pv.coeff(i)] = true;
+        to_update[pv.coeff(i)] = true;
+    }
+    for(Eigen::Index i = 0; i < pq.size(); ++i) to_update[pq.coeff(i)] = true;
+
+    // greedy coloring: each bus gets the smallest color not used by its (already colored) neighbors
+    std::vector<int> bus_color(nb_bus, -1);
+    std::vector<Eigen::Index> forbidden;  // forbidden[c] == bus_id if color c is used by a neighbor of bus_id
+    int nb_color = 0;
+    for(Eigen::Index bus_id = 0; bus_id < nb_bus; ++bus_id){
+        if(!to_update[bus_id]) continue;
+        for (Eigen::SparseMatrix<cplx_type, Eigen::RowMajor>::InnerIterator it(Ybus_csr_, bus_id); it; ++it){
+            const int neigh_color = bus_color[it.col()];
+            if(neigh_color >= 0) forbidden[neigh_color] = bus_id;
+        }
+        int color = 0;
+        while((color < nb_color) && (forbidden[color] == bus_id)) ++color;
+        if(color == nb_color){
+            ++nb_color;
+            forbidden.push_back(-1);
+        }
+        bus_color[bus_id] = color;
+    }
+
+    // sort the buses by color (counting sort, to keep the original order within a color)
+    color_start_.assign(nb_color + 1, 0);
+    for(Eigen::Index bus_id = 0; bus_id < nb_bus; ++bus_id){
+        if(bus_color[bus_id] >= 0) ++color_start_[bus_color[bus_id] + 1];
+    }
+    for(int color = 0; color < nb_color; ++color) color_start_[color + 1] += color_start_[color];
+    color_buses_.assign(color_start_[nb_color], -1);
+    std::vector<Eigen::Index> pos(color_start_.begin(), color_start_.end() - 1);
+    for(Eigen::Index bus_id = 0; bus_id < nb_bus; ++bus_id){
+        const int color = bus_color[bus_id];
+        if(color >= 0) color_buses_[pos[color]++] = static_cast<int>(bus_id);
+    }
+    need_coloring_ = false;
+}
+
+real_type GaussSeidelColoredSolver::update_buses(CplxVect & tmp_Sbus, Eigen::Index beg, Eigen::Index end)
+{
+    // buses of the same color are not connected: they can be updated in any order (and in parallel)
+    real_type max_delta = 0.;
+    cplx_type tmp;
+    for(Eigen::Index bus_tmp = beg; bus_tmp < end; ++bus_tmp)
+    {
+        const int k = color_buses_[bus_tmp];
+        cplx_type YbusV_k = 0.;  // Ybus[k,:] * V
+        for (Eigen::SparseMatrix<cplx_type, Eigen::RowMajor>::InnerIterator it(Ybus_csr_, k); it; ++it){
+            YbusV_k += it.value() * V_.coeff(it.col());
+        }
+        if(is_pv_[k]){
+            // update Sbus
+            tmp = std::conj(YbusV_k);  // conj(Ybus[k,:] * V)
+            tmp *= V_.coeff(k);  // (V[k] * conj(Ybus[k,:] * V))
+            tmp = my_i * std::imag(tmp);
+            tmp_Sbus.coeffRef(k) = std::real(tmp_Sbus.coeff(k)) + tmp;
+        }
+        // update V
+        tmp = tmp_Sbus.coeff(k) / V_.coeff(k);
+        tmp = std::conj(tmp);
+        tmp -= YbusV_k;
+        tmp *= diag_inv_.coeff(k);
+        max_delta = std::max(max_delta, std::abs(tmp));
+        V_.coeffRef(k) += omega_ * tmp;
+
+        // make sure the voltage magnitudes are not modified at pv buses
+        if(is_pv_[k]) V_.coeffRef(k) *= Vm_.coeff(k) / std::abs(V_.coeff(k));
+    }
+    return max_delta;
+}
+
+void GaussSeidelColoredSolver::one_iter(CplxVect & tmp_Sbus,
+                                        const Eigen::SparseMatrix<cplx_type> & /*Ybus*/,  // Ybus_csr_ is used instead
+                                        const Eigen::VectorXi & pv,
+                                        const Eigen::VectorXi & pq)
+{
+    if(need_coloring_) color_buses(pv, pq);
+
+    const int nb_color = get_nb_color();
+    Eigen::Index max_color_size = 0;
+    for(int color = 0; color < nb_color; ++color){
+        max_color_size = std::max(max_color_size, color_start_[color + 1] - color_start_[color]);
+    }
+    const int nb_thread = static_cast<int>(std::min(static_cast<Eigen::Index>(nb_thread_),
+                                                    max_color_size / MIN_BUS_PER_THREAD));
+
+    real_type delta = 0.;
+    if(nb_thread <= 1){
+        for(int color = 0; color < nb_color; ++color){
+            delta = std::max(delta, update_buses(tmp_Sbus, color_start_[color], color_start_[color + 1]));
+        }
+    }else{
+        // each thread updates a part of each color, and waits for the others before the next color
+        if(!workers_ || (workers_->nb_thread() != nb_thread)) workers_.reset(new Workers(nb_thread));
+        std::vector<real_type> deltas(nb_thread, 0.);
+        ColorBarrier barrier(nb_thread);
+        const std::function<void(int)> job = [this, &tmp_Sbus, &deltas, &barrier, nb_color, nb_thread](int thread_id){
+            for(int color = 0; color < nb_color; ++color){
+                const Eigen::Index beg = color_start_[color];
+                const Eigen::Index size = color_start_[color + 1] - beg;
+                const Eigen::Index my_beg = beg + (thread_id * size) / nb_thread;
+                const Eigen::Index my_end = beg + ((thread_id + 1) * size) / nb_thread;
+                deltas[thread_id] = std::max(deltas[thread_id], update_buses(tmp_Sbus, my_beg, my_end));
+                barrier.wait();
+            }
+        };
+        workers_->run(job);
+        for(const auto el : deltas) delta = std::max(delta, el);
+    }
+    update_omega(delta);
+}
+
+void GaussSeidelColoredSolver::update_omega(real_type delta)
+{
+    if(!adaptive_){
+        prev_delta_ = delta;
+        return;
+    }
+    if(omega_ == 1.){
+        // plain gauss seidel iterations: estimate the contraction rate
+        const real_type ratio = prev_delta_ > 0. ? delta / prev_delta_ : 1.;
+        if(ratio < 1.){
+            // the estimation is used only once it is stable, 1. - rho (which drives omega) being known up to 10%
+            if((rho_ >= 0.) && (std::abs(ratio - rho_) <= 0.1 * (1. - ratio))) ++nb_estimate_;
+            else nb_estimate_ = 0;
+            rho_ = ratio;
+            if(nb_estimate_ >= NB_ESTIMATE){
+                // optimal relaxation factor (Young), using rho as the spectral radius of the gauss seidel iteration
+                omega_ = 2. / (1. + std::sqrt(1. - rho_));
+                omega_ = std::min(omega_, omega_param_);
+                omega_ = std::max(omega_, static_cast<real_type>(1.));
+                ref_delta_ = delta;
+                nb_estimate_ = 0;
+            }
+        }else{
+            nb_estimate_ = 0;
+        }
+    }else{
+        // relaxed iterations are not monotonic (especially right after omega changed): they are checked
+        // every NB_CHECK iterations only
+        ++nb_estimate_;
+        if(nb_estimate_ >= NB_CHECK){
+            if(delta >= ref_delta_){
+                // relaxed iterations do not converge: go back to plain gauss seidel and estimate rho again
+                omega_ = 1.;
+                rho_ = -1.;
+            }
+            ref_delta_ = delta;
+            nb_estimate_ = 0;
+        }
+    }
+    prev_delta_ = delta;
+}
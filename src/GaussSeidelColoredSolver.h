@@ -0,0 +1,122 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef GAUSSSEIDELCOLOREDSOLVER_H
+#define GAUSSSEIDELCOLOREDSOLVER_H
+
+#include <memory>  // for std::unique_ptr
+
+#include "GaussSeidelSolver.h"
+
+/**
+The gauss seidel method (with successive over relaxation), written for larger grids:
+
+- a row major (CSR) copy of Ybus is kept, as well as the inverse of its diagonal, so that
+  the update of a bus only reads the non zero coefficients of its row (instead of scanning the whole
+  matrix with `Ybus.row(k)` and performing a binary search for `Ybus.coeff(k,k)`)
+- the graph of the buses is colored (greedy coloring), two connected buses never have the same color.
+  The buses are updated color by color, and all the buses of the same color are independent: they
+  can be updated in parallel (if `nb_thread` > 1). The threads are created at the first iteration and
+  kept alive (waiting for the next iteration) until the end of the powerflow.
+- the update is relaxed (SOR): V[k] += omega * delta[k]. omega is either fixed, or (adaptive mode)
+  estimated from the contraction rate of the plain gauss seidel iterations (omega = 2 / (1 + sqrt(1 - rho)))
+  and set back to 1. if the relaxed iterations start to diverge.
+**/
+class GaussSeidelColoredSolver : public GaussSeidelSolver
+{
+    public:
+        // defined in the cpp file, where GaussSeidelColoredSolver::Workers is defined
+        GaussSeidelColoredSolver();
+        ~GaussSeidelColoredSolver();
+
+        virtual
+        bool compute_pf(const Eigen::SparseMatrix<cplx_type> & Ybus,
+                        CplxVect & V,
+                        const CplxVect & Sbus,
+                        const Eigen::VectorXi & slack_ids,
+                        const RealVect & slack_weights,  // currently unused
+                        const Eigen::VectorXi & pv,
+                        const Eigen::VectorXi & pq,
+                        int max_iter,
+                        real_type tol
+                        ) ;
+
+        virtual
+        void reset();
+
+        // number of threads used to update the buses of the same color
+        void set_nb_thread(int nb_thread);
+        int get_nb_thread() const {return nb_thread_;}
+
+        /**
+        if adaptive is true, omega is the maximum relaxation factor allowed, otherwise it is the (fixed) relaxation factor.
+        It should be in ]0, 2[ (1. being the standard gauss seidel method)
+        **/
+        void set_sor(real_type omega, bool adaptive);
+        std::tuple<real_type, bool> get_sor() const {return std::tuple<real_type, bool>(omega_param_, adaptive_);}
+
+        // relaxation factor used for the last iteration
+        real_type get_omega() const {return omega_;}
+        // number of colors (independent sets of buses) used for the last powerflow
+        int get_nb_color() const {return static_cast<int>(color_start_.size()) - 1;}
+
+    protected:
+        // the threads used to update the buses of the same color, alive during a powerflow (defined in the cpp file)
+        class Workers;
+
+        virtual
+        void one_iter(CplxVect & tmp_Sbus,
+                      const Eigen::SparseMatrix<cplx_type> & Ybus,
+                      const Eigen::VectorXi & pv,
+                      const Eigen::VectorXi & pq
+                      );
+
+        // color the buses of the pv and pq lists (only the graph of Ybus_csr_ is used)
+        void color_buses(const Eigen::VectorXi & pv,
+                         const Eigen::VectorXi & pq);
+
+        // update all the buses of color_buses_[beg:end] (all of the same color), returns max |delta|
+        real_type update_buses(CplxVect & tmp_Sbus, Eigen::Index beg, Eigen::Index end);
+
+        // update the relaxation factor given the size of the last (unrelaxed) update
+        void update_omega(real_type delta);
+
+    protected:
+        // the minimum number of buses for a thread to be worth using (per color)
+        static const Eigen::Index MIN_BUS_PER_THREAD = 1024;
+        // the number of plain gauss seidel iterations with a stable contraction rate before omega is computed
+        static const int NB_ESTIMATE = 3;
+        // the relaxed iterations are checked (and omega set back to 1. if they diverge) every NB_CHECK iterations
+        static const int NB_CHECK = 10;
+
+        int nb_thread_;
+        real_type omega_param_;
+        bool adaptive_;
+
+        real_type omega_;  // current relaxation factor
+        real_type rho_;  // estimation of the contraction rate of the gauss seidel iterations
+        real_type prev_delta_;  // size of the previous update
+        real_type ref_delta_;  // size of the update at the last check of the relaxed iterations
+        int nb_estimate_;  // number of iterations since the last change of omega (or the last check)
+
+        Eigen::SparseMatrix<cplx_type, Eigen::RowMajor> Ybus_csr_;
+        CplxVect diag_inv_;  // 1. / Ybus(k,k)
+        std::vector<bool> is_pv_;
+        bool need_coloring_;
+        std::vector<int> color_buses_;  // the buses, sorted by color
+        std::vector<Eigen::Index> color_start_;  // buses of color c are color_buses_[color_start_[c]:color_start_[c+1]]
+        std::unique_ptr<Workers> workers_;  // only set during a powerflow, if more than one thread is used
+
+    private:
+        // no copy allowed
+        GaussSeidelColoredSolver( const GaussSeidelColoredSolver & ) ;
+        GaussSeidelColoredSolver & operator=( const GaussSeidelColoredSolver & ) ;
+
+};
+
+#endif // GAUSSSEIDELCOLOREDSOLVER_H
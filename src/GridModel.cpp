@@ -8,7 +8,194 @@
 
 #include "GridModel.h"
 
-GridModel::GridModel(const GridModel & other)
+#include <fstream>
+#include <limits>
+#include <cmath>  // for std::isfinite
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <numeric>  // std::iota
+#include <algorithm>
+
+namespace {
+    // copy the results in a buffer of the caller (starting at `offset`), converted with `factor`. If `finite_only`
+    // the non finite values are replaced by 0.
+    template<class Buffer>
+    void copy_res(const Eigen::Ref<const RealVect> & res, const Buffer & buffer, int offset,
+                  real_type factor = 1.0, bool finite_only = false)
+    {
+        if(!buffer.is_set()) return;
+        const int nb_el = static_cast<int>(res.size());
+        for(int el_id = 0; el_id < nb_el; ++el_id){
+            real_type val = res(el_id) * factor;
+            if(finite_only && !std::isfinite(val)) val = 0.;
+            buffer(offset + el_id) = static_cast<float>(val);
+        }
+    }
+
+    void check_res_buffer(const char * buffer_nm, int buffer_size, int nb_el)
+    {
+        if(buffer_size != nb_el){
+            std::ostringstream exc_;
+            exc_ << "GridModel: the buffer \"" << buffer_nm << "\" has a size of " << buffer_size;
+            exc_ << " but there are " << nb_el << " elements of this type on the grid.";
+            throw std::runtime_error(exc_.str());
+        }
+    }
+
+    // the tasks fun(0), ..., fun(nb_task - 1), run by the threads that call "work" (each task is run once)
+    struct ParallelJob
+    {
+        ParallelJob(int nb_task, const std::function<void(int)> & fun):
+            nb_task(nb_task), fun(fun), next_task(0), nb_done(0), exceptions(nb_task) {}
+
+        void work(){
+            for(int task_id = next_task++; task_id < nb_task; task_id = next_task++){
+                try{
+                    fun(task_id);
+                }catch(...){
+                    exceptions[task_id] = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if(++nb_done == nb_task) cv_done.notify_all();
+            }
+        }
+
+        // wait for all the tasks to be over (not only the ones run by this thread)
+        void wait(){
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_done.wait(lock, [this]{return nb_done == nb_task;});
+        }
+
+        const int nb_task;
+        const std::function<void(int)> & fun;  // only called while the caller of parallel_for waits
+        std::atomic<int> next_task;
+        int nb_done;
+        std::vector<std::exception_ptr> exceptions;
+        std::mutex mutex;
+        std::condition_variable cv_done;
+    };
+
+    // hardware_concurrency - 1 threads, created the first time a computation is split among threads and kept
+    // (waiting for jobs) until the end of the program. It can be used by several grid models at the same time.
+    class ThreadPool
+    {
+        public:
+            static ThreadPool & instance(){
+                // never destroyed: joining threads while the library is unloaded can dead lock on some platforms
+                static ThreadPool * pool = new ThreadPool(static_cast<int>(std::thread::hardware_concurrency()) - 1);
+                return *pool;
+            }
+
+            int nb_worker() const {return nb_worker_;}
+
+            // nb_helper threads of the pool (at most) will work on job
+            void submit(const std::shared_ptr<ParallelJob> & job, int nb_helper){
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for(int i = 0; i < nb_helper; ++i) queue_.push_back(job);
+                }
+                cv_.notify_all();
+            }
+
+        private:
+            explicit ThreadPool(int nb_worker):nb_worker_(std::max(nb_worker, 0)){
+                for(int thread_id = 0; thread_id < nb_worker_; ++thread_id) std::thread(&ThreadPool::loop, this).detach();
+            }
+
+            void loop(){
+                while(true){
+                    std::shared_ptr<ParallelJob> job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        cv_.wait(lock, [this]{return !queue_.empty();});
+                        job = queue_.front();
+                        queue_.pop_front();
+                    }
+                    job->work();  // returns immediately if the other threads already ran all the tasks
+                }
+            }
+
+            const int nb_worker_;
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::deque<std::shared_ptr<ParallelJob> > queue_;
+    };
+
+    // call fun(0), fun(1), ..., fun(nb_task - 1), on the calling thread and on the threads of the ThreadPool.
+    // The first exception raised (if any) is raised again once all the tasks are over.
+    void parallel_for(int nb_task, const std::function<void(int)> & fun)
+    {
+        if(nb_task <= 0) return;
+        std::shared_ptr<ParallelJob> job = std::make_shared<ParallelJob>(nb_task, fun);
+        if(nb_task > 1){
+            ThreadPool & pool = ThreadPool::instance();
+            const int nb_helper = std::min(nb_task - 1, pool.nb_worker());
+            if(nb_helper > 0) pool.submit(job, nb_helper);
+        }
+        job->work();
+        job->wait();
+        for(auto & exc : job->exceptions){
+            if(exc) std::rethrow_exception(exc);
+        }
+    }
+
+    // add the power injected by some elements (sign is 1. for the production, -1. for the consumption)
+    template<class TRes>
+    void add_injection(std::vector<cplx_type> & injection, const TRes & res, const std::vector<bool> & status,
+                       const Eigen::Ref<const Eigen::VectorXi> & bus_id, real_type sign)
+    {
+        const auto & p = std::get<0>(res);
+        const auto & q = std::get<1>(res);
+        for(std::size_t el_id = 0; el_id < status.size(); ++el_id){
+            if(!status[el_id]) continue;
+            injection[bus_id(el_id)] += sign * cplx_type(p(el_id), q(el_id));
+        }
+    }
+
+    // only keep the elements `keep[el_id]` in all the vectors of the state of a table of elements (see
+    // GridModel::ward_equivalent)
+    template<std::size_t I = 0, class... T>
+    typename std::enable_if<I == sizeof...(T)>::type filter_state(std::tuple<std::vector<T>...> &,
+                                                                 const std::vector<bool> &) {}
+    template<std::size_t I = 0, class... T>
+    typename std::enable_if<I < sizeof...(T)>::type filter_state(std::tuple<std::vector<T>...> & state,
+                                                                const std::vector<bool> & keep)
+    {
+        auto & vect = std::get<I>(state);
+        std::size_t nb_kept = 0;
+        for(std::size_t el_id = 0; el_id < vect.size(); ++el_id){
+            if(keep[el_id]) vect[nb_kept++] = vect[el_id];
+        }
+        vect.resize(nb_kept);
+        filter_state<I + 1>(state, keep);
+    }
+    // the former ids of the elements kept by filter_state
+    std::vector<int> kept_ids(const std::vector<bool> & keep)
+    {
+        std::vector<int> ids;
+        for(std::size_t el_id = 0; el_id < keep.size(); ++el_id){
+            if(keep[el_id]) ids.push_back(static_cast<int>(el_id));
+        }
+        return ids;
+    }
+}
+
+GridModel::GridModel(const GridModel & other):
+    result_mask_(other.result_mask_),
+    results_pending_(0),
+    results_ac_(other.results_ac_),
+    kron_reduction_(other.kron_reduction_),
+    kron_nb_eliminated_(0),
+    ward_boundary_buses_(other.ward_boundary_buses_),
+    ward_injection_ids_(other.ward_injection_ids_),
+    ward_extended_(other.ward_extended_),
+    ward_ids_(other.ward_ids_)
 {
     reset(true, true, true);
 
@@ -17,8 +204,10 @@ GridModel::GridModel(const GridModel & other)
 
     // copy the powersystem representation
     // 1. bus
-    bus_vn_kv_ = other.bus_vn_kv_;
+    static_ = other.static_;  // shared (and not copied) until one of the two models modifies it
     bus_status_ = other.bus_status_;
+    connectivity_ = other.connectivity_;
+    node_breaker_ = other.node_breaker_;
 
     // 2. powerline
     powerlines_ = other.powerlines_;
@@ -43,34 +232,88 @@ GridModel::GridModel(const GridModel & other)
     // 8. storage units
     storages_ = other.storages_;
 
-    // copy the attributes specific grid2op (speed optimization)
-    n_sub_ = other.n_sub_;
-    load_pos_topo_vect_ = other.load_pos_topo_vect_;
-    gen_pos_topo_vect_ = other.gen_pos_topo_vect_;
-    line_or_pos_topo_vect_ = other.line_or_pos_topo_vect_;
-    line_ex_pos_topo_vect_ = other.line_ex_pos_topo_vect_;
-    trafo_hv_pos_topo_vect_ = other.trafo_hv_pos_topo_vect_;
-    trafo_lv_pos_topo_vect_ = other.trafo_lv_pos_topo_vect_;
-    storage_pos_topo_vect_ = other.storage_pos_topo_vect_;
-
-    load_to_subid_ = other.load_to_subid_;
-    gen_to_subid_ = other.gen_to_subid_;
-    line_or_to_subid_ = other.line_or_to_subid_;
-    line_ex_to_subid_ = other.line_ex_to_subid_;
-    trafo_hv_to_subid_ = other.trafo_hv_to_subid_;
-    trafo_lv_to_subid_ = other.trafo_lv_to_subid_;
-    storage_to_subid_ = other.storage_to_subid_;
-
     // assign the right solver
     _solver.change_solver(other._solver.get_type());
     _dc_solver.change_solver(other._dc_solver.get_type());
+    _solver.copy_config(other._solver);
+    _dc_solver.copy_config(other._dc_solver);
     compute_results_ = other.compute_results_;
+    // the results not computed on the other model cannot be computed on this one
+    reset_results(other.results_pending_);
+
+    // the snapshots (and the changes made since) can be restored on the copy too
+    journal_ = other.journal_;
+    journal_marks_ = other.journal_marks_;
+    snapshots_ = other.snapshots_;
+    next_snapshot_id_ = other.next_snapshot_id_;
+}
+
+GridModel::GridModel(const GridModel & other, bool keep_solver_state):
+    GridModel(other)
+{
+    if(keep_solver_state) copy_solver_state(other);
+}
+
+void GridModel::set_klu_config(const KLUSolverConfig & config)
+{
+    // raises if KLU is not available or if the config is not valid (nothing is changed in this case)
+    _solver.set_klu_config(config);
+    _dc_solver.set_klu_config(config);
+    for(auto * islands : {&islands_ac_, &islands_dc_}){
+        for(auto & island : islands->islands){
+            if(island.solver) island.solver->set_klu_config(config);
+        }
+    }
+}
+
+void GridModel::set_gauss_seidel_colored_config(int nb_thread, real_type omega, bool adaptive)
+{
+    // raises if one of the settings is not valid (nothing is changed in this case)
+    _solver.set_gauss_seidel_colored_config(nb_thread, omega, adaptive);
+    _dc_solver.set_gauss_seidel_colored_config(nb_thread, omega, adaptive);
+    for(auto * islands : {&islands_ac_, &islands_dc_}){
+        for(auto & island : islands->islands){
+            if(island.solver) island.solver->set_gauss_seidel_colored_config(nb_thread, omega, adaptive);
+        }
+    }
+}
+
+void GridModel::copy_solver_state(const GridModel & other)
+{
+    // the admittance matrices and the conversion of the bus ids (they are recomputed anyway if the topology changed)
+    need_reset_ = other.need_reset_;
+    topo_changed_ = other.topo_changed_;
+    id_me_to_ac_solver_ = other.id_me_to_ac_solver_;
+    id_ac_solver_to_me_ = other.id_ac_solver_to_me_;
+    id_me_to_dc_solver_ = other.id_me_to_dc_solver_;
+    id_dc_solver_to_me_ = other.id_dc_solver_to_me_;
+    slack_bus_id_ = other.slack_bus_id_;
+    slack_bus_id_ac_solver_ = other.slack_bus_id_ac_solver_;
+    slack_bus_id_dc_solver_ = other.slack_bus_id_dc_solver_;
+    slack_weights_ = other.slack_weights_;
+    Ybus_ac_ = other.Ybus_ac_;
+    Ybus_dc_ = other.Ybus_dc_;
+    Sbus_ = other.Sbus_;
+    bus_pv_ = other.bus_pv_;
+    bus_pq_ = other.bus_pq_;
+    zero_impedance_lines_ = other.zero_impedance_lines_;
+    // the islands are computed again from the admittance matrices
+    islands_ac_.ok = false;
+    islands_dc_.ok = false;
+    islands_res_ac_ = other.islands_res_ac_;
+    islands_res_dc_ = other.islands_res_dc_;
+
+    // the solvers (the factorization is copied, or shared, when the linear solver allows it)
+    _solver.copy_config(other._solver);
+    _dc_solver.copy_config(other._dc_solver);
+    _solver.copy_state(other._solver);
+    _dc_solver.copy_state(other._dc_solver);
 }
 
 //pickle
 GridModel::StateRes GridModel::get_state() const
 {
-    std::vector<real_type> bus_vn_kv(bus_vn_kv_.begin(), bus_vn_kv_.end());
+    std::vector<real_type> bus_vn_kv(static_->bus_vn_kv.begin(), static_->bus_vn_kv.end());
     int version_major = VERSION_MAJOR;
     int version_medium = VERSION_MEDIUM;
     int version_minor = VERSION_MINOR;
@@ -104,10 +347,18 @@ void GridModel::set_state(GridModel::StateRes & my_state)
 {
     // after loading back, the instance need to be reset anyway
     // TODO see if it's worth the trouble NOT to do it
+    drop_pending_results();
     reset(true, true, true);
     need_reset_ = true;
     compute_results_ = true;
     topo_changed_ = true;
+    clear_snapshots();  // the elements might not be the same anymore
+    connectivity_.clear();
+    branches_.clear();
+    node_breaker_.clear();
+    ward_boundary_buses_.clear();  // the elements might not be the same anymore
+    ward_injection_ids_.clear();
+    ward_ids_ = WardIds();
 
     // extract data from the state
     int version_major = std::get<0>(my_state);
@@ -146,8 +397,9 @@ void GridModel::set_state(GridModel::StateRes & my_state)
     // assign it to this instance
 
     // buses
-    // 1. bus_vn_kv_
-    bus_vn_kv_ = RealVect::Map(&bus_vn_kv[0], bus_vn_kv.size());
+    StaticData & static_data = static_.mut();  // static data are cloned here if they are shared with another instance
+    // 1. bus_vn_kv
+    static_data.bus_vn_kv = RealVect::Map(&bus_vn_kv[0], bus_vn_kv.size());
     // 2. bus status
     bus_status_ = bus_status;
 
@@ -168,17 +420,566 @@ void GridModel::set_state(GridModel::StateRes & my_state)
     storages_.set_state(state_storages);
 };
 
+std::string GridModel::to_bytes() const
+{
+    GridModel::StateRes state = get_state();
+    BinaryStateWriter writer;
+    // the version of lightsim2grid (the first 3 members of the state) is stored in the header
+    writer.write<3>(state);
+    return writer.finish();
+}
+
+void GridModel::from_bytes(const std::string & data)
+{
+    BinaryStateReader reader(data.data(), data.size());
+    GridModel::StateRes state;
+    // the compatibility is ensured by the version of the binary format (checked by the reader)
+    std::get<0>(state) = VERSION_MAJOR;
+    std::get<1>(state) = VERSION_MEDIUM;
+    std::get<2>(state) = VERSION_MINOR;
+    reader.read<3>(state);
+    reader.finish();
+    set_state(state);
+}
+
+void GridModel::save(const std::string & path) const
+{
+    const std::string data = to_bytes();
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
+    if(!file){
+        std::ostringstream exc_;
+        exc_ << "GridModel::save: impossible to write the grid in \"" << path << "\"";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void GridModel::load(const std::string & path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if(!file){
+        std::ostringstream exc_;
+        exc_ << "GridModel::load: impossible to open the file \"" << path << "\"";
+        throw std::runtime_error(exc_.str());
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    from_bytes(data);
+}
+
+// snapshot / restore
+int GridModel::snapshot()
+{
+    Snapshot snap;
+    snap.id = next_snapshot_id_++;
+    snap.journal_pos = journal_.size();
+    if(!topo_changed_){
+        // the admittance matrices and the solvers are up to date for the current topology
+        std::shared_ptr<GridModel> cache = std::make_shared<GridModel>(*this, true);
+        cache->clear_snapshots();
+        snap.topo_cache = cache;
+    }
+    snapshots_.push_back(snap);
+    return snap.id;
+}
+
+void GridModel::restore(int snapshot_id)
+{
+    std::size_t snap_pos = snapshots_.size();
+    for(std::size_t i = 0; i < snapshots_.size(); ++i){
+        if(snapshots_[i].id == snapshot_id){
+            snap_pos = i;
+            break;
+        }
+    }
+    if(snap_pos == snapshots_.size()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::restore: there is no snapshot with id " << snapshot_id << ". ";
+        exc_ << "Snapshots are discarded when an older snapshot is restored, or when the grid is modified ";
+        exc_ << "with set_state / init_bus / clear_snapshots.";
+        throw std::runtime_error(exc_.str());
+    }
+    const Snapshot snap = snapshots_[snap_pos];
+    const bool same_topo = same_topology(snap.journal_pos);
+    const bool topo_changed_before = topo_changed_;
+
+    drop_pending_results();
+    // undo the changes, last one first
+    for(std::size_t i = journal_.size(); i > snap.journal_pos; --i) undo(journal_[i - 1]);
+    journal_.resize(snap.journal_pos);
+    if(node_breaker_.is_init()) node_breaker_.update_all();  // the switches too
+    snapshots_.resize(snap_pos + 1);  // this snapshot can be restored again
+
+    if(same_topo){
+        // the admittance matrices (and the factorization) are still valid
+        topo_changed_ = topo_changed_before;
+    }else if(snap.topo_cache &&
+             (snap.topo_cache->_solver.get_type() == _solver.get_type()) &&
+             (snap.topo_cache->_dc_solver.get_type() == _dc_solver.get_type())){
+        copy_solver_state(*snap.topo_cache);
+    }else{
+        topo_changed_ = true;
+    }
+}
+
+bool GridModel::has_snapshot(int snapshot_id) const
+{
+    for(const auto & snap : snapshots_){
+        if(snap.id == snapshot_id) return true;
+    }
+    return false;
+}
+
+void GridModel::clear_snapshots()
+{
+    journal_.clear();
+    for(auto & marks : journal_marks_) marks.clear();
+    snapshots_.clear();
+}
+
+bool GridModel::need_journal(JournalKey key, int el_id, Eigen::Index nb_el)
+{
+    if((el_id < 0) || (el_id >= nb_el)) return false;  // the modification will fail anyway
+    std::vector<std::size_t> & marks = journal_marks_[static_cast<std::size_t>(key)];
+    if(static_cast<Eigen::Index>(marks.size()) < nb_el) marks.resize(nb_el, std::numeric_limits<std::size_t>::max());
+    const std::size_t mark = marks[el_id];
+    // the value has already been recorded after the last snapshot (the journal might have been truncated since)
+    if((mark >= snapshots_.back().journal_pos) &&
+       (mark < journal_.size()) &&
+       (journal_[mark].key == key) &&
+       (journal_[mark].el_id == el_id)) return false;
+    return true;
+}
+
+void GridModel::add_journal(JournalKey key, int el_id, int old_int, real_type old_real)
+{
+    journal_marks_[static_cast<std::size_t>(key)][el_id] = journal_.size();
+    journal_.push_back({key, el_id, old_int, old_real});
+}
+
+bool GridModel::is_topo_key(JournalKey key)
+{
+    switch (key)
+    {
+    case JournalKey::GenP:
+    case JournalKey::GenV:
+    case JournalKey::LoadP:
+    case JournalKey::LoadQ:
+    case JournalKey::SGenP:
+    case JournalKey::SGenQ:
+    case JournalKey::StorageP:
+    case JournalKey::StorageQ:
+        return false;
+    default:
+        // the status and the buses, and the p / q of the shunts (they are part of the admittance matrix)
+        return true;
+    }
+}
+
+int GridModel::get_topo_value(const JournalEntry & entry) const
+{
+    const int el_id = entry.el_id;
+    switch (entry.key)
+    {
+    case JournalKey::BusStatus: return bus_status_[el_id];
+    case JournalKey::LineStatus: return powerlines_.get_status()[el_id];
+    case JournalKey::LineBusOr: return powerlines_.get_bus_from()(el_id);
+    case JournalKey::LineBusEx: return powerlines_.get_bus_to()(el_id);
+    case JournalKey::TrafoStatus: return trafos_.get_status()[el_id];
+    case JournalKey::TrafoBusHv: return trafos_.get_bus_from()(el_id);
+    case JournalKey::TrafoBusLv: return trafos_.get_bus_to()(el_id);
+    case JournalKey::GenStatus: return generators_.get_status()[el_id];
+    case JournalKey::GenBus: return generators_.get_bus_id()(el_id);
+    case JournalKey::LoadStatus: return loads_.get_status()[el_id];
+    case JournalKey::LoadBus: return loads_.get_bus_id()(el_id);
+    case JournalKey::SGenStatus: return sgens_.get_status()[el_id];
+    case JournalKey::SGenBus: return sgens_.get_bus_id()(el_id);
+    case JournalKey::StorageStatus: return storages_.get_status()[el_id];
+    case JournalKey::StorageBus: return storages_.get_bus_id()(el_id);
+    case JournalKey::ShuntStatus: return shunts_.get_status()[el_id];
+    case JournalKey::ShuntBus: return shunts_.get_bus_id()(el_id);
+    case JournalKey::SwitchState: return node_breaker_.get_switch(el_id);
+    default:
+        std::ostringstream exc_;
+        exc_ << "GridModel::get_topo_value: the key " << static_cast<int>(entry.key) << " is not related to the topology";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+bool GridModel::same_topology(std::size_t journal_pos) const
+{
+    for(std::size_t i = journal_pos; i < journal_.size(); ++i){
+        const JournalEntry & entry = journal_[i];
+        if(!is_topo_key(entry.key)) continue;
+        if(entry.key == JournalKey::ShuntP){
+            if(shunts_.get_p_mw()(entry.el_id) != entry.old_real) return false;
+        }else if(entry.key == JournalKey::ShuntQ){
+            if(shunts_.get_q_mvar()(entry.el_id) != entry.old_real) return false;
+        }else if(get_topo_value(entry) != entry.old_int) return false;
+    }
+    return true;
+}
+
+void GridModel::undo(const JournalEntry & entry)
+{
+    // the data are modified directly (and not with the public methods), so nothing is recorded in the journal
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
+    const int el_id = entry.el_id;
+    switch (entry.key)
+    {
+    case JournalKey::BusStatus: bus_status_[el_id] = entry.old_int != 0; break;
+    case JournalKey::LineStatus:
+        undo_status(powerlines_, entry);
+        update_branch(powerlines_, el_id, el_id);
+        break;
+    case JournalKey::LineBusOr:
+        powerlines_.change_bus_or(el_id, entry.old_int, topo_changed_, nb_bus);
+        update_branch(powerlines_, el_id, el_id);
+        break;
+    case JournalKey::LineBusEx:
+        powerlines_.change_bus_ex(el_id, entry.old_int, topo_changed_, nb_bus);
+        update_branch(powerlines_, el_id, el_id);
+        break;
+    case JournalKey::TrafoStatus:
+        undo_status(trafos_, entry);
+        update_branch(trafos_, el_id, static_cast<int>(nb_powerline()) + el_id);
+        break;
+    case JournalKey::TrafoBusHv:
+        trafos_.change_bus_hv(el_id, entry.old_int, topo_changed_, nb_bus);
+        update_branch(trafos_, el_id, static_cast<int>(nb_powerline()) + el_id);
+        break;
+    case JournalKey::TrafoBusLv:
+        trafos_.change_bus_lv(el_id, entry.old_int, topo_changed_, nb_bus);
+        update_branch(trafos_, el_id, static_cast<int>(nb_powerline()) + el_id);
+        break;
+    case JournalKey::GenStatus: undo_status(generators_, entry); break;
+    case JournalKey::GenBus: generators_.change_bus(el_id, entry.old_int, topo_changed_, nb_bus); break;
+    case JournalKey::GenP:
+        undo_injection(generators_, entry, [this](int id, real_type val){generators_.change_p(id, val, topo_changed_);});
+        break;
+    case JournalKey::GenV:
+        undo_injection(generators_, entry, [this](int id, real_type val){generators_.change_v(id, val, topo_changed_);});
+        break;
+    case JournalKey::LoadStatus: undo_status(loads_, entry); break;
+    case JournalKey::LoadBus: loads_.change_bus(el_id, entry.old_int, topo_changed_, nb_bus); break;
+    case JournalKey::LoadP:
+        undo_injection(loads_, entry, [this](int id, real_type val){loads_.change_p(id, val, topo_changed_);});
+        break;
+    case JournalKey::LoadQ:
+        undo_injection(loads_, entry, [this](int id, real_type val){loads_.change_q(id, val, topo_changed_);});
+        break;
+    case JournalKey::SGenStatus: undo_status(sgens_, entry); break;
+    case JournalKey::SGenBus: sgens_.change_bus(el_id, entry.old_int, topo_changed_, nb_bus); break;
+    case JournalKey::SGenP:
+        undo_injection(sgens_, entry, [this](int id, real_type val){sgens_.change_p(id, val, topo_changed_);});
+        break;
+    case JournalKey::SGenQ:
+        undo_injection(sgens_, entry, [this](int id, real_type val){sgens_.change_q(id, val, topo_changed_);});
+        break;
+    case JournalKey::StorageStatus: undo_status(storages_, entry); break;
+    case JournalKey::StorageBus: storages_.change_bus(el_id, entry.old_int, topo_changed_, nb_bus); break;
+    case JournalKey::StorageP:
+        undo_injection(storages_, entry, [this](int id, real_type val){storages_.change_p(id, val, topo_changed_);});
+        break;
+    case JournalKey::StorageQ:
+        undo_injection(storages_, entry, [this](int id, real_type val){storages_.change_q(id, val, topo_changed_);});
+        break;
+    case JournalKey::ShuntStatus: undo_status(shunts_, entry); break;
+    case JournalKey::ShuntBus: shunts_.change_bus(el_id, entry.old_int, topo_changed_, nb_bus); break;
+    case JournalKey::ShuntP:
+        undo_injection(shunts_, entry, [this](int id, real_type val){shunts_.change_p(id, val, topo_changed_);});
+        break;
+    case JournalKey::ShuntQ:
+        undo_injection(shunts_, entry, [this](int id, real_type val){shunts_.change_q(id, val, topo_changed_);});
+        break;
+    // the buses are computed once all the switches are restored (some intermediate states might not be valid)
+    case JournalKey::SwitchState: node_breaker_.set_switch_raw(el_id, entry.old_int != 0); break;
+    default:
+        std::ostringstream exc_;
+        exc_ << "GridModel::undo: unknown key " << static_cast<int>(entry.key);
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void GridModel::update_snapshot_cache()
+{
+    if(snapshots_.empty()) return;
+    Snapshot & snap = snapshots_.back();
+    if(snap.topo_cache || !same_topology(snap.journal_pos)) return;
+
+    // the ac powerflow has just been computed with the topology of the snapshot
+    std::shared_ptr<GridModel> cache = std::make_shared<GridModel>(*this, true);
+    cache->clear_snapshots();
+    // only the ac part is known to be up to date, the dc part will be computed again if needed
+    cache->reset(false, false, true);
+    cache->_dc_solver.reset();
+    cache->topo_changed_ = false;
+    snap.topo_cache = cache;
+}
+
 //init
 void GridModel::init_bus(const RealVect & bus_vn_kv, int nb_line, int nb_trafo){
     /**
-    initialize the bus_vn_kv_ member
+    initialize the bus_vn_kv member
     and
     initialize the Ybus_ matrix at the proper shape
     **/
     const int nb_bus = static_cast<int>(bus_vn_kv.size());
-    bus_vn_kv_ = bus_vn_kv;  // base_kv
+    clear_snapshots();  // the buses might not be the same anymore
+    StaticData & static_data = static_.mut();  // static data are cloned here if they are shared with another instance
+    static_data.bus_vn_kv = bus_vn_kv;  // base_kv
 
     bus_status_ = std::vector<bool>(nb_bus, true); // by default everything is connected
+    connectivity_.clear();
+    branches_.clear();
+    node_breaker_.clear();
+    ward_boundary_buses_.clear();  // the elements might not be the same anymore
+    ward_injection_ids_.clear();
+    ward_ids_ = WardIds();
+}
+
+Connectivity & GridModel::get_connectivity()
+{
+    if(connectivity_.is_init()) return connectivity_;
+    const int nb_line = static_cast<int>(powerlines_.nb());
+    const int nb_trafo = static_cast<int>(trafos_.nb());
+    std::vector<int> branch_from(nb_line + nb_trafo, Connectivity::_deactivated_bus_id);
+    std::vector<int> branch_to(nb_line + nb_trafo, Connectivity::_deactivated_bus_id);
+    for(int line_id = 0; line_id < nb_line; ++line_id){
+        if(!powerlines_.get_status()[line_id]) continue;
+        branch_from[line_id] = powerlines_.get_bus_from()(line_id);
+        branch_to[line_id] = powerlines_.get_bus_to()(line_id);
+    }
+    for(int trafo_id = 0; trafo_id < nb_trafo; ++trafo_id){
+        if(!trafos_.get_status()[trafo_id]) continue;
+        branch_from[nb_line + trafo_id] = trafos_.get_bus_from()(trafo_id);
+        branch_to[nb_line + trafo_id] = trafos_.get_bus_to()(trafo_id);
+    }
+    connectivity_.init(static_cast<int>(total_bus()), branch_from, branch_to);
+    return connectivity_;
+}
+
+const BranchTable & GridModel::get_branches()
+{
+    if(!branches_.is_init()) branches_.init(powerlines_, trafos_, static_->bus_vn_kv);
+    return branches_;
+}
+
+Eigen::VectorXi GridModel::get_bus_islands()
+{
+    const std::vector<int> islands = get_connectivity().get_components(bus_status_);
+    return Eigen::Map<const Eigen::VectorXi>(islands.data(), islands.size());
+}
+
+void GridModel::init_node_breaker(const std::vector<int> & node_to_sub,
+                                  const std::vector<std::vector<int> > & sub_buses,
+                                  const std::vector<int> & switch_node_1,
+                                  const std::vector<int> & switch_node_2,
+                                  const std::vector<bool> & switch_closed)
+{
+    const int nb_bus = static_cast<int>(total_bus());
+    for(std::size_t sub_id = 0; sub_id < sub_buses.size(); ++sub_id){
+        for(auto bus_id : sub_buses[sub_id]){
+            if(bus_id < 0 || bus_id >= nb_bus){
+                std::ostringstream exc_;
+                exc_ << "GridModel::init_node_breaker: substation " << sub_id << " uses bus " << bus_id;
+                exc_ << " that does not exist (there are " << nb_bus << " buses).";
+                throw std::runtime_error(exc_.str());
+            }
+        }
+    }
+    node_breaker_.init(node_to_sub, sub_buses, switch_node_1, switch_node_2, switch_closed);
+    clear_snapshots();  // the switches are not the same anymore
+}
+
+void GridModel::check_node_breaker(const char * fun_name) const
+{
+    if(!node_breaker_.is_init()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::" << fun_name << ": the node breaker topology has not been initialized ";
+        exc_ << "(see init_node_breaker).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void GridModel::set_node_breaker_terminals(TerminalType type, const std::vector<int> & nodes)
+{
+    check_node_breaker("set_node_breaker_terminals");
+    Eigen::Index nb_el = 0;
+    switch (type)
+    {
+    case TerminalType::Load: nb_el = loads_.nb(); break;
+    case TerminalType::Gen: nb_el = generators_.nb(); break;
+    case TerminalType::SGen: nb_el = sgens_.nb(); break;
+    case TerminalType::Storage: nb_el = storages_.nb(); break;
+    case TerminalType::Shunt: nb_el = shunts_.nb(); break;
+    case TerminalType::LineOr:
+    case TerminalType::LineEx: nb_el = powerlines_.nb(); break;
+    case TerminalType::TrafoHv:
+    case TerminalType::TrafoLv: nb_el = trafos_.nb(); break;
+    }
+    if(static_cast<Eigen::Index>(nodes.size()) != nb_el){
+        std::ostringstream exc_;
+        exc_ << "GridModel::set_node_breaker_terminals: " << nodes.size() << " nodes are given for ";
+        exc_ << nb_el << " elements.";
+        throw std::runtime_error(exc_.str());
+    }
+    node_breaker_.set_terminals(type, nodes, bus_nb_unregistered(type, &nodes));
+    for(int sub_id = 0; sub_id < node_breaker_.nb_sub(); ++sub_id) apply_node_breaker(sub_id);
+}
+
+void GridModel::set_switches(const std::vector<int> & switch_ids, const std::vector<bool> & closed)
+{
+    check_node_breaker("set_switches");
+    // the states are recorded before the modification (recording a state that is not modified in the end is harmless)
+    for(auto switch_id : switch_ids) journal_status(JournalKey::SwitchState, switch_id, node_breaker_.get_switches());
+    // only the substations with a modified switch are updated
+    const std::vector<int> modified_subs = node_breaker_.set_switches(switch_ids, closed, bus_nb_unregistered());
+    for(auto sub_id : modified_subs) apply_node_breaker(sub_id);
+}
+
+void GridModel::update_switches(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
+                                Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > new_values)
+{
+    check_node_breaker("update_switches");
+    if(has_changed.size() != node_breaker_.nb_switch() || new_values.size() != node_breaker_.nb_switch()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::update_switches: there are " << node_breaker_.nb_switch() << " switches but ";
+        exc_ << has_changed.size() << " and " << new_values.size() << " values are given.";
+        throw std::runtime_error(exc_.str());
+    }
+    std::vector<int> switch_ids;
+    std::vector<bool> closed;
+    for(int switch_id = 0; switch_id < has_changed.size(); ++switch_id){
+        if(!has_changed(switch_id)) continue;
+        switch_ids.push_back(switch_id);
+        closed.push_back(new_values(switch_id));
+    }
+    set_switches(switch_ids, closed);
+}
+
+Eigen::VectorXi GridModel::get_node_bus() const
+{
+    const std::vector<int> & node_bus = node_breaker_.get_node_bus();
+    return Eigen::Map<const Eigen::VectorXi>(node_bus.data(), node_bus.size());
+}
+
+std::vector<int> GridModel::bus_nb_unregistered(TerminalType type, const std::vector<int> * nodes) const
+{
+    // usual case: all the elements are handled by the processor (no need to look at them)
+    const bool all_handled =
+        (node_breaker_.nb_terminal(TerminalType::Load) == loads_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::Gen) == generators_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::SGen) == sgens_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::Storage) == storages_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::Shunt) == shunts_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::LineOr) == powerlines_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::LineEx) == powerlines_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::TrafoHv) == trafos_.nb()) &&
+        (node_breaker_.nb_terminal(TerminalType::TrafoLv) == trafos_.nb());
+    if(nodes == nullptr && all_handled) return std::vector<int>();
+
+    std::vector<int> res(static_cast<std::size_t>(total_bus()), 0);
+    auto node_of = [this, type, nodes](TerminalType el_type, int el_id){
+        if(nodes != nullptr && el_type == type) return (*nodes)[el_id];
+        return node_breaker_.get_node(el_type, el_id);
+    };
+    auto count = [&res, &node_of](TerminalType el_type, const std::vector<bool> & status,
+                                  Eigen::Ref<const Eigen::VectorXi> bus_ids){
+        for(int el_id = 0; el_id < static_cast<int>(status.size()); ++el_id){
+            if(status[el_id] && node_of(el_type, el_id) == -1) ++res[bus_ids(el_id)];
+        }
+    };
+    count(TerminalType::Load, loads_.get_status(), loads_.get_bus_id());
+    count(TerminalType::Gen, generators_.get_status(), generators_.get_bus_id());
+    count(TerminalType::SGen, sgens_.get_status(), sgens_.get_bus_id());
+    count(TerminalType::Storage, storages_.get_status(), storages_.get_bus_id());
+    count(TerminalType::Shunt, shunts_.get_status(), shunts_.get_bus_id());
+    count(TerminalType::LineOr, powerlines_.get_status(), powerlines_.get_bus_from());
+    count(TerminalType::LineEx, powerlines_.get_status(), powerlines_.get_bus_to());
+    count(TerminalType::TrafoHv, trafos_.get_status(), trafos_.get_bus_from());
+    count(TerminalType::TrafoLv, trafos_.get_status(), trafos_.get_bus_to());
+    return res;
+}
+
+void GridModel::apply_node_breaker(int sub_id)
+{
+    const std::vector<int> & node_bus = node_breaker_.get_node_bus();
+    const std::vector<NodeBreaker::Terminal> & terminals = node_breaker_.get_terminals(sub_id);
+
+    // a bus of the substation is active if (and only if) an element is connected to it (the elements not handled by
+    // the topology processor included)
+    for(auto bus_id : node_breaker_.get_sub_buses(sub_id)){
+        bool used = node_breaker_.get_nb_fixed(bus_id) > 0;
+        for(std::size_t i = 0; !used && i < terminals.size(); ++i) used = node_bus[terminals[i].node_id] == bus_id;
+        if(used != bus_status_[bus_id]){
+            if(used) reactivate_bus(bus_id);
+            else deactivate_bus(bus_id);
+        }
+    }
+
+    // bus of the other end of a branch (its current bus if this end is not handled by the topology processor)
+    auto other_bus = [this, &node_bus](TerminalType other_type, int el_id, int current_bus){
+        const int node_id = node_breaker_.get_node(other_type, el_id);
+        return node_id == -1 ? current_bus : node_bus[node_id];
+    };
+    for(const auto & terminal : terminals){
+        const int el_id = terminal.el_id;
+        const int bus_id = node_bus[terminal.node_id];
+        const bool has_bus = bus_id != -1;
+        switch (terminal.type)
+        {
+        case TerminalType::Load:
+            apply_terminal(loads_, loads_.get_bus_id(), el_id, bus_id, has_bus,
+                           [this](int id){deactivate_load(id);}, [this](int id){reactivate_load(id);},
+                           [this](int id, int bus){change_bus_load(id, bus);});
+            break;
+        case TerminalType::Gen:
+            apply_terminal(generators_, generators_.get_bus_id(), el_id, bus_id, has_bus,
+                           [this](int id){deactivate_gen(id);}, [this](int id){reactivate_gen(id);},
+                           [this](int id, int bus){change_bus_gen(id, bus);});
+            break;
+        case TerminalType::SGen:
+            apply_terminal(sgens_, sgens_.get_bus_id(), el_id, bus_id, has_bus,
+                           [this](int id){deactivate_sgen(id);}, [this](int id){reactivate_sgen(id);},
+                           [this](int id, int bus){change_bus_sgen(id, bus);});
+            break;
+        case TerminalType::Storage:
+            apply_terminal(storages_, storages_.get_bus_id(), el_id, bus_id, has_bus,
+                           [this](int id){deactivate_storage(id);}, [this](int id){reactivate_storage(id);},
+                           [this](int id, int bus){change_bus_storage(id, bus);});
+            break;
+        case TerminalType::Shunt:
+            apply_terminal(shunts_, shunts_.get_bus_id(), el_id, bus_id, has_bus,
+                           [this](int id){deactivate_shunt(id);}, [this](int id){reactivate_shunt(id);},
+                           [this](int id, int bus){change_bus_shunt(id, bus);});
+            break;
+        // a branch is connected if both its ends are
+        case TerminalType::LineOr:
+            apply_terminal(powerlines_, powerlines_.get_bus_from(), el_id, bus_id,
+                           has_bus && other_bus(TerminalType::LineEx, el_id, powerlines_.get_bus_to()(el_id)) != -1,
+                           [this](int id){deactivate_powerline(id);}, [this](int id){reactivate_powerline(id);},
+                           [this](int id, int bus){change_bus_powerline_or(id, bus);});
+            break;
+        case TerminalType::LineEx:
+            apply_terminal(powerlines_, powerlines_.get_bus_to(), el_id, bus_id,
+                           has_bus && other_bus(TerminalType::LineOr, el_id, powerlines_.get_bus_from()(el_id)) != -1,
+                           [this](int id){deactivate_powerline(id);}, [this](int id){reactivate_powerline(id);},
+                           [this](int id, int bus){change_bus_powerline_ex(id, bus);});
+            break;
+        case TerminalType::TrafoHv:
+            apply_terminal(trafos_, trafos_.get_bus_from(), el_id, bus_id,
+                           has_bus && other_bus(TerminalType::TrafoLv, el_id, trafos_.get_bus_to()(el_id)) != -1,
+                           [this](int id){deactivate_trafo(id);}, [this](int id){reactivate_trafo(id);},
+                           [this](int id, int bus){change_bus_trafo_hv(id, bus);});
+            break;
+        case TerminalType::TrafoLv:
+            apply_terminal(trafos_, trafos_.get_bus_to(), el_id, bus_id,
+                           has_bus && other_bus(TerminalType::TrafoHv, el_id, trafos_.get_bus_from()(el_id)) != -1,
+                           [this](int id){deactivate_trafo(id);}, [this](int id){reactivate_trafo(id);},
+                           [this](int id, int bus){change_bus_trafo_lv(id, bus);});
+            break;
+        }
+    }
 }
 
 void GridModel::reset(bool reset_solver, bool reset_ac, bool reset_dc)
@@ -216,7 +1017,7 @@ CplxVect GridModel::ac_pf(const CplxVect & Vinit,
                           int max_iter,
                           real_type tol)
 {
-    const int nb_bus = static_cast<int>(bus_vn_kv_.size());
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
     if(Vinit.size() != nb_bus){
         std::ostringstream exc_;
         exc_ << "GridModel::ac_pf: Size of the Vinit should be the same as the total number of buses. Currently:  ";
@@ -236,10 +1037,14 @@ CplxVect GridModel::ac_pf(const CplxVect & Vinit,
 
     // start the solver
     slack_weights_ = generators_.get_slack_weights(Ybus_ac_.rows(), id_me_to_ac_solver_); 
-    conv = _solver.compute_pf(Ybus_ac_, V, Sbus_, slack_bus_id_ac_solver_, slack_weights_, bus_pv_, bus_pq_, max_iter, tol / sn_mva_);
+    kron_nb_eliminated_ = 0;
+    islands_res_ac_.solved = !islands_ac_.islands.empty();
+    if(islands_res_ac_.solved) conv = solve_islands(is_ac, V, slack_bus_id_ac_solver_, max_iter, tol / sn_mva_);
+    else conv = _solver.compute_pf(Ybus_ac_, V, Sbus_, slack_bus_id_ac_solver_, slack_weights_, bus_pv_, bus_pq_, max_iter, tol / sn_mva_);
 
     // store results (in ac mode)
     process_results(conv, res, Vinit, true, id_me_to_ac_solver_);
+    if(conv) update_snapshot_cache();
 
     // return the vector of complex voltage at each bus
     return res;
@@ -247,74 +1052,94 @@ CplxVect GridModel::ac_pf(const CplxVect & Vinit,
 
 CplxVect GridModel::check_solution(const CplxVect & V_proposed, bool check_q_limits)
 {
-    // pre process the data to define a proper jacobian matrix, the proper voltage vector etc.
-    const int nb_bus = static_cast<int>(V_proposed.size());
+    return check_solutions(V_proposed.transpose(), check_q_limits).row(0).transpose();
+}
+
+CplxMat GridModel::check_solutions(const Eigen::Ref<const CplxMat> & Vs, bool check_q_limits)
+{
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
+    if(Vs.cols() != nb_bus){
+        std::ostringstream exc_;
+        exc_ << "GridModel::check_solutions: the voltages should be given for the " << nb_bus << " buses of the grid ";
+        exc_ << "(one column per bus). You provided " << Vs.cols() << " columns.";
+        throw std::runtime_error(exc_.str());
+    }
+    const int nb_state = static_cast<int>(Vs.rows());
+    CplxMat res = CplxMat::Zero(nb_state, nb_bus);
+    if(nb_state == 0) return res;
+
+    // pre process the data to define a proper admittance matrix, the injections etc. (once for all the states)
     bool is_ac = true;
     bool reset_solver = false;
-    CplxVect V = pre_process_solver(V_proposed, Ybus_ac_, 
-                                    id_me_to_ac_solver_, id_ac_solver_to_me_, slack_bus_id_ac_solver_,
-                                    is_ac, reset_solver);
+    pre_process_solver(Vs.row(0).transpose(), Ybus_ac_,
+                       id_me_to_ac_solver_, id_ac_solver_to_me_, slack_bus_id_ac_solver_,
+                       is_ac, reset_solver);
+    const int nb_bus_solver = static_cast<int>(id_ac_solver_to_me_.size());
+
+    // the connected generators (they absorb the reactive mismatch, and the active one for the slack buses)
+    const Eigen::Ref<const Eigen::VectorXi> gen_bus = generators_.get_bus_id();
+    const Eigen::Ref<const RealVect> gen_min_q = generators_.get_min_q();
+    const Eigen::Ref<const RealVect> gen_max_q = generators_.get_max_q();
+    std::vector<int> gen_ids;
+    for(int gen_id = 0; gen_id < generators_.nb(); ++gen_id){
+        if(generators_.get_status()[gen_id]) gen_ids.push_back(gen_id);
+    }
 
-    // compute the mismatch
-    CplxVect tmp = Ybus_ac_ * V;  // this is a vector
-    tmp = tmp.array().conjugate();  // i take the conjugate
-    auto mis = V.array() * tmp.array() - Sbus_.array();
-
-    // store results
-    CplxVect res = _get_results_back_to_orig_nodes(mis,
-                                                   id_me_to_ac_solver_,
-                                                   static_cast<int>(V_proposed.size())
-                                                   );
-    if(sn_mva_ != 1.) res *= sn_mva_;
-
-    // now check reactive values for buses where there are generators and active values of slack bus
-    // test for iterator though generator
-    for(const auto & gen: generators_)
-    {
-        if(!gen.connected)
-        {
-            // the generator is disconnected, I do nothing
-            continue;
-        }
-        if(check_q_limits)
-        {
-            // i need to check the reactive can be absorbed / produced by the generator
-            real_type new_q = my_zero_;
-            real_type react_this_bus = std::imag(res.coeff(gen.bus_id));
-            if((react_this_bus >= gen.min_q_mvar) && (react_this_bus <= gen.max_q_mvar))
-            {
-                // this generator is able to handle all reactive
-                new_q = my_zero_;
-            }else if(react_this_bus < gen.min_q_mvar){
-                // generator cannot absorb enough reactive power
-                new_q = react_this_bus - gen.min_q_mvar; //ex. need -50, qmin is -30, remains: (-50) - (-30) = -20 MVAr
-            }else{
-                // generator cannot produce enough reactive power
-                new_q = react_this_bus - gen.max_q_mvar;  // ex. need 50, qmax is 30, remains: 50 - 30 = 20 MVAr
+    // the states are split in blocks, and the mismatch of a block is computed with one sparse dense product
+    const int nb_block = std::min(nb_state, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    parallel_for(nb_block, [&](int block_id){
+        const int state_beg = static_cast<int>((static_cast<long>(block_id) * nb_state) / nb_block);
+        const int state_end = static_cast<int>((static_cast<long>(block_id + 1) * nb_state) / nb_block);
+        const int nb_state_block = state_end - state_beg;
+
+        // voltages in the solver order (one column per state), with the magnitude of the generators
+        Eigen::Matrix<cplx_type, Eigen::Dynamic, Eigen::Dynamic> V(nb_bus_solver, nb_state_block);
+        CplxVect V_state(nb_bus_solver);
+        for(int state = 0; state < nb_state_block; ++state){
+            for(int bus_solver_id = 0; bus_solver_id < nb_bus_solver; ++bus_solver_id){
+                V_state(bus_solver_id) = Vs(state_beg + state, id_ac_solver_to_me_[bus_solver_id]);
             }
-            res.coeffRef(gen.bus_id) = {std::real(res.coeff(gen.bus_id)), new_q};
-        }else{
-            // the q value for the bus at which the generator is connected will be 0
-            res.coeffRef(gen.bus_id) = {std::real(res.coeff(gen.bus_id)), my_zero_};
+            generators_.set_vm(V_state, id_me_to_ac_solver_);
+            V.col(state) = V_state;
         }
 
-        // if(gen.id == gen_slackbus_)
-        if(gen.is_slack)
-        {
-            // slack bus, by definition, can handle all active value
-            // This is probably not the case with distributed slack !
-            res.coeffRef(gen.bus_id) = {my_zero_, std::imag(res.coeff(gen.bus_id))};
-        }
-    }
+        // compute the mismatch
+        const Eigen::Matrix<cplx_type, Eigen::Dynamic, Eigen::Dynamic> mis =
+            (V.array() * (Ybus_ac_ * V).array().conjugate()).colwise() - Sbus_.array();
 
-    // set to 0 the error on the disconnected bus (it is not initialized at 0.0 in _get_results_back_to_orig_nodes)
-    for(int bus_id = 0; bus_id < nb_bus; ++bus_id)
-    {
-        if(bus_status_[bus_id]) continue;
-        res.coeffRef(bus_id) = my_zero_;
-    }
+        for(int state = 0; state < nb_state_block; ++state){
+            auto res_state = res.row(state_beg + state);
+            // store results (the error on the disconnected buses is 0.)
+            for(int bus_id = 0; bus_id < nb_bus; ++bus_id){
+                if(!bus_status_[bus_id]) continue;
+                res_state(bus_id) = mis(id_me_to_ac_solver_[bus_id], state) * sn_mva_;
+            }
+
+            // now check reactive values for buses where there are generators and active values of slack bus
+            for(auto gen_id : gen_ids){
+                const int bus_id = gen_bus(gen_id);
+                const real_type react_this_bus = std::imag(res_state(bus_id));
+                real_type new_q = my_zero_;
+                if(check_q_limits)
+                {
+                    // i need to check the reactive can be absorbed / produced by the generator
+                    if(react_this_bus < gen_min_q(gen_id)){
+                        // generator cannot absorb enough reactive power
+                        new_q = react_this_bus - gen_min_q(gen_id); //ex. need -50, qmin is -30, remains: (-50) - (-30) = -20 MVAr
+                    }else if(react_this_bus > gen_max_q(gen_id)){
+                        // generator cannot produce enough reactive power
+                        new_q = react_this_bus - gen_max_q(gen_id);  // ex. need 50, qmax is 30, remains: 50 - 30 = 20 MVAr
+                    }
+                }
+                // slack bus, by definition, can handle all active value
+                // This is probably not the case with distributed slack !
+                const real_type new_p = generators_.get_is_slack()[gen_id] ? my_zero_ : std::real(res_state(bus_id));
+                res_state(bus_id) = {new_p, new_q};
+            }
+        }
+    });
     return res;
-};
+}
 
 CplxVect GridModel::pre_process_solver(const CplxVect & Vinit, 
                                        Eigen::SparseMatrix<cplx_type> & Ybus,
@@ -325,9 +1150,16 @@ CplxVect GridModel::pre_process_solver(const CplxVect & Vinit,
                                        bool reset_solver)
 {
     // TODO get rid of the "is_ac" argument: this info is available in the _solver already
+    drop_pending_results();  // they depend on the current state of the solver
     // std::cout << "GridModel::pre_process_solver : topo_changed_ " << topo_changed_ << std::endl;
     // std::cout << "GridModel::pre_process_solver : reset_solver " << reset_solver << std::endl;
 
+    // the admittance matrix might not have been computed for this topology (eg only the other powerflow has been run
+    // or the state of the solvers has been restored from a snapshot)
+    if(Ybus.rows() == 0){
+        topo_changed_ = true;
+        reset_solver = true;
+    }
     bool reset_ac = topo_changed_ && is_ac;
     bool reset_dc = topo_changed_ && !is_ac;
     // if(need_reset_){ // TODO optimization when it's not mandatory to start from scratch
@@ -349,7 +1181,7 @@ CplxVect GridModel::pre_process_solver(const CplxVect & Vinit,
     init_Sbus(Sbus_, id_me_to_solver, id_solver_to_me, slack_bus_id_solver);
     fillpv_pq(id_me_to_solver, id_solver_to_me, slack_bus_id_solver); // TODO what if pv and pq changed ? :O
     
-    generators_.init_q_vector(static_cast<int>(bus_vn_kv_.size()));
+    generators_.init_q_vector(static_cast<int>(id_solver_to_me.size()), id_me_to_solver);
     fillSbus_me(Sbus_, is_ac, id_me_to_solver, slack_bus_id_solver);
 
     const int nb_bus_solver = static_cast<int>(id_solver_to_me.size());
@@ -360,15 +1192,573 @@ CplxVect GridModel::pre_process_solver(const CplxVect & Vinit,
         V(bus_solver_id) = tmp;
     }
     generators_.set_vm(V, id_me_to_solver);
+
+    // the grid might be split in multiple islands, they are then solved separately (see solve_islands)
+    if(topo_changed_ || !get_islands(is_ac).ok){
+        init_islands(Ybus, id_me_to_solver, is_ac);
+    }else if(reset_solver){
+        for(auto & island : get_islands(is_ac).islands){
+            if(island.solver) island.solver->reset();
+        }
+    }
     return V;
 }
 
+void GridModel::init_islands(const Eigen::SparseMatrix<cplx_type> & Ybus,
+                             const std::vector<int> & id_me_to_solver,
+                             bool is_ac)
+{
+    Islands & data = get_islands(is_ac);
+    std::vector<Island> & islands = data.islands;
+    std::vector<int> & island_of_bus = data.island_of_bus;
+    std::vector<int> & island_local_id = data.local_id;
+    islands.clear();
+    island_of_bus.clear();
+    island_local_id.clear();
+    data.ok = true;
+    const std::vector<int> bus_islands = get_connectivity().get_components(bus_status_);
+    int nb_island = 0;
+    for(auto island_id : bus_islands) nb_island = std::max(nb_island, island_id + 1);
+    // the whole grid is solved at once, unless it needs to be reduced
+    if(nb_island <= 1 && !(kron_reduction_ && is_ac)) return;
+
+    // the buses of each island
+    const int nb_bus_solver = static_cast<int>(Ybus.cols());
+    islands = std::vector<Island>(nb_island);
+    island_of_bus = std::vector<int>(nb_bus_solver, _deactivated_bus_id);
+    island_local_id = std::vector<int>(nb_bus_solver, _deactivated_bus_id);
+    const int nb_bus = static_cast<int>(bus_islands.size());
+    for(int bus_id_me = 0; bus_id_me < nb_bus; ++bus_id_me){
+        const int island_id = bus_islands[bus_id_me];
+        if(island_id == _deactivated_bus_id) continue;
+        const int bus_id_solver = id_me_to_solver[bus_id_me];
+        if(island_of_bus[bus_id_solver] != _deactivated_bus_id) continue;  // merged with another bus
+        std::vector<int> & id_solver = islands[island_id].id_solver;
+        island_of_bus[bus_id_solver] = island_id;
+        island_local_id[bus_id_solver] = static_cast<int>(id_solver.size());
+        id_solver.push_back(bus_id_solver);
+    }
+
+    // and their part of the admittance matrix (it is block diagonal)
+    for(auto & island : islands){
+        const int nb_bus_island = static_cast<int>(island.id_solver.size());
+        std::vector<Eigen::Triplet<cplx_type> > tripletList;
+        for(int col_id = 0; col_id < nb_bus_island; ++col_id){
+            for(Eigen::SparseMatrix<cplx_type>::InnerIterator it(Ybus, island.id_solver[col_id]); it; ++it){
+                tripletList.push_back(Eigen::Triplet<cplx_type>(island_local_id[it.row()], col_id, it.value()));
+            }
+        }
+        island.Ybus = Eigen::SparseMatrix<cplx_type>(nb_bus_island, nb_bus_island);
+        island.Ybus.setFromTriplets(tripletList.begin(), tripletList.end());
+        island.Ybus.makeCompressed();
+    }
+}
+
+bool GridModel::solve_islands(bool is_ac,
+                              const CplxVect & V,
+                              const Eigen::VectorXi & slack_bus_id_solver,
+                              int max_iter,
+                              real_type tol)
+{
+    // dispatch the data of the whole grid to the islands
+    std::vector<Island> & islands = get_islands(is_ac).islands;
+    const std::vector<int> & island_of_bus = get_islands(is_ac).island_of_bus;
+    const std::vector<int> & island_local_id = get_islands(is_ac).local_id;
+    const int nb_island = static_cast<int>(islands.size());
+    std::vector<std::vector<int> > slack_ids(nb_island), pv(nb_island), pq(nb_island);
+    for(int i = 0; i < slack_bus_id_solver.size(); ++i){
+        const int bus_id = slack_bus_id_solver(i);
+        slack_ids[island_of_bus[bus_id]].push_back(island_local_id[bus_id]);
+    }
+    for(int i = 0; i < bus_pv_.size(); ++i) pv[island_of_bus[bus_pv_(i)]].push_back(island_local_id[bus_pv_(i)]);
+    for(int i = 0; i < bus_pq_.size(); ++i) pq[island_of_bus[bus_pq_(i)]].push_back(island_local_id[bus_pq_(i)]);
+
+    std::vector<int> energized;  // the islands that can be solved (with a slack bus)
+    for(int island_id = 0; island_id < nb_island; ++island_id){
+        Island & island = islands[island_id];
+        island.conv = false;
+        if(slack_ids[island_id].empty()) continue;
+        const int nb_bus_island = static_cast<int>(island.id_solver.size());
+        island.Sbus = CplxVect(nb_bus_island);
+        island.V = CplxVect(nb_bus_island);
+        island.slack_weights = RealVect(nb_bus_island);
+        for(int bus_id = 0; bus_id < nb_bus_island; ++bus_id){
+            island.Sbus(bus_id) = Sbus_(island.id_solver[bus_id]);
+            island.V(bus_id) = V(island.id_solver[bus_id]);
+            island.slack_weights(bus_id) = slack_weights_(island.id_solver[bus_id]);
+        }
+        // the slack weights are normalized on each island
+        const real_type sum_weights = island.slack_weights.sum();
+        if(sum_weights > 0.) island.slack_weights /= sum_weights;
+        island.slack_ids = Eigen::Map<Eigen::VectorXi>(slack_ids[island_id].data(), slack_ids[island_id].size());
+        island.pv = Eigen::Map<Eigen::VectorXi>(pv[island_id].data(), pv[island_id].size());
+        island.pq = Eigen::Map<Eigen::VectorXi>(pq[island_id].data(), pq[island_id].size());
+        if(!island.solver){
+            island.solver = std::unique_ptr<ChooseSolver>(new ChooseSolver());
+            island.solver->change_solver(is_ac ? _solver.get_type() : _dc_solver.get_type());
+            island.solver->copy_config(is_ac ? _solver : _dc_solver);
+        }
+
+        // Kron reduction, computed again only when the zero injection buses change
+        if(kron_reduction_ && is_ac){
+            std::vector<int> candidates;
+            for(auto bus_id : pq[island_id]){
+                if(island.Sbus(bus_id) == cplx_type(0.)) candidates.push_back(bus_id);
+            }
+            if(candidates != island.kron_candidates){
+                island.kron_candidates = candidates;
+                kron_reduce(island, candidates);
+                island.solver->reset();  // the admittance matrix changed
+            }
+            kron_reduce_data(island);
+        }
+        energized.push_back(island_id);
+    }
+
+    // solve them (concurrently)
+    parallel_for(static_cast<int>(energized.size()), [&islands, &energized, max_iter, tol](int task_id){
+        Island & island = islands[energized[task_id]];
+        if(island.pv.size() + island.pq.size() == 0){
+            // only slack buses: there is nothing to solve
+            island.conv = true;
+            return;
+        }
+        const Eigen::SparseMatrix<cplx_type> & Ybus = island.kron_elim.empty() ? island.Ybus : island.kron_Ybus;
+        island.conv = island.solver->compute_pf(Ybus, island.V, island.Sbus, island.slack_ids,
+                                                island.slack_weights, island.pv, island.pq, max_iter, tol);
+    });
+
+    // gather the results (and the timers and errors of the solvers), the other islands are de-energized
+    IslandsRes & res = is_ac ? islands_res_ac_ : islands_res_dc_;
+    res.computation_time = 0.;
+    // no island with a slack bus: the admittance matrix of the grid is singular
+    res.error = energized.empty() ? ErrorType::SingularMatrix : ErrorType::NoError;
+    for(auto island_id : energized){
+        const Island & island = islands[island_id];
+        if(island.pv.size() + island.pq.size() == 0) continue;  // not solved
+        res.computation_time += island.solver->get_computation_time();
+        if(!island.conv && (res.error == ErrorType::NoError)) res.error = island.solver->get_error();
+    }
+    bool conv = !energized.empty();
+    res.V = CplxVect::Zero(V.size());
+    kron_nb_eliminated_ = 0;
+    for(auto island_id : energized){
+        const Island & island = islands[island_id];
+        conv = conv && island.conv;
+        if(!conv) break;
+        const bool only_slack = island.pv.size() + island.pq.size() == 0;
+        const Eigen::Ref<const CplxVect> V_island = only_slack ? Eigen::Ref<const CplxVect>(island.V) : island.solver->get_V();
+        if(island.kron_elim.empty()){
+            for(std::size_t bus_id = 0; bus_id < island.id_solver.size(); ++bus_id){
+                res.V(island.id_solver[bus_id]) = V_island(bus_id);
+            }
+        }else{
+            // back substitution for the eliminated buses
+            const CplxVect V_elim = island.kron_back * V_island;
+            for(std::size_t bus_id = 0; bus_id < island.id_solver.size(); ++bus_id){
+                const int kron_id = island.kron_id[bus_id];
+                if(kron_id != _deactivated_bus_id) res.V(island.id_solver[bus_id]) = V_island(kron_id);
+            }
+            for(std::size_t elim_id = 0; elim_id < island.kron_elim.size(); ++elim_id){
+                res.V(island.id_solver[island.kron_elim[elim_id]]) = V_elim(elim_id);
+            }
+            kron_nb_eliminated_ += static_cast<int>(island.kron_elim.size());
+        }
+    }
+    res.Va = res.V.array().arg();
+    res.Vm = res.V.array().abs();
+    return conv;
+}
+
+bool GridModel::kron_reduce(Island & island, const std::vector<int> & elim) const
+{
+    island.kron_elim.clear();
+    island.kron_Ybus = Eigen::SparseMatrix<cplx_type>();
+    island.kron_back = Eigen::SparseMatrix<cplx_type>();
+    if(elim.empty()) return true;
+
+    // ids of the buses in the kept (k) and eliminated (e) parts
+    const int nb_bus_island = static_cast<int>(island.id_solver.size());
+    std::vector<int> kept_id(nb_bus_island, _deactivated_bus_id);
+    std::vector<int> elim_id(nb_bus_island, _deactivated_bus_id);
+    for(std::size_t i = 0; i < elim.size(); ++i) elim_id[elim[i]] = static_cast<int>(i);
+    int nb_kept = 0;
+    for(int bus_id = 0; bus_id < nb_bus_island; ++bus_id){
+        if(elim_id[bus_id] == _deactivated_bus_id) kept_id[bus_id] = nb_kept++;
+    }
+    const int nb_elim = static_cast<int>(elim.size());
+
+    // split the admittance matrix in 4 blocks
+    std::vector<Eigen::Triplet<cplx_type> > t_kk, t_ke, t_ek, t_ee;
+    for(int col_id = 0; col_id < nb_bus_island; ++col_id){
+        for(Eigen::SparseMatrix<cplx_type>::InnerIterator it(island.Ybus, col_id); it; ++it){
+            const int row_id = static_cast<int>(it.row());
+            const bool row_kept = kept_id[row_id] != _deactivated_bus_id;
+            const bool col_kept = kept_id[col_id] != _deactivated_bus_id;
+            if(row_kept && col_kept) t_kk.push_back(Eigen::Triplet<cplx_type>(kept_id[row_id], kept_id[col_id], it.value()));
+            else if(row_kept) t_ke.push_back(Eigen::Triplet<cplx_type>(kept_id[row_id], elim_id[col_id], it.value()));
+            else if(col_kept) t_ek.push_back(Eigen::Triplet<cplx_type>(elim_id[row_id], kept_id[col_id], it.value()));
+            else t_ee.push_back(Eigen::Triplet<cplx_type>(elim_id[row_id], elim_id[col_id], it.value()));
+        }
+    }
+    Eigen::SparseMatrix<cplx_type> Ykk(nb_kept, nb_kept), Yke(nb_kept, nb_elim), Yek(nb_elim, nb_kept), Yee(nb_elim, nb_elim);
+    Ykk.setFromTriplets(t_kk.begin(), t_kk.end());
+    Yke.setFromTriplets(t_ke.begin(), t_ke.end());
+    Yek.setFromTriplets(t_ek.begin(), t_ek.end());
+    Yee.setFromTriplets(t_ee.begin(), t_ee.end());
+    Yee.makeCompressed();
+
+    Eigen::SparseLU<Eigen::SparseMatrix<cplx_type>, Eigen::COLAMDOrdering<int> > lu;
+    lu.compute(Yee);
+    if(lu.info() != Eigen::Success) return false;  // the powerflow is solved without reduction
+    Eigen::SparseMatrix<cplx_type> back = lu.solve(Yek);
+    if(lu.info() != Eigen::Success) return false;
+    island.kron_back = -back;
+    island.kron_Ybus = Ykk + Yke * island.kron_back;
+    island.kron_Ybus.makeCompressed();
+    island.kron_elim = elim;
+    island.kron_id = kept_id;
+    return true;
+}
+
+void GridModel::kron_reduce_data(Island & island) const
+{
+    if(island.kron_elim.empty()) return;
+    const int nb_bus_island = static_cast<int>(island.id_solver.size());
+    const int nb_kept = static_cast<int>(island.kron_Ybus.cols());
+    CplxVect Sbus(nb_kept), V(nb_kept);
+    RealVect slack_weights(nb_kept);
+    for(int bus_id = 0; bus_id < nb_bus_island; ++bus_id){
+        const int kron_id = island.kron_id[bus_id];
+        if(kron_id == _deactivated_bus_id) continue;
+        Sbus(kron_id) = island.Sbus(bus_id);
+        V(kron_id) = island.V(bus_id);
+        slack_weights(kron_id) = island.slack_weights(bus_id);
+    }
+    island.Sbus = Sbus;
+    island.V = V;
+    island.slack_weights = slack_weights;
+    for(int i = 0; i < island.slack_ids.size(); ++i) island.slack_ids(i) = island.kron_id[island.slack_ids(i)];
+    for(int i = 0; i < island.pv.size(); ++i) island.pv(i) = island.kron_id[island.pv(i)];
+    // the eliminated buses are all PQ buses
+    std::vector<int> pq;
+    for(int i = 0; i < island.pq.size(); ++i){
+        const int kron_id = island.kron_id[island.pq(i)];
+        if(kron_id != _deactivated_bus_id) pq.push_back(kron_id);
+    }
+    island.pq = Eigen::Map<Eigen::VectorXi>(pq.data(), pq.size());
+}
+
+GridModel GridModel::ward_equivalent(const Eigen::VectorXi & internal_buses, const CplxVect & V_full, bool extended)
+{
+    const int nb_bus = static_cast<int>(total_bus());
+    if(V_full.size() != nb_bus){
+        std::ostringstream exc_;
+        exc_ << "GridModel::ward_equivalent: the voltage vector has a size of " << V_full.size() << " but there are ";
+        exc_ << nb_bus << " buses.";
+        throw std::runtime_error(exc_.str());
+    }
+
+    // admittance matrix of the whole grid (the buses connected by a powerline without impedance are merged, see
+    // init_Ybus, so the areas below are defined for the buses of the solver)
+    GridModel ext(*this);
+    ext.clear_snapshots();
+    Eigen::SparseMatrix<cplx_type> Ybus;
+    std::vector<int> id_me_to_solver, id_solver_to_me;
+    ext.init_Ybus(Ybus, id_me_to_solver, id_solver_to_me);
+    ext.fillYbus(Ybus, true, id_me_to_solver);
+    const int nb_bus_solver = static_cast<int>(id_solver_to_me.size());
+
+    // area of each bus: 0 external, 1 boundary (external bus connected to an internal one), 2 internal
+    const int external = 0, boundary = 1, internal = 2;
+    std::vector<int> area(nb_bus_solver, external);
+    for(auto bus_id : internal_buses){
+        if(bus_id < 0 || bus_id >= nb_bus || id_me_to_solver[bus_id] == _deactivated_bus_id){
+            std::ostringstream exc_;
+            exc_ << "GridModel::ward_equivalent: the internal bus " << bus_id << " does not exist or is disconnected.";
+            throw std::runtime_error(exc_.str());
+        }
+        area[id_me_to_solver[bus_id]] = internal;
+    }
+    for(int col_id = 0; col_id < nb_bus_solver; ++col_id){
+        if(area[col_id] != internal) continue;
+        for(Eigen::SparseMatrix<cplx_type>::InnerIterator it(Ybus, col_id); it; ++it){
+            if(area[it.row()] == external) area[it.row()] = boundary;
+        }
+    }
+    auto get_area = [&](int bus_id){
+        if(bus_id < 0) return -1;
+        const int bus_solver = id_me_to_solver[bus_id];
+        return bus_solver == _deactivated_bus_id ? -1 : area[bus_solver];
+    };
+    // the elements kept in the equivalent: the injections at the internal buses and the branches with one side at an
+    // internal bus (and the other one at an internal or boundary bus). The powerlines without impedance between two
+    // kept buses are kept too, as they merge these buses.
+    auto keep_injection = [&](int bus_id){return get_area(bus_id) == internal;};
+    auto keep_branch = [&](int bus_or_id, int bus_ex_id, bool zero_impedance){
+        const int area_or = get_area(bus_or_id);
+        const int area_ex = get_area(bus_ex_id);
+        if(area_or < boundary || area_ex < boundary) return false;
+        return zero_impedance || area_or == internal || area_ex == internal;
+    };
+
+    // admittance matrix of the external grid only: the kept elements are disconnected
+    std::vector<bool> keep_line(powerlines_.nb()), keep_trafo(trafos_.nb()), keep_shunt(shunts_.nb());
+    for(int line_id = 0; line_id < powerlines_.nb(); ++line_id){
+        keep_line[line_id] = keep_branch(powerlines_.get_bus_from()(line_id), powerlines_.get_bus_to()(line_id),
+                                         powerlines_.is_zero_impedance(line_id));
+        if(keep_line[line_id] && powerlines_.get_status()[line_id]) ext.deactivate_powerline(line_id);
+    }
+    for(int trafo_id = 0; trafo_id < trafos_.nb(); ++trafo_id){
+        keep_trafo[trafo_id] = keep_branch(trafos_.get_bus_from()(trafo_id), trafos_.get_bus_to()(trafo_id), false);
+        if(keep_trafo[trafo_id] && trafos_.get_status()[trafo_id]) ext.deactivate_trafo(trafo_id);
+    }
+    for(int shunt_id = 0; shunt_id < shunts_.nb(); ++shunt_id){
+        keep_shunt[shunt_id] = keep_injection(shunts_.get_bus_id()(shunt_id));
+        if(keep_shunt[shunt_id] && shunts_.get_status()[shunt_id]) ext.deactivate_shunt(shunt_id);
+    }
+    // the other injections do not change the admittance matrix
+    std::vector<bool> keep_load(loads_.nb()), keep_sgen(sgens_.nb()), keep_storage(storages_.nb());
+    std::vector<bool> keep_gen(generators_.nb());
+    for(int load_id = 0; load_id < loads_.nb(); ++load_id) keep_load[load_id] = keep_injection(loads_.get_bus_id()(load_id));
+    for(int sgen_id = 0; sgen_id < sgens_.nb(); ++sgen_id) keep_sgen[sgen_id] = keep_injection(sgens_.get_bus_id()(sgen_id));
+    for(int storage_id = 0; storage_id < storages_.nb(); ++storage_id){
+        keep_storage[storage_id] = keep_injection(storages_.get_bus_id()(storage_id));
+    }
+    bool has_slack = false;
+    for(int gen_id = 0; gen_id < generators_.nb(); ++gen_id){
+        keep_gen[gen_id] = keep_injection(generators_.get_bus_id()(gen_id));
+        if(keep_gen[gen_id] && generators_.get_status()[gen_id] && generators_[gen_id].is_slack) has_slack = true;
+    }
+    if(!has_slack){
+        std::ostringstream exc_;
+        exc_ << "GridModel::ward_equivalent: no slack generator is connected to the internal buses.";
+        throw std::runtime_error(exc_.str());
+    }
+    Eigen::SparseMatrix<cplx_type> Yext(nb_bus_solver, nb_bus_solver);
+    ext.fillYbus(Yext, true, id_me_to_solver);
+
+    // the external buses eliminated are the ones connected to a boundary bus (the other ones are simply removed)
+    std::vector<int> bound_id(nb_bus_solver, _deactivated_bus_id);
+    std::vector<int> elim_id(nb_bus_solver, _deactivated_bus_id);
+    std::vector<int> boundary_buses, to_visit;
+    for(int bus_solver = 0; bus_solver < nb_bus_solver; ++bus_solver){
+        if(area[bus_solver] != boundary) continue;
+        bound_id[bus_solver] = static_cast<int>(boundary_buses.size());
+        boundary_buses.push_back(bus_solver);
+        to_visit.push_back(bus_solver);
+    }
+    int nb_elim = 0;
+    while(!to_visit.empty()){
+        const int col_id = to_visit.back();
+        to_visit.pop_back();
+        for(Eigen::SparseMatrix<cplx_type>::InnerIterator it(Yext, col_id); it; ++it){
+            const int row_id = static_cast<int>(it.row());
+            if(area[row_id] != external || elim_id[row_id] != _deactivated_bus_id) continue;
+            elim_id[row_id] = nb_elim++;
+            to_visit.push_back(row_id);
+        }
+    }
+    const int nb_bound = static_cast<int>(boundary_buses.size());
+
+    // Ward reduction: Yeq = Ybb - Ybe * Yee^-1 * Yeb
+    std::vector<Eigen::Triplet<cplx_type> > t_bb, t_be, t_eb, t_ee;
+    for(int col_id = 0; col_id < nb_bus_solver; ++col_id){
+        const bool col_bound = bound_id[col_id] != _deactivated_bus_id;
+        if(!col_bound && elim_id[col_id] == _deactivated_bus_id) continue;
+        for(Eigen::SparseMatrix<cplx_type>::InnerIterator it(Yext, col_id); it; ++it){
+            const int row_id = static_cast<int>(it.row());
+            const bool row_bound = bound_id[row_id] != _deactivated_bus_id;
+            if(!row_bound && elim_id[row_id] == _deactivated_bus_id) continue;
+            if(row_bound && col_bound) t_bb.push_back(Eigen::Triplet<cplx_type>(bound_id[row_id], bound_id[col_id], it.value()));
+            else if(row_bound) t_be.push_back(Eigen::Triplet<cplx_type>(bound_id[row_id], elim_id[col_id], it.value()));
+            else if(col_bound) t_eb.push_back(Eigen::Triplet<cplx_type>(elim_id[row_id], bound_id[col_id], it.value()));
+            else t_ee.push_back(Eigen::Triplet<cplx_type>(elim_id[row_id], elim_id[col_id], it.value()));
+        }
+    }
+    Eigen::SparseMatrix<cplx_type> Yeq(nb_bound, nb_bound);
+    Yeq.setFromTriplets(t_bb.begin(), t_bb.end());
+    if(nb_elim > 0){
+        Eigen::SparseMatrix<cplx_type> Ybe(nb_bound, nb_elim), Yeb(nb_elim, nb_bound), Yee(nb_elim, nb_elim);
+        Ybe.setFromTriplets(t_be.begin(), t_be.end());
+        Yeb.setFromTriplets(t_eb.begin(), t_eb.end());
+        Yee.setFromTriplets(t_ee.begin(), t_ee.end());
+        Yee.makeCompressed();
+        Eigen::SparseLU<Eigen::SparseMatrix<cplx_type>, Eigen::COLAMDOrdering<int> > lu;
+        lu.compute(Yee);
+        if(lu.info() != Eigen::Success){
+            std::ostringstream exc_;
+            exc_ << "GridModel::ward_equivalent: the admittance matrix of the external grid cannot be factorized.";
+            throw std::runtime_error(exc_.str());
+        }
+        Eigen::SparseMatrix<cplx_type> tmp = lu.solve(Yeb);
+        Yeq = Yeq - Ybe * tmp;
+    }
+    const Eigen::Matrix<cplx_type, Eigen::Dynamic, Eigen::Dynamic> Yeq_dense(Yeq);
+
+    // only the internal and boundary buses, and the elements between them, are kept (in the order of their ids)
+    WardIds ids;
+    ids.nb_bus_full = nb_bus;
+    std::vector<int> new_bus_id(nb_bus, _deactivated_bus_id);
+    for(int bus_id = 0; bus_id < nb_bus; ++bus_id){
+        if(get_area(bus_id) < boundary) continue;
+        new_bus_id[bus_id] = static_cast<int>(ids.bus.size());
+        ids.bus.push_back(bus_id);
+    }
+    auto to_new_bus = [&new_bus_id](std::vector<int> & bus_ids){
+        for(auto & bus_id : bus_ids) bus_id = new_bus_id[bus_id];
+    };
+    auto to_new_bus_solver = [&](int bus_solver){return new_bus_id[id_solver_to_me[bus_solver]];};
+    GridModel::StateRes state = get_state();
+    std::get<5>(state) = std::vector<real_type>();
+    for(auto bus_id : ids.bus) std::get<5>(state).push_back(static_->bus_vn_kv(bus_id));
+    std::get<6>(state) = std::vector<bool>(ids.bus.size(), true);
+    DataLine::StateRes & line_state = std::get<7>(state);
+    DataShunt::StateRes & shunt_state = std::get<8>(state);
+    DataTrafo::StateRes & trafo_state = std::get<9>(state);
+    DataGen::StateRes & gen_state = std::get<10>(state);
+    DataLoad::StateRes & load_state = std::get<11>(state);
+    DataSGen::StateRes & sgen_state = std::get<12>(state);
+    DataLoad::StateRes & storage_state = std::get<13>(state);
+    filter_state(line_state, keep_line);
+    filter_state(shunt_state, keep_shunt);
+    filter_state(trafo_state, keep_trafo);
+    filter_state(gen_state, keep_gen);
+    filter_state(load_state, keep_load);
+    filter_state(sgen_state, keep_sgen);
+    filter_state(storage_state, keep_storage);
+    to_new_bus(std::get<3>(line_state));
+    to_new_bus(std::get<4>(line_state));
+    to_new_bus(std::get<2>(shunt_state));
+    to_new_bus(std::get<3>(trafo_state));
+    to_new_bus(std::get<4>(trafo_state));
+    to_new_bus(std::get<4>(gen_state));
+    to_new_bus(std::get<2>(load_state));
+    to_new_bus(std::get<6>(sgen_state));
+    to_new_bus(std::get<2>(storage_state));
+    ids.line = kept_ids(keep_line);
+    ids.trafo = kept_ids(keep_trafo);
+    ids.shunt = kept_ids(keep_shunt);
+    ids.gen = kept_ids(keep_gen);
+    ids.load = kept_ids(keep_load);
+    ids.sgen = kept_ids(keep_sgen);
+    ids.storage = kept_ids(keep_storage);
+
+    // equivalent branches (Yeq is symmetric when there is no phase shifter in the external grid, otherwise its
+    // symmetric part is used) and shunts, they have no id in this grid (-1)
+    real_type max_y = 0.;
+    for(int i = 0; i < nb_bound; ++i) max_y = std::max(max_y, std::abs(Yeq_dense(i, i)));
+    const real_type tol_y = max_y * 1e-9;
+    for(int i = 0; i < nb_bound; ++i){
+        const int bus_i = to_new_bus_solver(boundary_buses[i]);
+        cplx_type y_shunt = Yeq_dense(i, i);
+        for(int j = 0; j < nb_bound; ++j){
+            if(j == i) continue;
+            const cplx_type y_ij = -0.5 * (Yeq_dense(i, j) + Yeq_dense(j, i));
+            y_shunt -= y_ij;
+            if(j < i || std::abs(y_ij) <= tol_y) continue;
+            const cplx_type z_ij = 1. / y_ij;
+            std::get<0>(line_state).push_back(std::real(z_ij));
+            std::get<1>(line_state).push_back(std::imag(z_ij));
+            std::get<2>(line_state).push_back(0.);
+            std::get<3>(line_state).push_back(bus_i);
+            std::get<4>(line_state).push_back(to_new_bus_solver(boundary_buses[j]));
+            std::get<5>(line_state).push_back(true);
+            ids.line.push_back(_deactivated_bus_id);
+        }
+        if(std::abs(y_shunt) <= tol_y) continue;
+        // the shunts consume p_mw + j.q_mvar at 1 pu
+        std::get<0>(shunt_state).push_back(-std::real(y_shunt) * sn_mva_);
+        std::get<1>(shunt_state).push_back(-std::imag(y_shunt) * sn_mva_);
+        std::get<2>(shunt_state).push_back(bus_i);
+        std::get<3>(shunt_state).push_back(true);
+        ids.shunt.push_back(_deactivated_bus_id);
+    }
+
+    // equivalent injections, their values are given by refit_ward_injections
+    std::vector<int> ward_boundary_buses, ward_injection_ids;
+    for(int i = 0; i < nb_bound; ++i){
+        const int bus_i = to_new_bus_solver(boundary_buses[i]);
+        ward_boundary_buses.push_back(bus_i);
+        if(extended){
+            ward_injection_ids.push_back(static_cast<int>(std::get<0>(gen_state).size()));
+            std::get<0>(gen_state).push_back(0.);
+            std::get<1>(gen_state).push_back(1.);
+            std::get<2>(gen_state).push_back(-std::numeric_limits<real_type>::max());
+            std::get<3>(gen_state).push_back(std::numeric_limits<real_type>::max());
+            std::get<4>(gen_state).push_back(bus_i);
+            std::get<5>(gen_state).push_back(true);
+            std::get<6>(gen_state).push_back(false);
+            std::get<7>(gen_state).push_back(0.);
+            ids.gen.push_back(_deactivated_bus_id);
+        }else{
+            ward_injection_ids.push_back(static_cast<int>(std::get<0>(load_state).size()));
+            std::get<0>(load_state).push_back(0.);
+            std::get<1>(load_state).push_back(0.);
+            std::get<2>(load_state).push_back(bus_i);
+            std::get<3>(load_state).push_back(true);
+            ids.load.push_back(_deactivated_bus_id);
+        }
+    }
+
+    // the reduced grid has the same settings (solvers, results computed...) as this one
+    GridModel res(*this);
+    res.set_state(state);
+    res.compute_results_ = compute_results_;
+    res.ward_boundary_buses_ = ward_boundary_buses;
+    res.ward_injection_ids_ = ward_injection_ids;
+    res.ward_extended_ = extended;
+    res.ward_ids_ = ids;
+    res.refit_ward_injections(V_full);
+    return res;
+}
+
+void GridModel::refit_ward_injections(const CplxVect & V_full)
+{
+    if(ward_boundary_buses_.empty()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::refit_ward_injections: this model is not a Ward equivalent (see ward_equivalent).";
+        throw std::runtime_error(exc_.str());
+    }
+    if(V_full.size() != ward_ids_.nb_bus_full){
+        std::ostringstream exc_;
+        exc_ << "GridModel::refit_ward_injections: the voltage vector has a size of " << V_full.size();
+        exc_ << " but there are " << ward_ids_.nb_bus_full << " buses in the full grid.";
+        throw std::runtime_error(exc_.str());
+    }
+    // the only injections at the boundary buses are the equivalent ones: they must match the power flowing from these
+    // buses (in the kept branches and in the equivalent ones) with the voltages of the full grid
+    Eigen::SparseMatrix<cplx_type> Ybus;
+    std::vector<int> id_me_to_solver, id_solver_to_me;
+    GridModel tmp(*this);
+    tmp.init_Ybus(Ybus, id_me_to_solver, id_solver_to_me);
+    tmp.fillYbus(Ybus, true, id_me_to_solver);
+    CplxVect V(id_solver_to_me.size());
+    for(std::size_t bus_solver = 0; bus_solver < id_solver_to_me.size(); ++bus_solver){
+        V(bus_solver) = V_full(ward_ids_.bus[id_solver_to_me[bus_solver]]);
+    }
+    const CplxVect I = Ybus * V;
+
+    for(std::size_t i = 0; i < ward_boundary_buses_.size(); ++i){
+        const int bus_solver = id_me_to_solver[ward_boundary_buses_[i]];
+        const cplx_type S = V(bus_solver) * std::conj(I(bus_solver)) * sn_mva_;
+        const int el_id = ward_injection_ids_[i];
+        if(ward_extended_){
+            change_p_gen(el_id, std::real(S));
+            change_v_gen(el_id, std::abs(V(bus_solver)));
+        }else{
+            change_p_load(el_id, -std::real(S));
+            change_q_load(el_id, -std::imag(S));
+        }
+    }
+}
+
 CplxVect GridModel::_get_results_back_to_orig_nodes(const CplxVect & res_tmp, 
                                                     std::vector<int> & id_me_to_solver,
                                                     int size)
 {
     CplxVect res = CplxVect::Constant(size, {init_vm_pu_, my_zero_});
-    const int nb_bus = static_cast<int>(bus_vn_kv_.size());
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
     for (int bus_id_me=0; bus_id_me < nb_bus; ++bus_id_me){
         if(!bus_status_[bus_id_me]) continue;  // nothing is done if the bus is connected
         int bus_id_solver = id_me_to_solver[bus_id_me];
@@ -389,11 +1779,15 @@ void GridModel::process_results(bool conv, CplxVect & res, const CplxVect & Vini
 {
     if (conv){
         if(compute_results_){
-            // compute the results of the flows, P,Q,V of loads etc.
-            compute_results(ac);
+            // compute the results of the flows, P,Q,V of loads etc. (only the ones in the mask, the others are
+            // computed if needed, see GridModel::ensure_results)
+            results_ac_ = ac;
+            results_pending_ = ResAll;
+            compute_results(ac, result_mask_);
+            fill_res_buffers();
         }
         need_reset_ = false;
-        const CplxVect & res_tmp = ac ? _solver.get_V(): _dc_solver.get_V() ;
+        const CplxVect & res_tmp = get_res_V(ac);
 
         // convert back the results to "big" vector
         res = _get_results_back_to_orig_nodes(res_tmp,
@@ -411,7 +1805,31 @@ void GridModel::init_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
                           std::vector<int>& id_solver_to_me){
     //TODO get disconnected bus !!! (and have some conversion for it)
     //1. init the conversion bus
-    const int nb_bus_init = static_cast<int>(bus_vn_kv_.size());
+    const int nb_bus_init = static_cast<int>(static_->bus_vn_kv.size());
+
+    // the buses connected by a powerline without impedance (eg a bus coupler) are the same bus for the solver,
+    // each group of buses is represented by its smallest bus id
+    std::vector<int> merged_with(nb_bus_init);
+    std::iota(merged_with.begin(), merged_with.end(), 0);
+    auto find_bus = [&merged_with](int bus_id){
+        while(merged_with[bus_id] != bus_id) bus_id = merged_with[bus_id] = merged_with[merged_with[bus_id]];
+        return bus_id;
+    };
+    zero_impedance_lines_.clear();
+    const auto & line_status = powerlines_.get_status();
+    const int nb_line = powerlines_.nb();
+    for(int line_id = 0; line_id < nb_line; ++line_id){
+        if(!line_status[line_id] || !powerlines_.is_zero_impedance(line_id)) continue;
+        const int bus_or_id = powerlines_.get_bus_from()(line_id);
+        const int bus_ex_id = powerlines_.get_bus_to()(line_id);
+        if(!bus_status_[bus_or_id] || !bus_status_[bus_ex_id]) continue;  // error raised when Ybus is filled
+        zero_impedance_lines_.push_back(line_id);
+        const int root_or = find_bus(bus_or_id);
+        const int root_ex = find_bus(bus_ex_id);
+        if(root_or < root_ex) merged_with[root_ex] = root_or;
+        else merged_with[root_or] = root_ex;
+    }
+
     id_me_to_solver = std::vector<int>(nb_bus_init, _deactivated_bus_id);  // by default, if a bus is disconnected, then it has a -1 there
     id_solver_to_me = std::vector<int>();
     id_solver_to_me.reserve(nb_bus_init);
@@ -419,6 +1837,12 @@ void GridModel::init_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
     for(int bus_id_me=0; bus_id_me < nb_bus_init; ++bus_id_me){
         if(bus_status_[bus_id_me]){
             // bus is connected
+            const int bus_root = find_bus(bus_id_me);
+            if(bus_root != bus_id_me){
+                // merged with a bus that has a smaller id (already processed)
+                id_me_to_solver[bus_id_me] = id_me_to_solver[bus_root];
+                continue;
+            }
             id_solver_to_me.push_back(bus_id_me);
             id_me_to_solver[bus_id_me] = bus_id_solver;
             ++bus_id_solver;
@@ -439,13 +1863,15 @@ void GridModel::init_Sbus(CplxVect & Sbus,
     
     const int nb_bus = static_cast<int>(id_solver_to_me.size());                 
     Sbus = CplxVect::Constant(nb_bus, 0.);
-    slack_bus_id_solver = Eigen::VectorXi::Zero(slack_bus_id_.size());
 
-    size_t i = 0;
+    std::vector<int> slack_ids;
+    slack_ids.reserve(slack_bus_id_.size());
     for(auto el: slack_bus_id_) {
-        slack_bus_id_solver(i) = id_me_to_solver[el];
-        ++i;
+        // two slack buses can be merged in the same solver bus (see init_Ybus)
+        const int bus_solver = id_me_to_solver[el];
+        if(std::find(slack_ids.begin(), slack_ids.end(), bus_solver) == slack_ids.end()) slack_ids.push_back(bus_solver);
     }
+    slack_bus_id_solver = Eigen::Map<Eigen::VectorXi, Eigen::Unaligned>(slack_ids.data(), slack_ids.size());
     
     if(is_in_vect(_deactivated_bus_id, slack_bus_id_solver)){
         // TODO improve error message with the gen_id
@@ -461,10 +1887,10 @@ void GridModel::fillYbus(Eigen::SparseMatrix<cplx_type> & res, bool ac, const st
 
     // init the Ybus matrix
     std::vector<Eigen::Triplet<cplx_type> > tripletList;
-    tripletList.reserve(bus_vn_kv_.size() + 4*powerlines_.nb() + 4*trafos_.nb() + shunts_.nb());
-    powerlines_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
+    tripletList.reserve(static_->bus_vn_kv.size() + 4*powerlines_.nb() + 4*trafos_.nb() + shunts_.nb());
+    // the powerlines and the trafos are handled in one pass (see BranchTable)
+    get_branches().fillYbus(tripletList, ac, id_me_to_solver);
     shunts_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
-    trafos_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
     loads_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
     sgens_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
     storages_.fillYbus(tripletList, ac, id_me_to_solver, sn_mva_);
@@ -521,61 +1947,341 @@ void GridModel::fillpv_pq(const std::vector<int>& id_me_to_solver,
     bus_pv_ = Eigen::Map<Eigen::VectorXi, Eigen::Unaligned>(bus_pv.data(), bus_pv.size());
     bus_pq_ = Eigen::Map<Eigen::VectorXi, Eigen::Unaligned>(bus_pq.data(), bus_pq.size());
 }
-void GridModel::compute_results(bool ac){
+void GridModel::set_result_mask(int result_mask)
+{
+    if((result_mask < 0) || (result_mask > ResAll)){
+        std::ostringstream exc_;
+        exc_ << "GridModel::set_result_mask: the mask should be a combination of ResultType (between 0 and ";
+        exc_ << ResAll << ") and not " << result_mask;
+        throw std::runtime_error(exc_.str());
+    }
+    result_mask_ = result_mask;
+}
+
+void GridModel::compute_results(bool ac, int result_types){
+    // the flows on the powerlines without impedance need all the other results (see compute_coupler_flows)
+    if((result_types & results_pending_ & ResLines) && !zero_impedance_lines_.empty()) result_types = ResAll;
+    // each type of results is computed at most once per powerflow
+    result_types &= results_pending_;
+    if(!result_types) return;
+    results_pending_ &= ~result_types;
+
     // retrieve results from powerflow
-    const auto & Va = ac ? _solver.get_Va() : _dc_solver.get_Va();
-    const auto & Vm = ac ? _solver.get_Vm() : _dc_solver.get_Vm();
-    const auto & V = ac ? _solver.get_V() : _dc_solver.get_V();
+    const auto & Va = get_res_Va(ac);
+    const auto & Vm = get_res_Vm(ac);
+    const auto & V = get_res_V(ac);
 
     const std::vector<int> & id_me_to_solver = ac ? id_me_to_ac_solver_ : id_me_to_dc_solver_;
     // for powerlines
-    powerlines_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
+    if(result_types & ResLines) powerlines_.compute_results(get_branches(), Va, Vm, V, id_me_to_solver, sn_mva_, ac);
     // for trafo
-    trafos_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
+    if(result_types & ResTrafos) trafos_.compute_results(get_branches(), Va, Vm, V, id_me_to_solver, sn_mva_, ac);
     // for loads
-    loads_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
+    if(result_types & ResLoads) loads_.compute_results(Va, Vm, V, id_me_to_solver, static_->bus_vn_kv, sn_mva_, ac);
     // for static gen
-    sgens_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
+    if(result_types & ResSGens) sgens_.compute_results(Va, Vm, V, id_me_to_solver, static_->bus_vn_kv, sn_mva_, ac);
     // for storage units
-    storages_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
+    if(result_types & ResStorages) storages_.compute_results(Va, Vm, V, id_me_to_solver, static_->bus_vn_kv, sn_mva_, ac);
     // for shunts
-    shunts_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
-    // for prods
-    generators_.compute_results(Va, Vm, V, id_me_to_solver, bus_vn_kv_, sn_mva_, ac);
-
-    //handle_slack_bus active power
-    CplxVect mismatch;  // power mismatch at each bus (SOLVER BUS !!!)
-    RealVect ractive_mismatch;  // not used in dc mode (DO NOT ATTEMPT TO USE IT THERE)
-    RealVect active_mismatch;
-    if(ac){
-        // In AC mode i am not forced to run through all the grid
-        auto tmp = (Ybus_ac_ * V).conjugate();
-        mismatch = V.array() * tmp.array() - Sbus_.array();
-        active_mismatch = mismatch.real() * sn_mva_;
-    } else{
-        active_mismatch = RealVect::Zero(V.size());
-        //TODO SLACK: improve distributed slack for DC mode !
-        // it is possible to know in advance the contribution of each slack generators (sum(Sbus) MW 
-        // to split among the contributing generators) so it's possible to "mess with" Sbus 
-        // for such purpose
-        const auto id_slack = slack_bus_id_dc_solver_(0);
-        active_mismatch(id_slack) = -Sbus_.real().sum() * sn_mva_;
-    }
-    generators_.set_p_slack(active_mismatch, id_me_to_solver);
-
-    if(ac) ractive_mismatch = mismatch.imag() * sn_mva_;
-    // mainly to initialize the Q value of the generators in dc (just fill it with 0.)
-    generators_.set_q(ractive_mismatch, id_me_to_solver, ac);
-}
-
-void GridModel::reset_results(){
-    powerlines_.reset_results();
-    shunts_.reset_results();
-    trafos_.reset_results();
-    loads_.reset_results();
-    sgens_.reset_results();
-    storages_.reset_results();
-    generators_.reset_results();
+    if(result_types & ResShunts) shunts_.compute_results(Va, Vm, V, id_me_to_solver, static_->bus_vn_kv, sn_mva_, ac);
+    if(result_types & ResGens){
+        // for prods
+        generators_.compute_results(Va, Vm, V, id_me_to_solver, static_->bus_vn_kv, sn_mva_, ac);
+
+        //handle_slack_bus active power
+        CplxVect mismatch;  // power mismatch at each bus (SOLVER BUS !!!)
+        RealVect ractive_mismatch;  // not used in dc mode (DO NOT ATTEMPT TO USE IT THERE)
+        RealVect active_mismatch;
+        if(ac){
+            // In AC mode i am not forced to run through all the grid
+            auto tmp = (Ybus_ac_ * V).conjugate();
+            mismatch = V.array() * tmp.array() - Sbus_.array();
+            // nothing is produced on the de-energized islands
+            if(get_islands_res(ac).solved) mismatch = (V.array() == cplx_type(0.)).select(cplx_type(0.), mismatch);
+            active_mismatch = mismatch.real() * sn_mva_;
+        } else{
+            active_mismatch = RealVect::Zero(V.size());
+            //TODO SLACK: improve distributed slack for DC mode !
+            // it is possible to know in advance the contribution of each slack generators (sum(Sbus) MW 
+            // to split among the contributing generators) so it's possible to "mess with" Sbus 
+            // for such purpose
+            if(!get_islands_res(ac).solved){
+                const auto id_slack = slack_bus_id_dc_solver_(0);
+                active_mismatch(id_slack) = -Sbus_.real().sum() * sn_mva_;
+            }else{
+                // the power is balanced on each island (that has a slack bus)
+                for(const auto & island : get_islands(ac).islands){
+                    if(!island.conv) continue;
+                    real_type sum_island = 0.;
+                    for(auto bus_id : island.id_solver) sum_island += std::real(Sbus_(bus_id));
+                    active_mismatch(island.id_solver[island.slack_ids(0)]) = -sum_island * sn_mva_;
+                }
+            }
+        }
+        generators_.set_p_slack(active_mismatch, id_me_to_solver);
+
+        if(ac) ractive_mismatch = mismatch.imag() * sn_mva_;
+        // mainly to initialize the Q value of the generators in dc (just fill it with 0.)
+        generators_.set_q(ractive_mismatch, id_me_to_solver, ac);
+    }
+    if(result_types & ResLines) compute_coupler_flows(ac);
+}
+
+void GridModel::compute_coupler_flows(bool ac)
+{
+    if(zero_impedance_lines_.empty()) return;
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
+    const std::vector<int> & id_me_to_solver = ac ? id_me_to_ac_solver_ : id_me_to_dc_solver_;
+    const auto & V = get_res_V(ac);
+
+    // power (MW, MVAr) injected at each bus by all the elements (the couplers only count for their shunt part)
+    std::vector<cplx_type> injection(nb_bus, cplx_type(0.));
+    add_injection(injection, generators_.get_res(), generators_.get_status(), generators_.get_bus_id(), 1.);
+    add_injection(injection, sgens_.get_res(), sgens_.get_status(), sgens_.get_bus_id(), 1.);
+    add_injection(injection, loads_.get_res(), loads_.get_status(), loads_.get_bus_id(), -1.);
+    add_injection(injection, storages_.get_res(), storages_.get_status(), storages_.get_bus_id(), -1.);
+    add_injection(injection, shunts_.get_res(), shunts_.get_status(), shunts_.get_bus_id(), -1.);
+    add_injection(injection, powerlines_.get_lineor_res(), powerlines_.get_status(), powerlines_.get_bus_from(), -1.);
+    add_injection(injection, powerlines_.get_lineex_res(), powerlines_.get_status(), powerlines_.get_bus_to(), -1.);
+    add_injection(injection, trafos_.get_res_hv(), trafos_.get_status(), trafos_.get_bus_from(), -1.);
+    add_injection(injection, trafos_.get_res_lv(), trafos_.get_status(), trafos_.get_bus_to(), -1.);
+
+    // the couplers of each bus
+    std::vector<std::vector<int> > bus_couplers(nb_bus);
+    const auto & bus_or = powerlines_.get_bus_from();
+    const auto & bus_ex = powerlines_.get_bus_to();
+    for(std::size_t i = 0; i < zero_impedance_lines_.size(); ++i){
+        bus_couplers[bus_or(zero_impedance_lines_[i])].push_back(static_cast<int>(i));
+        bus_couplers[bus_ex(zero_impedance_lines_[i])].push_back(static_cast<int>(i));
+    }
+
+    // the power of each bus goes through the couplers of a spanning tree of its group of buses, from the leaves to
+    // the root (the power flowing in a loop of couplers cannot be known: it is 0. for the couplers not in the tree)
+    std::vector<cplx_type> s_or_ex(zero_impedance_lines_.size(), cplx_type(0.));
+    std::vector<int> parent_coupler(nb_bus, _deactivated_bus_id);
+    std::vector<bool> visited(nb_bus, false);
+    std::vector<int> order;
+    for(auto line_id : zero_impedance_lines_){
+        const int root = bus_or(line_id);
+        if(visited[root]) continue;
+        visited[root] = true;
+        order.clear();
+        order.push_back(root);
+        for(std::size_t pos = 0; pos < order.size(); ++pos){
+            const int bus_id = order[pos];
+            for(auto coupler_id : bus_couplers[bus_id]){
+                const int line_id_ = zero_impedance_lines_[coupler_id];
+                const int other_bus = bus_or(line_id_) == bus_id ? bus_ex(line_id_) : bus_or(line_id_);
+                if(visited[other_bus]) continue;
+                visited[other_bus] = true;
+                parent_coupler[other_bus] = coupler_id;
+                order.push_back(other_bus);
+            }
+        }
+        // nothing flows in the de-energized islands
+        const int root_solver = id_me_to_solver[root];
+        if(root_solver == _deactivated_bus_id || V(root_solver) == cplx_type(0.)) continue;
+        for(std::size_t pos = order.size() - 1; pos > 0; --pos){
+            const int bus_id = order[pos];
+            const int coupler_id = parent_coupler[bus_id];
+            const int line_id_ = zero_impedance_lines_[coupler_id];
+            // the power injected at this bus (and the ones below it) leaves through the coupler
+            const cplx_type s_out = injection[bus_id];
+            s_or_ex[coupler_id] = bus_or(line_id_) == bus_id ? s_out : -s_out;
+            const int parent = bus_or(line_id_) == bus_id ? bus_ex(line_id_) : bus_or(line_id_);
+            injection[parent] += s_out;
+        }
+    }
+    if(!ac){
+        for(auto & el : s_or_ex) el = {std::real(el), my_zero_};
+    }
+    powerlines_.add_coupler_flows(zero_impedance_lines_, s_or_ex);
+}
+
+void GridModel::set_line_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p_or,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q_or,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v_or,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > a_or,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta_or,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p_ex,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q_ex,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v_ex,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > a_ex,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta_ex)
+{
+    // powerlines then transformers
+    const int nb_branch = powerlines_.nb() + trafos_.nb();
+    check_res_buffer("p_or", static_cast<int>(p_or.size()), nb_branch);
+    check_res_buffer("q_or", static_cast<int>(q_or.size()), nb_branch);
+    check_res_buffer("v_or", static_cast<int>(v_or.size()), nb_branch);
+    check_res_buffer("a_or", static_cast<int>(a_or.size()), nb_branch);
+    check_res_buffer("theta_or", static_cast<int>(theta_or.size()), nb_branch);
+    check_res_buffer("p_ex", static_cast<int>(p_ex.size()), nb_branch);
+    check_res_buffer("q_ex", static_cast<int>(q_ex.size()), nb_branch);
+    check_res_buffer("v_ex", static_cast<int>(v_ex.size()), nb_branch);
+    check_res_buffer("a_ex", static_cast<int>(a_ex.size()), nb_branch);
+    check_res_buffer("theta_ex", static_cast<int>(theta_ex.size()), nb_branch);
+    res_buffers_.p_or = p_or;
+    res_buffers_.q_or = q_or;
+    res_buffers_.v_or = v_or;
+    res_buffers_.a_or = a_or;
+    res_buffers_.theta_or = theta_or;
+    res_buffers_.p_ex = p_ex;
+    res_buffers_.q_ex = q_ex;
+    res_buffers_.v_ex = v_ex;
+    res_buffers_.a_ex = a_ex;
+    res_buffers_.theta_ex = theta_ex;
+}
+
+void GridModel::set_load_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta)
+{
+    const int nb_load = loads_.nb();
+    check_res_buffer("load_p", static_cast<int>(p.size()), nb_load);
+    check_res_buffer("load_q", static_cast<int>(q.size()), nb_load);
+    check_res_buffer("load_v", static_cast<int>(v.size()), nb_load);
+    check_res_buffer("load_theta", static_cast<int>(theta.size()), nb_load);
+    res_buffers_.load_p = p;
+    res_buffers_.load_q = q;
+    res_buffers_.load_v = v;
+    res_buffers_.load_theta = theta;
+}
+
+void GridModel::set_gen_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta)
+{
+    const int nb_gen = generators_.nb();
+    check_res_buffer("gen_p", static_cast<int>(p.size()), nb_gen);
+    check_res_buffer("gen_q", static_cast<int>(q.size()), nb_gen);
+    check_res_buffer("gen_v", static_cast<int>(v.size()), nb_gen);
+    check_res_buffer("gen_theta", static_cast<int>(theta.size()), nb_gen);
+    res_buffers_.gen_p = p;
+    res_buffers_.gen_q = q;
+    res_buffers_.gen_v = v;
+    res_buffers_.gen_theta = theta;
+}
+
+void GridModel::set_storage_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                        Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                        Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                        Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta)
+{
+    const int nb_storage = storages_.nb();
+    check_res_buffer("storage_p", static_cast<int>(p.size()), nb_storage);
+    check_res_buffer("storage_q", static_cast<int>(q.size()), nb_storage);
+    check_res_buffer("storage_v", static_cast<int>(v.size()), nb_storage);
+    check_res_buffer("storage_theta", static_cast<int>(theta.size()), nb_storage);
+    res_buffers_.storage_p = p;
+    res_buffers_.storage_q = q;
+    res_buffers_.storage_v = v;
+    res_buffers_.storage_theta = theta;
+}
+
+void GridModel::set_shunt_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                      Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                      Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                      Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > bus)
+{
+    const int nb_shunt = shunts_.nb();
+    check_res_buffer("shunt_p", static_cast<int>(p.size()), nb_shunt);
+    check_res_buffer("shunt_q", static_cast<int>(q.size()), nb_shunt);
+    check_res_buffer("shunt_v", static_cast<int>(v.size()), nb_shunt);
+    check_res_buffer("shunt_bus", static_cast<int>(bus.size()), nb_shunt);
+    res_buffers_.shunt_p = p;
+    res_buffers_.shunt_q = q;
+    res_buffers_.shunt_v = v;
+    res_buffers_.shunt_bus = bus;
+}
+
+void GridModel::fill_res_buffers()
+{
+    const ResBuffers & buf = res_buffers_;
+    // the results written in the buffers are needed, even if they are not in the result mask
+    int needed = 0;
+    if(buf.p_or.is_set()) needed |= ResLines | ResTrafos;
+    if(buf.load_p.is_set()) needed |= ResLoads;
+    if(buf.gen_p.is_set()) needed |= ResGens;
+    if(buf.storage_p.is_set()) needed |= ResStorages;
+    if(buf.shunt_p.is_set()) needed |= ResShunts;
+    if(!needed) return;
+    ensure_results(needed);
+
+    // grid2op expects the flows in A (kA in lightsim2grid), and 0. for the voltages and flows of the
+    // disconnected powerlines
+    const int nb_line = powerlines_.nb();
+    const real_type ka_to_a = 1000.;
+    const tuple4d line_or = powerlines_.get_lineor_res();
+    const tuple4d line_ex = powerlines_.get_lineex_res();
+    const tuple4d trafo_hv = trafos_.get_res_hv();
+    const tuple4d trafo_lv = trafos_.get_res_lv();
+    copy_res(std::get<0>(line_or), buf.p_or, 0);
+    copy_res(std::get<1>(line_or), buf.q_or, 0);
+    copy_res(std::get<2>(line_or), buf.v_or, 0, 1.0, true);
+    copy_res(std::get<3>(line_or), buf.a_or, 0, ka_to_a, true);
+    copy_res(powerlines_.get_theta_or(), buf.theta_or, 0);
+    copy_res(std::get<0>(line_ex), buf.p_ex, 0);
+    copy_res(std::get<1>(line_ex), buf.q_ex, 0);
+    copy_res(std::get<2>(line_ex), buf.v_ex, 0, 1.0, true);
+    copy_res(std::get<3>(line_ex), buf.a_ex, 0, ka_to_a, true);
+    copy_res(powerlines_.get_theta_ex(), buf.theta_ex, 0);
+    copy_res(std::get<0>(trafo_hv), buf.p_or, nb_line);
+    copy_res(std::get<1>(trafo_hv), buf.q_or, nb_line);
+    copy_res(std::get<2>(trafo_hv), buf.v_or, nb_line, 1.0, true);
+    copy_res(std::get<3>(trafo_hv), buf.a_or, nb_line, ka_to_a, true);
+    copy_res(trafos_.get_theta_hv(), buf.theta_or, nb_line);
+    copy_res(std::get<0>(trafo_lv), buf.p_ex, nb_line);
+    copy_res(std::get<1>(trafo_lv), buf.q_ex, nb_line);
+    copy_res(std::get<2>(trafo_lv), buf.v_ex, nb_line, 1.0, true);
+    copy_res(std::get<3>(trafo_lv), buf.a_ex, nb_line, ka_to_a, true);
+    copy_res(trafos_.get_theta_lv(), buf.theta_ex, nb_line);
+
+    const tuple3d load_res = loads_.get_res();
+    copy_res(std::get<0>(load_res), buf.load_p, 0);
+    copy_res(std::get<1>(load_res), buf.load_q, 0);
+    copy_res(std::get<2>(load_res), buf.load_v, 0);
+    copy_res(loads_.get_theta(), buf.load_theta, 0);
+
+    const tuple3d gen_res = generators_.get_res();
+    copy_res(std::get<0>(gen_res), buf.gen_p, 0);
+    copy_res(std::get<1>(gen_res), buf.gen_q, 0);
+    copy_res(std::get<2>(gen_res), buf.gen_v, 0);
+    copy_res(generators_.get_theta(), buf.gen_theta, 0);
+
+    const tuple3d storage_res = storages_.get_res();
+    copy_res(std::get<0>(storage_res), buf.storage_p, 0);
+    copy_res(std::get<1>(storage_res), buf.storage_q, 0);
+    copy_res(std::get<2>(storage_res), buf.storage_v, 0);
+    copy_res(storages_.get_theta(), buf.storage_theta, 0);
+
+    const tuple3d shunt_res = shunts_.get_res();
+    copy_res(std::get<0>(shunt_res), buf.shunt_p, 0);
+    copy_res(std::get<1>(shunt_res), buf.shunt_q, 0);
+    copy_res(std::get<2>(shunt_res), buf.shunt_v, 0);
+    if(buf.shunt_bus.is_set()){
+        // grid2op convention: 1 or 2 for the bus of the substation, -1 if disconnected
+        const int nb_shunt = shunts_.nb();
+        const std::vector<bool> & shunt_status = shunts_.get_status();
+        const Eigen::VectorXi & shunt_bus_id = shunts_.get_bus_id();
+        for(int shunt_id = 0; shunt_id < nb_shunt; ++shunt_id){
+            if(!shunt_status[shunt_id]) buf.shunt_bus(shunt_id) = -1;
+            else buf.shunt_bus(shunt_id) = shunt_bus_id(shunt_id) >= static_->n_sub ? 2 : 1;
+        }
+    }
+}
+
+void GridModel::reset_results(int result_types){
+    results_pending_ &= ~result_types;
+    if(result_types & ResLines) powerlines_.reset_results();
+    if(result_types & ResShunts) shunts_.reset_results();
+    if(result_types & ResTrafos) trafos_.reset_results();
+    if(result_types & ResLoads) loads_.reset_results();
+    if(result_types & ResSGens) sgens_.reset_results();
+    if(result_types & ResStorages) storages_.reset_results();
+    if(result_types & ResGens) generators_.reset_results();
 }
 
 CplxVect GridModel::dc_pf(const CplxVect & Vinit,
@@ -587,7 +2293,7 @@ CplxVect GridModel::dc_pf(const CplxVect & Vinit,
     // the idea is to "mess" with the Sbus beforehand to split the "losses"
     // ie fake the action of generators to adjust Sbus such that sum(Sbus) = 0
     // and the slack contribution factors are met.
-    const int nb_bus = static_cast<int>(bus_vn_kv_.size());
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
     if(Vinit.size() != nb_bus){
         //TODO DEBUG MODE: 
         std::ostringstream exc_;
@@ -608,7 +2314,9 @@ CplxVect GridModel::dc_pf(const CplxVect & Vinit,
 
     // start the solver
     slack_weights_ = generators_.get_slack_weights(Ybus_dc_.rows(), id_me_to_dc_solver_);
-    conv = _dc_solver.compute_pf(Ybus_dc_, V, Sbus_, slack_bus_id_dc_solver_, slack_weights_, bus_pv_, bus_pq_, max_iter, tol);
+    islands_res_dc_.solved = !islands_dc_.islands.empty();
+    if(islands_res_dc_.solved) conv = solve_islands(is_ac, V, slack_bus_id_dc_solver_, max_iter, tol);
+    else conv = _dc_solver.compute_pf(Ybus_dc_, V, Sbus_, slack_bus_id_dc_solver_, slack_weights_, bus_pv_, bus_pq_, max_iter, tol);
 
     // store results (fase -> because I am in dc mode)
     process_results(conv, res, Vinit, false, id_me_to_dc_solver_);
@@ -693,78 +2401,317 @@ void GridModel::update_bus_status(int nb_bus_before,
 void GridModel::update_gens_p(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                               Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
-    update_continuous_values(has_changed, new_values, &GridModel::change_p_gen);
+    update_continuous_values(has_changed, new_values, [this](int el_id, real_type new_value){change_p_gen(el_id, new_value);});
 }
 void GridModel::update_gens_v(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                               Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
-    update_continuous_values(has_changed, new_values, &GridModel::change_v_gen);
+    update_continuous_values(has_changed, new_values, [this](int el_id, real_type new_value){change_v_gen(el_id, new_value);});
 }
 void GridModel::update_loads_p(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                               Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
-    update_continuous_values(has_changed, new_values, &GridModel::change_p_load);
+    update_continuous_values(has_changed, new_values, [this](int el_id, real_type new_value){change_p_load(el_id, new_value);});
 }
 void GridModel::update_loads_q(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                               Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
-    update_continuous_values(has_changed, new_values, &GridModel::change_q_load);
+    update_continuous_values(has_changed, new_values, [this](int el_id, real_type new_value){change_q_load(el_id, new_value);});
 }
 void GridModel::update_storages_p(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                               Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
-    update_continuous_values(has_changed, new_values, &GridModel::change_p_storage);
+    update_continuous_values(has_changed, new_values, [this](int el_id, real_type new_value){change_p_storage(el_id, new_value);});
+}
+void GridModel::update_shunts(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > p_changed,
+                              Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_p,
+                              Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > q_changed,
+                              Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_q,
+                              Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > bus_changed,
+                              Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > new_bus)
+{
+    // the topology is modified first, otherwise the p / q of a shunt being reconnected cannot be changed
+    if(bus_changed.any() && (static_->shunt_to_subid.size() != bus_changed.size())){
+        std::ostringstream exc_;
+        exc_ << "GridModel::update_shunts: the substation of " << static_->shunt_to_subid.size() << " shunts is known ";
+        exc_ << "(see GridModel::set_shunt_to_subid) but the topology of " << bus_changed.size() << " shunts is modified.";
+        throw std::runtime_error(exc_.str());
+    }
+    for(int shunt_id = 0; shunt_id < bus_changed.rows(); ++shunt_id)
+    {
+        if(!bus_changed(shunt_id)) continue;
+        const int bus_grid2op = new_bus(shunt_id);
+        if(bus_grid2op > 0){
+            const int sub_id = static_->shunt_to_subid(shunt_id);
+            reactivate_shunt(shunt_id);
+            change_bus_shunt(shunt_id, bus_grid2op == 1 ? sub_id : sub_id + static_->n_sub);
+        }else{
+            deactivate_shunt(shunt_id);
+        }
+    }
+    update_continuous_values(p_changed, new_p, [this](int el_id, real_type new_value){change_p_shunt(el_id, new_value);});
+    update_continuous_values(q_changed, new_q, [this](int el_id, real_type new_value){change_q_shunt(el_id, new_value);});
+}
+
+void GridModel::apply_action_packed(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > gen_p_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > gen_p,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > gen_v_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > gen_v,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > load_p_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > load_p,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > load_q_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > load_q,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > storage_p_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > storage_p,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_p_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > shunt_p,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_q_changed,
+                                    Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > shunt_q,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_bus_changed,
+                                    Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > shunt_bus,
+                                    Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > topo_changed,
+                                    Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > topo_values)
+{
+    // same order as the successive calls previously made by the LightSimBackend:
+    // injections, then shunts, then the topology
+    update_gens_p(gen_p_changed, gen_p);
+    // the voltage setpoints are given in kV (as in grid2op): they are converted with the nominal
+    // voltage of the bus 1 of the substation of the generator
+    const auto & gen_to_subid = static_->gen_to_subid;
+    if(gen_to_subid.size() != gen_v_changed.size()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::apply_action_packed: gen_v_changed has " << gen_v_changed.size() << " elements but the";
+        exc_ << " substation of " << gen_to_subid.size() << " generators is known (see `set_gen_to_subid`).";
+        throw std::runtime_error(exc_.str());
+    }
+    update_continuous_values(gen_v_changed, gen_v,
+                             [this, &gen_to_subid](int gen_id, real_type new_v_kv){
+                                change_v_gen(gen_id, new_v_kv / static_->bus_vn_kv(gen_to_subid(gen_id)));
+                             });
+    update_loads_p(load_p_changed, load_p);
+    update_loads_q(load_q_changed, load_q);
+    update_storages_p(storage_p_changed, storage_p);
+    update_shunts(shunt_p_changed, shunt_p, shunt_q_changed, shunt_q, shunt_bus_changed, shunt_bus);
+    update_topo(topo_changed, topo_values);
 }
 
 void GridModel::update_topo(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                             Eigen::Ref<Eigen::Array<int,  Eigen::Dynamic, Eigen::RowMajor> > new_values)
 {
     const int nb_bus = static_cast<int>(bus_status_.size());
-    for(int i = 0; i < nb_bus; ++i) bus_status_[i] = false;
+    for(int i = 0; i < nb_bus; ++i){
+        journal_status(JournalKey::BusStatus, i, bus_status_);
+        bus_status_[i] = false;
+    }
 
     update_topo_generic(has_changed, new_values,
-                        load_pos_topo_vect_, load_to_subid_,
-                        &GridModel::reactivate_load,
-                        &GridModel::change_bus_load,
-                        &GridModel::deactivate_load
+                        static_->load_pos_topo_vect, static_->load_to_subid,
+                        [this](int el_id){reactivate_load(el_id);},
+                        [this](int el_id, int new_bus){change_bus_load(el_id, new_bus);},
+                        [this](int el_id){deactivate_load(el_id);}
                         );
     update_topo_generic(has_changed, new_values,
-                        gen_pos_topo_vect_, gen_to_subid_,
-                        &GridModel::reactivate_gen,
-                        &GridModel::change_bus_gen,
-                        &GridModel::deactivate_gen
+                        static_->gen_pos_topo_vect, static_->gen_to_subid,
+                        [this](int el_id){reactivate_gen(el_id);},
+                        [this](int el_id, int new_bus){change_bus_gen(el_id, new_bus);},
+                        [this](int el_id){deactivate_gen(el_id);}
                         );
     update_topo_generic(has_changed, new_values,
-                        storage_pos_topo_vect_, storage_to_subid_,
-                        &GridModel::reactivate_storage,
-                        &GridModel::change_bus_storage,
-                        &GridModel::deactivate_storage
+                        static_->storage_pos_topo_vect, static_->storage_to_subid,
+                        [this](int el_id){reactivate_storage(el_id);},
+                        [this](int el_id, int new_bus){change_bus_storage(el_id, new_bus);},
+                        [this](int el_id){deactivate_storage(el_id);}
                         );
 
     // NB we suppose that if a powerline (or a trafo) is disconnected, then both its ends are
     // and same for trafo, obviously
     update_topo_generic(has_changed, new_values,
-                        line_or_pos_topo_vect_, line_or_to_subid_,
-                        &GridModel::reactivate_powerline,
-                        &GridModel::change_bus_powerline_or,
-                        &GridModel::deactivate_powerline
+                        static_->line_or_pos_topo_vect, static_->line_or_to_subid,
+                        [this](int el_id){reactivate_powerline(el_id);},
+                        [this](int el_id, int new_bus){change_bus_powerline_or(el_id, new_bus);},
+                        [this](int el_id){deactivate_powerline(el_id);}
                         );
     update_topo_generic(has_changed, new_values,
-                        line_ex_pos_topo_vect_, line_ex_to_subid_,
-                        &GridModel::reactivate_powerline,
-                        &GridModel::change_bus_powerline_ex,
-                        &GridModel::deactivate_powerline
+                        static_->line_ex_pos_topo_vect, static_->line_ex_to_subid,
+                        [this](int el_id){reactivate_powerline(el_id);},
+                        [this](int el_id, int new_bus){change_bus_powerline_ex(el_id, new_bus);},
+                        [this](int el_id){deactivate_powerline(el_id);}
                         );
     update_topo_generic(has_changed, new_values,
-                        trafo_hv_pos_topo_vect_, trafo_hv_to_subid_,
-                        &GridModel::reactivate_trafo,
-                        &GridModel::change_bus_trafo_hv,
-                        &GridModel::deactivate_trafo
+                        static_->trafo_hv_pos_topo_vect, static_->trafo_hv_to_subid,
+                        [this](int el_id){reactivate_trafo(el_id);},
+                        [this](int el_id, int new_bus){change_bus_trafo_hv(el_id, new_bus);},
+                        [this](int el_id){deactivate_trafo(el_id);}
                         );
     update_topo_generic(has_changed, new_values,
-                        trafo_lv_pos_topo_vect_, trafo_lv_to_subid_,
-                        &GridModel::reactivate_trafo,
-                        &GridModel::change_bus_trafo_lv,
-                        &GridModel::deactivate_trafo
+                        static_->trafo_lv_pos_topo_vect, static_->trafo_lv_to_subid,
+                        [this](int el_id){reactivate_trafo(el_id);},
+                        [this](int el_id, int new_bus){change_bus_trafo_lv(el_id, new_bus);},
+                        [this](int el_id){deactivate_trafo(el_id);}
                         );
 }
+
+const std::vector<bool> & GridModel::get_status(TerminalType type) const
+{
+    switch (type)
+    {
+    case TerminalType::Load: return loads_.get_status();
+    case TerminalType::Gen: return generators_.get_status();
+    case TerminalType::SGen: return sgens_.get_status();
+    case TerminalType::Storage: return storages_.get_status();
+    case TerminalType::Shunt: return shunts_.get_status();
+    case TerminalType::LineOr:
+    case TerminalType::LineEx: return powerlines_.get_status();
+    case TerminalType::TrafoHv:
+    case TerminalType::TrafoLv: return trafos_.get_status();
+    }
+    throw std::runtime_error("GridModel::get_status: unknown element type");
+}
+
+void GridModel::check_values(TerminalType type, ElementAttribute attribute,
+                             const Eigen::Ref<const Eigen::VectorXi> & el_ids,
+                             const Eigen::Ref<const RealVect> & values) const
+{
+    if(el_ids.size() != values.size()){
+        std::ostringstream exc_;
+        exc_ << "GridModel::set_values: " << values.size() << " values are given for " << el_ids.size() << " elements.";
+        throw std::runtime_error(exc_.str());
+    }
+
+    const bool is_branch = type == TerminalType::LineOr || type == TerminalType::LineEx ||
+                           type == TerminalType::TrafoHv || type == TerminalType::TrafoLv;
+    bool valid_attribute = true;
+    switch (attribute)
+    {
+    case ElementAttribute::P: valid_attribute = !is_branch; break;
+    case ElementAttribute::Q: valid_attribute = !is_branch && type != TerminalType::Gen; break;
+    case ElementAttribute::V: valid_attribute = type == TerminalType::Gen; break;
+    case ElementAttribute::Bus:
+    case ElementAttribute::Status: break;
+    }
+    if(!valid_attribute){
+        std::ostringstream exc_;
+        exc_ << "GridModel::set_values: this attribute cannot be modified for this type of elements ";
+        exc_ << "(only the generators have a voltage setpoint, and the generators and the branches have no reactive setpoint).";
+        throw std::runtime_error(exc_.str());
+    }
+
+    const std::vector<bool> & status = get_status(type);
+    const int nb_el = static_cast<int>(status.size());
+    const bool is_injection = attribute == ElementAttribute::P || attribute == ElementAttribute::Q || attribute == ElementAttribute::V;
+    const int nb_bus = static_cast<int>(static_->bus_vn_kv.size());
+    for(Eigen::Index i = 0; i < el_ids.size(); ++i){
+        const int el_id = el_ids(i);
+        if(el_id < 0 || el_id >= nb_el){
+            std::ostringstream exc_;
+            exc_ << "GridModel::set_values: element id " << el_id << " is not valid (there are " << nb_el << " such elements).";
+            throw std::out_of_range(exc_.str());
+        }
+        // the value of a disconnected element cannot be changed
+        if(is_injection && !status[el_id]){
+            std::ostringstream exc_;
+            exc_ << "GridModel::set_values: Impossible to change the value of the disconnected element with id " << el_id << ".";
+            throw std::runtime_error(exc_.str());
+        }
+        if(attribute == ElementAttribute::Bus){
+            const real_type bus_id = values(i);
+            if(bus_id != std::floor(bus_id) || bus_id < 0 || bus_id >= nb_bus){
+                std::ostringstream exc_;
+                exc_ << "GridModel::set_values: " << bus_id << " is not a valid bus id for the element with id " << el_id;
+                exc_ << " (there are " << nb_bus << " buses).";
+                throw std::out_of_range(exc_.str());
+            }
+        }
+    }
+}
+
+void GridModel::set_values(TerminalType type, ElementAttribute attribute,
+                           const Eigen::Ref<const Eigen::VectorXi> & el_ids,
+                           const Eigen::Ref<const RealVect> & values)
+{
+    // nothing is modified if one of the values is not valid
+    check_values(type, attribute, el_ids, values);
+    // the results are dropped once for all the modifications
+    drop_pending_results();
+
+    // the type of element and the attribute are dispatched once, and not for each element
+    switch (attribute)
+    {
+    case ElementAttribute::P:
+        switch (type)
+        {
+        case TerminalType::Load: apply_values(el_ids, values, [this](int id, real_type val){change_p_load(id, val);}); break;
+        case TerminalType::Gen: apply_values(el_ids, values, [this](int id, real_type val){change_p_gen(id, val);}); break;
+        case TerminalType::SGen: apply_values(el_ids, values, [this](int id, real_type val){change_p_sgen(id, val);}); break;
+        case TerminalType::Storage: apply_values(el_ids, values, [this](int id, real_type val){change_p_storage(id, val);}); break;
+        case TerminalType::Shunt: apply_values(el_ids, values, [this](int id, real_type val){change_p_shunt(id, val);}); break;
+        default: break;
+        }
+        break;
+    case ElementAttribute::Q:
+        switch (type)
+        {
+        case TerminalType::Load: apply_values(el_ids, values, [this](int id, real_type val){change_q_load(id, val);}); break;
+        case TerminalType::SGen: apply_values(el_ids, values, [this](int id, real_type val){change_q_sgen(id, val);}); break;
+        case TerminalType::Storage: apply_values(el_ids, values, [this](int id, real_type val){change_q_storage(id, val);}); break;
+        case TerminalType::Shunt: apply_values(el_ids, values, [this](int id, real_type val){change_q_shunt(id, val);}); break;
+        default: break;
+        }
+        break;
+    case ElementAttribute::V:
+        apply_values(el_ids, values, [this](int id, real_type val){change_v_gen(id, val);});
+        break;
+    case ElementAttribute::Bus:
+        switch (type)
+        {
+        case TerminalType::Load: apply_values(el_ids, values, [this](int id, real_type val){change_bus_load(id, static_cast<int>(val));}); break;
+        case TerminalType::Gen: apply_values(el_ids, values, [this](int id, real_type val){change_bus_gen(id, static_cast<int>(val));}); break;
+        case TerminalType::SGen: apply_values(el_ids, values, [this](int id, real_type val){change_bus_sgen(id, static_cast<int>(val));}); break;
+        case TerminalType::Storage: apply_values(el_ids, values, [this](int id, real_type val){change_bus_storage(id, static_cast<int>(val));}); break;
+        case TerminalType::Shunt: apply_values(el_ids, values, [this](int id, real_type val){change_bus_shunt(id, static_cast<int>(val));}); break;
+        case TerminalType::LineOr: apply_values(el_ids, values, [this](int id, real_type val){change_bus_powerline_or(id, static_cast<int>(val));}); break;
+        case TerminalType::LineEx: apply_values(el_ids, values, [this](int id, real_type val){change_bus_powerline_ex(id, static_cast<int>(val));}); break;
+        case TerminalType::TrafoHv: apply_values(el_ids, values, [this](int id, real_type val){change_bus_trafo_hv(id, static_cast<int>(val));}); break;
+        case TerminalType::TrafoLv: apply_values(el_ids, values, [this](int id, real_type val){change_bus_trafo_lv(id, static_cast<int>(val));}); break;
+        }
+        break;
+    case ElementAttribute::Status:
+        switch (type)
+        {
+        case TerminalType::Load: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_load(id); else deactivate_load(id);}); break;
+        case TerminalType::Gen: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_gen(id); else deactivate_gen(id);}); break;
+        case TerminalType::SGen: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_sgen(id); else deactivate_sgen(id);}); break;
+        case TerminalType::Storage: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_storage(id); else deactivate_storage(id);}); break;
+        case TerminalType::Shunt: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_shunt(id); else deactivate_shunt(id);}); break;
+        case TerminalType::LineOr:
+        case TerminalType::LineEx: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_powerline(id); else deactivate_powerline(id);}); break;
+        case TerminalType::TrafoHv:
+        case TerminalType::TrafoLv: apply_values(el_ids, values, [this](int id, real_type val){if(val != 0.) reactivate_trafo(id); else deactivate_trafo(id);}); break;
+        }
+        break;
+    }
+}
+
+void GridModel::set_values_mask(TerminalType type, ElementAttribute attribute,
+                                const Eigen::Ref<const Eigen::Array<bool, Eigen::Dynamic, 1> > & has_changed,
+                                const Eigen::Ref<const RealVect> & new_values)
+{
+    const Eigen::Index nb_el = static_cast<Eigen::Index>(get_status(type).size());
+    if(has_changed.size() != nb_el || new_values.size() != nb_el){
+        std::ostringstream exc_;
+        exc_ << "GridModel::set_values: there are " << nb_el << " elements of this type but ";
+        exc_ << has_changed.size() << " and " << new_values.size() << " values are given.";
+        throw std::runtime_error(exc_.str());
+    }
+    const Eigen::Index nb_changed = has_changed.count();
+    Eigen::VectorXi el_ids(nb_changed);
+    RealVect values(nb_changed);
+    Eigen::Index pos = 0;
+    for(Eigen::Index el_id = 0; el_id < nb_el; ++el_id){
+        if(!has_changed(el_id)) continue;
+        el_ids(pos) = static_cast<int>(el_id);
+        values(pos) = new_values(el_id);
+        ++pos;
+    }
+    set_values(type, attribute, el_ids, values);
+}
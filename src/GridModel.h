@@ -16,8 +16,12 @@
 #include <cstdint> // for int32
 #include <chrono>
 #include <cmath>  // for PI
+#include <memory>
+#include <array>
 
 #include "Utils.h"
+#include "CowPtr.h"
+#include "BinaryState.h"
 
 // eigen is necessary to easily pass data from numpy to c++ without any copy.
 // and to optimize the matrix operations
@@ -31,15 +35,24 @@
 #include "DataLine.h"
 #include "DataShunt.h"
 #include "DataTrafo.h"
+#include "BranchTable.h"
 #include "DataLoad.h"
 #include "DataGen.h"
 #include "DataSGen.h"
+#include "Connectivity.h"
+#include "NodeBreaker.h"
 
 
 // import newton raphson solvers using different linear algebra solvers
 #include "ChooseSolver.h"
 
-//TODO implement a BFS check to make sure the Ymatrix is "connected" [one single component]
+// the results computed after a powerflow, they can be combined (see GridModel::set_result_mask)
+enum ResultType {ResLines = 1, ResTrafos = 2, ResLoads = 4, ResSGens = 8, ResStorages = 16, ResShunts = 32, ResGens = 64,
+                 ResAll = 127};
+
+// the attributes of the elements that can be modified in bulk (see GridModel::set_values)
+enum class ElementAttribute {P, Q, V, Bus, Status};
+
 class GridModel : public DataGeneric
 {
     public:
@@ -67,15 +80,23 @@ class GridModel : public DataGeneric
                 DataLoad::StateRes
                 >  StateRes;
 
-        GridModel():need_reset_(true), topo_changed_(true), compute_results_(true),init_vm_pu_(1.04), sn_mva_(1.0){
+        GridModel():need_reset_(true), topo_changed_(true), compute_results_(true), result_mask_(ResAll), results_pending_(0),
+                    results_ac_(true), init_vm_pu_(1.04), sn_mva_(1.0),
+                    kron_reduction_(false), kron_nb_eliminated_(0), ward_extended_(false),
+                    next_snapshot_id_(0){
             _dc_solver.change_solver(SolverType::DC);
         }
         GridModel(const GridModel & other);
-        GridModel copy() const{
-            GridModel res(*this);
-            return res;
+        /**
+        If keep_solver_state is true, the admittance matrices, the conversion of the bus ids and the state of the solvers
+        (including their factorization when the linear solver allows it) are copied too: the first powerflow on the copy
+        is then as fast as the next powerflow on "other" would be.
+        **/
+        GridModel(const GridModel & other, bool keep_solver_state);
+        GridModel copy(bool keep_solver_state=false) const{
+            return GridModel(*this, keep_solver_state);
         }
-        Eigen::Index total_bus() const {return bus_vn_kv_.size();}
+        Eigen::Index total_bus() const {return static_->bus_vn_kv.size();}
         const std::vector<int> & id_me_to_ac_solver() const {return id_me_to_ac_solver_;}
         const std::vector<int> & id_ac_solver_to_me() const {return id_ac_solver_to_me_;}
         const std::vector<int> & id_me_to_dc_solver() const {return id_me_to_dc_solver_;}
@@ -87,10 +108,15 @@ class GridModel : public DataGeneric
         const DataLoad & get_loads_as_data() const {return loads_;}
         const DataLine & get_powerlines_as_data() const {return powerlines_;}
         const DataTrafo & get_trafos_as_data() const {return trafos_;}
-        Eigen::Ref<const RealVect> get_bus_vn_kv() const {return bus_vn_kv_;}
+        const DataLoad & get_storages_as_data() const {return storages_;}
+        const DataShunt & get_shunts_as_data() const {return shunts_;}
+        // all the branches (powerlines then trafos), filled from the powerlines and trafos the first time it is used
+        const BranchTable & get_branches();
+        Eigen::Ref<const RealVect> get_bus_vn_kv() const {return static_->bus_vn_kv;}
 
         // solver "control"
         void change_solver(const SolverType & type){
+            drop_pending_results();
             need_reset_ = true;
             topo_changed_ = true;
             if(_solver.is_dc(type)) _dc_solver.change_solver(type);
@@ -100,11 +126,66 @@ class GridModel : public DataGeneric
         SolverType get_solver_type() {return _solver.get_type(); }
         SolverType get_dc_solver_type() {return _dc_solver.get_type(); }
         const ChooseSolver & get_solver() const {return _solver;}
+        // settings of all the KLU based solvers (ac, dc and the ones of the islands), kept when the model is copied
+        void set_klu_config(const KLUSolverConfig & config);
+        KLUSolverConfig get_klu_config() const {return _solver.get_klu_config();}
+        // settings of the GaussSeidelColored solvers (ac and the ones of the islands), kept when the model is copied
+        void set_gauss_seidel_colored_config(int nb_thread, real_type omega, bool adaptive);
+        std::tuple<int, real_type, bool> get_gauss_seidel_colored_config() const {return _solver.get_gauss_seidel_colored_config();}
         const ChooseSolver & get_dc_solver() const {return _dc_solver;}
 
+        /**
+        Kron reduction: the PQ buses without any injection are eliminated from the admittance matrix before the ac
+        powerflow (their voltages are then recovered from the ones of their neighbors). Off by default, the reduced
+        admittance matrix can be (much) denser than the original one when many adjacent buses are eliminated.
+        **/
+        void set_kron_reduction(bool kron_reduction){
+            if(kron_reduction == kron_reduction_) return;
+            drop_pending_results();
+            kron_reduction_ = kron_reduction;
+            islands_ac_.ok = false;  // the reduction is only used for the ac powerflow
+        }
+        bool get_kron_reduction() const {return kron_reduction_;}
+        int nb_kron_eliminated() const {return kron_nb_eliminated_;}
+
+        // ids, in the full grid, of the buses and of the elements of a Ward equivalent (-1 for the equivalent elements)
+        struct WardIds
+        {
+            int nb_bus_full = 0;
+            std::vector<int> bus;
+            std::vector<int> line;
+            std::vector<int> trafo;
+            std::vector<int> shunt;
+            std::vector<int> gen;
+            std::vector<int> load;
+            std::vector<int> sgen;
+            std::vector<int> storage;
+        };
+
+        /**
+        Ward equivalent: a new model where only the internal buses (and the boundary buses, the external buses
+        directly connected to them) and the elements between them are kept. The rest of the grid is replaced by
+        equivalent branches and shunts between the boundary buses and by one injection per boundary bus (a load, or
+        a generator holding the voltage for the extended Ward equivalent), fitted so that the model gives V_full on
+        the kept buses. The buses and the elements are numbered again (in the order of their ids), the equivalent
+        elements are added after the kept ones: see get_ward_ids for the ids in this grid.
+        **/
+        GridModel ward_equivalent(const Eigen::VectorXi & internal_buses, const CplxVect & V_full, bool extended);
+        // fit the injections of the boundary buses of a Ward equivalent from the voltages of the full grid
+        void refit_ward_injections(const CplxVect & V_full);
+        // the boundary buses (ids in the Ward equivalent)
+        const std::vector<int> & get_ward_boundary_buses() const {return ward_boundary_buses_;}
+        // ids of the loads (or of the generators for the extended Ward equivalent) at the boundary buses
+        const std::vector<int> & get_ward_injections() const {return ward_injection_ids_;}
+        const WardIds & get_ward_ids() const {return ward_ids_;}
+
         // do i compute the results (in terms of P,Q,V or loads, generators and flows on lines
         void deactivate_result_computation(){compute_results_=false;}
         void reactivate_result_computation(){compute_results_=true;}
+        // which results are computed right after the powerflow (combination of ResultType), the other ones are
+        // computed (once) from the last voltages the first time they are accessed
+        void set_result_mask(int result_mask);
+        int get_result_mask() const {return result_mask_;}
 
         // All methods to init this data model, all need to be pair unit when applicable
         void init_bus(const RealVect & bus_vn_kv, int nb_line, int nb_trafo);
@@ -120,6 +201,8 @@ class GridModel : public DataGeneric
                              const Eigen::VectorXi & branch_to_id
                              ){
             powerlines_.init(branch_r, branch_x, branch_h, branch_from_id, branch_to_id);
+            connectivity_.clear();
+            branches_.clear();
         }
         void init_shunt(const RealVect & shunt_p_mw,
                         const RealVect & shunt_q_mvar,
@@ -139,6 +222,8 @@ class GridModel : public DataGeneric
                         ){
             trafos_.init(trafo_r, trafo_x, trafo_b, trafo_tap_step_pct, trafo_tap_pos, trafo_shift_degree,
                          trafo_tap_hv, trafo_hv_id, trafo_lv_id);
+            connectivity_.clear();
+            branches_.clear();
         }
         void init_generators(const RealVect & generators_p,
                              const RealVect & generators_v,
@@ -173,6 +258,25 @@ class GridModel : public DataGeneric
         //pickle
         GridModel::StateRes get_state() const ;
         void set_state(GridModel::StateRes & my_state) ;
+
+        // compact binary representation of the state (see BinaryState.h), used for pickle
+        std::string to_bytes() const;
+        void from_bytes(const std::string & data);
+        // same as to_bytes / from_bytes but with a file
+        void save(const std::string & path) const;
+        void load(const std::string & path);
+
+        /**
+        snapshot / restore: once a snapshot is taken, the changes of status, bus and injections are recorded in a
+        journal (only the first change of each value is recorded) and `restore` undoes them, in O(number of changes).
+        Other modifications (parameters of the elements, slack buses, solver etc.) are not recorded.
+
+        A snapshot can be restored multiple times. Restoring a snapshot discards the snapshots taken after it.
+        **/
+        int snapshot();
+        void restore(int snapshot_id);
+        bool has_snapshot(int snapshot_id) const;
+        void clear_snapshots();
         template<class T>
         void check_size(const T& my_state)
         {
@@ -204,77 +308,123 @@ class GridModel : public DataGeneric
 
         // check the kirchoff law
         CplxVect check_solution(const CplxVect & V, bool check_q_limits);
+        /**
+        same as check_solution for many states of the grid at once (one per row of Vs, the result has the same shape).
+        The admittance matrix and the injections are computed once, and the states are split between the threads.
+        **/
+        CplxMat check_solutions(const Eigen::Ref<const CplxMat> & Vs, bool check_q_limits);
 
         // deactivate a bus. Be careful, if a bus is deactivated, but an element is
         //still connected to it, it will throw an exception
-        void deactivate_bus(int bus_id) {_deactivate(bus_id, bus_status_, topo_changed_); }
+        void deactivate_bus(int bus_id) {journal_status(JournalKey::BusStatus, bus_id, bus_status_); _deactivate(bus_id, bus_status_, topo_changed_); }
         // if a bus is connected, but isolated, it will make the powerflow diverge
-        void reactivate_bus(int bus_id) {_reactivate(bus_id, bus_status_, topo_changed_); }
+        void reactivate_bus(int bus_id) {journal_status(JournalKey::BusStatus, bus_id, bus_status_); _reactivate(bus_id, bus_status_, topo_changed_); }
         int nb_bus() const;  // number of activated buses
         Eigen::Index nb_powerline() const {return powerlines_.nb();}
         Eigen::Index nb_trafo() const {return trafos_.nb();}
 
-        // read only data accessor
-        const DataLine & get_lines() const {return powerlines_;}
-        const DataTrafo & get_trafos() const {return trafos_;}
-        const DataGen & get_generators() const {return generators_;}
-        const DataLoad & get_loads() const {return loads_;}
-        const DataLoad & get_storages() const {return storages_;}
-        const DataSGen & get_static_generators() const {return sgens_;}
-        const DataShunt & get_shunts() const {return shunts_;}
+        // read only data accessor (the results, if they are not computed yet, are computed first)
+        const DataLine & get_lines() {ensure_results(ResLines); return powerlines_;}
+        const DataTrafo & get_trafos() {ensure_results(ResTrafos); return trafos_;}
+        const DataGen & get_generators() {ensure_results(ResGens); return generators_;}
+        const DataLoad & get_loads() {ensure_results(ResLoads); return loads_;}
+        const DataLoad & get_storages() {ensure_results(ResStorages); return storages_;}
+        const DataSGen & get_static_generators() {ensure_results(ResSGens); return sgens_;}
+        const DataShunt & get_shunts() {ensure_results(ResShunts); return shunts_;}
 
         //deactivate a powerline (disconnect it)
-        void deactivate_powerline(int powerline_id) {powerlines_.deactivate(powerline_id, topo_changed_); }
-        void reactivate_powerline(int powerline_id) {powerlines_.reactivate(powerline_id, topo_changed_); }
-        void change_bus_powerline_or(int powerline_id, int new_bus_id) {powerlines_.change_bus_or(powerline_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
-        void change_bus_powerline_ex(int powerline_id, int new_bus_id) {powerlines_.change_bus_ex(powerline_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
+        void deactivate_powerline(int powerline_id) {journal_status(JournalKey::LineStatus, powerline_id, powerlines_.get_status()); powerlines_.deactivate(powerline_id, topo_changed_); update_branch(powerlines_, powerline_id, powerline_id); }
+        void reactivate_powerline(int powerline_id) {journal_status(JournalKey::LineStatus, powerline_id, powerlines_.get_status()); powerlines_.reactivate(powerline_id, topo_changed_); update_branch(powerlines_, powerline_id, powerline_id); }
+        void change_bus_powerline_or(int powerline_id, int new_bus_id) {journal_bus(JournalKey::LineBusOr, powerline_id, powerlines_.get_bus_from()); powerlines_.change_bus_or(powerline_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); update_branch(powerlines_, powerline_id, powerline_id); }
+        void change_bus_powerline_ex(int powerline_id, int new_bus_id) {journal_bus(JournalKey::LineBusEx, powerline_id, powerlines_.get_bus_to()); powerlines_.change_bus_ex(powerline_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); update_branch(powerlines_, powerline_id, powerline_id); }
         int get_bus_powerline_or(int powerline_id) {return powerlines_.get_bus_or(powerline_id);}
         int get_bus_powerline_ex(int powerline_id) {return powerlines_.get_bus_ex(powerline_id);}
 
         //deactivate trafo
-        void deactivate_trafo(int trafo_id) {trafos_.deactivate(trafo_id, topo_changed_); }
-        void reactivate_trafo(int trafo_id) {trafos_.reactivate(trafo_id, topo_changed_); }
-        void change_bus_trafo_hv(int trafo_id, int new_bus_id) {trafos_.change_bus_hv(trafo_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
-        void change_bus_trafo_lv(int trafo_id, int new_bus_id) {trafos_.change_bus_lv(trafo_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
+        void deactivate_trafo(int trafo_id) {journal_status(JournalKey::TrafoStatus, trafo_id, trafos_.get_status()); trafos_.deactivate(trafo_id, topo_changed_); update_branch(trafos_, trafo_id, static_cast<int>(nb_powerline()) + trafo_id); }
+        void reactivate_trafo(int trafo_id) {journal_status(JournalKey::TrafoStatus, trafo_id, trafos_.get_status()); trafos_.reactivate(trafo_id, topo_changed_); update_branch(trafos_, trafo_id, static_cast<int>(nb_powerline()) + trafo_id); }
+        void change_bus_trafo_hv(int trafo_id, int new_bus_id) {journal_bus(JournalKey::TrafoBusHv, trafo_id, trafos_.get_bus_from()); trafos_.change_bus_hv(trafo_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); update_branch(trafos_, trafo_id, static_cast<int>(nb_powerline()) + trafo_id); }
+        void change_bus_trafo_lv(int trafo_id, int new_bus_id) {journal_bus(JournalKey::TrafoBusLv, trafo_id, trafos_.get_bus_to()); trafos_.change_bus_lv(trafo_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); update_branch(trafos_, trafo_id, static_cast<int>(nb_powerline()) + trafo_id); }
         int get_bus_trafo_hv(int trafo_id) {return trafos_.get_bus_hv(trafo_id);}
         int get_bus_trafo_lv(int trafo_id) {return trafos_.get_bus_lv(trafo_id);}
 
+        // connectivity of the grid (see Connectivity), computed from the status of the powerlines and trafos and
+        // kept up to date when they are modified. The branches are the powerlines (ids 0 to nb_powerline() - 1)
+        // followed by the trafos.
+        int nb_connected_components() {return get_connectivity().nb_components(bus_status_);}
+        // for each bus, the id of its island (-1 for the deactivated buses)
+        Eigen::VectorXi get_bus_islands();
+        const std::vector<bool> & get_bridges() {return get_connectivity().get_bridges();}
+        const std::vector<bool> & get_articulation_points() {return get_connectivity().get_articulation_points();}
+        // whether the disconnection of all these branches would split one island of the grid
+        bool is_islanding(const std::vector<int> & branch_ids) {return get_connectivity().is_islanding(branch_ids);}
+
+        // node breaker topology (see NodeBreaker): the buses of the elements handled by the topology processor are
+        // computed from the state of the switches of their substation
+        void init_node_breaker(const std::vector<int> & node_to_sub,
+                               const std::vector<std::vector<int> > & sub_buses,
+                               const std::vector<int> & switch_node_1,
+                               const std::vector<int> & switch_node_2,
+                               const std::vector<bool> & switch_closed);
+        // nodes[el_id] is the node of the element (-1 if it is not handled by the topology processor)
+        void set_node_breaker_terminals(TerminalType type, const std::vector<int> & nodes);
+        void set_switch(int switch_id, bool closed) {set_switches({switch_id}, {closed});}
+        void set_switches(const std::vector<int> & switch_ids, const std::vector<bool> & closed);
+        void update_switches(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
+                             Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > new_values);
+        const std::vector<bool> & get_switches() const {return node_breaker_.get_switches();}
+        /**
+        change one attribute of many elements of the same type at once: values[i] is the new value of the element
+        el_ids[i]. The side of a powerline (or a trafo) is only used for its bus, both sides give its status. For the
+        statuses, any non zero value means "connected". Everything is checked before the first modification: nothing
+        is changed if an error is raised.
+        **/
+        void set_values(TerminalType type, ElementAttribute attribute,
+                        const Eigen::Ref<const Eigen::VectorXi> & el_ids,
+                        const Eigen::Ref<const RealVect> & values);
+        // same as above for the elements el_id such that has_changed[el_id] (new value in new_values[el_id])
+        void set_values_mask(TerminalType type, ElementAttribute attribute,
+                             const Eigen::Ref<const Eigen::Array<bool, Eigen::Dynamic, 1> > & has_changed,
+                             const Eigen::Ref<const RealVect> & new_values);
+        // bus of each node (-1 if the node is not part of a bus)
+        Eigen::VectorXi get_node_bus() const;
+
         //load
-        void deactivate_load(int load_id) {loads_.deactivate(load_id, topo_changed_); }
-        void reactivate_load(int load_id) {loads_.reactivate(load_id, topo_changed_); }
-        void change_bus_load(int load_id, int new_bus_id) {loads_.change_bus(load_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
-        void change_p_load(int load_id, real_type new_p) {loads_.change_p(load_id, new_p, topo_changed_); }
-        void change_q_load(int load_id, real_type new_q) {loads_.change_q(load_id, new_q, topo_changed_); }
+        void deactivate_load(int load_id) {journal_status(JournalKey::LoadStatus, load_id, loads_.get_status()); loads_.deactivate(load_id, topo_changed_); }
+        void reactivate_load(int load_id) {journal_status(JournalKey::LoadStatus, load_id, loads_.get_status()); loads_.reactivate(load_id, topo_changed_); }
+        void change_bus_load(int load_id, int new_bus_id) {journal_bus(JournalKey::LoadBus, load_id, loads_.get_bus_id()); loads_.change_bus(load_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); }
+        void change_p_load(int load_id, real_type new_p) {journal_value(JournalKey::LoadP, load_id, loads_.nb(), [&](){return loads_.get_p_mw()(load_id);}); loads_.change_p(load_id, new_p, topo_changed_); }
+        void change_q_load(int load_id, real_type new_q) {journal_value(JournalKey::LoadQ, load_id, loads_.nb(), [&](){return loads_.get_q_mvar()(load_id);}); loads_.change_q(load_id, new_q, topo_changed_); }
         int get_bus_load(int load_id) {return loads_.get_bus(load_id);}
 
         //generator
-        void deactivate_gen(int gen_id) {generators_.deactivate(gen_id, topo_changed_); }
-        void reactivate_gen(int gen_id) {generators_.reactivate(gen_id, topo_changed_); }
-        void change_bus_gen(int gen_id, int new_bus_id) {generators_.change_bus(gen_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
-        void change_p_gen(int gen_id, real_type new_p) {generators_.change_p(gen_id, new_p, topo_changed_); }
-        void change_v_gen(int gen_id, real_type new_v_pu) {generators_.change_v(gen_id, new_v_pu, topo_changed_); }
+        void deactivate_gen(int gen_id) {journal_status(JournalKey::GenStatus, gen_id, generators_.get_status()); generators_.deactivate(gen_id, topo_changed_); }
+        void reactivate_gen(int gen_id) {journal_status(JournalKey::GenStatus, gen_id, generators_.get_status()); generators_.reactivate(gen_id, topo_changed_); }
+        void change_bus_gen(int gen_id, int new_bus_id) {journal_bus(JournalKey::GenBus, gen_id, generators_.get_bus_id()); generators_.change_bus(gen_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); }
+        void change_p_gen(int gen_id, real_type new_p) {journal_value(JournalKey::GenP, gen_id, generators_.nb(), [&](){return generators_.get_p_mw()(gen_id);}); generators_.change_p(gen_id, new_p, topo_changed_); }
+        void change_v_gen(int gen_id, real_type new_v_pu) {journal_value(JournalKey::GenV, gen_id, generators_.nb(), [&](){return generators_.get_vm_pu()(gen_id);}); generators_.change_v(gen_id, new_v_pu, topo_changed_); }
         int get_bus_gen(int gen_id) {return generators_.get_bus(gen_id);}
 
         //shunt
-        void deactivate_shunt(int shunt_id) {shunts_.deactivate(shunt_id, topo_changed_); }
-        void reactivate_shunt(int shunt_id) {shunts_.reactivate(shunt_id, topo_changed_); }
-        void change_bus_shunt(int shunt_id, int new_bus_id) {shunts_.change_bus(shunt_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size()));  }
-        void change_p_shunt(int shunt_id, real_type new_p) {shunts_.change_p(shunt_id, new_p, topo_changed_); }
-        void change_q_shunt(int shunt_id, real_type new_q) {shunts_.change_q(shunt_id, new_q, topo_changed_); }
+        void deactivate_shunt(int shunt_id) {journal_status(JournalKey::ShuntStatus, shunt_id, shunts_.get_status()); shunts_.deactivate(shunt_id, topo_changed_); }
+        void reactivate_shunt(int shunt_id) {journal_status(JournalKey::ShuntStatus, shunt_id, shunts_.get_status()); shunts_.reactivate(shunt_id, topo_changed_); }
+        void change_bus_shunt(int shunt_id, int new_bus_id) {journal_bus(JournalKey::ShuntBus, shunt_id, shunts_.get_bus_id()); shunts_.change_bus(shunt_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size()));  }
+        void change_p_shunt(int shunt_id, real_type new_p) {journal_value(JournalKey::ShuntP, shunt_id, shunts_.nb(), [&](){return shunts_.get_p_mw()(shunt_id);}); shunts_.change_p(shunt_id, new_p, topo_changed_); }
+        void change_q_shunt(int shunt_id, real_type new_q) {journal_value(JournalKey::ShuntQ, shunt_id, shunts_.nb(), [&](){return shunts_.get_q_mvar()(shunt_id);}); shunts_.change_q(shunt_id, new_q, topo_changed_); }
         int get_bus_shunt(int shunt_id) {return shunts_.get_bus(shunt_id);}
 
         //static gen
-        void deactivate_sgen(int sgen_id) {sgens_.deactivate(sgen_id, topo_changed_); }
-        void reactivate_sgen(int sgen_id) {sgens_.reactivate(sgen_id, topo_changed_); }
-        void change_bus_sgen(int sgen_id, int new_bus_id) {sgens_.change_bus(sgen_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
-        void change_p_sgen(int sgen_id, real_type new_p) {sgens_.change_p(sgen_id, new_p, topo_changed_); }
-        void change_q_sgen(int sgen_id, real_type new_q) {sgens_.change_q(sgen_id, new_q, topo_changed_); }
+        void deactivate_sgen(int sgen_id) {journal_status(JournalKey::SGenStatus, sgen_id, sgens_.get_status()); sgens_.deactivate(sgen_id, topo_changed_); }
+        void reactivate_sgen(int sgen_id) {journal_status(JournalKey::SGenStatus, sgen_id, sgens_.get_status()); sgens_.reactivate(sgen_id, topo_changed_); }
+        void change_bus_sgen(int sgen_id, int new_bus_id) {journal_bus(JournalKey::SGenBus, sgen_id, sgens_.get_bus_id()); sgens_.change_bus(sgen_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); }
+        void change_p_sgen(int sgen_id, real_type new_p) {journal_value(JournalKey::SGenP, sgen_id, sgens_.nb(), [&](){return sgens_.get_p_mw()(sgen_id);}); sgens_.change_p(sgen_id, new_p, topo_changed_); }
+        void change_q_sgen(int sgen_id, real_type new_q) {journal_value(JournalKey::SGenQ, sgen_id, sgens_.nb(), [&](){return sgens_.get_q_mvar()(sgen_id);}); sgens_.change_q(sgen_id, new_q, topo_changed_); }
         int get_bus_sgen(int sgen_id) {return sgens_.get_bus(sgen_id);}
 
         //storage units
-        void deactivate_storage(int storage_id) {storages_.deactivate(storage_id, topo_changed_); }
-        void reactivate_storage(int storage_id) {storages_.reactivate(storage_id, topo_changed_); }
-        void change_bus_storage(int storage_id, int new_bus_id) {storages_.change_bus(storage_id, new_bus_id, topo_changed_, static_cast<int>(bus_vn_kv_.size())); }
+        void deactivate_storage(int storage_id) {journal_status(JournalKey::StorageStatus, storage_id, storages_.get_status()); storages_.deactivate(storage_id, topo_changed_); }
+        void reactivate_storage(int storage_id) {journal_status(JournalKey::StorageStatus, storage_id, storages_.get_status()); storages_.reactivate(storage_id, topo_changed_); }
+        void change_bus_storage(int storage_id, int new_bus_id) {journal_bus(JournalKey::StorageBus, storage_id, storages_.get_bus_id()); storages_.change_bus(storage_id, new_bus_id, topo_changed_, static_cast<int>(static_->bus_vn_kv.size())); }
         void change_p_storage(int storage_id, real_type new_p) {
 //            if(new_p == 0.)
 //            {
@@ -285,37 +435,38 @@ class GridModel : public DataGeneric
 //                reactivate_storage(storage_id);  // requirement from grid2op, might be discussed
 //                storages_.change_p(storage_id, new_p, need_reset_);
 //            }
+               journal_value(JournalKey::StorageP, storage_id, storages_.nb(), [&](){return storages_.get_p_mw()(storage_id);});
                storages_.change_p(storage_id, new_p, topo_changed_);
             }
-        void change_q_storage(int storage_id, real_type new_q) {storages_.change_q(storage_id, new_q, topo_changed_); }
+        void change_q_storage(int storage_id, real_type new_q) {journal_value(JournalKey::StorageQ, storage_id, storages_.nb(), [&](){return storages_.get_q_mvar()(storage_id);}); storages_.change_q(storage_id, new_q, topo_changed_); }
         int get_bus_storage(int storage_id) {return storages_.get_bus(storage_id);}
 
         // All results access
-        tuple3d get_loads_res() const {return loads_.get_res();}
+        tuple3d get_loads_res() {ensure_results(ResLoads); return loads_.get_res();}
         const std::vector<bool>& get_loads_status() const { return loads_.get_status();}
-        tuple3d get_shunts_res() const {return shunts_.get_res();}
+        tuple3d get_shunts_res() {ensure_results(ResShunts); return shunts_.get_res();}
         const std::vector<bool>& get_shunts_status() const { return shunts_.get_status();}
-        tuple3d get_gen_res() const {return generators_.get_res();}
+        tuple3d get_gen_res() {ensure_results(ResGens); return generators_.get_res();}
         const std::vector<bool>& get_gen_status() const { return generators_.get_status();}
-        tuple4d get_lineor_res() const {return powerlines_.get_lineor_res();}
-        tuple4d get_lineex_res() const {return powerlines_.get_lineex_res();}
+        tuple4d get_lineor_res() {ensure_results(ResLines); return powerlines_.get_lineor_res();}
+        tuple4d get_lineex_res() {ensure_results(ResLines); return powerlines_.get_lineex_res();}
         const std::vector<bool>& get_lines_status() const { return powerlines_.get_status();}
-        tuple4d get_trafohv_res() const {return trafos_.get_res_hv();}
-        tuple4d get_trafolv_res() const {return trafos_.get_res_lv();}
+        tuple4d get_trafohv_res() {ensure_results(ResTrafos); return trafos_.get_res_hv();}
+        tuple4d get_trafolv_res() {ensure_results(ResTrafos); return trafos_.get_res_lv();}
         const std::vector<bool>& get_trafo_status() const { return trafos_.get_status();}
-        tuple3d get_storages_res() const {return storages_.get_res();}
+        tuple3d get_storages_res() {ensure_results(ResStorages); return storages_.get_res();}
         const std::vector<bool>& get_storages_status() const { return storages_.get_status();}
-        tuple3d get_sgens_res() const {return sgens_.get_res();}
+        tuple3d get_sgens_res() {ensure_results(ResSGens); return sgens_.get_res();}
         const std::vector<bool>& get_sgens_status() const { return sgens_.get_status();}
 
-        Eigen::Ref<const RealVect> get_gen_theta() const  {return generators_.get_theta();}
-        Eigen::Ref<const RealVect> get_load_theta() const  {return loads_.get_theta();}
-        Eigen::Ref<const RealVect> get_shunt_theta() const  {return shunts_.get_theta();}
-        Eigen::Ref<const RealVect> get_storage_theta() const  {return storages_.get_theta();}
-        Eigen::Ref<const RealVect> get_lineor_theta() const {return powerlines_.get_theta_or();}
-        Eigen::Ref<const RealVect> get_lineex_theta() const {return powerlines_.get_theta_ex();}
-        Eigen::Ref<const RealVect> get_trafohv_theta() const {return trafos_.get_theta_hv();}
-        Eigen::Ref<const RealVect> get_trafolv_theta() const {return trafos_.get_theta_lv();}
+        Eigen::Ref<const RealVect> get_gen_theta() {ensure_results(ResGens); return generators_.get_theta();}
+        Eigen::Ref<const RealVect> get_load_theta() {ensure_results(ResLoads); return loads_.get_theta();}
+        Eigen::Ref<const RealVect> get_shunt_theta() {ensure_results(ResShunts); return shunts_.get_theta();}
+        Eigen::Ref<const RealVect> get_storage_theta() {ensure_results(ResStorages); return storages_.get_theta();}
+        Eigen::Ref<const RealVect> get_lineor_theta() {ensure_results(ResLines); return powerlines_.get_theta_or();}
+        Eigen::Ref<const RealVect> get_lineex_theta() {ensure_results(ResLines); return powerlines_.get_theta_ex();}
+        Eigen::Ref<const RealVect> get_trafohv_theta() {ensure_results(ResTrafos); return trafos_.get_theta_hv();}
+        Eigen::Ref<const RealVect> get_trafolv_theta() {ensure_results(ResTrafos); return trafos_.get_theta_lv();}
 
         // get some internal information, be cerafull the ID of the buses might not be the same
         // TODO convert it back to this ID, that will make copies, but who really cares ?
@@ -342,23 +493,32 @@ class GridModel : public DataGeneric
             return slack_weights_;
         }
 
+        // results of the last ac powerflow (from the solvers of the islands if the grid was split, see get_res_V)
         Eigen::Ref<const CplxVect> get_V() const{
-            return _solver.get_V();
+            return get_res_V(true);
         }
         Eigen::Ref<const RealVect> get_Va() const{
-            return _solver.get_Va();
+            return get_res_Va(true);
         }
         Eigen::Ref<const RealVect> get_Vm() const{
-            return _solver.get_Vm();
+            return get_res_Vm(true);
         }
         Eigen::Ref<const Eigen::SparseMatrix<real_type> > get_J() const{
+            check_no_islands_J("get_J");
             return _solver.get_J();
         }
         Eigen::SparseMatrix<real_type> get_J_python() const{
+            check_no_islands_J("get_J");
             return _solver.get_J_python();  // This is copied to python
         }
-        real_type get_computation_time() const{ return _solver.get_computation_time();}
-        real_type get_dc_computation_time() const{ return _dc_solver.get_computation_time();}
+        real_type get_computation_time() const{
+            return islands_res_ac_.solved ? islands_res_ac_.computation_time : _solver.get_computation_time();
+        }
+        real_type get_dc_computation_time() const{
+            return islands_res_dc_.solved ? islands_res_dc_.computation_time : _dc_solver.get_computation_time();
+        }
+        ErrorType get_error() const {return islands_res_ac_.solved ? islands_res_ac_.error : _solver.get_error();}
+        ErrorType get_dc_error() const {return islands_res_dc_.solved ? islands_res_dc_.error : _dc_solver.get_error();}
 
         // part dedicated to grid2op backend, optimized for grid2op data representation (for speed)
         // this is not recommended to use it outside of its intended usage within grid2op !
@@ -376,69 +536,128 @@ class GridModel : public DataGeneric
                          Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > new_values);
         void update_storages_p(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > has_changed,
                                Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_values);
+        void update_shunts(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > p_changed,
+                           Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_p,
+                           Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > q_changed,
+                           Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > new_q,
+                           Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > bus_changed,
+                           Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > new_bus);
+        // everything a grid2op action can modify, in one call (see the python LightSimBackend.apply_action)
+        void apply_action_packed(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > gen_p_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > gen_p,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > gen_v_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > gen_v,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > load_p_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > load_p,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > load_q_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > load_q,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > storage_p_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > storage_p,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_p_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > shunt_p,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_q_changed,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > shunt_q,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > shunt_bus_changed,
+                                 Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > shunt_bus,
+                                 Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > topo_changed,
+                                 Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > topo_values);
 
         void set_load_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > load_pos_topo_vect)
         {
-            load_pos_topo_vect_.array() = load_pos_topo_vect;
+            static_.mut().load_pos_topo_vect.array() = load_pos_topo_vect;
         }
         void set_gen_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > gen_pos_topo_vect)
         {
-            gen_pos_topo_vect_.array() = gen_pos_topo_vect;
+            static_.mut().gen_pos_topo_vect.array() = gen_pos_topo_vect;
         }
         void set_line_or_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > line_or_pos_topo_vect)
         {
-            line_or_pos_topo_vect_.array() = line_or_pos_topo_vect;
+            static_.mut().line_or_pos_topo_vect.array() = line_or_pos_topo_vect;
         }
         void set_line_ex_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > line_ex_pos_topo_vect)
         {
-            line_ex_pos_topo_vect_.array() = line_ex_pos_topo_vect;
+            static_.mut().line_ex_pos_topo_vect.array() = line_ex_pos_topo_vect;
         }
         void set_trafo_hv_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > trafo_hv_pos_topo_vect)
         {
-            trafo_hv_pos_topo_vect_.array() = trafo_hv_pos_topo_vect;
+            static_.mut().trafo_hv_pos_topo_vect.array() = trafo_hv_pos_topo_vect;
         }
         void set_trafo_lv_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > trafo_lv_pos_topo_vect)
         {
-            trafo_lv_pos_topo_vect_.array() = trafo_lv_pos_topo_vect;
+            static_.mut().trafo_lv_pos_topo_vect.array() = trafo_lv_pos_topo_vect;
         }
         void set_storage_pos_topo_vect(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > storage_pos_topo_vect)
         {
-            storage_pos_topo_vect_.array() = storage_pos_topo_vect;
+            static_.mut().storage_pos_topo_vect.array() = storage_pos_topo_vect;
         }
 
         void set_load_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > load_to_subid)
         {
-            load_to_subid_.array() = load_to_subid;
+            static_.mut().load_to_subid.array() = load_to_subid;
         }
         void set_gen_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > gen_to_subid)
         {
-            gen_to_subid_.array() = gen_to_subid;
+            static_.mut().gen_to_subid.array() = gen_to_subid;
         }
         void set_line_or_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > line_or_to_subid)
         {
-            line_or_to_subid_.array() = line_or_to_subid;
+            static_.mut().line_or_to_subid.array() = line_or_to_subid;
         }
         void set_line_ex_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > line_ex_to_subid)
         {
-            line_ex_to_subid_.array() = line_ex_to_subid;
+            static_.mut().line_ex_to_subid.array() = line_ex_to_subid;
         }
         void set_trafo_hv_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > trafo_hv_to_subid)
         {
-            trafo_hv_to_subid_.array() = trafo_hv_to_subid;
+            static_.mut().trafo_hv_to_subid.array() = trafo_hv_to_subid;
         }
         void set_trafo_lv_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > trafo_lv_to_subid)
         {
-            trafo_lv_to_subid_.array() = trafo_lv_to_subid;
+            static_.mut().trafo_lv_to_subid.array() = trafo_lv_to_subid;
         }
         void set_storage_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > storage_to_subid)
         {
-            storage_to_subid_.array() = storage_to_subid;
+            static_.mut().storage_to_subid.array() = storage_to_subid;
+        }
+        void set_shunt_to_subid(Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > shunt_to_subid)
+        {
+            static_.mut().shunt_to_subid.array() = shunt_to_subid;
         }
         void set_n_sub(int n_sub)
         {
-            n_sub_ = n_sub;
+            static_.mut().n_sub = n_sub;
         }
 
+        // the results of the next powerflows are written (in the grid2op units) in these buffers, owned by the caller
+        // they are not copied with the GridModel, and the caller must keep them alive (see main.cpp)
+        void set_line_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p_or,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q_or,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v_or,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > a_or,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta_or,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p_ex,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q_ex,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v_ex,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > a_ex,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta_ex);
+        void set_load_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                  Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta);
+        void set_gen_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                 Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta);
+        void set_storage_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                     Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > theta);
+        void set_shunt_res_buffers(Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > p,
+                                   Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > q,
+                                   Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > v,
+                                   Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > bus);
+        void clear_res_buffers() {res_buffers_ = ResBuffers();}
+
     protected:
     // add method to change topology, change ratio of transformers, change
 
@@ -474,17 +693,33 @@ class GridModel : public DataGeneric
         // results
         /**process the results from the solver to this instance
         **/
+        /**
+        write the results in the buffers registered with the set_*_res_buffers methods (if any)
+        **/
+        void fill_res_buffers();
+
         void process_results(bool conv, CplxVect & res, const CplxVect & Vinit, bool ac,
                              std::vector<int> & id_me_to_solver);
 
         /**
         Compute the results vector from the Va, Vm post powerflow
         **/
-        void compute_results(bool ac);
+        // compute the results of the given types (combination of ResultType)
+        void compute_results(bool ac, int result_types);
+        // compute the results not computed yet (since the last powerflow) among the given types
+        void ensure_results(int result_types){
+            const int todo = results_pending_ & result_types;
+            if(todo) compute_results(results_ac_, todo);
+        }
+        // the results that are not computed yet cannot be computed anymore (the grid or the solver are modified):
+        // they are reset
+        void drop_pending_results(){
+            if(results_pending_) reset_results(results_pending_);
+        }
         /**
         reset the results in case of divergence of the powerflow.
         **/
-        void reset_results();
+        void reset_results(int result_types = ResAll);
 
         /**
         reset the solver, and all its results
@@ -493,23 +728,26 @@ class GridModel : public DataGeneric
 
         /**
         optimization for grid2op
+
+        the `fun*` arguments are callables (typically lambdas calling the GridModel::change_* methods) and not member
+        function pointers so that the calls can be inlined in the loops.
         **/
         template<class T>
-        void update_continuous_values(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > & has_changed,
-                                      Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > & new_values,
+        void update_continuous_values(const Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > & has_changed,
+                                      const Eigen::Ref<Eigen::Array<float, Eigen::Dynamic, Eigen::RowMajor> > & new_values,
                                       T fun)
         {
             for(int el_id = 0; el_id < has_changed.rows(); ++el_id)
             {
                 if(has_changed(el_id))
                 {
-                    (this->*fun)(el_id, static_cast<real_type>(new_values[el_id]));
+                    fun(el_id, static_cast<real_type>(new_values[el_id]));  // eg change_p_load(load_id, new_p);
                 }
             }
         }
         template<class CReac, class CChange, class CDeact>
-        void update_topo_generic(Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > & has_changed,
-                                 Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > & new_values,
+        void update_topo_generic(const Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, Eigen::RowMajor> > & has_changed,
+                                 const Eigen::Ref<Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> > & new_values,
                                  const Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> & vect_pos,
                                  const Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> & vect_subid,
                                  CReac fun_react,
@@ -523,19 +761,19 @@ class GridModel : public DataGeneric
                 if(new_bus > 0){
                     // new bus is a real bus, so i need to make sure to have it turned on, and then change the bus
                     int init_bus_me = vect_subid(el_id);
-                    int new_bus_backend = new_bus == 1 ? init_bus_me : init_bus_me + n_sub_ ;
+                    int new_bus_backend = new_bus == 1 ? init_bus_me : init_bus_me + static_->n_sub ;
                     bus_status_[new_bus_backend] = true;
                     if(has_changed(el_pos))
                     {
-                        (this->*fun_react)(el_id); // eg reactivate_load(load_id);
-                        (this->*fun_change)(el_id, new_bus_backend); // eg change_bus_load(load_id, new_bus_backend);
+                        fun_react(el_id); // eg reactivate_load(load_id);
+                        fun_change(el_id, new_bus_backend); // eg change_bus_load(load_id, new_bus_backend);
                         topo_changed_ = true;
                     }
                 } else{
                     if(has_changed(el_pos))
                     {
                         // new bus is negative, we deactivate it
-                        (this->*fun_deact)(el_id);// eg deactivate_load(load_id);
+                        fun_deact(el_id);// eg deactivate_load(load_id);
                         // bus_status_ is set to "false" in GridModel.update_topo
                         // and a bus is activated if (and only if) one element is connected to it.
                         // I must not set `bus_status_[new_bus_backend] = false;` in this case !
@@ -548,19 +786,291 @@ class GridModel : public DataGeneric
         CplxVect _get_results_back_to_orig_nodes(const CplxVect & res_tmp,
                                                  std::vector<int> & id_me_to_solver,
                                                  int size);
+
+        /**
+        change journal (see snapshot / restore)
+        **/
+        enum class JournalKey {BusStatus,
+                               LineStatus, LineBusOr, LineBusEx,
+                               TrafoStatus, TrafoBusHv, TrafoBusLv,
+                               GenStatus, GenBus, GenP, GenV,
+                               LoadStatus, LoadBus, LoadP, LoadQ,
+                               SGenStatus, SGenBus, SGenP, SGenQ,
+                               StorageStatus, StorageBus, StorageP, StorageQ,
+                               ShuntStatus, ShuntBus, ShuntP, ShuntQ,
+                               SwitchState,
+                               NbKey};
+        struct JournalEntry
+        {
+            JournalKey key;
+            int el_id;
+            int old_int;  // status or bus id
+            real_type old_real;  // injection
+        };
+        struct Snapshot
+        {
+            int id;
+            std::size_t journal_pos;  // the changes made after the snapshot are in journal_[journal_pos:]
+            // admittance matrices and solvers for the topology of the snapshot, when they are known
+            std::shared_ptr<const GridModel> topo_cache;
+        };
+
+        // whether the value of the element should be recorded (it is recorded only once after the last snapshot)
+        bool need_journal(JournalKey key, int el_id, Eigen::Index nb_el);
+        void add_journal(JournalKey key, int el_id, int old_int, real_type old_real);
+        // these are called before each modification of the grid: the results not computed yet are also dropped here
+        void journal_status(JournalKey key, int el_id, const std::vector<bool> & status){
+            drop_pending_results();
+            if(snapshots_.empty() || !need_journal(key, el_id, status.size())) return;
+            add_journal(key, el_id, status[el_id] ? 1 : 0, 0.);
+        }
+        template<class T>
+        void journal_bus(JournalKey key, int el_id, const T & bus_ids){
+            drop_pending_results();
+            if(snapshots_.empty() || !need_journal(key, el_id, bus_ids.size())) return;
+            add_journal(key, el_id, bus_ids(el_id), 0.);
+        }
+        template<class F>
+        void journal_value(JournalKey key, int el_id, Eigen::Index nb_el, F get_old_value){
+            drop_pending_results();
+            if(snapshots_.empty() || !need_journal(key, el_id, nb_el)) return;
+            add_journal(key, el_id, 0, get_old_value());
+        }
+
+        // whether the change modifies the admittance matrix (the status, the buses and the values of the shunts)
+        static bool is_topo_key(JournalKey key);
+        // current value of a status or a bus recorded in the journal
+        int get_topo_value(const JournalEntry & entry) const;
+        // whether the topology is the same as the one when the journal had the size journal_pos
+        bool same_topology(std::size_t journal_pos) const;
+        void undo(const JournalEntry & entry);
+        template<class TData>
+        void undo_status(TData & data, const JournalEntry & entry){
+            if(entry.old_int) data.reactivate(entry.el_id, topo_changed_);
+            else data.deactivate(entry.el_id, topo_changed_);
+        }
+        template<class TData, class F>
+        void undo_injection(TData & data, const JournalEntry & entry, F change_value){
+            // the value of a disconnected element cannot be changed
+            const bool connected = data.get_status().at(entry.el_id);
+            if(!connected) data.reactivate(entry.el_id, topo_changed_);
+            change_value(entry.el_id, entry.old_real);
+            if(!connected) data.deactivate(entry.el_id, topo_changed_);
+        }
+        // the topology of the last snapshot is the current one: its admittance matrices and solvers are kept
+        void update_snapshot_cache();
+
+        /**
+        multi island powerflows: when the grid is split, each island with (at least) one slack bus is solved
+        independently (concurrently when there are several of them) and the other islands are de-energized (their
+        voltages are 0.)
+        **/
+        struct Island
+        {
+            std::vector<int> id_solver;  // the buses of the island (ids in the solver of the whole grid, sorted)
+            Eigen::SparseMatrix<cplx_type> Ybus;  // the rows / columns of the island in the admittance matrix
+            CplxVect Sbus;
+            CplxVect V;
+            Eigen::VectorXi slack_ids;
+            RealVect slack_weights;
+            Eigen::VectorXi pv;
+            Eigen::VectorXi pq;
+            std::unique_ptr<ChooseSolver> solver;  // created the first time the island has a slack bus
+            bool conv;
+
+            // Kron reduction (see set_kron_reduction): the vectors above are then the ones of the reduced system
+            std::vector<int> kron_candidates;  // zero injection PQ buses (ids in the island) at the last powerflow
+            std::vector<int> kron_elim;  // buses eliminated (empty if the reduction is not used)
+            std::vector<int> kron_id;  // for each bus of the island, its id in the reduced system (-1 if eliminated)
+            Eigen::SparseMatrix<cplx_type> kron_Ybus;  // Ykk - Yke * Yee^-1 * Yek
+            Eigen::SparseMatrix<cplx_type> kron_back;  // - Yee^-1 * Yek (to recover the voltages of the eliminated buses)
+        };
+        // the islands of the grid, for the ac or for the dc admittance matrix (they are kept separately so that a dc
+        // powerflow, eg to initialize the ac one, does not invalidate the solvers and the Kron reduction of the ac islands)
+        struct Islands
+        {
+            Islands():ok(false){}
+
+            std::vector<Island> islands;  // empty if the grid is solved at once
+            std::vector<int> island_of_bus;  // for each bus (solver id), the island it belongs to
+            std::vector<int> local_id;  // for each bus (solver id), its id in the island
+            bool ok;  // up to date with the topology
+        };
+        Islands & get_islands(bool ac) {return ac ? islands_ac_ : islands_dc_;}
+        const Islands & get_islands(bool ac) const {return ac ? islands_ac_ : islands_dc_;}
+        // split the admittance matrix per island (the islands are left empty if the grid has only one island)
+        void init_islands(const Eigen::SparseMatrix<cplx_type> & Ybus, const std::vector<int> & id_me_to_solver, bool is_ac);
+        // solve the powerflow island by island (Sbus_, bus_pv_, bus_pq_ and slack_weights_ are the ones of the whole grid)
+        bool solve_islands(bool is_ac, const CplxVect & V, const Eigen::VectorXi & slack_bus_id_solver,
+                           int max_iter, real_type tol);
+        // eliminate the buses "elim" of the island, returns false (and nothing is eliminated) if Yee is singular
+        bool kron_reduce(Island & island, const std::vector<int> & elim) const;
+        // express Sbus, V, slack_weights, slack_ids, pv and pq of the island in the reduced system
+        void kron_reduce_data(Island & island) const;
+        // the flows on the powerlines without impedance, from the kirchhoff current law at each bus
+        void compute_coupler_flows(bool ac);
+        // results of the last powerflow (ac or dc) when it has been solved island by island
+        struct IslandsRes
+        {
+            IslandsRes():solved(false), computation_time(0.), error(ErrorType::NoError){}
+
+            bool solved;  // false if the whole grid has been solved at once (the results are the ones of the solver)
+            CplxVect V;  // solver bus ids, 0. for the de-energized islands
+            RealVect Va;
+            RealVect Vm;
+            real_type computation_time;  // sum of the computation times of the solvers of the islands
+            ErrorType error;  // first error of the solvers of the islands
+        };
+        const IslandsRes & get_islands_res(bool ac) const {return ac ? islands_res_ac_ : islands_res_dc_;}
+        // voltages (solver bus ids) of the last powerflow
+        Eigen::Ref<const CplxVect> get_res_V(bool ac) const {
+            if(get_islands_res(ac).solved) return get_islands_res(ac).V;
+            return ac ? _solver.get_V() : _dc_solver.get_V();
+        }
+        Eigen::Ref<const RealVect> get_res_Va(bool ac) const {
+            if(get_islands_res(ac).solved) return get_islands_res(ac).Va;
+            return ac ? _solver.get_Va() : _dc_solver.get_Va();
+        }
+        Eigen::Ref<const RealVect> get_res_Vm(bool ac) const {
+            if(get_islands_res(ac).solved) return get_islands_res(ac).Vm;
+            return ac ? _solver.get_Vm() : _dc_solver.get_Vm();
+        }
+        // the jacobian of the ac solver is not the one of the whole grid if it has been solved island by island
+        void check_no_islands_J(const char * fun_name) const {
+            if(!islands_res_ac_.solved) return;
+            std::ostringstream exc_;
+            exc_ << "GridModel::" << fun_name << ": the last ac powerflow has been solved island by island (or with a Kron ";
+            exc_ << "reduction), there is no jacobian matrix for the whole grid.";
+            throw std::runtime_error(exc_.str());
+        }
+
+        // the connectivity, initialized from the powerlines and trafos the first time it is used
+        Connectivity & get_connectivity();
+        // the connectivity and the table of the branches (once initialized) are kept up to date after each
+        // modification of the status or of the buses of a powerline / trafo
+        template<class TData>
+        void update_branch(const TData & data, int el_id, int branch_id){
+            const bool status = data.get_status()[el_id];
+            const int bus_from = data.get_bus_from()(el_id);
+            const int bus_to = data.get_bus_to()(el_id);
+            if(branches_.is_init()) branches_.set_branch(branch_id, status, bus_from, bus_to, static_->bus_vn_kv);
+            if(!connectivity_.is_init()) return;
+            if(status) connectivity_.set_branch(branch_id, bus_from, bus_to);
+            else connectivity_.set_branch(branch_id, Connectivity::_deactivated_bus_id, Connectivity::_deactivated_bus_id);
+        }
+
+        // whether the elements of this type are connected
+        const std::vector<bool> & get_status(TerminalType type) const;
+        // check the arguments of set_values
+        void check_values(TerminalType type, ElementAttribute attribute,
+                          const Eigen::Ref<const Eigen::VectorXi> & el_ids,
+                          const Eigen::Ref<const RealVect> & values) const;
+
+        // the `fun` argument is a callable (typically a lambda calling a GridModel::change_* method)
+        template<class F>
+        void apply_values(const Eigen::Ref<const Eigen::VectorXi> & el_ids,
+                          const Eigen::Ref<const RealVect> & values,
+                          F fun)
+        {
+            for(Eigen::Index i = 0; i < el_ids.size(); ++i) fun(el_ids(i), values(i));  // eg change_p_load(load_id, new_p);
+        }
+
+        // check that the node breaker topology can be used
+        void check_node_breaker(const char * fun_name) const;
+        // number of connected elements not handled by the topology processor on each bus (the nodes of the elements of
+        // type `type` are `nodes` if it is given, the ones of the processor otherwise)
+        std::vector<int> bus_nb_unregistered(TerminalType type = TerminalType::Load,
+                                             const std::vector<int> * nodes = nullptr) const;
+        // set the buses (and the status) of the elements of the substation from the node breaker topology
+        void apply_node_breaker(int sub_id);
+        template<class TData, class TBus, class FDeact, class FReact, class FChange>
+        void apply_terminal(const TData & data, const TBus & bus_ids, int el_id, int new_bus, bool connected,
+                            FDeact fun_deact, FReact fun_react, FChange fun_change){
+            // the bus of a disconnected element is not changed
+            if(new_bus != -1 && bus_ids(el_id) != new_bus) fun_change(el_id, new_bus);
+            if(connected != data.get_status()[el_id]){
+                if(connected) fun_react(el_id);
+                else fun_deact(el_id);
+            }
+        }
+
+        // copy the admittance matrices, the conversion of the bus ids and the state of the solvers of other
+        void copy_solver_state(const GridModel & other);
+
     protected:
         // member of the grid
         // static const int _deactivated_bus_id;
         bool need_reset_;
         bool topo_changed_;
         bool compute_results_;
+        int result_mask_;  // results computed right after the powerflows
+        int results_pending_;  // results of the last powerflow not computed yet
+        bool results_ac_;  // whether the last powerflow was an AC one
         real_type init_vm_pu_;  // default vm initialization, mainly for dc powerflow
         real_type sn_mva_;
 
         // powersystem representation
         // 1. bus
-        RealVect bus_vn_kv_;
+        // bus_vn_kv and the grid2op specific data do not change after the grid is loaded: they are shared between
+        // the copies of this model (cloned only when modified, see CowPtr)
+        class StaticData
+        {
+            public:
+                RealVect bus_vn_kv;
+
+                // specific grid2op
+                int n_sub;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> load_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> gen_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_or_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_ex_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_hv_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_lv_pos_topo_vect;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> storage_pos_topo_vect;
+
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> load_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> gen_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_or_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_ex_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_hv_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_lv_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> storage_to_subid;
+                Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> shunt_to_subid;
+        };
+        CowPtr<StaticData> static_;
+
+        // view on a buffer owned by the caller of the set_*_res_buffers methods
+        template<class T>
+        class ResBuffer
+        {
+            public:
+                ResBuffer(): data_(nullptr), size_(0) {}
+                ResBuffer(Eigen::Ref<Eigen::Array<T, Eigen::Dynamic, Eigen::RowMajor> > buffer):
+                    data_(buffer.data()), size_(static_cast<int>(buffer.size())) {}
+
+                bool is_set() const {return data_ != nullptr;}
+                int size() const {return size_;}
+                T & operator()(int el_id) const {return data_[el_id];}
+
+            protected:
+                T * data_;
+                int size_;
+        };
+        class ResBuffers
+        {
+            public:
+                // powerlines then transformers, as in grid2op
+                ResBuffer<float> p_or, q_or, v_or, a_or, theta_or, p_ex, q_ex, v_ex, a_ex, theta_ex;
+                ResBuffer<float> load_p, load_q, load_v, load_theta;
+                ResBuffer<float> gen_p, gen_q, gen_v, gen_theta;
+                ResBuffer<float> storage_p, storage_q, storage_v, storage_theta;
+                ResBuffer<float> shunt_p, shunt_q, shunt_v;
+                ResBuffer<int> shunt_bus;
+        };
+        ResBuffers res_buffers_;  // not copied with the GridModel
         std::vector<bool> bus_status_;  // for each bus, gives its status. true if connected, false otherwise
+        Connectivity connectivity_;  // islands of the grid (see get_connectivity)
+        NodeBreaker node_breaker_;  // switches of the substations (see init_node_breaker)
 
         // always have the length of the number of buses,
         // id_me_to_model_[id_me] gives -1 if the bus "id_me" is deactivated, or "id_model" if it is activated.
@@ -616,23 +1126,31 @@ class GridModel : public DataGeneric
         ChooseSolver _solver;
         ChooseSolver _dc_solver;
 
-        // specific grid2op
-        int n_sub_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> load_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> gen_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_or_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_ex_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_hv_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_lv_pos_topo_vect_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> storage_pos_topo_vect_;
-
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> load_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> gen_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_or_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> line_ex_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_hv_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> trafo_lv_to_subid_;
-        Eigen::Array<int, Eigen::Dynamic, Eigen::RowMajor> storage_to_subid_;
+        // the powerlines without impedance, their two buses are the same bus for the solver (see init_Ybus)
+        std::vector<int> zero_impedance_lines_;
+
+        // the powerlines and the trafos, as used for the last admittance matrix computed (see fillYbus)
+        BranchTable branches_;
+
+        // islands of the grid, when it is split (see init_islands and solve_islands)
+        Islands islands_ac_;
+        Islands islands_dc_;
+        bool kron_reduction_;  // the zero injection PQ buses are eliminated before the ac powerflow
+        int kron_nb_eliminated_;  // number of buses eliminated in the last ac powerflow
+        // Ward equivalent (see ward_equivalent): boundary buses and their equivalent injections (loads or generators)
+        std::vector<int> ward_boundary_buses_;
+        std::vector<int> ward_injection_ids_;
+        bool ward_extended_;
+        WardIds ward_ids_;
+        IslandsRes islands_res_ac_;
+        IslandsRes islands_res_dc_;
+
+        // change journal (see snapshot / restore)
+        std::vector<JournalEntry> journal_;
+        // journal_marks_[key][el_id] is the position in journal_ of the last record of this value
+        std::array<std::vector<std::size_t>, static_cast<std::size_t>(JournalKey::NbKey)> journal_marks_;
+        std::vector<Snapshot> snapshots_;
+        int next_snapshot_id_;
 
 };
 
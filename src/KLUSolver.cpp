@@ -8,28 +8,92 @@
 
 #include "KLUSolver.h"
 
+void KLULinearSolver::free_symbolic(klu_symbolic * symbolic){
+    // the klu_common is only used for the memory management functions (the default ones)
+    klu_common common;
+    klu_defaults(&common);
+    klu_free_symbolic(&symbolic, &common);
+}
+
 ErrorType KLULinearSolver::reset(){
-    klu_free_symbolic(&symbolic_, &common_);
     klu_free_numeric(&numeric_, &common_);
     common_ = klu_common();
-    symbolic_ = nullptr;
+    symbolic_.reset();
     numeric_ = nullptr;
+    stats_ = KLUSolverStats();
+    rcond_ref_ = 0.;
     return ErrorType::NoError;
 }
 
+void KLULinearSolver::apply_config(){
+    common_ = klu_common();
+    klu_defaults(&common_);
+    common_.ordering = config_.ordering;
+    common_.btf = config_.btf ? 1 : 0;
+    common_.scale = config_.scale;
+    common_.tol = config_.tol;
+}
+
 ErrorType KLULinearSolver::initialize(Eigen::SparseMatrix<real_type>&  J){
     // default Eigen representation: column major, which is good for klu !
     // J is const here, even if it's not said in klu_analyze
     const auto n = J.cols();
-    common_ = klu_common();
+    apply_config();
     ErrorType res = ErrorType::NoError; 
-    symbolic_ = klu_analyze(n, J.outerIndexPtr(), J.innerIndexPtr(), &common_);
-    if(common_.status != KLU_OK){
+    symbolic_ = std::shared_ptr<klu_symbolic>(klu_analyze(n, J.outerIndexPtr(), J.innerIndexPtr(), &common_), free_symbolic);
+    if((symbolic_ == nullptr) || (common_.status != KLU_OK)){
         res = ErrorType::SolverAnalyze; 
     }else{
-        numeric_ = klu_factor(J.outerIndexPtr(), J.innerIndexPtr(), J.valuePtr(), symbolic_, &common_);
-        if(common_.status != KLU_OK) res = ErrorType::SolverFactor; 
+        res = factor(J);
+    }
+    return res;
+}
+
+bool KLULinearSolver::reuse_factorization(const KLULinearSolver & other){
+    if(other.symbolic_ == nullptr) return false;
+    // the numeric factorization is modified by each klu_refactor: it is not shared
+    reset();
+    config_ = other.config_;
+    apply_config();
+    symbolic_ = other.symbolic_;
+    return true;
+}
+
+ErrorType KLULinearSolver::factor(Eigen::SparseMatrix<real_type>& J){
+    if(numeric_ != nullptr) klu_free_numeric(&numeric_, &common_);
+    numeric_ = klu_factor(J.outerIndexPtr(), J.innerIndexPtr(), J.valuePtr(), symbolic_.get(), &common_);
+    ++stats_.nb_factor;
+    if((numeric_ == nullptr) || (common_.status != KLU_OK)) return ErrorType::SolverFactor;
+
+    // update the statistics
+    stats_.lnz = numeric_->lnz;
+    stats_.unz = numeric_->unz;
+    if(klu_flops(symbolic_.get(), numeric_, &common_) == 1) stats_.flops = common_.flops;
+    if(klu_rcond(symbolic_.get(), numeric_, &common_) == 1) rcond_ref_ = common_.rcond;
+    stats_.rcond = rcond_ref_;
+    return ErrorType::NoError;
+}
+
+ErrorType KLULinearSolver::refactor(Eigen::SparseMatrix<real_type>& J){
+    // first factorization with a symbolic analysis shared by another solver
+    if(numeric_ == nullptr) return factor(J);
+
+    int ok = klu_refactor(J.outerIndexPtr(), J.innerIndexPtr(), J.valuePtr(), symbolic_.get(), numeric_, &common_);
+    ++stats_.nb_refactor;
+    bool need_factor = (ok != 1);
+    if(!need_factor && config_.check_refactor){
+        // the pivots of the last klu_factor might not be suited for this matrix
+        ok = klu_rcond(symbolic_.get(), numeric_, &common_);
+        const real_type rcond = common_.rcond;
+        need_factor = (ok != 1) || !std::isfinite(rcond) || (rcond < config_.rcond_ratio * rcond_ref_);
+        if(!need_factor) stats_.rcond = rcond;
     }
+    if(!need_factor) return ErrorType::NoError;
+
+    // fallback to a full factorization
+    ++stats_.nb_fallback;
+    ErrorType res = factor(J);
+    if(res == ErrorType::SolverFactor) res = ErrorType::SolverReFactor;
     return res;
 }
 
@@ -44,16 +108,15 @@ ErrorType KLULinearSolver::solve(Eigen::SparseMatrix<real_type>& J, RealVect & b
         // if the call to "klu_factor" has been made this iteration, there is no need
         // to re factor again the matrix
         // i'm in the case where it has not
-        ok = klu_refactor(J.outerIndexPtr(), J.innerIndexPtr(), J.valuePtr(), symbolic_, numeric_, &common_);
-        if (ok != 1) {
+        err = refactor(J);
+        if (err != ErrorType::NoError) {
             // std::cout << "\t KLU: refactor error" << std::endl;
-            err = ErrorType::SolverReFactor;
             stop = true;
         }
     }
     if(!stop){
         const auto n = J.cols();
-        ok = klu_solve(symbolic_, numeric_, n, 1, &b(0), &common_);
+        ok = klu_solve(symbolic_.get(), numeric_, n, 1, &b(0), &common_);
         if (ok != 1) {
             // std::cout << "\t KLU: klu_solve error" << std::endl;
             err = ErrorType::SolverSolve;
@@ -61,3 +124,14 @@ ErrorType KLULinearSolver::solve(Eigen::SparseMatrix<real_type>& J, RealVect & b
     }
     return err;
 }
+
+ErrorType KLULinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & /*J*/, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, with the factorization already computed
+    // klu handles multiple right hand sides natively (by blocks of 4 columns)
+    if(numeric_ == nullptr) return ErrorType::NotInitError;
+    const int ldim = static_cast<int>(B.outerStride());
+    const int nrhs = static_cast<int>(B.cols());
+    int ok = klu_solve(symbolic_.get(), numeric_, ldim, nrhs, B.data(), &common_);
+    if (ok != 1) return ErrorType::SolverSolve;
+    return ErrorType::NoError;
+}
@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <vector>
+#include <memory>  // for std::shared_ptr
 #include <stdio.h>
 #include <cstdint> // for int32
 #include <chrono>
@@ -32,9 +33,19 @@ extern "C" {
 
 #include "CustTimer.h"
 #include "BaseNRSolver.h"
+#include "KLUSolverConfig.h"
 /**
 class to handle the solver using newton-raphson method, using KLU algorithm and sparse matrices.
 
+The KLU settings (ordering, btf, scaling, pivoting tolerance) can be changed with a KLUSolverConfig. They are applied
+(after "klu_defaults") at the next call to "initialize".
+
+The symbolic analysis (result of "klu_analyze") is only read by klu once computed: it can be shared between different
+solvers (see "reuse_factorization"), for example between the copies of a GridModel.
+
+When the matrix is factorized again with "klu_refactor" (same pivots as the last "klu_factor") the quality of the
+factorization is checked with "klu_rcond". If it failed, or if rcond degraded too much, a full "klu_factor" is performed instead.
+
 As long as the admittance matrix of the sytem does not change, you can reuse the same solver.
 Reusing the same solver is possible, but "reset" method must be called.
 
@@ -44,25 +55,57 @@ Otherwise, unexpected behaviour might follow, including "segfault".
 class KLULinearSolver
 {
     public:
-        KLULinearSolver():symbolic_(),numeric_(),common_(){}
+        KLULinearSolver():symbolic_(),numeric_(),common_(),config_(),stats_(),rcond_ref_(0.){}
 
         ~KLULinearSolver()
          {
-             klu_free_symbolic(&symbolic_, &common_);
              klu_free_numeric(&numeric_, &common_);
          }
 
         // public api
         ErrorType reset();
+        void set_outer_tol(real_type /*tol*/) {}  // direct solver: the linear system is solved exactly
         ErrorType initialize(Eigen::SparseMatrix<real_type>& J);
         ErrorType solve(Eigen::SparseMatrix<real_type>& J, RealVect & b, bool has_just_been_inialized);
+        // solve J.X = B (in place) for all the columns of B, using the last factorization (J is not factorized again)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = false;  // klu_solve uses a workspace stored in the numeric object
+
+        // share the symbolic analysis (and the settings) of other, the next "solve" performs a "klu_factor" with it
+        // ("klu_analyze" is not called again)
+        bool reuse_factorization(const KLULinearSolver & other);
+
+        // settings, used at the next "initialize" (after a "reset")
+        void set_config(const KLUSolverConfig & config){
+            config.check();
+            config_ = config;
+        }
+        const KLUSolverConfig & get_config() const {return config_;}
+        const KLUSolverStats & get_stats() const {return stats_;}
+
+    protected:
+        // call klu_defaults and then apply the settings of config_
+        void apply_config();
+
+        // full factorization (with pivoting), frees the previous one if any
+        ErrorType factor(Eigen::SparseMatrix<real_type>& J);
+
+        // refactorization (reusing the pivots), falls back to a full factorization if needed
+        ErrorType refactor(Eigen::SparseMatrix<real_type>& J);
+
+        // free the symbolic object once it is not used by any solver anymore
+        static void free_symbolic(klu_symbolic * symbolic);
 
     private:
         // solver initialization
-        klu_symbolic* symbolic_;
+        std::shared_ptr<klu_symbolic> symbolic_;  // possibly shared with other solvers, see "reuse_factorization"
         klu_numeric* numeric_;
         klu_common common_;
 
+        KLUSolverConfig config_;
+        KLUSolverStats stats_;
+        real_type rcond_ref_;  // rcond after the last "klu_factor"
+
         // no copy allowed
         KLULinearSolver( const KLULinearSolver & ) = delete ;
         KLULinearSolver & operator=( const KLULinearSolver & ) = delete ;
@@ -0,0 +1,97 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef KLUSOLVERCONFIG_H
+#define KLUSOLVERCONFIG_H
+
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+#include "Utils.h"
+
+/**
+Settings of the KLU linear solver.
+
+This class does not depend on KLU itself (so that it can be used, and exposed to python, even if KLU
+is not available).
+
+The first settings are given "as is" to the "klu_common" structure (after a call to "klu_defaults"), see the
+KLU user guide for more information. The last ones control the check of the quality of the "klu_refactor":
+klu_refactor reuses the pivots of the last "klu_factor", which can become inaccurate if the matrix changed a lot.
+**/
+class KLUSolverConfig
+{
+    public:
+        KLUSolverConfig():
+            ordering(0),
+            btf(true),
+            scale(2),
+            tol(0.001),
+            check_refactor(true),
+            rcond_ratio(1e-3)
+            {}
+
+        // throws if one of the settings is not valid
+        void check() const {
+            if((ordering != 0) && (ordering != 1)){
+                std::ostringstream exc_;
+                exc_ << "KLUSolverConfig: ordering should be 0 (AMD) or 1 (COLAMD). You provided: " << ordering;
+                throw std::runtime_error(exc_.str());
+            }
+            if((scale < -1) || (scale > 2)){
+                std::ostringstream exc_;
+                exc_ << "KLUSolverConfig: scale should be -1 (none, no check), 0 (none), 1 (sum) or 2 (max). You provided: " << scale;
+                throw std::runtime_error(exc_.str());
+            }
+            if(!std::isfinite(tol) || (tol <= 0.) || (tol > 1.)){
+                std::ostringstream exc_;
+                exc_ << "KLUSolverConfig: tol should be in ]0, 1]. You provided: " << tol;
+                throw std::runtime_error(exc_.str());
+            }
+            if(!std::isfinite(rcond_ratio) || (rcond_ratio < 0.) || (rcond_ratio > 1.)){
+                std::ostringstream exc_;
+                exc_ << "KLUSolverConfig: rcond_ratio should be in [0, 1]. You provided: " << rcond_ratio;
+                throw std::runtime_error(exc_.str());
+            }
+        }
+
+        int ordering;  // fill reducing ordering: 0 AMD (default), 1 COLAMD
+        bool btf;  // use the block triangular form (default true)
+        int scale;  // row scaling: -1 none (and no check of the matrix), 0 none, 1 sum, 2 max (default)
+        real_type tol;  // partial pivoting tolerance (default 0.001)
+        bool check_refactor;  // check the quality of each "klu_refactor" (default true)
+        real_type rcond_ratio;  // a full "klu_factor" is performed if rcond after "klu_refactor" < rcond_ratio * rcond after the last "klu_factor"
+};
+
+/**
+Some statistics about the KLU linear solver (since its last reset).
+**/
+class KLUSolverStats
+{
+    public:
+        KLUSolverStats():
+            lnz(0.),
+            unz(0.),
+            flops(0.),
+            rcond(0.),
+            nb_factor(0),
+            nb_refactor(0),
+            nb_fallback(0)
+            {}
+
+        real_type lnz;  // number of non zeros in L (including the diagonal), for the last factorization
+        real_type unz;  // number of non zeros in U (including the diagonal), for the last factorization
+        real_type flops;  // number of flops of the last "klu_factor"
+        real_type rcond;  // cheap estimate of the reciprocal of the condition number, for the last factorization
+        int nb_factor;  // number of calls to "klu_factor" (including the fallbacks)
+        int nb_refactor;  // number of calls to "klu_refactor"
+        int nb_fallback;  // number of "klu_refactor" that were replaced by a "klu_factor" (failure or rcond degradation)
+};
+
+#endif // KLUSOLVERCONFIG_H
@@ -0,0 +1,92 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "LDLTSolver.h"
+
+bool LDLTLinearSolver::is_symmetric(const Eigen::SparseMatrix<real_type> & J){
+    if(J.rows() != J.cols()) return false;
+    const Eigen::SparseMatrix<real_type> J_t = J.transpose();
+    const real_type tol = 1e-12 * J.cwiseAbs().sum() / std::max(static_cast<real_type>(J.nonZeros()), static_cast<real_type>(1.));
+    const Eigen::SparseMatrix<real_type> diff = J - J_t;
+    for (Eigen::Index col_id = 0; col_id < diff.outerSize(); ++col_id){
+        for (Eigen::SparseMatrix<real_type>::InnerIterator it(diff, col_id); it; ++it){
+            if(std::abs(it.value()) > tol) return false;
+        }
+    }
+    return true;
+}
+
+ErrorType LDLTLinearSolver::initialize(const Eigen::SparseMatrix<real_type> & J){
+    use_ldlt_ = is_symmetric(J);
+    if(!use_ldlt_) return initialize_lu(J);
+
+    ldlt_.analyzePattern(J);
+    ldlt_.factorize(J);
+    if(ldlt_.info() != Eigen::Success){
+        // the LDLT decomposition failed (zero pivot), i try with the more robust LU
+        use_ldlt_ = false;
+        return initialize_lu(J);
+    }
+    return ErrorType::NoError;
+}
+
+ErrorType LDLTLinearSolver::initialize_lu(const Eigen::SparseMatrix<real_type> & J){
+    ErrorType res = ErrorType::NoError;
+    lu_.analyzePattern(J);
+    // do not check here for "lu_.info" it is not set to "Success"
+    lu_.factorize(J);
+    if(lu_.info() != Eigen::Success) res = ErrorType::SolverFactor;
+    return res;
+}
+
+ErrorType LDLTLinearSolver::solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized){
+    // solves (for x) the linear system J.x = b
+    // supposes that the solver has been initialized (call initialize() before calling that)
+    ErrorType err = ErrorType::NoError;
+    if(!has_just_been_inialized){
+        // if the call to "initialize" has been made this iteration, there is no need
+        // to re factor again the matrix
+        // i'm in the case where it has not
+        if(use_ldlt_){
+            ldlt_.factorize(J);
+            if(ldlt_.info() != Eigen::Success){
+                use_ldlt_ = false;
+                err = initialize_lu(J);
+            }
+        }else{
+            lu_.factorize(J);
+            if(lu_.info() != Eigen::Success) err = ErrorType::SolverReFactor;
+        }
+        if(err == ErrorType::SolverFactor) err = ErrorType::SolverReFactor;
+        if(err != ErrorType::NoError) return err;
+    }
+    RealVect x;
+    if(use_ldlt_){
+        x = ldlt_.solve(b);
+        if(ldlt_.info() != Eigen::Success) err = ErrorType::SolverSolve;
+    }else{
+        x = lu_.solve(b);
+        if(lu_.info() != Eigen::Success) err = ErrorType::SolverSolve;
+    }
+    b = x;
+    return err;
+}
+
+ErrorType LDLTLinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & /*J*/, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, with the factorization already computed
+    RealMatRhs X;
+    if(use_ldlt_){
+        X = ldlt_.solve(B);
+        if(ldlt_.info() != Eigen::Success) return ErrorType::SolverSolve;
+    }else{
+        X = lu_.solve(B);
+        if(lu_.info() != Eigen::Success) return ErrorType::SolverSolve;
+    }
+    B = X;
+    return ErrorType::NoError;
+}
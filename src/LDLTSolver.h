@@ -0,0 +1,85 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef LDLTSOLVER_H
+#define LDLTSOLVER_H
+
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <cstdint> // for int32
+#include <chrono>
+#include <cmath>  // for PI
+
+// eigen is necessary to easily pass data from numpy to c++ without any copy.
+// and to optimize the matrix operations
+#include "Utils.h"
+#include "Eigen/Core"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "Eigen/SparseLU"
+#include "Eigen/SparseCholesky"
+#include "Eigen/OrderingMethods"
+
+#include "CustTimer.h"
+#include "BaseNRSolver.h"
+/**
+class to handle the solver of symmetric linear systems (typically the DC admittance matrix), using the sparse LDL^T
+decomposition ("SimplicialLDLT" with an AMD ordering) of Eigen.
+
+Only the lower triangular part of the matrix is used, and L is (roughly) half the size of the L and U factors of
+a LU decomposition, making it faster to compute and lighter in memory.
+
+The symmetry of the matrix is checked in "initialize". If the matrix is not symmetric (*eg* in some grid models
+with phase shifters) or if the LDL^T decomposition fails, it falls back to the SparseLU decomposition of Eigen.
+
+As long as the admittance matrix of the sytem does not change, you can reuse the same solver.
+Reusing the same solver is possible, but "reset" method must be called.
+**/
+class LDLTLinearSolver
+{
+    public:
+        typedef Eigen::SimplicialLDLT<Eigen::SparseMatrix<real_type>, Eigen::Lower, Eigen::AMDOrdering<int> > LDLTType;
+        typedef Eigen::SparseLU<Eigen::SparseMatrix<real_type>, Eigen::COLAMDOrdering<int> > LUType;
+
+        LDLTLinearSolver():ldlt_(), lu_(), use_ldlt_(true){}
+
+        // public api
+        ErrorType initialize(const Eigen::SparseMatrix<real_type> & J);
+        ErrorType solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized);
+        ErrorType reset(){
+            use_ldlt_ = true;
+            return ErrorType::NoError;
+        }
+        void set_outer_tol(real_type /*tol*/) {}  // direct solver: the linear system is solved exactly
+        // the Eigen decompositions cannot be copied: the matrix will be analyzed and factorized again by "initialize"
+        bool reuse_factorization(const LDLTLinearSolver & /*other*/){ return false; }
+        // solve J.X = B (in place) for all the columns of B, using the last factorization (J is not factorized again)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = true;  // the factorization is only read in "solve_many"
+
+        // whether the LDL^T decomposition is used (true) or the matrix was not symmetric and SparseLU is used (false)
+        bool use_ldlt() const {return use_ldlt_;}
+
+        // check (up to some relative tolerance) that the matrix is symmetric
+        static bool is_symmetric(const Eigen::SparseMatrix<real_type> & J);
+
+    protected:
+        ErrorType initialize_lu(const Eigen::SparseMatrix<real_type> & J);
+
+    private:
+        LDLTType ldlt_;
+        LUType lu_;  // fallback, if the matrix is not symmetric
+        bool use_ldlt_;
+
+        // no copy allowed
+        LDLTLinearSolver( const LDLTLinearSolver & ) =delete ;
+        LDLTLinearSolver & operator=( const LDLTLinearSolver & ) =delete ;
+};
+
+#endif // LDLTSOLVER_H
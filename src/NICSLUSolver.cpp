@@ -109,3 +109,16 @@ ErrorType NICSLULinearSolver::solve(Eigen::SparseMatrix<real_type> & J, RealVect
     }
     return err;
 }
+
+ErrorType NICSLULinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, with the factorization already computed
+    // NICSLU solves one right hand side at a time
+    int ret;
+    RealVect x(J.cols());
+    for(Eigen::Index col_id = 0; col_id < B.cols(); ++col_id){
+        ret = solver_.Solve(B.col(col_id).data(), &x(0));
+        if (ret < 0) return ErrorType::SolverSolve;
+        B.col(col_id) = x;
+    }
+    return ErrorType::NoError;
+}
@@ -62,8 +62,14 @@ class NICSLULinearSolver
 
         // public api
         ErrorType reset();
+        void set_outer_tol(real_type /*tol*/) {}  // direct solver: the linear system is solved exactly
+        // NICSLU does not provide a way to copy a factorization: the matrix will be analyzed and factorized again by "initialize"
+        bool reuse_factorization(const NICSLULinearSolver & /*other*/){ return false; }
         ErrorType initialize(Eigen::SparseMatrix<real_type> & J);
         ErrorType solve(Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized);
+        // solve J.X = B (in place) for all the columns of B, using the last factorization (J is not factorized again)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = false;  // not documented as thread safe by NICSLU
 
         // prevent copy and assignment
         NICSLULinearSolver(const NICSLULinearSolver & other) = delete;
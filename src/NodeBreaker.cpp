@@ -0,0 +1,316 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#include "NodeBreaker.h"
+
+#include <algorithm>
+
+namespace {
+    const std::size_t nb_terminal_type = static_cast<std::size_t>(TerminalType::TrafoLv) + 1;
+}
+
+void NodeBreaker::init(const std::vector<int> & node_to_sub,
+                       const std::vector<std::vector<int> > & sub_buses,
+                       const std::vector<int> & switch_node_1,
+                       const std::vector<int> & switch_node_2,
+                       const std::vector<bool> & switch_closed)
+{
+    if((switch_node_1.size() != switch_node_2.size()) || (switch_node_1.size() != switch_closed.size())){
+        std::ostringstream exc_;
+        exc_ << "NodeBreaker::init: there are " << switch_node_1.size() << " first nodes, ";
+        exc_ << switch_node_2.size() << " second nodes and " << switch_closed.size() << " states for the switches.";
+        throw std::runtime_error(exc_.str());
+    }
+    const int nb_sub = static_cast<int>(sub_buses.size());
+    for(std::size_t node_id = 0; node_id < node_to_sub.size(); ++node_id){
+        const int sub_id = node_to_sub[node_id];
+        if(sub_id < 0 || sub_id >= nb_sub){
+            std::ostringstream exc_;
+            exc_ << "NodeBreaker::init: node " << node_id << " is in substation " << sub_id << " that does not exist ";
+            exc_ << "(there are " << nb_sub << " substations).";
+            throw std::runtime_error(exc_.str());
+        }
+    }
+
+    for(std::size_t switch_id = 0; switch_id < switch_node_1.size(); ++switch_id){
+        const int node_1_id = switch_node_1[switch_id];
+        const int node_2_id = switch_node_2[switch_id];
+        const int nb_node = static_cast<int>(node_to_sub.size());
+        if(node_1_id < 0 || node_1_id >= nb_node || node_2_id < 0 || node_2_id >= nb_node){
+            std::ostringstream exc_;
+            exc_ << "NodeBreaker::init: switch " << switch_id << " links node " << node_1_id << " to node ";
+            exc_ << node_2_id << " but there are " << nb_node << " nodes.";
+            throw std::runtime_error(exc_.str());
+        }
+        if(node_to_sub[node_1_id] != node_to_sub[node_2_id]){
+            std::ostringstream exc_;
+            exc_ << "NodeBreaker::init: switch " << switch_id << " links node " << node_1_id << " (substation ";
+            exc_ << node_to_sub[node_1_id] << ") to node " << node_2_id << " (substation ";
+            exc_ << node_to_sub[node_2_id] << "): a switch cannot link two substations.";
+            throw std::runtime_error(exc_.str());
+        }
+    }
+
+    clear();
+    node_to_sub_ = node_to_sub;
+    sub_buses_ = sub_buses;
+    switch_node_1_ = switch_node_1;
+    switch_node_2_ = switch_node_2;
+    switch_closed_ = switch_closed;
+    initialized_ = true;
+
+    const std::size_t nb_node = node_to_sub_.size();
+    sub_nodes_ = std::vector<std::vector<int> >(nb_sub);
+    sub_switches_ = std::vector<std::vector<int> >(nb_sub);
+    sub_terminals_ = std::vector<std::vector<Terminal> >(nb_sub);
+    for(std::size_t node_id = 0; node_id < nb_node; ++node_id){
+        sub_nodes_[node_to_sub_[node_id]].push_back(static_cast<int>(node_id));
+    }
+    for(int switch_id = 0; switch_id < nb_switch(); ++switch_id){
+        sub_switches_[node_to_sub_[switch_node_1_[switch_id]]].push_back(switch_id);
+    }
+
+    node_nb_terminal_ = std::vector<int>(nb_node, 0);
+    terminal_nodes_ = std::vector<std::vector<int> >(nb_terminal_type);
+    type_nb_terminal_ = std::vector<int>(nb_terminal_type, 0);
+    parent_ = std::vector<int>(nb_node);
+    node_bus_ = std::vector<int>(nb_node, -1);
+    group_nb_terminal_ = std::vector<int>(nb_node, 0);
+    group_label_ = std::vector<int>(nb_node, -1);
+    update_all();
+}
+
+void NodeBreaker::clear()
+{
+    initialized_ = false;
+    node_to_sub_.clear();
+    sub_buses_.clear();
+    sub_nodes_.clear();
+    sub_switches_.clear();
+    sub_terminals_.clear();
+    switch_node_1_.clear();
+    switch_node_2_.clear();
+    switch_closed_.clear();
+    node_nb_terminal_.clear();
+    terminal_nodes_.clear();
+    type_nb_terminal_.clear();
+    bus_nb_fixed_.clear();
+    parent_.clear();
+    node_bus_.clear();
+    group_nb_terminal_.clear();
+    group_label_.clear();
+}
+
+void NodeBreaker::check_node(const char * fun_name, int node_id) const
+{
+    if(node_id < 0 || node_id >= nb_node()){
+        std::ostringstream exc_;
+        exc_ << "NodeBreaker::" << fun_name << ": node " << node_id << " does not exist (there are ";
+        exc_ << nb_node() << " nodes).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void NodeBreaker::check_switch(const char * fun_name, int switch_id) const
+{
+    if(switch_id < 0 || switch_id >= nb_switch()){
+        std::ostringstream exc_;
+        exc_ << "NodeBreaker::" << fun_name << ": switch " << switch_id << " does not exist (there are ";
+        exc_ << nb_switch() << " switches).";
+        throw std::runtime_error(exc_.str());
+    }
+}
+
+void NodeBreaker::set_terminals(TerminalType type, const std::vector<int> & nodes, const std::vector<int> & bus_nb_fixed)
+{
+    check_init("set_terminals");
+    for(auto node_id : nodes){
+        if(node_id != -1) check_node("set_terminals", node_id);
+    }
+    const std::size_t type_id = static_cast<std::size_t>(type);
+    const std::vector<std::vector<Terminal> > sub_terminals_before = sub_terminals_;
+    const std::vector<int> node_nb_terminal_before = node_nb_terminal_;
+    const std::vector<int> nodes_before = terminal_nodes_[type_id];
+    const std::vector<int> bus_nb_fixed_before = bus_nb_fixed_;
+
+    // the previous elements of this type are removed
+    for(auto & terminals : sub_terminals_){
+        terminals.erase(std::remove_if(terminals.begin(), terminals.end(),
+                                       [type](const Terminal & terminal){return terminal.type == type;}),
+                        terminals.end());
+    }
+    for(auto node_id : nodes_before){
+        if(node_id != -1) --node_nb_terminal_[node_id];
+    }
+
+    auto nb_handled = [](const std::vector<int> & nodes_){
+        return static_cast<int>(std::count_if(nodes_.begin(), nodes_.end(), [](int node_id){return node_id != -1;}));
+    };
+    terminal_nodes_[type_id] = nodes;
+    type_nb_terminal_[type_id] = nb_handled(nodes);
+    bus_nb_fixed_ = bus_nb_fixed;
+    for(std::size_t el_id = 0; el_id < nodes.size(); ++el_id){
+        const int node_id = nodes[el_id];
+        if(node_id == -1) continue;
+        sub_terminals_[node_to_sub_[node_id]].push_back({type, static_cast<int>(el_id), node_id});
+        ++node_nb_terminal_[node_id];
+    }
+    try{
+        update_all();
+    }catch(const std::runtime_error &){
+        sub_terminals_ = sub_terminals_before;
+        node_nb_terminal_ = node_nb_terminal_before;
+        terminal_nodes_[type_id] = nodes_before;
+        type_nb_terminal_[type_id] = nb_handled(nodes_before);
+        bus_nb_fixed_ = bus_nb_fixed_before;
+        update_all();
+        throw;
+    }
+}
+
+int NodeBreaker::get_node(TerminalType type, int el_id) const
+{
+    const std::size_t type_id = static_cast<std::size_t>(type);
+    if(type_id >= terminal_nodes_.size()) return -1;
+    const std::vector<int> & nodes = terminal_nodes_[type_id];
+    if(el_id < 0 || el_id >= static_cast<int>(nodes.size())) return -1;
+    return nodes[el_id];
+}
+
+std::vector<int> NodeBreaker::set_switches(const std::vector<int> & switch_ids, const std::vector<bool> & closed,
+                                           const std::vector<int> & bus_nb_fixed)
+{
+    check_init("set_switches");
+    if(switch_ids.size() != closed.size()){
+        std::ostringstream exc_;
+        exc_ << "NodeBreaker::set_switches: there are " << switch_ids.size() << " switches but ";
+        exc_ << closed.size() << " states.";
+        throw std::runtime_error(exc_.str());
+    }
+    for(auto switch_id : switch_ids) check_switch("set_switches", switch_id);
+
+    const std::vector<bool> closed_before = switch_closed_;
+    const std::vector<int> bus_nb_fixed_before = bus_nb_fixed_;
+    bus_nb_fixed_ = bus_nb_fixed;
+    std::vector<int> modified_subs;
+    bool has_opened = false;
+    for(std::size_t i = 0; i < switch_ids.size(); ++i){
+        const int switch_id = switch_ids[i];
+        if(switch_closed_[switch_id] == closed[i]) continue;
+        switch_closed_[switch_id] = closed[i];
+        has_opened |= !closed[i];
+        modified_subs.push_back(node_to_sub_[switch_node_1_[switch_id]]);
+    }
+    std::sort(modified_subs.begin(), modified_subs.end());
+    modified_subs.erase(std::unique(modified_subs.begin(), modified_subs.end()), modified_subs.end());
+
+    try{
+        // a union-find can merge two groups but not split them
+        if(has_opened){
+            for(auto sub_id : modified_subs) rebuild_sub(sub_id);
+        }else{
+            for(std::size_t i = 0; i < switch_ids.size(); ++i){
+                if(closed[i]) unite(switch_node_1_[switch_ids[i]], switch_node_2_[switch_ids[i]]);
+            }
+        }
+        for(auto sub_id : modified_subs) compute_buses(sub_id);
+    }catch(const std::runtime_error &){
+        switch_closed_ = closed_before;
+        bus_nb_fixed_ = bus_nb_fixed_before;
+        for(auto sub_id : modified_subs){
+            rebuild_sub(sub_id);
+            compute_buses(sub_id);
+        }
+        throw;
+    }
+    return modified_subs;
+}
+
+void NodeBreaker::set_switch_raw(int switch_id, bool closed)
+{
+    check_switch("set_switch_raw", switch_id);
+    switch_closed_[switch_id] = closed;
+}
+
+void NodeBreaker::update_all()
+{
+    check_init("update_all");
+    for(int sub_id = 0; sub_id < nb_sub(); ++sub_id){
+        rebuild_sub(sub_id);
+        compute_buses(sub_id);
+    }
+}
+
+int NodeBreaker::find(int node_id)
+{
+    int root = node_id;
+    while(parent_[root] != root) root = parent_[root];
+    // path compression
+    while(parent_[node_id] != root){
+        const int next = parent_[node_id];
+        parent_[node_id] = root;
+        node_id = next;
+    }
+    return root;
+}
+
+void NodeBreaker::unite(int node_1_id, int node_2_id)
+{
+    const int root_1 = find(node_1_id);
+    const int root_2 = find(node_2_id);
+    if(root_1 == root_2) return;
+    // the root of a group is its smallest node
+    if(root_1 < root_2) parent_[root_2] = root_1;
+    else parent_[root_1] = root_2;
+}
+
+void NodeBreaker::rebuild_sub(int sub_id)
+{
+    for(auto node_id : sub_nodes_[sub_id]) parent_[node_id] = node_id;
+    for(auto switch_id : sub_switches_[sub_id]){
+        if(switch_closed_[switch_id]) unite(switch_node_1_[switch_id], switch_node_2_[switch_id]);
+    }
+}
+
+void NodeBreaker::compute_buses(int sub_id)
+{
+    const std::vector<int> & nodes = sub_nodes_[sub_id];
+    const std::vector<int> & buses = sub_buses_[sub_id];
+    for(auto node_id : nodes) group_nb_terminal_[find(node_id)] += node_nb_terminal_[node_id];
+
+    // the nodes are sorted, so the groups are labelled in the order of their smallest node. The elements not handled
+    // by the processor on the bus a group would be assigned count as elements of this group. A group without any
+    // element handled by the processor (an isolated busbar section for example) is not labelled: it does not use a bus.
+    const int nb_bus = static_cast<int>(buses.size());
+    int nb_group = 0;
+    for(auto node_id : nodes){
+        const int root = find(node_id);
+        if(group_label_[root] != -1) continue;
+        const int nb_terminal = group_nb_terminal_[root];
+        const int nb_fixed = nb_group < nb_bus ? get_nb_fixed(buses[nb_group]) : 0;
+        if(nb_terminal > 0 && nb_terminal + nb_fixed >= 2) group_label_[root] = nb_group++;
+    }
+    const bool too_many_groups = nb_group > nb_bus;
+    if(!too_many_groups){
+        for(auto node_id : nodes){
+            const int label = group_label_[find(node_id)];
+            node_bus_[node_id] = label == -1 ? -1 : buses[label];
+        }
+    }
+    for(auto node_id : nodes){
+        group_nb_terminal_[node_id] = 0;
+        group_label_[node_id] = -1;
+    }
+
+    if(too_many_groups){
+        std::ostringstream exc_;
+        exc_ << "NodeBreaker::compute_buses: substation " << sub_id << " would be split in " << nb_group;
+        exc_ << " buses but it has only " << buses.size() << " buses.";
+        throw std::runtime_error(exc_.str());
+    }
+}
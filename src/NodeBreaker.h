@@ -0,0 +1,153 @@
+// Copyright (c) 2020, RTE (https://www.rte-france.com)
+// See AUTHORS.txt
+// This Source Code Form is subject to the terms of the Mozilla Public License, version 2.0.
+// If a copy of the Mozilla Public License, version 2.0 was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+// SPDX-License-Identifier: MPL-2.0
+// This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
+
+#ifndef NODEBREAKER_H
+#define NODEBREAKER_H
+
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+/**
+The type of the element connected to a node of a substation (the powerlines and the transformers have two ends)
+**/
+enum class TerminalType {Load, Gen, SGen, Storage, Shunt, LineOr, LineEx, TrafoHv, TrafoLv};
+
+/**
+Topology processor of a grid described at the "node breaker" level: each substation is made of nodes (busbar
+sections, element connection points...) linked by switches (breakers, disconnectors, couplers), and each element
+is connected to one node.
+
+The nodes of a substation connected through closed switches form one bus. Such a group of nodes is assigned the
+first bus (among the buses of the substation given in `init`) not used by a group with a smaller node id, and only
+if at least two elements are connected to it: otherwise the elements of the group are disconnected (an isolated
+load or generator has no meaning for the powerflow). The elements not handled by the processor stay on their bus:
+they are part of the group assigned this bus (and a group without any other element is assigned the bus if it has
+such elements). An error is raised if a substation would need more buses than it has.
+
+The groups are maintained with a union-find structure: closing a switch merges two groups in almost constant time.
+Opening a switch rebuilds the groups of its substation only, the other substations are not affected.
+
+The nodes are identified by an integer (from 0 to the number of nodes - 1), as are the switches.
+**/
+class NodeBreaker
+{
+    public:
+        struct Terminal
+        {
+            TerminalType type;
+            int el_id;
+            int node_id;
+        };
+
+        NodeBreaker():initialized_(false) {}
+
+        /**
+        the description of the substations is given entirely (the previous information are discarded):
+        node_to_sub[node_id] is the substation of the node, sub_buses[sub_id] the buses (of the GridModel) the
+        substation can use, and the switch `switch_id` links the nodes switch_node_1[switch_id] and
+        switch_node_2[switch_id] (that must be in the same substation).
+        **/
+        void init(const std::vector<int> & node_to_sub,
+                  const std::vector<std::vector<int> > & sub_buses,
+                  const std::vector<int> & switch_node_1,
+                  const std::vector<int> & switch_node_2,
+                  const std::vector<bool> & switch_closed);
+        bool is_init() const {return initialized_;}
+        void clear();
+
+        /**
+        nodes[el_id] is the node to which the element is connected (-1 if it is not handled by the processor).
+        bus_nb_fixed[bus_id] is the number of elements connected to this bus (of the GridModel) that are not handled by
+        the processor, once this type is set (it can be empty if there are none). Nothing is changed if an error is
+        raised.
+        **/
+        void set_terminals(TerminalType type, const std::vector<int> & nodes, const std::vector<int> & bus_nb_fixed);
+
+        /**
+        change the state of some switches and compute the buses of their substations (bus_nb_fixed: see
+        set_terminals). Nothing is changed if an error is raised. Returns the (sorted) ids of the substations that have
+        been modified.
+        **/
+        std::vector<int> set_switches(const std::vector<int> & switch_ids, const std::vector<bool> & closed,
+                                      const std::vector<int> & bus_nb_fixed);
+        // change the state of a switch without computing the buses (see update_all)
+        void set_switch_raw(int switch_id, bool closed);
+        // compute the buses of all the substations from the state of the switches
+        void update_all();
+
+        bool get_switch(int switch_id) const {check_switch("get_switch", switch_id); return switch_closed_[switch_id];}
+        const std::vector<bool> & get_switches() const {return switch_closed_;}
+        int nb_node() const {return static_cast<int>(node_to_sub_.size());}
+        int nb_switch() const {return static_cast<int>(switch_closed_.size());}
+        int nb_sub() const {return static_cast<int>(sub_buses_.size());}
+
+        // bus (of the GridModel) of each node, -1 if the node is not part of a bus
+        const std::vector<int> & get_node_bus() const {return node_bus_;}
+        const std::vector<int> & get_sub_buses(int sub_id) const {return sub_buses_.at(sub_id);}
+        const std::vector<Terminal> & get_terminals(int sub_id) const {return sub_terminals_.at(sub_id);}
+        // node of an element (-1 if it is not handled by the processor)
+        int get_node(TerminalType type, int el_id) const;
+        // number of elements of this type handled by the processor
+        int nb_terminal(TerminalType type) const {
+            const std::size_t type_id = static_cast<std::size_t>(type);
+            return type_id < type_nb_terminal_.size() ? type_nb_terminal_[type_id] : 0;
+        }
+        // number of elements not handled by the processor connected to a bus (see set_terminals)
+        int get_nb_fixed(int bus_id) const {
+            return bus_id < static_cast<int>(bus_nb_fixed_.size()) ? bus_nb_fixed_[bus_id] : 0;
+        }
+
+    protected:
+        void check_init(const char * fun_name) const{
+            if(!initialized_){
+                std::ostringstream exc_;
+                exc_ << "NodeBreaker::" << fun_name << ": the substations have not been initialized.";
+                throw std::runtime_error(exc_.str());
+            }
+        }
+        void check_node(const char * fun_name, int node_id) const;
+        void check_switch(const char * fun_name, int switch_id) const;
+
+        int find(int node_id);
+        void unite(int node_1_id, int node_2_id);
+        // union-find of the nodes of the substation, from the state of its switches
+        void rebuild_sub(int sub_id);
+        // bus of each node of the substation, in node_bus_
+        void compute_buses(int sub_id);
+
+    protected:
+        bool initialized_;
+
+        // the substations
+        std::vector<int> node_to_sub_;
+        std::vector<std::vector<int> > sub_buses_;
+        std::vector<std::vector<int> > sub_nodes_;
+        std::vector<std::vector<int> > sub_switches_;
+        std::vector<std::vector<Terminal> > sub_terminals_;
+
+        // the switches
+        std::vector<int> switch_node_1_;
+        std::vector<int> switch_node_2_;
+        std::vector<bool> switch_closed_;
+
+        // the elements
+        std::vector<int> node_nb_terminal_;
+        std::vector<std::vector<int> > terminal_nodes_;  // terminal_nodes_[type][el_id] is the node of the element
+        std::vector<int> type_nb_terminal_;  // number of elements of each type handled by the processor
+        std::vector<int> bus_nb_fixed_;  // number of elements not handled by the processor on each bus
+
+        // union-find, and the resulting buses
+        std::vector<int> parent_;
+        std::vector<int> node_bus_;
+        // for each node: number of elements in its group and label of the group (only used in compute_buses)
+        std::vector<int> group_nb_terminal_;
+        std::vector<int> group_label_;
+};
+
+#endif // NODEBREAKER_H
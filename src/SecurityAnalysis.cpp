@@ -7,79 +7,37 @@
 // This file is part of LightSim2grid, LightSim2grid implements a c++ backend targeting the Grid2Op platform.
 
 #include "SecurityAnalysis.h"
-#include <queue>
 #include <math.h>       /* isfinite */
-
-bool SecurityAnalysis::check_invertible(const Eigen::SparseMatrix<cplx_type> & Ybus) const{
-    std::vector<bool> visited(Ybus.cols(), false); 
-    std::queue<Eigen::Index> neighborhood;
-    Eigen::Index col_id = 0;  // start by node 0, why not
-    while (true)
-    {
-        visited[col_id] = true;
-        for (Eigen::SparseMatrix<cplx_type>::InnerIterator it(Ybus, col_id); it; ++it)
-        {
-            // add in the queue all my neighbor (if the coefficient is big enough)
-            if(!visited[it.row()] && abs(it.value()) > 1e-8){
-                neighborhood.push(it.row());
-            }
-        }
-        if(neighborhood.empty()) break;
-        col_id = neighborhood.front();
-        neighborhood.pop();
-    }
-    
-    bool ok = true;
-    for(auto el: visited){
-        if(!el)
-        {
-            // this node has not been visited, there is an error
-            ok=false;
-            break;
-        }
-    }
-    return ok;
-}
+#include <iterator>
 
 void SecurityAnalysis::init_li_coeffs(){
     _li_coeffs.clear();
     _li_coeffs.reserve(_li_defaults.size());
-    const auto & powerlines = _grid_model.get_powerlines_as_data();
-    const auto & trafos = _grid_model.get_trafos_as_data();
+    // the contingencies use the same branch ids as the table (powerlines then trafos)
+    const auto & branches = _grid_model.get_branches();
+    const auto & status = branches.get_status();
+    const auto & bus_from = branches.get_bus_from();
+    const auto & bus_to = branches.get_bus_to();
+    const auto & y_ff = branches.yac_ff();
+    const auto & y_ft = branches.yac_ft();
+    const auto & y_tf = branches.yac_tf();
+    const auto & y_tt = branches.yac_tt();
     const auto & id_me_to_ac_solver = _grid_model.id_me_to_ac_solver();
-    Eigen::Index bus_1_id, bus_2_id;
-    cplx_type y_ff, y_ft, y_tf, y_tt;
     for(const auto & this_cont_id: _li_defaults){
         std::vector<Coeff> this_cont_coeffs;
         this_cont_coeffs.reserve(this_cont_id.size() * 4);  // usually there are 4 coeffs per powerlines
-        for(auto line_id : this_cont_id){
-            if(line_id < n_line_)
-            {
-                // this is a powerline
-                bus_1_id = id_me_to_ac_solver[powerlines.get_bus_from()[line_id]];
-                bus_2_id = id_me_to_ac_solver[powerlines.get_bus_to()[line_id]];
-                y_ff = powerlines.yac_ff()[line_id];
-                y_ft = powerlines.yac_ft()[line_id];
-                y_tf = powerlines.yac_tf()[line_id];
-                y_tt = powerlines.yac_tt()[line_id];
-            }else{
-                // this is a trafo
-                const auto trafo_id = line_id - n_line_;
-                bus_1_id = id_me_to_ac_solver[trafos.get_bus_from()[trafo_id]];
-                bus_2_id = id_me_to_ac_solver[trafos.get_bus_to()[trafo_id]];
-                y_ff = trafos.yac_ff()[trafo_id];
-                y_ft = trafos.yac_ft()[trafo_id];
-                y_tf = trafos.yac_tf()[trafo_id];
-                y_tt = trafos.yac_tt()[trafo_id];
-            }
-
+        for(auto branch_id : this_cont_id){
+            // a disconnected branch is not in Ybus
+            if(!status[branch_id]) continue;
+            const Eigen::Index bus_1_id = id_me_to_ac_solver[bus_from[branch_id]];
+            const Eigen::Index bus_2_id = id_me_to_ac_solver[bus_to[branch_id]];
             if(bus_1_id != DataGeneric::_deactivated_bus_id && bus_2_id != DataGeneric::_deactivated_bus_id)
             {
                 // element is connected
-                this_cont_coeffs.push_back({bus_1_id, bus_1_id, y_ff});
-                this_cont_coeffs.push_back({bus_1_id, bus_2_id, y_ft});
-                this_cont_coeffs.push_back({bus_2_id, bus_1_id, y_tf});
-                this_cont_coeffs.push_back({bus_2_id, bus_2_id, y_tt});
+                this_cont_coeffs.push_back({bus_1_id, bus_1_id, y_ff[branch_id]});
+                this_cont_coeffs.push_back({bus_1_id, bus_2_id, y_ft[branch_id]});
+                this_cont_coeffs.push_back({bus_2_id, bus_1_id, y_tf[branch_id]});
+                this_cont_coeffs.push_back({bus_2_id, bus_2_id, y_tt[branch_id]});
             }
         }
         _li_coeffs.push_back(this_cont_coeffs);
@@ -87,14 +45,63 @@ void SecurityAnalysis::init_li_coeffs(){
 }
 
 
-bool SecurityAnalysis::remove_from_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
+void SecurityAnalysis::remove_from_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
                                         const std::vector<Coeff> & coeffs) const
 {
     for(const auto & coeff_to_remove: coeffs){
         Ybus.coeffRef(coeff_to_remove.row_id, coeff_to_remove.col_id) -= coeff_to_remove.value;
     }
-    return check_invertible(Ybus);
 }
+
+std::vector<bool> SecurityAnalysis::check_invertible()
+{
+    // the bridges of the grid are computed once, so checking a n-1 is a simple lookup
+    std::vector<bool> res;
+    res.reserve(_li_defaults.size());
+    const bool grid_connected = _grid_model.nb_connected_components() == 1;
+    for(const auto & this_cont_id: _li_defaults){
+        const std::vector<int> branch_ids(this_cont_id.begin(), this_cont_id.end());
+        res.push_back(grid_connected && !_grid_model.is_islanding(branch_ids));
+    }
+    return res;
+}
+
+std::vector<bool> SecurityAnalysis::check_zero_impedance()
+{
+    std::vector<bool> res;
+    res.reserve(_li_defaults.size());
+    const auto & branches = _grid_model.get_branches();
+    const auto & status = branches.get_status();
+    for(const auto & this_cont_id: _li_defaults){
+        bool has_coupler = false;
+        for(auto branch_id : this_cont_id) has_coupler = has_coupler || (status[branch_id] && branches.is_zero_impedance(branch_id));
+        res.push_back(has_coupler);
+    }
+    return res;
+}
+
+bool SecurityAnalysis::compute_without_merge(const std::set<int> & this_cont_id,
+                                             const CplxVect & Vinit,
+                                             Eigen::Index cont_id,
+                                             int max_iter,
+                                             real_type tol)
+{
+    // the Ybus (and the buses of the solver) of this contingency are built again from a copy of the grid
+    GridModel grid_cont(_grid_model);
+    grid_cont.deactivate_result_computation();
+    grid_cont.change_solver(_solver.get_type());
+    for(auto branch_id : this_cont_id){
+        if(branch_id < n_line_) grid_cont.deactivate_powerline(branch_id);
+        else grid_cont.deactivate_trafo(branch_id - static_cast<int>(n_line_));
+    }
+    const CplxVect V = grid_cont.ac_pf(Vinit, max_iter, tol);
+    ++_nb_solved;
+    _timer_solver += grid_cont.get_computation_time();
+    const bool conv = V.size() > 0;
+    if(conv) _voltages.row(cont_id) = V.transpose();
+    return conv;
+}
+
 void SecurityAnalysis::readd_to_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
                                      const std::vector<Coeff> & coeffs) const
 {
@@ -103,7 +110,7 @@ void SecurityAnalysis::readd_to_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus,
     }
 }
 
-void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type tol)
+void SecurityAnalysis::run_compute(const CplxVect & Vinit, int max_iter, real_type tol)
 {
     auto timer = CustTimer();
     auto timer_preproc = CustTimer();
@@ -112,6 +119,7 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
     _timer_pre_proc = 0.;
     _timer_total = 0.;
     _timer_solver = 0.;
+    reset_progress();
 
     const Eigen::Index nb_total_bus = _grid_model.total_bus();
     if(Vinit.size() != nb_total_bus){
@@ -124,13 +132,14 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
 
     // initialize properly the coefficients that I will need to remove
     init_li_coeffs();
+    const std::vector<bool> li_invertible = check_invertible();
+    const std::vector<bool> li_zero_impedance = check_zero_impedance();
     Eigen::Index nb_steps = _li_defaults.size();
 
     // read from the grid the usefull information
     const auto & sn_mva = _grid_model.get_sn_mva();
     Eigen::SparseMatrix<cplx_type> Ybus = _grid_model.get_Ybus(); 
     const auto & Sbus = _grid_model.get_Sbus(); 
-    const auto & id_ac_solver_to_me = _grid_model.id_ac_solver_to_me();
     const Eigen::VectorXi & bus_pv = _grid_model.get_pv();
     const Eigen::VectorXi & bus_pq = _grid_model.get_pq();
     const Eigen::VectorXi & slack_ids = _grid_model.get_slack_ids();
@@ -153,12 +162,17 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
 
     // now perform the security analysis
     Eigen::Index cont_id = 0;
+    auto it_cont = _li_defaults.begin();
     bool conv;
     CplxVect V;
     // int contingency = 0;
     for(const auto & coeffs_modif: _li_coeffs){
+        // the computation has been stopped by the user (see `cancel()`)
+        if(is_cancelled()) break;
+
         auto timer_modif_Ybus = CustTimer();
-        bool invertible = remove_from_Ybus(Ybus, coeffs_modif);
+        remove_from_Ybus(Ybus, coeffs_modif);
+        const bool invertible = li_invertible[cont_id];
         _timer_modif_Ybus += timer_modif_Ybus.duration();
         conv = false;
 
@@ -167,7 +181,13 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
         // 5.2ms without it vs 81.9ms with it (for the iee 118)
         // So better make the computation, even if it's not used...
 
-        if(invertible)
+        if(invertible && li_zero_impedance[cont_id])
+        {
+            // the two buses of a powerline without impedance are the same bus of the solver (see GridModel::init_Ybus)
+            // so its disconnection cannot be emulated by a modification of Ybus
+            conv = compute_without_merge(*it_cont, Vinit, cont_id, max_iter, tol);
+        }
+        else if(invertible)
         {
             V = Vinit_solver; // Vinit is reused for each contingencies
             conv = compute_one_powerflow(Ybus, V, Sbus,
@@ -176,6 +196,7 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
                                         max_iter,
                                         tol / sn_mva);
         }
+        update_progress(conv && invertible);
         // std::string conv_str =  conv ? "has converged" : "has diverged";
         // std::cout << "contingency " << contingency << ": " << conv_str << std::endl;
         // if(!conv) std::cout << "\t error was: " << _solver.get_error() << std::endl;
@@ -184,8 +205,9 @@ void SecurityAnalysis::compute(const CplxVect & Vinit, int max_iter, real_type t
         timer_modif_Ybus = CustTimer();
         readd_to_Ybus(Ybus, coeffs_modif);
         _timer_modif_Ybus += timer_modif_Ybus.duration();
-        if (conv && invertible) _voltages.row(cont_id)(id_ac_solver_to_me) = V.array();
+        if (conv && invertible && !li_zero_impedance[cont_id]) set_voltages_from_Vsolver(cont_id, V, id_me_to_ac_solver);
         ++cont_id;
+        ++it_cont;
     }
     _timer_total = timer.duration();
 }
@@ -194,10 +216,12 @@ void SecurityAnalysis::clean_flows(bool is_amps)
 {
     auto timer = CustTimer();
     Eigen::Index cont_id = 0;
+    const auto & branches = _grid_model.get_branches();
     for(const auto & l_id_this_cont: _li_defaults){
         for(auto l_id : l_id_this_cont){
             real_type & el = is_amps ? _amps_flows(cont_id, l_id): _active_power_flows(cont_id, l_id);
-            if(isfinite(el)) el = 0.;
+            // the flows of the powerlines without impedance are always NaN (see compute_flows_from_Vs)
+            if(isfinite(el) || branches.is_zero_impedance(l_id)) el = 0.;
         }
         ++cont_id;
     }
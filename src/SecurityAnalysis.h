@@ -34,19 +34,24 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         _timer_pre_proc(0.)
         { }
 
+        ~SecurityAnalysis() {stop_job();}  // the job uses this object, it needs to be stopped before anything is destroyed
+
         // utilities to add defaults to simulate
         void add_all_n1(){
+            check_no_job("add_all_n1");
             for(int l_id = 0; l_id < n_total_; ++l_id){
                 std::set<int> this_default = {l_id};
                 _li_defaults.insert(this_default);
             }
         }
         void add_n1(int line_id){
+            check_no_job("add_n1");
             check_ok_el(line_id);
             std::set<int> this_default = {line_id};
             _li_defaults.insert(this_default);
         }
         void add_multiple_n1(const std::vector<int> & vect_n1s){
+            check_no_job("add_multiple_n1");
             for(const auto line_id : vect_n1s){
                 check_ok_el(line_id);
                 std::set<int> this_default = {line_id};
@@ -54,6 +59,7 @@ class SecurityAnalysis: public BaseMultiplePowerflow
             }
         }
         void add_nk(const std::vector<int> & vect_nk){
+            check_no_job("add_nk");
             std::set<int> this_default;
             for(const auto line_id : vect_nk)
             {
@@ -64,14 +70,16 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         }
 
         // utilities to remove defaults to simulate (TODO)
-        void clear(){_li_defaults.clear();}
+        void clear(){check_no_job("clear"); _li_defaults.clear();}
         bool remove_n1(int line_id){
+            check_no_job("remove_n1");
             check_ok_el(line_id);
             std::set<int> this_default = {line_id};
             auto nb_removed = _li_defaults.erase(this_default);
             return nb_removed >= 1;
         }
         size_t remove_multiple_n1(const std::vector<int> & vect_n1s){
+            check_no_job("remove_multiple_n1");
             size_t nb_removed = 0;
             for(const auto line_id : vect_n1s){
                 check_ok_el(line_id);
@@ -81,6 +89,7 @@ class SecurityAnalysis: public BaseMultiplePowerflow
             return nb_removed;
         }
         bool remove_nk(const std::vector<int> & vect_nk){
+            check_no_job("remove_nk");
             std::set<int> this_default;
             for(const auto line_id : vect_nk)
             {
@@ -92,7 +101,19 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         }
 
         // make the computation
-        void compute(const CplxVect & Vinit, int max_iter, real_type tol);
+        void compute(const CplxVect & Vinit, int max_iter, real_type tol){
+            check_no_job("compute");
+            _cancel_requested.store(false);
+            run_compute(Vinit, max_iter, tol);
+        }
+        /**
+        Same as `compute` but the computation is performed in a separate thread. This function returns immediately.
+        The contingencies must not be modified while the computation is running.
+        **/
+        void start_compute(const CplxVect & Vinit, int max_iter, real_type tol){
+            const CplxVect Vinit_ = Vinit;
+            start_job("start_compute", [=](){run_compute(Vinit_, max_iter, tol);});
+        }
         
         Eigen::Ref<const RealMat > compute_flows() {
             compute_flows_from_Vs();
@@ -125,6 +146,9 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         double modif_Ybus_time() const {return _timer_modif_Ybus;}
 
     protected:
+        // perform the computation of `compute` (used both when it is synchronous or in a separate thread)
+        void run_compute(const CplxVect & Vinit, int max_iter, real_type tol);
+
         // prevent the insertion of "out of range" elements
         void check_ok_el(Eigen::Index el){
             if(el < 0){
@@ -142,7 +166,7 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         }
         void init_li_coeffs();
         // remove the line parameters from Ybus, this is to emulate its disconnection
-        bool remove_from_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus, const std::vector<Coeff> & coeffs) const;
+        void remove_from_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus, const std::vector<Coeff> & coeffs) const;
         // after the coefficient has been removed with "remove_from_Ybus", add it back to Ybus
         void readd_to_Ybus(Eigen::SparseMatrix<cplx_type> & Ybus, const std::vector<Coeff> & coeffs) const;
 
@@ -151,8 +175,20 @@ class SecurityAnalysis: public BaseMultiplePowerflow
         void clean_flows(bool is_amps=true);
 
         // sometimes, when i perform some disconnection, I make the graph non connexe
-        // in this case, well, i don't use the results of the simulation
-        bool check_invertible(const Eigen::SparseMatrix<cplx_type> & Ybus) const;
+        // in this case, well, i don't use the results of the simulation.
+        // For each contingency, whether the grid stays connected (see GridModel::is_islanding)
+        std::vector<bool> check_invertible();
+
+        // For each contingency, whether it disconnects a powerline without impedance
+        std::vector<bool> check_zero_impedance();
+
+        // simulate a contingency that disconnects a powerline without impedance: its buses are not merged anymore,
+        // so the powerflow is performed on a copy of the grid (and not by a modification of Ybus)
+        bool compute_without_merge(const std::set<int> & this_cont_id,
+                                   const CplxVect & Vinit,
+                                   Eigen::Index cont_id,
+                                   int max_iter,
+                                   real_type tol);
     private:
         // li_default
         std::set<std::set<int> > _li_defaults;  // do not use unordered_set here, we rely on the order for different functions !
@@ -11,6 +11,9 @@
 #include "DCSolver.h"
 
 #include "SparseLUSolver.h"
+#include "DenseLUSolver.h"
+#include "BiCGSTABSolver.h"
+#include "LDLTSolver.h"
 #include "KLUSolver.h"
 #include "NICSLUSolver.h"
 
@@ -21,6 +24,23 @@ typedef BaseNRSolverSingleSlack<SparseLULinearSolver> SparseLUSolverSingleSlack;
 /** Solver based on Newton Raphson, using the SparseLU decomposition of Eigen, only suitable for the DC approximation**/
 typedef BaseDCSolver<SparseLULinearSolver> DCSolver;
 
+/** Solver based on Newton Raphson, using a dense LU decomposition (only suitable for small grids)**/
+typedef BaseNRSolver<DenseLULinearSolver> DenseLUSolver;
+/** Solver based on Newton Raphson, using a dense LU decomposition (only suitable for small grids), do not consider multiple slack bus**/
+typedef BaseNRSolverSingleSlack<DenseLULinearSolver> DenseLUSolverSingleSlack;
+/** Solver based on Newton Raphson, using a dense LU decomposition (only suitable for small grids), only suitable for the DC approximation**/
+typedef BaseDCSolver<DenseLULinearSolver> DenseLUDCSolver;
+
+/** Solver based on Newton Raphson, using the iterative BiCGSTAB method (preconditioned with an incomplete LU)**/
+typedef BaseNRSolver<BiCGSTABLinearSolver> BiCGSTABSolver;
+/** Solver based on Newton Raphson, using the iterative BiCGSTAB method (preconditioned with an incomplete LU), do not consider multiple slack bus**/
+typedef BaseNRSolverSingleSlack<BiCGSTABLinearSolver> BiCGSTABSolverSingleSlack;
+/** Solver based on Newton Raphson, using the iterative BiCGSTAB method (preconditioned with an incomplete LU), only suitable for the DC approximation**/
+typedef BaseDCSolver<BiCGSTABLinearSolver> BiCGSTABDCSolver;
+
+/** Solver based on Newton Raphson, using the sparse LDL^T (cholesky) decomposition of Eigen, only suitable for the DC approximation (symmetric matrix, falls back to SparseLU otherwise)**/
+typedef BaseDCSolver<LDLTLinearSolver> LDLTDCSolver;
+
 #ifdef KLU_SOLVER_AVAILABLE
     /** Solver based on Newton Raphson, using the KLU linear solver**/
     typedef BaseNRSolver<KLULinearSolver> KLUSolver;
@@ -44,3 +44,11 @@ ErrorType SparseLULinearSolver::solve(const Eigen::SparseMatrix<real_type> & J,
     }
     return err;
 }
+
+ErrorType SparseLULinearSolver::solve_many(const Eigen::SparseMatrix<real_type> & /*J*/, Eigen::Ref<RealMatRhs> B){
+    // solves (for X) the linear systems J.X = B, with the factorization already computed
+    RealMatRhs X = solver_.solve(B);
+    if (solver_.info() != Eigen::Success) return ErrorType::SolverSolve;
+    B = X;
+    return ErrorType::NoError;
+}
@@ -44,7 +44,13 @@ class SparseLULinearSolver
         // public api
         ErrorType initialize(const Eigen::SparseMatrix<real_type> & J);
         ErrorType solve(const Eigen::SparseMatrix<real_type> & J, RealVect & b, bool has_just_been_inialized);
+        // solve J.X = B (in place) for all the columns of B, using the last factorization (J is not factorized again)
+        ErrorType solve_many(const Eigen::SparseMatrix<real_type> & J, Eigen::Ref<RealMatRhs> B);
+        static const bool SOLVE_MANY_THREAD_SAFE = true;  // the factorization is only read in "solve_many"
         ErrorType reset(){ return ErrorType::NoError; }
+        // Eigen::SparseLU cannot be copied: the matrix will be analyzed and factorized again by "initialize"
+        bool reuse_factorization(const SparseLULinearSolver & /*other*/){ return false; }
+        void set_outer_tol(real_type /*tol*/) {}  // direct solver: the linear system is solved exactly
 
     private:
         // solver initialization
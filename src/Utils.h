@@ -31,5 +31,7 @@ typedef std::tuple<Eigen::Ref<const EigenPythonNumType>,
                    Eigen::Ref<const EigenPythonNumType> > tuple4d;
 typedef Eigen::Matrix<real_type, Eigen::Dynamic, 1> RealVect;
 typedef Eigen::Matrix<cplx_type, Eigen::Dynamic, 1> CplxVect;
+typedef Eigen::Matrix<real_type, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> RealMatRhs;  // one column = one right hand side (see LinearSolver::solve_many)
+typedef Eigen::Matrix<cplx_type, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> CplxMat;  // one row = one state of the grid (see GridModel::check_solutions)
 
 #endif // UTILS_H
@@ -100,6 +100,152 @@ const std::string DocSolver::get_timers = R"mydelimiter(
         Total time spent in the solver
 
 )mydelimiter";
+
+const std::string DocSolver::set_parameters_bicgstab = R"mydelimiter(
+    Change the parameters of the iterative method. They will be used the next time the preconditioner is built.
+
+    Parameters
+    ------------
+    drop_tol: ``float``
+        Drop tolerance of the incomplete LU decomposition used as preconditioner (default 1e-4). The smaller, the better (but the more
+        expensive) the preconditioner.
+
+    fill_factor: ``int``
+        Fill factor of the incomplete LU decomposition (default 10).
+
+    max_iter: ``int``
+        Maximum number of BiCGSTAB iterations for each linear system (default 1000).
+
+    rebuild_factor: ``float``
+        The preconditioner is kept as long as possible (across the newton raphson iterations and across the calls to `compute_pf`). It is rebuilt
+        when the number of iterations needed to solve a linear system is greater than `rebuild_factor` times the number of iterations needed just
+        after its last (re)build (default 2.). It is also rebuilt if the BiCGSTAB method fails to converge.
+
+)mydelimiter";
+
+const std::string DocSolver::get_parameters_bicgstab = R"mydelimiter(
+    Returns the parameters of the iterative method as a tuple `(drop_tol, fill_factor, max_iter, rebuild_factor)`, see 
+    :func:`lightsim2grid.solver.BiCGSTABSolver.set_parameters` for more information.
+
+)mydelimiter";
+
+const std::string DocSolver::set_tolerance_coupling = R"mydelimiter(
+    Change the way the tolerance of each linear system is computed from the tolerance of the newton raphson ("inexact newton").
+
+    The relative tolerance used to solve `J.x = b` is `min(eta_max, max(forcing * ||b||, safety * tol / ||b||))` where `tol` is
+    the tolerance given to `compute_pf`. It is never lower than `exact_tol`, which is also the tolerance used when the tolerance of
+    the newton raphson is not known (*eg* for the DC approximation).
+
+    Parameters
+    ------------
+    eta_max: ``float``
+        Maximum relative tolerance (used at the first iterations of the newton raphson), in ]0, 1[ (default 0.1)
+
+    forcing: ``float``
+        The relative tolerance decreases linearly with the norm of the mismatch, this is the slope (default 0.1)
+
+    safety: ``float``
+        Avoid computing the newton step with more precision than needed: the residual of the linear system is not asked to
+        be lower than `safety * tol` (default 0.1)
+
+    exact_tol: ``float``
+        Minimum relative tolerance (default 1e-12)
+
+)mydelimiter";
+
+const std::string DocSolver::get_tolerance_coupling = R"mydelimiter(
+    Returns the parameters used to compute the tolerance of each linear system as a tuple `(eta_max, forcing, safety, exact_tol)`, see 
+    :func:`lightsim2grid.solver.BiCGSTABSolver.set_tolerance_coupling` for more information.
+
+)mydelimiter";
+
+const std::string DocSolver::get_krylov_stats = R"mydelimiter(
+    Returns some statistics about the iterative method, as a tuple of 3 integers:
+
+    - the number of BiCGSTAB iterations performed to solve the last linear system
+    - the total number of BiCGSTAB iterations performed since the last `reset`
+    - the number of times the preconditioner has been (re)built since the last `reset`
+
+)mydelimiter";
+
+const std::string DocSolver::set_nb_thread_gs = R"mydelimiter(
+    Set the number of threads used to update (in parallel) the buses of the same color.
+
+    Threads are used only for large grids (when a color contains at least a thousand buses per thread).
+
+    Parameters
+    ----------
+    nb_thread: ``int``
+        The number of threads (>= 1, default 1)
+
+)mydelimiter";
+
+const std::string DocSolver::get_nb_thread_gs = R"mydelimiter(
+    Returns the number of threads used to update the buses of the same color (see :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_nb_thread`)
+
+)mydelimiter";
+
+const std::string DocSolver::set_sor = R"mydelimiter(
+    Set the relaxation factor of the successive over relaxation (SOR): at each iteration, each bus is updated with `V[k] += omega * delta[k]`
+    where `delta[k]` is the standard gauss seidel update.
+
+    In the adaptive mode (default), the powerflow starts with `omega = 1.`, estimates the contraction rate `rho` of the gauss seidel iterations
+    and then uses `omega = 2. / (1. + sqrt(1. - rho))` (clipped to the value provided here). `omega` is set back to 1. if the relaxed
+    iterations do not converge.
+
+    Parameters
+    ----------
+    omega: ``float``
+        The (fixed) relaxation factor if `adaptive` is ``False``, in ]0, 2[. The maximum relaxation factor if `adaptive` is ``True``, in [1, 2[.
+        (default 1.8)
+    adaptive: ``bool``
+        Whether the relaxation factor is estimated during the powerflow (default ``True``)
+
+)mydelimiter";
+
+const std::string DocSolver::get_sor = R"mydelimiter(
+    Returns the settings of the successive over relaxation, as a tuple `(omega, adaptive)` (see :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_sor`)
+
+)mydelimiter";
+
+const std::string DocSolver::get_omega = R"mydelimiter(
+    Returns the relaxation factor used for the last iteration of the last powerflow.
+
+)mydelimiter";
+
+const std::string DocSolver::get_nb_color = R"mydelimiter(
+    Returns the number of colors (independent sets of buses, updated one after the other) used for the last powerflow.
+
+)mydelimiter";
+
+const std::string DocSolver::set_gauss_seidel_colored_config = R"mydelimiter(
+    Set the settings of the :class:`lightsim2grid.solver.GaussSeidelColoredSolver` of the grid model (the ac solver and the ones
+    used for the islands of the grid), used when the `GaussSeidelColored` solver type is selected. The settings are kept when
+    the model is copied.
+
+    It raises a RuntimeError if one of the settings is not valid (nothing is changed in this case).
+
+    Parameters
+    ----------
+    nb_thread: ``int``
+        See :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_nb_thread`
+    omega: ``float``
+        See :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_sor`
+    adaptive: ``bool``
+        See :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_sor`
+
+)mydelimiter";
+
+const std::string DocSolver::get_gauss_seidel_colored_config = R"mydelimiter(
+    Returns the settings of the :class:`lightsim2grid.solver.GaussSeidelColoredSolver`, as a tuple `(nb_thread, omega, adaptive)`.
+
+)mydelimiter";
+
+const std::string DocSolver::use_ldlt = R"mydelimiter(
+    Whether the sparse LDL^T (cholesky) decomposition has been used for the last powerflow (``True``) or if the matrix was
+    not symmetric (or not suitable for this decomposition) and the solver fell back to the sparse LU decomposition (``False``).
+
+)mydelimiter";
     
 const std::string DocSolver::SparseLUSolver = R"mydelimiter(
     This classes implements the Newton Raphson algorithm, allowing for distributed slack and using the default Eigen sparse solver available in Eigen
@@ -137,6 +283,114 @@ const std::string DocSolver::DCSolver =  R"mydelimiter(
 
 )mydelimiter";
 
+const std::string DocSolver::DenseLUSolver = R"mydelimiter(
+    This classes implements the Newton Raphson algorithm, allowing for distributed slack and using a dense LU decomposition (with partial pivoting)
+    for the linear algebra. The jacobian matrix is copied into a dense matrix (allocated once) before being factorized.
+
+    It is only interesting for small grids (up to a few hundreds buses). For bigger grids, the sparse solvers (*eg* :class:`lightsim2grid.solver.KLUSolver`
+    or :class:`lightsim2grid.solver.SparseLUSolver`) are much faster.
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `DenseLU` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.DenseLU)`).
+
+)mydelimiter";
+
+const std::string DocSolver::DenseLUSolverSingleSlack = R"mydelimiter(
+    This classes implements the Newton Raphson algorithm, using a dense LU decomposition (with partial pivoting)
+    for the linear algebra. It does not support the distributed slack, but can be slightly faster than the :class:`lightsim2grid.solver.DenseLUSolver` .
+
+    It is only interesting for small grids (up to a few hundreds buses).
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `DenseLUSingleSlack` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.DenseLUSingleSlack)`).
+
+)mydelimiter";
+
+const std::string DocSolver::DenseLUDCSolver = R"mydelimiter(
+    Alternative implementation of the DC solver, it uses a dense LU decomposition (with partial pivoting) to solve for the DC voltage given the DC admitance matrix and
+    the power injected at each nodes.
+
+    It is only interesting for small grids (up to a few hundreds buses).
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `DenseLUDC` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.DenseLUDC)`).
+
+)mydelimiter";
+
+const std::string DocSolver::BiCGSTABSolver = R"mydelimiter(
+    This classes implements the Newton Raphson algorithm, allowing for distributed slack and using an iterative method (BiCGSTAB, preconditioned
+    with an incomplete LU decomposition) for the linear algebra.
+
+    The jacobian matrix is never factorized: the preconditioner is kept across the newton raphson iterations and across the calls to `compute_pf`, 
+    and it is rebuilt only when the number of iterations of the BiCGSTAB method grows. The tolerance of each linear system is coupled to the tolerance
+    of the newton raphson (see :func:`lightsim2grid.solver.BiCGSTABSolver.set_tolerance_coupling`).
+
+    It is only interesting for very large grids (tens of thousands of buses) where the factorization performed by the direct solvers
+    (*eg* :class:`lightsim2grid.solver.KLUSolver`) becomes expensive.
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `BiCGSTAB` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.BiCGSTAB)`).
+
+)mydelimiter";
+
+const std::string DocSolver::BiCGSTABSolverSingleSlack = R"mydelimiter(
+    This classes implements the Newton Raphson algorithm, using an iterative method (BiCGSTAB, preconditioned with an incomplete LU decomposition)
+    for the linear algebra. It does not support the distributed slack, but can be slightly faster than the :class:`lightsim2grid.solver.BiCGSTABSolver` .
+
+    It is only interesting for very large grids (tens of thousands of buses).
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `BiCGSTABSingleSlack` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.BiCGSTABSingleSlack)`).
+
+)mydelimiter";
+
+const std::string DocSolver::BiCGSTABDCSolver = R"mydelimiter(
+    Alternative implementation of the DC solver, it uses an iterative method (BiCGSTAB, preconditioned with an incomplete LU decomposition) to solve for 
+    the DC voltage given the DC admitance matrix and the power injected at each nodes.
+
+    It is only interesting for very large grids (tens of thousands of buses).
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `BiCGSTABDC` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.BiCGSTABDC)`).
+
+)mydelimiter";
+
+const std::string DocSolver::LDLTDCSolver = R"mydelimiter(
+    Alternative implementation of the DC solver, it uses the sparse LDL^T (cholesky) decomposition of Eigen (with an AMD ordering) to solve for the DC voltage 
+    given the DC admitance matrix and the power injected at each nodes.
+
+    The DC admittance matrix is symmetric in most cases, which allows this decomposition to be roughly twice as cheap (in time and memory) as a LU
+    decomposition. The symmetry is checked when the solver is initialized: if the matrix is not symmetric (*eg* because of some phase shifters)
+    the sparse LU decomposition of Eigen is used instead (see :func:`lightsim2grid.solver.LDLTDCSolver.use_ldlt`).
+
+    This is the default solver used for the DC powerflow.
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `LDLTDC` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.LDLTDC)`).
+
+)mydelimiter";
+
 const std::string DocSolver::KLUSolver = R"mydelimiter(
     This classes implements the Newton Raphson algorithm, allowing for distributed slack and using the faster KLU solver available in the SuiteSparse library
     for the linear algebra (can be unavailable if you build lightsim2grid from source). It is usually faster than the :class:`lightsim2grid.solver.SparseLUSolver`.
@@ -221,6 +475,23 @@ const std::string DocSolver::GaussSeidelSolver = R"mydelimiter(
 
 )mydelimiter";
 
+const std::string DocSolver::GaussSeidelColoredSolver = R"mydelimiter(
+    Implementation of the Gauss Seidel method (with successive over relaxation) suited for larger grids than the :class:`lightsim2grid.solver.GaussSeidelSolver`.
+    It does not support the distributed slack.
+
+    A row major copy of the admittance matrix (and the inverse of its diagonal) is kept, so that the update of a bus only reads the coefficients
+    of its row. The buses are colored (two connected buses never have the same color) and updated color by color: buses of the same color are
+    independent and can be updated in parallel (see :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_nb_thread`). The relaxation factor is,
+    by default, estimated during the powerflow (see :func:`lightsim2grid.solver.GaussSeidelColoredSolver.set_sor`).
+
+    See :ref:`available-powerflow-solvers` for more information on how to use it.
+
+    .. note::
+
+        In the enum :attr:`lightsim2grid.solver.SolverType`, it is referred to by the `GaussSeidelColored` member (*eg* `env_lightsim.backend.set_solver_type(lightsim2grid.solver.SolverType.GaussSeidelColored)`).
+
+)mydelimiter";
+
 const std::string DocSolver::GaussSeidelSynchSolver = R"mydelimiter(
     Variant implementation of the "Gauss Seidel" powerflow solver, where every buses are updated at once (can be significantly faster than the 
     :class:`lightsim2grid.solver.GaussSeidelSolver` for larger grid). We still do not recommend to use it as the Newton Raphson based solvers
@@ -272,6 +543,104 @@ const std::string DocSolver::chooseSolver_get_J_python = R"mydelimiter(
         the jacobian matrix might be irrelevant and an attempt to use this function will throw a RuntimeError. 
 
 )mydelimiter";
+const std::string DocSolver::solve_many = R"mydelimiter(
+    Solves the linear systems `M.X = B` for all the columns of `B` reusing the last factorization computed by the solver (the matrix
+    is not factorized again). This is useful for example to compute sensitivities or PTDF-like matrices after a powerflow.
+
+    `M` is the jacobian matrix (see :func:`lightsim2grid.solver.AnySolver.get_J`) for the newton raphson based solvers. For the dc solvers,
+    it is the (real part of the) dc admittance matrix (see :func:`lightsim2grid.gridmodel.GridModel.get_dcYbus`) where the row and column
+    of the slack bus have been removed.
+
+    Parameters
+    ------------
+    B: ``numpy.ndarray``
+        The right hand sides, one per column. It should have as many rows as `M`.
+
+    nb_thread: ``int``
+        The columns of `B` are split into `nb_thread` blocks solved in parallel (the factorization is shared, read only, between the threads). 
+        This is not supported by all linear solvers (*eg* KLU or NICSLU): in that case the blocks are solved one after the other (KLU still 
+        solves multiple right hand sides at once).
+
+    Returns
+    ---------
+    X: ``numpy.ndarray``
+        The solutions, one per column, same shape as `B`
+
+    .. note::
+        The factorization is the one of the last powerflow performed by this solver (the last newton raphson iteration for the ac solvers). If the
+        topology of the grid changed since, it does not reflect it.
+
+    .. note::
+        Gauss Seidel based solvers do not factorize any matrix, using this function with them will raise a RuntimeError.
+
+    Examples
+    ----------
+
+    .. code-block:: python
+
+        import numpy as np
+        # model is a lightsim2grid.gridmodel.GridModel on which a dc powerflow has been performed
+        dc_solver = model.get_dc_solver()
+        nb_bus_no_slack = model.get_dcYbus().shape[0] - 1
+        X = dc_solver.solve_many(np.eye(nb_bus_no_slack), nb_thread=4)  # inverse of the reduced dc admittance matrix
+
+)mydelimiter";
+
+const std::string DocSolver::KLUSolverConfig = R"mydelimiter(
+    Settings of the KLU linear solver (used by :class:`lightsim2grid.solver.KLUSolver`, :class:`lightsim2grid.solver.KLUSolverSingleSlack`
+    and :class:`lightsim2grid.solver.KLUDCSolver`).
+
+    The first settings (`ordering`, `btf`, `scale` and `tol`) are given to KLU (after a call to `klu_defaults`), see the
+    KLU user guide for more information. The last ones (`check_refactor` and `rcond_ratio`) control the check of the quality
+    of the refactorizations: they reuse the pivots of the last full factorization, which can become inaccurate if the matrix
+    changed a lot. When it is the case (or if the refactorization fails) a full factorization is performed instead.
+
+    Examples
+    ----------
+
+    .. code-block:: python
+
+        from lightsim2grid.solver import KLUSolverConfig, SolverType
+
+        # model is a lightsim2grid.gridmodel.GridModel
+        config = KLUSolverConfig()
+        config.ordering = 1  # COLAMD
+        config.btf = False
+        model.change_solver(SolverType.KLU)
+        model.set_klu_config(config)
+        # then perform a powerflow
+        ...
+        stats = model.get_solver().get_klu_stats()
+        print(f"fill in: {stats.lnz + stats.unz}, flops: {stats.flops}")
+
+)mydelimiter";
+
+const std::string DocSolver::KLUSolverStats = R"mydelimiter(
+    Statistics about the KLU linear solver (since its last reset), see :func:`lightsim2grid.solver.AnySolver.get_klu_stats`.
+
+)mydelimiter";
+
+const std::string DocSolver::set_klu_config = R"mydelimiter(
+    Change the settings (see :class:`lightsim2grid.solver.KLUSolverConfig`) of all the KLU based solvers of the grid model (ac, dc, and the ones
+    used for the islands of the grid). These solvers are reset, the new settings will be used at the next powerflow. The settings are kept when
+    the model is copied.
+
+    It raises a RuntimeError if KLU is not available or if one of the settings is not valid.
+
+)mydelimiter";
+
+const std::string DocSolver::get_klu_config = R"mydelimiter(
+    Returns (a copy of) the settings of the KLU based solvers, see :class:`lightsim2grid.solver.KLUSolverConfig`.
+
+)mydelimiter";
+
+const std::string DocSolver::get_klu_stats = R"mydelimiter(
+    Returns some statistics (fill-in, flops, number of factorizations etc.) about the linear solver (as a :class:`lightsim2grid.solver.KLUSolverStats`).
+
+    It raises a RuntimeError if the solver currently used is not based on KLU.
+
+)mydelimiter";
+
 const std::string DocSolver::get_computation_time = R"mydelimiter(
     Return the total computation time (in second) spend in the solver when performing a powerflow.
 
@@ -466,6 +835,16 @@ const std::string DocIterator::DataGen = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.GenInfo` for properties of these elements.
 
+    These properties are also available for all the generators at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_generators().res_p_mw``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_generators()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_generators()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::GenInfo = R"mydelimiter(
@@ -591,6 +970,16 @@ const std::string DocIterator::DataSGen = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.SGenInfo` for properties of these elements.
 
+    These properties are also available for all the static generators at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_static_generators().res_p_mw``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_static_generators()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_static_generators()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::SGenInfo = R"mydelimiter(
@@ -668,6 +1057,16 @@ const std::string DocIterator::DataLoad = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.LoadInfo` for properties of these elements.
 
+    These properties are also available for all the loads at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_loads().res_p_mw``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_loads()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_loads()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::LoadInfo = R"mydelimiter(
@@ -741,6 +1140,16 @@ const std::string DocIterator::DataShunt = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.ShuntInfo` for properties of these elements.
 
+    These properties are also available for all the shunts at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_shunts().res_q_mvar``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_shunts()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_shunts()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::ShuntInfo = R"mydelimiter(
@@ -803,6 +1212,16 @@ const std::string DocIterator::DataTrafo = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.TrafoInfo` for properties of these elements.
 
+    These properties are also available for all the transformers at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_trafos().res_p_hv_mw``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_trafos()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_trafos()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::TrafoInfo = R"mydelimiter(
@@ -1004,6 +1423,16 @@ const std::string DocIterator::DataLine = R"mydelimiter(
 
     You can have a look at :class:`lightsim2grid.elements.LineInfo` for properties of these elements.
 
+    These properties are also available for all the powerlines at once, as read only numpy arrays viewing the memory of
+    the grid model (without any copy, except for the boolean ones such as ``connected``), for example
+    ``grid_model.get_lines().res_p_or_mw``. This is much faster than iterating through the elements on large grids.
+
+    ``grid_model.get_lines()`` returns the table of the grid model itself, not a copy (the grid model is kept alive while
+    it is used). The memory of the results (``res_*``) is kept for the life of the grid model: these arrays are updated
+    by each powerflow, and set to ``nan`` when there is no result (the powerflow diverged, or the grid was modified
+    before they were computed). The memory is only reallocated when the elements change (``init_*``, ``set_state``...):
+    call ``grid_model.get_lines()`` again after such a modification, and copy the arrays (``np.array(...)``) to keep the values.
+
 )mydelimiter";
 
 const std::string DocIterator::LineInfo = R"mydelimiter(
@@ -1218,6 +1647,292 @@ const std::string DocGridModel::change_solver =  R"mydelimiter(
 
 )mydelimiter";
 
+const std::string DocGridModel::copy = R"mydelimiter(
+    Return a copy of this grid model.
+
+    The static data of the grid (parameters of the elements, nominal voltages etc.) are shared between the copies
+    until one of them is modified.
+
+    Parameters
+    ----------
+    keep_solver_state: ``bool``
+        If ``True``, the admittance matrices, the conversion of the bus ids and the state of the solvers are copied too
+        (including the factorization when the linear solver allows it: for KLU the symbolic analysis is shared, for
+        the dense LU the decomposition is copied, for the other solvers the sparsity pattern of the jacobian matrix is kept).
+        The first powerflow on the copy is then (almost) as fast as the next one on the original model. If ``False``
+        (default) the copy starts from scratch.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        V0 = np.ones(gridmodel.total_bus(), dtype=complex)
+        V = gridmodel.ac_pf(V0, 10, 1e-8)
+        gridmodel.unset_topo_changed()
+
+        gridmodel_cpy = gridmodel.copy(keep_solver_state=True)
+        V_cpy = gridmodel_cpy.ac_pf(V0, 10, 1e-8)  # no need to analyze the jacobian matrix again
+
+)mydelimiter";
+
+const std::string DocGridModel::to_bytes = R"mydelimiter(
+    Return a compact binary representation of this grid model (the one used by pickle).
+
+    The format is versioned and made of "column blocks" (one per attribute of the elements, in little endian, each
+    block starting at an offset multiple of 8 bytes). It can be read back with :func:`GridModel.from_bytes` with any
+    version of lightsim2grid that uses the same version of the binary format.
+
+    Only the grid is stored, not the results of the last powerflow nor the state of the solver.
+
+    Returns
+    -------
+    res: ``bytes``
+        The binary representation of the grid model
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init
+        from lightsim2grid_cpp import GridModel
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+
+        data = gridmodel.to_bytes()
+        gridmodel_loaded = GridModel.from_bytes(data)
+
+)mydelimiter";
+
+const std::string DocGridModel::from_bytes = R"mydelimiter(
+    Create a grid model from its binary representation (see :func:`GridModel.to_bytes`).
+
+    A ``RuntimeError`` is raised if the data are not a valid binary representation of a grid model, or if they have been
+    written with another version of the binary format.
+
+    Parameters
+    ----------
+    data: ``bytes``
+        The binary representation of the grid model
+
+    Returns
+    -------
+    res: :class:`GridModel`
+        The grid model
+
+)mydelimiter";
+
+const std::string DocGridModel::save = R"mydelimiter(
+    Save this grid model in a file, with the binary format of :func:`GridModel.to_bytes`.
+
+    Parameters
+    ----------
+    path: ``str``
+        Path of the file (it is overwritten if it exists)
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init
+        from lightsim2grid_cpp import GridModel
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+
+        gridmodel.save("case118.ls2g")
+        gridmodel_loaded = GridModel.load("case118.ls2g")
+
+)mydelimiter";
+
+const std::string DocGridModel::load = R"mydelimiter(
+    Load a grid model previously saved with :func:`GridModel.save`.
+
+    Parameters
+    ----------
+    path: ``str``
+        Path of the file
+
+    Returns
+    -------
+    res: :class:`GridModel`
+        The grid model
+
+)mydelimiter";
+
+const std::string DocGridModel::snapshot = R"mydelimiter(
+    Take a snapshot of the grid model, that can be restored later with :func:`GridModel.restore`.
+
+    Once a snapshot is taken, the changes of status, of bus and of injections (active / reactive values of loads,
+    generators, static generators, storage units and shunts and voltage setpoints of generators) are recorded in
+    a journal: only the first change of each value is recorded, so the journal never counts more entries than
+    the number of values of the grid.
+
+    The other modifications (parameters of the elements, slack buses, solver etc.) are not recorded.
+
+    If the topology is "up to date" (see :func:`GridModel.unset_topo_changed`) or, otherwise, at the first ac powerflow
+    computed with the topology of the snapshot, the admittance matrices and the state of the solvers are also kept
+    with the snapshot.
+
+    Returns
+    -------
+    res: ``int``
+        The id of the snapshot
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        V0 = np.ones(gridmodel.total_bus(), dtype=complex)
+
+        snapshot_id = gridmodel.snapshot()
+        gridmodel.deactivate_powerline(0)
+        gridmodel.change_p_load(1, 10.)
+        V = gridmodel.ac_pf(V0, 10, 1e-8)
+
+        gridmodel.restore(snapshot_id)  # powerline 0 is connected again, load 1 has its initial value
+
+)mydelimiter";
+
+const std::string DocGridModel::restore = R"mydelimiter(
+    Undo all the changes (recorded in the journal, see :func:`GridModel.snapshot`) made after a snapshot was taken.
+    This takes a time proportional to the number of changes.
+
+    The snapshot can be restored again afterwards, but the snapshots taken after it are discarded.
+
+    If the topology after the restoration is the same as the current one, the admittance matrices and the
+    factorization of the solver are kept. Otherwise the ones stored with the snapshot (if any) are used.
+
+    A ``RuntimeError`` is raised if the snapshot does not exist (anymore).
+
+    Parameters
+    ----------
+    snapshot_id: ``int``
+        The id of the snapshot (returned by :func:`GridModel.snapshot`)
+
+)mydelimiter";
+
+const std::string DocGridModel::has_snapshot = R"mydelimiter(
+    Whether the snapshot can be restored (see :func:`GridModel.restore`).
+
+    Parameters
+    ----------
+    snapshot_id: ``int``
+        The id of the snapshot (returned by :func:`GridModel.snapshot`)
+
+    Returns
+    -------
+    res: ``bool``
+        ``False`` if the snapshot does not exist (anymore)
+
+)mydelimiter";
+
+const std::string DocGridModel::clear_snapshots = R"mydelimiter(
+    Discard all the snapshots (and stop recording the changes made to the grid model).
+
+)mydelimiter";
+
+const std::string DocGridModel::apply_action_packed = R"mydelimiter(
+    Apply, in a single call, all the modifications of a grid2op action (this is mainly used by the
+    :class:`lightsim2grid.LightSimBackend`, it is not recommended to use it outside of this context).
+
+    For each type of modification, a boolean mask tells which elements are modified and a vector (with one value
+    per element) gives the new values: only the values for which the mask is ``True`` are read.
+
+    The modifications are applied in this order: injections, shunts (bus first, then active and reactive values)
+    and then the topology. The GIL is released during the call.
+
+    Parameters
+    ----------
+    gen_p_changed: ``numpy.ndarray``, bool
+        Which generators have their active production modified
+    gen_p: ``numpy.ndarray``, float32
+        The new active production of the generators (MW)
+    gen_v_changed: ``numpy.ndarray``, bool
+        Which generators have their voltage setpoint modified
+    gen_v: ``numpy.ndarray``, float32
+        The new voltage setpoint of the generators (kV, as in grid2op). It is converted in pu with the nominal voltage
+        of the substation of the generator (see `set_gen_to_subid`, that should be called before)
+    load_p_changed: ``numpy.ndarray``, bool
+        Which loads have their active consumption modified
+    load_p: ``numpy.ndarray``, float32
+        The new active consumption of the loads (MW)
+    load_q_changed: ``numpy.ndarray``, bool
+        Which loads have their reactive consumption modified
+    load_q: ``numpy.ndarray``, float32
+        The new reactive consumption of the loads (MVAr)
+    storage_p_changed: ``numpy.ndarray``, bool
+        Which storage units have their active power modified (can be empty)
+    storage_p: ``numpy.ndarray``, float32
+        The new active power of the storage units (MW)
+    shunt_p_changed: ``numpy.ndarray``, bool
+        Which shunts have their active power modified (can be empty)
+    shunt_p: ``numpy.ndarray``, float32
+        The new active power of the shunts (MW)
+    shunt_q_changed: ``numpy.ndarray``, bool
+        Which shunts have their reactive power modified (can be empty)
+    shunt_q: ``numpy.ndarray``, float32
+        The new reactive power of the shunts (MVAr)
+    shunt_bus_changed: ``numpy.ndarray``, bool
+        Which shunts have their bus modified (can be empty)
+    shunt_bus: ``numpy.ndarray``, int32
+        The new bus of the shunts, in the grid2op convention: 1 or 2 (bus of the substation, see
+        `set_shunt_to_subid`) or -1 (shunt disconnected)
+    topo_changed: ``numpy.ndarray``, bool
+        Which elements of the grid2op "topo_vect" are modified
+    topo_values: ``numpy.ndarray``, int32
+        The new bus of the elements of the grid2op "topo_vect" (1, 2 or -1)
+
+)mydelimiter";
+
+const std::string DocGridModel::set_res_buffers = R"mydelimiter(
+    Register numpy arrays (owned by the caller) in which the results of the next powerflows are written, in the
+    grid2op units, after each successful powerflow (this is mainly used by the :class:`lightsim2grid.LightSimBackend`,
+    it is not recommended to use it outside of this context).
+
+    - `set_line_res_buffers(p_or, q_or, v_or, a_or, theta_or, p_ex, q_ex, v_ex, a_ex, theta_ex)`: one value per
+      powerline then per transformer (as in grid2op). The flows are in A and the voltages and flows that are not
+      finite are set to 0.
+    - `set_load_res_buffers(p, q, v, theta)`, `set_gen_res_buffers(p, q, v, theta)` and
+      `set_storage_res_buffers(p, q, v, theta)`
+    - `set_shunt_res_buffers(p, q, v, bus)`: the bus is 1 or 2 (bus of the substation) or -1 if the shunt is
+      disconnected
+
+    The arrays must be contiguous, of type float32 (int32 for the bus) and have one element per element of the grid.
+    They are written in place (without any copy nor allocation on the python side) and are kept alive as long as
+    the GridModel. They are not registered on the copies of the GridModel.
+
+    `clear_res_buffers()` stops writing the results in the registered arrays.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        nb_load = len(gridmodel.get_loads())
+        load_p, load_q, load_v, load_theta = [np.zeros(nb_load, dtype=np.float32) for _ in range(4)]
+        gridmodel.set_load_res_buffers(load_p, load_q, load_v, load_theta)
+
+        V0 = np.ones(gridmodel.total_bus(), dtype=complex)
+        V = gridmodel.ac_pf(V0, 10, 1e-8)
+        # load_p, load_q, load_v and load_theta now contain the results of the powerflow
+
+)mydelimiter";
+
 const std::string DocGridModel::available_solvers =  R"mydelimiter(
     Return the list of solver available on the current lightsim2grid installation.
 
@@ -1228,15 +1943,29 @@ const std::string DocGridModel::get_computation_time = R"mydelimiter(
     Return the total computation time (in second) spend in the solver when performing a powerflow.
 
     This is equivalent to the `get_computation_time` of the :func:`lightsim2grid.solver.AnySolver.get_computation_time` of
-    the solver used (:func:`lightsim2grid.gridmodel.GridModel.get_solver`)
+    the solver used (:func:`lightsim2grid.gridmodel.GridModel.get_solver`), unless the grid was split in multiple islands: it is
+    then the sum of the computation times of the solvers of the islands.
     
 )mydelimiter";
 const std::string DocGridModel::get_dc_computation_time = R"mydelimiter(
     Return the total computation time (in second) spend in the solver (used to perform DC approximation) when performing a DC powerflow.
 
     This is equivalent to the `get_computation_time` of the :func:`lightsim2grid.solver.AnySolver.get_computation_time` of
-    the DC solver used (:func:`lightsim2grid.gridmodel.GridModel.get_dc_solver`)
+    the DC solver used (:func:`lightsim2grid.gridmodel.GridModel.get_dc_solver`), unless the grid was split in multiple islands: it is
+    then the sum of the computation times of the solvers of the islands.
     
+)mydelimiter";
+const std::string DocGridModel::get_error = R"mydelimiter(
+    Return the error (see :class:`lightsim2grid.solver.ErrorType`) of the last AC powerflow.
+
+    This is equivalent to the `get_error` of the solver used (:func:`lightsim2grid.gridmodel.GridModel.get_solver`), unless the grid
+    was split in multiple islands: it is then the first error of the solvers of the islands (`SingularMatrix` if no island has a slack bus).
+
+)mydelimiter";
+const std::string DocGridModel::get_dc_error = R"mydelimiter(
+    Return the error (see :class:`lightsim2grid.solver.ErrorType`) of the last DC powerflow, see
+    :func:`lightsim2grid.gridmodel.GridModel.get_error`
+
 )mydelimiter";
 const std::string DocGridModel::get_solver_type = R"mydelimiter(
     Return the type of the solver currently used.
@@ -1252,10 +1981,14 @@ const std::string DocGridModel::get_dc_solver_type = R"mydelimiter(
 const std::string DocGridModel::get_solver = R"mydelimiter(
     Return the solver currently in use as a :func:`lightsim2grid.solver.AnySolver` instance.
 
+    Its last factorization can be reused with :func:`lightsim2grid.solver.AnySolver.solve_many`.
+
 )mydelimiter";
 const std::string DocGridModel::get_dc_solver = R"mydelimiter(
     Return the solver currently in use as a :func:`lightsim2grid.solver.AnySolver` instance for the dc powerflow.
 
+    Its last factorization can be reused with :func:`lightsim2grid.solver.AnySolver.solve_many`.
+
 )mydelimiter";
 
 const std::string DocGridModel::get_lines = R"mydelimiter(
@@ -1430,6 +2163,7 @@ const std::string DocGridModel::get_J_python = R"mydelimiter(
 
     .. note::
         Some powerflows (*eg* DC or Gauss Seidel) do not rely on jacobian matrix, in this case, calling this function will return an exception. 
+        It also raises an exception if the last powerflow has been solved island by island (grid split in multiple islands, or Kron reduction).
 )mydelimiter" + DocGridModel::J_description;
 
 const std::string DocGridModel::get_Va = R"mydelimiter(
@@ -1438,6 +2172,9 @@ const std::string DocGridModel::get_Va = R"mydelimiter(
     You can use the :attr:`lightsim2grid.gridmodel.GridModel.id_ac_solver_to_me` (or :attr:`lightsim2grid.gridmodel.GridModel.id_dc_solver_to_me`) to know at which bus
     (on the grid) they corresponds.
 
+    These are the results of the last AC powerflow. If the grid was split in multiple islands, they are gathered from the
+    solvers of the islands (and are 0. for the de-energized islands).
+
 )mydelimiter";
 
 const std::string DocGridModel::get_Vm = R"mydelimiter(
@@ -1445,6 +2182,9 @@ const std::string DocGridModel::get_Vm = R"mydelimiter(
 
     You can use the :attr:`lightsim2grid.gridmodel.GridModel.id_ac_solver_to_me` (or :attr:`lightsim2grid.gridmodel.GridModel.id_dc_solver_to_me`) to know at which bus
     (on the grid) they corresponds.
+
+    These are the results of the last AC powerflow. If the grid was split in multiple islands, they are gathered from the
+    solvers of the islands (and are 0. for the de-energized islands).
 )mydelimiter";
 
 const std::string DocGridModel::get_V = R"mydelimiter(
@@ -1452,6 +2192,9 @@ const std::string DocGridModel::get_V = R"mydelimiter(
 
     You can use the :attr:`lightsim2grid.gridmodel.GridModel.id_ac_solver_to_me` (or :attr:`lightsim2grid.gridmodel.GridModel.id_dc_solver_to_me`) to know at which bus
     (on the grid) they corresponds.
+
+    These are the results of the last AC powerflow. If the grid was split in multiple islands, they are gathered from the
+    solvers of the islands (and are 0. for the de-energized islands).
 )mydelimiter";
 
 
@@ -1504,6 +2247,10 @@ const std::string DocGridModel::id_me_to_ac_solver = R"mydelimiter(
     - `solver_bus_id` is shorter (or of the same length) than `gridmodel_bus_id`
     - the connected bus (in the grid model) are given by `gridmodel_bus_id[id_ac_solver_to_me]`, and it gives their order
 
+    The buses connected by a powerline without impedance (``r = x = 0``, for example a bus coupler) are the same bus
+    for the solver: they have the same value in `id_me_to_ac_solver` and only the first one (smallest id) is in
+    `id_ac_solver_to_me`.
+
 )mydelimiter";
 
 const std::string DocGridModel::id_ac_solver_to_me = R"mydelimiter(
@@ -1554,6 +2301,10 @@ const std::string DocGridModel::id_ac_solver_to_me = R"mydelimiter(
     - `solver_bus_id` is shorter (or of the same length) than `gridmodel_bus_id`
     - the connected bus (in the grid model) are given by `gridmodel_bus_id[id_ac_solver_to_me]`, and it gives their order
 
+    The buses connected by a powerline without impedance (``r = x = 0``, for example a bus coupler) are the same bus
+    for the solver: they have the same value in `id_me_to_ac_solver` and only the first one (smallest id) is in
+    `id_ac_solver_to_me`.
+
 )mydelimiter";
 
 const std::string DocGridModel::id_me_to_dc_solver = R"mydelimiter(
@@ -1721,6 +2472,46 @@ const std::string DocGridModel::check_solution = R"mydelimiter(
 
 )mydelimiter"; 
 
+const std::string DocGridModel::check_solutions = R"mydelimiter(
+    Same as :func:`lightsim2grid.gridmodel.GridModel.check_solution` for many complex voltage vectors at once (for
+    example to validate the predictions of a surrogate model in bulk).
+
+    The admittance matrix and the injections are computed once for all the vectors, and the mismatches are computed
+    in c++ (with one sparse dense matrix product for each block of vectors, the blocks being split between the
+    threads) without holding the python GIL. The results are the same as calling `check_solution` on each row.
+
+    Parameters
+    ------------
+    Vs:
+      A complex matrix with one row per voltage vector to test and one column per bus of the grid (as many columns
+      as the total number of buses).
+
+    check_q_limits: ``bool``
+      whether you want to take into account the reactive limit of generators when performing the check
+
+    Returns
+    -------
+    mismatches:
+        A complex matrix with the same shape as `Vs`: its row `i` is the mismatch of the voltage vector `Vs[i]`
+        (see :func:`lightsim2grid.gridmodel.GridModel.check_solution`)
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+
+        V = gridmodel.ac_pf(np.ones(gridmodel.total_bus(), dtype=complex), 10, 1e-8)
+        # 1000 (noisy) candidate states of the grid
+        Vs = V * (1. + 0.01 * np.random.randn(1000, V.shape[0]))
+        mismatches = gridmodel.check_solutions(Vs, False)  # shape (1000, gridmodel.total_bus())
+
+)mydelimiter";
+
 const std::string DocGridModel::deactivate_result_computation = R"mydelimiter(
     Allows to deactivate the computation of the flows, reactive power absorbed by generators etc. to gain a bit of time when it is not needed.
 
@@ -1734,6 +2525,255 @@ const std::string DocGridModel::reactivate_result_computation = R"mydelimiter(
     .. seealso:: :func:`lightsim2grid.gridmodel.GridModel.deactivate_result_computation`
 )mydelimiter";     
 
+const std::string DocGridModel::set_result_mask = R"mydelimiter(
+    Set which results are computed right after each powerflow, as a combination of
+    :class:`lightsim2grid.gridmodel.ResultType` (by default all of them: ``ResultType.All``).
+
+    The other results are not lost: they are computed from the voltages of the last powerflow the first time they
+    are accessed (for example with `get_loads_res`) and never computed twice for the same powerflow. They are however
+    dropped (and the corresponding getters return vectors of ``nan``) if the grid, or the solver, is modified before
+    they are accessed.
+
+    `get_result_mask()` returns the current mask.
+
+    Parameters
+    ----------
+    result_mask: :class:`lightsim2grid.gridmodel.ResultType` or ``int``
+        The results to compute right after each powerflow
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init
+        from lightsim2grid.gridmodel import ResultType
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        gridmodel.set_result_mask(ResultType.Lines | ResultType.Trafos)
+
+        V0 = np.ones(gridmodel.total_bus(), dtype=complex)
+        V = gridmodel.ac_pf(V0, 10, 1e-8)
+        p_or, q_or, v_or, a_or = gridmodel.get_lineor_res()  # already computed
+        gen_p, gen_q, gen_v = gridmodel.get_gen_res()  # computed now
+
+)mydelimiter";
+
+const std::string DocGridModel::connectivity = R"mydelimiter(
+    Information about the islands of the grid, computed from the status and the buses of the powerlines and the
+    transformers. They are kept up to date (incrementally when possible) when these elements are modified, so
+    the functions below are cheap and can be called before each powerflow.
+
+    - `nb_connected_components()`: the number of islands (only the activated buses are considered). When there are
+      more than one, the islands are solved independently and the ones without slack bus are de-energized.
+    - `get_bus_islands()`: for each bus, the id of its island (``-1`` for the deactivated buses)
+    - `get_bridges()`: for each branch, whether its disconnection would split an island
+    - `get_articulation_points()`: for each bus, whether its removal would split an island
+    - `is_islanding(branch_ids)`: whether the disconnection of all these branches would split an island
+
+    The branches are the powerlines (ids ``0`` to ``len(gridmodel.get_lines()) - 1``) followed by the
+    transformers, as in :class:`lightsim2grid.securityAnalysis.SecurityAnalysisCPP`.
+
+    The bridges are computed once for a given topology: checking whether a single disconnection splits the grid is
+    then a simple lookup.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+
+        assert gridmodel.nb_connected_components() == 1
+        n1_islanding = gridmodel.get_bridges()  # one value per powerline / trafo
+        nk_islanding = gridmodel.is_islanding([0, 1])
+
+)mydelimiter";
+
+const std::string DocGridModel::kron_reduction = R"mydelimiter(
+    Kron reduction of the grid before the AC powerflow (off by default).
+
+    The PQ buses without any injection (no load, generator, static generator or storage unit, or only elements
+    producing / consuming nothing) are eliminated from the admittance matrix: the Newton Raphson is performed on a
+    smaller system and the voltages of the eliminated buses are then recovered from the ones of the other buses. The
+    results are the same as without reduction.
+
+    The reduction is computed again only when the topology, or the set of buses without injection, changes.
+
+    - `set_kron_reduction(kron_reduction)`: activate (``True``) or deactivate (``False``) the reduction
+    - `get_kron_reduction()`: whether the reduction is activated
+    - `nb_kron_eliminated()`: the number of buses eliminated in the last AC powerflow
+
+    .. warning::
+        Eliminating many adjacent buses can make the reduced admittance matrix much denser than the original one, in
+        which case the powerflow can be slower with the reduction. It has no effect on the DC powerflow.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        gridmodel.set_kron_reduction(True)
+
+        V0 = np.ones(gridmodel.total_bus(), dtype=complex)
+        V = gridmodel.ac_pf(V0, 10, 1e-8)
+        print(f"{gridmodel.nb_kron_eliminated()} buses have been eliminated")
+
+)mydelimiter";
+
+const std::string DocGridModel::ward_equivalent = R"mydelimiter(
+    Network reduction (Ward equivalent) of the grid around an area of interest.
+
+    `ward_equivalent(internal_buses, V_full, extended=False)` returns a new grid model where only the internal buses,
+    and the boundary buses (the other buses directly connected to them), are kept. The rest of the grid is eliminated
+    from the admittance matrix (with a sparse factorization of its external part) and replaced by:
+
+    - equivalent powerlines between the boundary buses and equivalent shunts at the boundary buses
+    - one equivalent injection per boundary bus: a load, or for the extended Ward equivalent (``extended=True``) a
+      generator holding the voltage of the boundary bus, which better represents the reactive response of the
+      external grid
+
+    The injections are fitted so that the reduced grid gives the voltages `V_full` (a solution of the powerflow on the
+    whole grid) on the kept buses. They can be fitted again on another solution with `refit_ward_injections(V_full)`.
+    `get_ward_boundary_buses()` and `get_ward_injections()` give the boundary buses and the ids of the equivalent
+    loads (or generators) in the reduced grid.
+
+    The reduced grid only has the kept buses and the elements connected to them (at both sides for the branches), so
+    it is numbered again: the buses and the elements keep the order of their ids in the full grid, and the equivalent
+    elements are added after them. `get_ward_ids()` gives, for the buses (`bus`) and for each type of element (`line`,
+    `trafo`, `shunt`, `gen`, `load`, `sgen`, `storage`), the id in the full grid of each bus or element of the reduced
+    grid (``-1`` for the equivalent elements). The internal buses must hold a slack generator.
+
+    .. note::
+        The equivalent is exact for the base case. For other states (eg after a contingency in the internal area), it
+        is an approximation. If the external grid has phase shifting transformers, only the symmetric part of the
+        equivalent admittance matrix is kept.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+        V_full = gridmodel.ac_pf(np.ones(gridmodel.total_bus(), dtype=complex), 10, 1e-8)
+
+        reduced = gridmodel.ward_equivalent(np.arange(40), V_full)
+        ids = reduced.get_ward_ids()
+        V = reduced.ac_pf(V_full[ids.bus], 10, 1e-8)  # same voltages as V_full[ids.bus]
+
+)mydelimiter";
+
+const std::string DocGridModel::node_breaker = R"mydelimiter(
+    Topology processor for a grid described at the "node breaker" level.
+
+    Each substation is made of nodes (busbar sections, connection points of the elements...) linked by switches
+    (breakers, disconnectors, couplers). The nodes connected through closed switches form one bus, and the buses of
+    the elements (and their status) are computed from the state of the switches. Only the substation of a switch is
+    updated when its state changes.
+
+    A group of nodes is assigned the first available bus of its substation (in the order of the smallest node id of
+    the groups), and only if at least two elements are connected to it: otherwise these elements are disconnected. A
+    powerline (or a transformer) is connected if both its sides are. An error is raised, and nothing is modified, if a
+    substation would need more buses than it has.
+
+    The elements not handled by the topology processor stay on their bus, and they count as elements of the group of
+    nodes assigned this bus. A group of nodes without any element handled by the topology processor (an isolated
+    busbar section for example) is never assigned a bus, so the elements not handled by the processor count as elements
+    of the first group with a handled element. So the types of elements can be registered one by one, or only some of
+    them. These elements are counted again each time the terminals or the switches are modified.
+
+    - `init_node_breaker(node_to_sub, sub_buses, switch_node_1, switch_node_2, switch_closed)`: the substation of each
+      node, the buses (of the grid model) each substation can use, and the two nodes and the state of each switch
+    - `set_node_breaker_terminals(terminal_type, nodes)`: the node of each element of this type (``-1`` for the elements
+      not handled by the topology processor, their buses are left untouched)
+    - `set_switch(switch_id, closed)`, `set_switches(switch_ids, closed)` and `update_switches(has_changed, new_values)`:
+      open (``False``) or close (``True``) some switches
+    - `get_switches()`: the state of each switch
+    - `get_node_bus()`: the bus of each node (``-1`` if the node is not part of a bus)
+
+    The state of the switches is restored with :func:`lightsim2grid.gridmodel.GridModel.restore`, but it is not
+    part of the pickled model.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        from lightsim2grid.gridmodel import init, TerminalType
+        import pandapower.networks as pn
+        gridmodel = init(pn.case14())
+
+        # one node per bus (the elements other than the loads are connected there), and one node per load
+        # linked to the node of its bus by a breaker
+        n_bus = gridmodel.total_bus()
+        n_load = len(gridmodel.get_loads())
+        load_bus = [el.bus_id for el in gridmodel.get_loads()]
+        gridmodel.init_node_breaker(node_to_sub=list(range(n_bus)) + load_bus,
+                                    sub_buses=[[bus_id] for bus_id in range(n_bus)],
+                                    switch_node_1=list(range(n_bus, n_bus + n_load)),
+                                    switch_node_2=load_bus,
+                                    switch_closed=[True for _ in range(n_load)])
+        gridmodel.set_node_breaker_terminals(TerminalType.Load, list(range(n_bus, n_bus + n_load)))
+        gridmodel.set_node_breaker_terminals(TerminalType.Gen, [el.bus_id for el in gridmodel.get_generators()])
+        gridmodel.set_node_breaker_terminals(TerminalType.LineOr, [el.bus_or_id for el in gridmodel.get_lines()])
+        gridmodel.set_node_breaker_terminals(TerminalType.LineEx, [el.bus_ex_id for el in gridmodel.get_lines()])
+        gridmodel.set_node_breaker_terminals(TerminalType.TrafoHv, [el.bus_hv_id for el in gridmodel.get_trafos()])
+        gridmodel.set_node_breaker_terminals(TerminalType.TrafoLv, [el.bus_lv_id for el in gridmodel.get_trafos()])
+
+        gridmodel.set_switch(0, False)  # the first load is now disconnected
+
+)mydelimiter";
+
+const std::string DocGridModel::set_values = R"mydelimiter(
+    Change one attribute (see :class:`lightsim2grid.gridmodel.ElementAttribute`) of many elements of the same type
+    (see :class:`lightsim2grid.gridmodel.TerminalType`) with one call. The loop over the elements is made in c++,
+    without holding the python GIL.
+
+    - `set_values(element_type, attribute, el_ids, values)`: the element `el_ids[i]` is given the value `values[i]`
+    - `set_values_mask(element_type, attribute, has_changed, new_values)`: the element `el_id` is given the value
+      `new_values[el_id]` if `has_changed[el_id]` is ``True`` (both arrays have one value per element)
+
+    The values can be given in float32 or in float64. The valid attributes are:
+
+    - `P`: for the loads, the generators, the static generators, the storage units and the shunts
+    - `Q`: for the loads, the static generators, the storage units and the shunts
+    - `V`: for the generators (in pu)
+    - `Bus`: for all the elements. For the branches, only the bus of the side given by `element_type` is changed
+    - `Status`: for all the elements (``0.`` to disconnect it, any other value to connect it). For the branches, both
+      sides give the same result.
+
+    All the values are checked before the grid is modified: if an error is raised (unknown element, bus that does
+    not exist, disconnected element for `P`, `Q` or `V`...) the grid is not changed.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        import numpy as np
+        from lightsim2grid.gridmodel import init, TerminalType, ElementAttribute
+        import pandapower.networks as pn
+        gridmodel = init(pn.case118())
+
+        # multiply the consumption of the first ten loads by 1.1
+        load_p = np.array([el.target_p_mw for el in gridmodel.get_loads()], dtype=np.float32)
+        gridmodel.set_values(TerminalType.Load, ElementAttribute.P, np.arange(10), 1.1 * load_p[:10])
+
+        # disconnect the powerlines 3 and 5
+        mask = np.zeros(len(gridmodel.get_lines()), dtype=bool)
+        mask[[3, 5]] = True
+        gridmodel.set_values_mask(TerminalType.LineOr, ElementAttribute.Status, mask, np.zeros(mask.shape[0]))
+
+)mydelimiter";
+
 const std::string DocGridModel::ac_pf = R"mydelimiter(
     Allows to perform an AC (alternating current) powerflow.
 
@@ -1875,6 +2915,30 @@ const std::string DocComputers::compute_Vs = R"mydelimiter(
     tol: ``float``
         Solver tolerance (> 0. float)
 
+    gen_v: ``numy.ndarray``, float (optional)
+        Voltage setpoint (in pair unit) for each generators. Its counts as many column as the number of generators on the grid and as many rows as
+        the number of steps to compute. If not provided, the voltage magnitude given in `Vinit` is used for every steps.
+
+    sgen_q: ``numy.ndarray``, float (optional)
+        Reactive generation for each static generator. Its counts as many column as the number of static generators on the grid and as many rows as
+        the number of steps to compute. If not provided, it is not taken into account.
+
+    storage_p: ``numy.ndarray``, float (optional)
+        Active consumption (load sign convention) for each storage units. Its counts as many column as the number of storage units on the grid and 
+        as many rows as the number of steps to compute. If not provided, it is not taken into account.
+
+    storage_q: ``numy.ndarray``, float (optional)
+        Reactive consumption (load sign convention) for each storage units. Its counts as many column as the number of storage units on the grid and 
+        as many rows as the number of steps to compute. If not provided, it is not taken into account.
+
+    shunt_p: ``numy.ndarray``, float (optional)
+        Active consumption (in MW, at 1 pu) for each shunt. Its counts as many column as the number of shunts on the grid and as many rows as
+        the number of steps to compute. If not provided, the value stored in the grid model is used for every steps.
+
+    shunt_q: ``numy.ndarray``, float (optional)
+        Reactive consumption (in MVAr, at 1 pu) for each shunt. Its counts as many column as the number of shunts on the grid and as many rows as
+        the number of steps to compute. If not provided, the value stored in the grid model is used for every steps.
+
     Returns
     ----------
     status: ``int``
@@ -1895,6 +2959,10 @@ const std::string DocComputers::compute_flows = R"mydelimiter(
     .. note::
         During this computation, the GIL is released, allowing easier parrallel computation
 
+    .. note::
+        The flows of the powerlines without impedance (``r = x = 0``, for example bus couplers) are ``nan``: both
+        their ends have the same voltage, so they cannot be computed from the voltages alone.
+
 )mydelimiter";
 
 const std::string DocComputers::compute_power_flows = R"mydelimiter(
@@ -1909,6 +2977,10 @@ const std::string DocComputers::compute_power_flows = R"mydelimiter(
     .. note::
         During this computation, the GIL is released, allowing easier parrallel computation
 
+    .. note::
+        The flows of the powerlines without impedance (``r = x = 0``, for example bus couplers) are ``nan``: both
+        their ends have the same voltage, so they cannot be computed from the voltages alone.
+
 )mydelimiter";
 
 const std::string DocComputers::get_flows = R"mydelimiter(
@@ -1976,6 +3048,79 @@ const std::string DocComputers::get_sbuses = R"mydelimiter(
 
 )mydelimiter";
 
+const std::string DocComputers::start_compute_Vs = R"mydelimiter(
+    Same as :func:`lightsim2grid.timeSerie.Computers.compute_Vs` (same parameters) but the computation is performed
+    in a separate c++ thread. This function returns immediately (the input data are copied).
+
+    While the computation is running, you can follow it with :func:`lightsim2grid.timeSerie.Computers.get_progress` and
+    stop it with :func:`lightsim2grid.timeSerie.Computers.cancel`. Results (*eg* voltages) can only be retrieved once it is over,
+    see :func:`lightsim2grid.timeSerie.Computers.result` or :func:`lightsim2grid.timeSerie.Computers.wait`.
+
+    .. warning::
+        Only the methods `is_running`, `get_progress`, `cancel`, `wait` and `result` can be used while the computation is running.
+
+    Examples
+    ---------
+
+    .. code-block:: python
+
+        computer.start_compute_Vs(gen_p, sgen_p, load_p, load_q, Vinit, max_iter, tol)
+        # do something else (load the data of the next scenario for example)
+        nb_done, nb_failed, solver_time = computer.get_progress()
+        status = computer.result()  # wait for the computation to be over
+        Vs = computer.get_voltages()
+
+)mydelimiter";
+
+const std::string DocComputers::result = R"mydelimiter(
+    Wait for the computation started with :func:`lightsim2grid.timeSerie.Computers.start_compute_Vs` to be over and
+    returns its status (see :func:`lightsim2grid.timeSerie.Computers.get_status`).
+
+    If an error occured during the computation, it is raised here.
+
+    .. note::
+        The GIL is released while waiting.
+
+)mydelimiter";
+
+const std::string DocComputers::is_running = R"mydelimiter(
+    Whether a computation is currently running in the background.
+
+)mydelimiter";
+
+const std::string DocComputers::cancel = R"mydelimiter(
+    Ask the computation running in the background to stop. This is cooperative: the current powerflow is 
+    finished before the computation stops. Results computed before the cancellation are kept.
+
+    You still need to call `wait()` (or `result()`) to make sure the computation is over.
+
+)mydelimiter";
+
+const std::string DocComputers::wait = R"mydelimiter(
+    Wait for the computation running in the background (if any) to be over. If an error occured during the computation,
+    it is raised here.
+
+    .. note::
+        The GIL is released while waiting.
+
+)mydelimiter";
+
+const std::string DocComputers::get_progress = R"mydelimiter(
+    Retrieve the progress of the current (or last) computation. It can be called while the computation is running.
+
+    Returns
+    -------
+    nb_done: ``int``
+        Number of powerflows performed so far
+
+    nb_failed: ``int``
+        Number of powerflows that did not converge
+
+    solver_time: ``float``
+        Time spent in the solver so far (in seconds)
+
+)mydelimiter";
+
 const std::string DocSecurityAnalysis::SecurityAnalysis = R"mydelimiter(
     Allows the computation of "security analysis", that consists in computing the flows that would result from the disconnection of one or multiple
     disconnections of some powerlines.
@@ -1994,6 +3139,11 @@ const std::string DocSecurityAnalysis::SecurityAnalysis = R"mydelimiter(
     .. note::
         You can only simulate disconnection of powerlines / transformers
 
+    .. note::
+        The buses connected by a powerline without impedance are the same bus for the solver. The contingencies
+        disconnecting such a powerline cannot be simulated by a modification of the admittance matrix: they are
+        simulated on a copy of the grid model (slower).
+
     At a glance, this class should be used in three steps:
 
     1) Modify the list of contingencies to simulate, with the functions:
@@ -2174,6 +3324,19 @@ const std::string DocSecurityAnalysis::compute = R"mydelimiter(
 
 )mydelimiter";
 
+const std::string DocSecurityAnalysis::start_compute = R"mydelimiter(
+    Same as :func:`lightsim2grid.securityAnalysis.SecurityAnalysisCPP.compute` (same parameters) but the computation is performed
+    in a separate c++ thread. This function returns immediately.
+
+    While the computation is running, you can follow it with `get_progress()` and stop it with `cancel()`. Use `wait()` to wait 
+    for the computation to be over before retrieving the results.
+
+    .. warning::
+        Only the methods `is_running`, `get_progress`, `cancel` and `wait` can be used while the computation is running. In particular,
+        the contingencies cannot be modified.
+
+)mydelimiter";
+
 const std::string DocSecurityAnalysis::compute_flows = R"mydelimiter(
     Compute the current flows (in amps, at the origin of each powerlines / high voltage size of each transformers.
 
@@ -2186,6 +3349,10 @@ const std::string DocSecurityAnalysis::compute_flows = R"mydelimiter(
     .. note::
         During this computation, the GIL is released, allowing easier parrallel computation
 
+    .. note::
+        The flows of the powerlines without impedance (``r = x = 0``, for example bus couplers) are ``nan``: both
+        their ends have the same voltage, so they cannot be computed from the voltages alone.
+
 )mydelimiter";
 
 const std::string DocSecurityAnalysis::compute_power_flows = R"mydelimiter(
@@ -2200,6 +3367,10 @@ const std::string DocSecurityAnalysis::compute_power_flows = R"mydelimiter(
     .. note::
         During this computation, the GIL is released, allowing easier parrallel computation
 
+    .. note::
+        The flows of the powerlines without impedance (``r = x = 0``, for example bus couplers) are ``nan``: both
+        their ends have the same voltage, so they cannot be computed from the voltages alone.
+
 )mydelimiter";
 
 const std::string DocSecurityAnalysis::get_flows = R"mydelimiter(
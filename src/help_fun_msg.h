@@ -28,10 +28,37 @@ struct DocSolver
     static const std::string compute_pf;
     static const std::string get_timers;
 
+    // iterative solvers
+    static const std::string set_parameters_bicgstab;
+    static const std::string get_parameters_bicgstab;
+    static const std::string set_tolerance_coupling;
+    static const std::string get_tolerance_coupling;
+    static const std::string get_krylov_stats;
+
+    // colored gauss seidel solver
+    static const std::string set_nb_thread_gs;
+    static const std::string get_nb_thread_gs;
+    static const std::string set_sor;
+    static const std::string get_sor;
+    static const std::string get_omega;
+    static const std::string get_nb_color;
+    static const std::string set_gauss_seidel_colored_config;
+    static const std::string get_gauss_seidel_colored_config;
+
+    // cholesky solver
+    static const std::string use_ldlt;
+
     // solver description
     static const std::string SparseLUSolver;
     static const std::string SparseLUSolverSingleSlack;
     static const std::string DCSolver;
+    static const std::string DenseLUSolver;
+    static const std::string DenseLUSolverSingleSlack;
+    static const std::string DenseLUDCSolver;
+    static const std::string BiCGSTABSolver;
+    static const std::string BiCGSTABSolverSingleSlack;
+    static const std::string BiCGSTABDCSolver;
+    static const std::string LDLTDCSolver;
 
     static const std::string KLUSolver;
     static const std::string KLUSolverSingleSlack;
@@ -43,11 +70,18 @@ struct DocSolver
 
     static const std::string GaussSeidelSolver;
     static const std::string GaussSeidelSynchSolver;
+    static const std::string GaussSeidelColoredSolver;
 
     // function to select the solver
     static const std::string AnySolver;
     static const std::string get_type;
     static const std::string chooseSolver_get_J_python;
+    static const std::string solve_many;
+    static const std::string KLUSolverConfig;
+    static const std::string KLUSolverStats;
+    static const std::string set_klu_config;
+    static const std::string get_klu_config;
+    static const std::string get_klu_stats;
     static const std::string get_computation_time;
 
 };
@@ -136,11 +170,24 @@ struct DocGridModel
     static const std::string J_description;
     
     static const std::string GridModel;
+    static const std::string copy;
+    static const std::string to_bytes;
+    static const std::string from_bytes;
+    static const std::string save;
+    static const std::string load;
+    static const std::string snapshot;
+    static const std::string restore;
+    static const std::string has_snapshot;
+    static const std::string clear_snapshots;
+    static const std::string apply_action_packed;
+    static const std::string set_res_buffers;
 
     static const std::string change_solver;
     static const std::string available_solvers;
     static const std::string get_computation_time;
     static const std::string get_dc_computation_time;
+    static const std::string get_error;
+    static const std::string get_dc_error;
     static const std::string get_solver_type;
     static const std::string get_dc_solver_type;
     static const std::string get_solver;
@@ -175,9 +222,16 @@ struct DocGridModel
     static const std::string get_Sbus;
 
     static const std::string check_solution;
+    static const std::string check_solutions;
 
     static const std::string deactivate_result_computation;
     static const std::string reactivate_result_computation;
+    static const std::string set_result_mask;
+    static const std::string connectivity;
+    static const std::string kron_reduction;
+    static const std::string node_breaker;
+    static const std::string set_values;
+    static const std::string ward_equivalent;
     static const std::string ac_pf;
     static const std::string dc_pf;
 };
@@ -200,6 +254,14 @@ struct DocComputers
     static const std::string get_power_flows;
     static const std::string get_voltages;
     static const std::string get_sbuses;
+
+    // asynchronous computation
+    static const std::string start_compute_Vs;
+    static const std::string result;
+    static const std::string is_running;
+    static const std::string cancel;
+    static const std::string wait;
+    static const std::string get_progress;
 };
 
 struct DocSecurityAnalysis
@@ -221,6 +283,7 @@ struct DocSecurityAnalysis
     static const std::string my_defaults_vect;
 
     static const std::string compute;
+    static const std::string start_compute;
     static const std::string compute_flows;
     static const std::string compute_power_flows;
 
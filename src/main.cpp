@@ -9,6 +9,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/eigen.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 
 #include "ChooseSolver.h"
 #include "DataConverter.h"
@@ -20,6 +21,15 @@
 
 namespace py = pybind11;
 
+// the std::vector<bool> are stored as bits: they cannot be viewed from numpy, they are copied
+py::array_t<bool> bool_column(const std::vector<bool> & values)
+{
+    py::array_t<bool> res(static_cast<py::ssize_t>(values.size()));
+    auto res_ = res.mutable_unchecked<1>();
+    for(std::size_t el_id = 0; el_id < values.size(); ++el_id) res_(el_id) = values[el_id];
+    return res;
+}
+
 PYBIND11_MODULE(lightsim2grid_cpp, m)
 {
 
@@ -36,8 +46,44 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .value("NICSLU", SolverType::NICSLU, "denotes the :class:`lightsim2grid.solver.NICSLUSolver`")
         .value("NICSLUSingleSlack", SolverType::NICSLUSingleSlack, "denotes the :class:`lightsim2grid.solver.NICSLUSolverSingleSlack`")
         .value("NICSLUDC", SolverType::NICSLUDC, "denotes the :class:`lightsim2grid.solver.NICSLUDCSolver`")
+        .value("DenseLU", SolverType::DenseLU, "denotes the :class:`lightsim2grid.solver.DenseLUSolver`")
+        .value("DenseLUSingleSlack", SolverType::DenseLUSingleSlack, "denotes the :class:`lightsim2grid.solver.DenseLUSolverSingleSlack`")
+        .value("DenseLUDC", SolverType::DenseLUDC, "denotes the :class:`lightsim2grid.solver.DenseLUDCSolver`")
+        .value("BiCGSTAB", SolverType::BiCGSTAB, "denotes the :class:`lightsim2grid.solver.BiCGSTABSolver`")
+        .value("BiCGSTABSingleSlack", SolverType::BiCGSTABSingleSlack, "denotes the :class:`lightsim2grid.solver.BiCGSTABSolverSingleSlack`")
+        .value("BiCGSTABDC", SolverType::BiCGSTABDC, "denotes the :class:`lightsim2grid.solver.BiCGSTABDCSolver`")
+        .value("LDLTDC", SolverType::LDLTDC, "denotes the :class:`lightsim2grid.solver.LDLTDCSolver`")
+        .value("GaussSeidelColored", SolverType::GaussSeidelColored, "denotes the :class:`lightsim2grid.solver.GaussSeidelColoredSolver`")
         .export_values();
 
+    py::enum_<ResultType>(m, "ResultType", "This enum controls the results computed after a powerflow (see :func:`lightsim2grid.gridmodel.GridModel.set_result_mask`). The values can be combined with `|`.", py::arithmetic())
+        .value("Lines", ResultType::ResLines, "flows, voltages and angles at both ends of the powerlines")
+        .value("Trafos", ResultType::ResTrafos, "flows, voltages and angles at both ends of the transformers")
+        .value("Loads", ResultType::ResLoads, "active, reactive values, voltages and angles of the loads")
+        .value("SGens", ResultType::ResSGens, "active, reactive values, voltages and angles of the static generators")
+        .value("Storages", ResultType::ResStorages, "active, reactive values, voltages and angles of the storage units")
+        .value("Shunts", ResultType::ResShunts, "active, reactive values, voltages and angles of the shunts")
+        .value("Gens", ResultType::ResGens, "active (slack included), reactive values, voltages and angles of the generators")
+        .value("All", ResultType::ResAll, "all the results (default)");
+
+    py::enum_<TerminalType>(m, "TerminalType", "This enum gives the type of the elements connected to the nodes of a substation (see :func:`lightsim2grid.gridmodel.GridModel.set_node_breaker_terminals`) or modified in bulk (see :func:`lightsim2grid.gridmodel.GridModel.set_values`)")
+        .value("Load", TerminalType::Load, "the loads")
+        .value("Gen", TerminalType::Gen, "the generators")
+        .value("SGen", TerminalType::SGen, "the static generators")
+        .value("Storage", TerminalType::Storage, "the storage units")
+        .value("Shunt", TerminalType::Shunt, "the shunts")
+        .value("LineOr", TerminalType::LineOr, "the origin side of the powerlines")
+        .value("LineEx", TerminalType::LineEx, "the extremity side of the powerlines")
+        .value("TrafoHv", TerminalType::TrafoHv, "the high voltage side of the transformers")
+        .value("TrafoLv", TerminalType::TrafoLv, "the low voltage side of the transformers");
+
+    py::enum_<ElementAttribute>(m, "ElementAttribute", "This enum gives the attribute of the elements modified in bulk (see :func:`lightsim2grid.gridmodel.GridModel.set_values`)")
+        .value("P", ElementAttribute::P, "the active setpoint (MW)")
+        .value("Q", ElementAttribute::Q, "the reactive setpoint (MVAr)")
+        .value("V", ElementAttribute::V, "the voltage setpoint of the generators (pu)")
+        .value("Bus", ElementAttribute::Bus, "the bus (for a branch, the bus of the side given by the type of element)")
+        .value("Status", ElementAttribute::Status, "the status (0. for disconnected, any other value for connected)");
+
     py::enum_<ErrorType>(m, "ErrorType", "This enum controls the error encountered in the solver")
         .value("NoError", ErrorType::NoError, "No error were encountered")
         .value("SingularMatrix", ErrorType::SingularMatrix, "The Jacobian matrix was singular and could not be factorized (most likely, the grid is not connex)")
@@ -92,6 +138,123 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_timers", &DCSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
         .def("solve", &DCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
 
+    py::class_<DenseLUSolver>(m, "DenseLUSolver", DocSolver::DenseLUSolver.c_str())
+        .def(py::init<>())
+        .def("get_J", &DenseLUSolver::get_J_python, DocSolver::get_J_python.c_str())  // (get the jacobian matrix, sparse csc matrix)
+        .def("get_Va", &DenseLUSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &DenseLUSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &DenseLUSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &DenseLUSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &DenseLUSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &DenseLUSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &DenseLUSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &DenseLUSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // perform the newton raphson optimization
+        .def("get_timers", &DenseLUSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &DenseLUSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+    
+    py::class_<DenseLUSolverSingleSlack>(m, "DenseLUSolverSingleSlack", DocSolver::DenseLUSolverSingleSlack.c_str())
+        .def(py::init<>())
+        .def("get_J", &DenseLUSolverSingleSlack::get_J_python, DocSolver::get_J_python.c_str())  // (get the jacobian matrix, sparse csc matrix)
+        .def("get_Va", &DenseLUSolverSingleSlack::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &DenseLUSolverSingleSlack::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &DenseLUSolverSingleSlack::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &DenseLUSolverSingleSlack::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &DenseLUSolverSingleSlack::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &DenseLUSolverSingleSlack::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &DenseLUSolverSingleSlack::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &DenseLUSolverSingleSlack::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // perform the newton raphson optimization
+        .def("get_timers", &DenseLUSolverSingleSlack::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &DenseLUSolverSingleSlack::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
+    py::class_<DenseLUDCSolver>(m, "DenseLUDCSolver", DocSolver::DenseLUDCSolver.c_str())
+        .def(py::init<>())
+        .def("get_Va", &DenseLUDCSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &DenseLUDCSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &DenseLUDCSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &DenseLUDCSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &DenseLUDCSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &DenseLUDCSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &DenseLUDCSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &DenseLUDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // compute the powerflow
+        .def("get_timers", &DenseLUDCSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &DenseLUDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
+    py::class_<BiCGSTABSolver>(m, "BiCGSTABSolver", DocSolver::BiCGSTABSolver.c_str())
+        .def(py::init<>())
+        .def("set_parameters", [](BiCGSTABSolver & solver, real_type drop_tol, int fill_factor, int max_iter, real_type rebuild_factor){solver.get_linear_solver().set_parameters(drop_tol, fill_factor, max_iter, rebuild_factor);},
+             py::arg("drop_tol"), py::arg("fill_factor"), py::arg("max_iter"), py::arg("rebuild_factor"), DocSolver::set_parameters_bicgstab.c_str())
+        .def("get_parameters", [](const BiCGSTABSolver & solver){return solver.get_linear_solver().get_parameters();}, DocSolver::get_parameters_bicgstab.c_str())
+        .def("set_tolerance_coupling", [](BiCGSTABSolver & solver, real_type eta_max, real_type forcing, real_type safety, real_type exact_tol){solver.get_linear_solver().set_tolerance_coupling(eta_max, forcing, safety, exact_tol);},
+             py::arg("eta_max"), py::arg("forcing"), py::arg("safety"), py::arg("exact_tol"), DocSolver::set_tolerance_coupling.c_str())
+        .def("get_tolerance_coupling", [](const BiCGSTABSolver & solver){return solver.get_linear_solver().get_tolerance_coupling();}, DocSolver::get_tolerance_coupling.c_str())
+        .def("get_krylov_stats", [](const BiCGSTABSolver & solver){return solver.get_linear_solver().get_stats();}, DocSolver::get_krylov_stats.c_str())
+        .def("get_J", &BiCGSTABSolver::get_J_python, DocSolver::get_J_python.c_str())  // (get the jacobian matrix, sparse csc matrix)
+        .def("get_Va", &BiCGSTABSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &BiCGSTABSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &BiCGSTABSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &BiCGSTABSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &BiCGSTABSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &BiCGSTABSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &BiCGSTABSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &BiCGSTABSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // perform the newton raphson optimization
+        .def("get_timers", &BiCGSTABSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &BiCGSTABSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+    
+    py::class_<BiCGSTABSolverSingleSlack>(m, "BiCGSTABSolverSingleSlack", DocSolver::BiCGSTABSolverSingleSlack.c_str())
+        .def(py::init<>())
+        .def("set_parameters", [](BiCGSTABSolverSingleSlack & solver, real_type drop_tol, int fill_factor, int max_iter, real_type rebuild_factor){solver.get_linear_solver().set_parameters(drop_tol, fill_factor, max_iter, rebuild_factor);},
+             py::arg("drop_tol"), py::arg("fill_factor"), py::arg("max_iter"), py::arg("rebuild_factor"), DocSolver::set_parameters_bicgstab.c_str())
+        .def("get_parameters", [](const BiCGSTABSolverSingleSlack & solver){return solver.get_linear_solver().get_parameters();}, DocSolver::get_parameters_bicgstab.c_str())
+        .def("set_tolerance_coupling", [](BiCGSTABSolverSingleSlack & solver, real_type eta_max, real_type forcing, real_type safety, real_type exact_tol){solver.get_linear_solver().set_tolerance_coupling(eta_max, forcing, safety, exact_tol);},
+             py::arg("eta_max"), py::arg("forcing"), py::arg("safety"), py::arg("exact_tol"), DocSolver::set_tolerance_coupling.c_str())
+        .def("get_tolerance_coupling", [](const BiCGSTABSolverSingleSlack & solver){return solver.get_linear_solver().get_tolerance_coupling();}, DocSolver::get_tolerance_coupling.c_str())
+        .def("get_krylov_stats", [](const BiCGSTABSolverSingleSlack & solver){return solver.get_linear_solver().get_stats();}, DocSolver::get_krylov_stats.c_str())
+        .def("get_J", &BiCGSTABSolverSingleSlack::get_J_python, DocSolver::get_J_python.c_str())  // (get the jacobian matrix, sparse csc matrix)
+        .def("get_Va", &BiCGSTABSolverSingleSlack::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &BiCGSTABSolverSingleSlack::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &BiCGSTABSolverSingleSlack::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &BiCGSTABSolverSingleSlack::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &BiCGSTABSolverSingleSlack::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &BiCGSTABSolverSingleSlack::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &BiCGSTABSolverSingleSlack::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &BiCGSTABSolverSingleSlack::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // perform the newton raphson optimization
+        .def("get_timers", &BiCGSTABSolverSingleSlack::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &BiCGSTABSolverSingleSlack::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
+    py::class_<BiCGSTABDCSolver>(m, "BiCGSTABDCSolver", DocSolver::BiCGSTABDCSolver.c_str())
+        .def(py::init<>())
+        .def("set_parameters", [](BiCGSTABDCSolver & solver, real_type drop_tol, int fill_factor, int max_iter, real_type rebuild_factor){solver.get_linear_solver().set_parameters(drop_tol, fill_factor, max_iter, rebuild_factor);},
+             py::arg("drop_tol"), py::arg("fill_factor"), py::arg("max_iter"), py::arg("rebuild_factor"), DocSolver::set_parameters_bicgstab.c_str())
+        .def("get_parameters", [](const BiCGSTABDCSolver & solver){return solver.get_linear_solver().get_parameters();}, DocSolver::get_parameters_bicgstab.c_str())
+        .def("set_tolerance_coupling", [](BiCGSTABDCSolver & solver, real_type eta_max, real_type forcing, real_type safety, real_type exact_tol){solver.get_linear_solver().set_tolerance_coupling(eta_max, forcing, safety, exact_tol);},
+             py::arg("eta_max"), py::arg("forcing"), py::arg("safety"), py::arg("exact_tol"), DocSolver::set_tolerance_coupling.c_str())
+        .def("get_tolerance_coupling", [](const BiCGSTABDCSolver & solver){return solver.get_linear_solver().get_tolerance_coupling();}, DocSolver::get_tolerance_coupling.c_str())
+        .def("get_krylov_stats", [](const BiCGSTABDCSolver & solver){return solver.get_linear_solver().get_stats();}, DocSolver::get_krylov_stats.c_str())
+        .def("get_Va", &BiCGSTABDCSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &BiCGSTABDCSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &BiCGSTABDCSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &BiCGSTABDCSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &BiCGSTABDCSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &BiCGSTABDCSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &BiCGSTABDCSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &BiCGSTABDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // compute the powerflow
+        .def("get_timers", &BiCGSTABDCSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &BiCGSTABDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
+    py::class_<LDLTDCSolver>(m, "LDLTDCSolver", DocSolver::LDLTDCSolver.c_str())
+        .def(py::init<>())
+        .def("use_ldlt", [](const LDLTDCSolver & solver){return solver.get_linear_solver().use_ldlt();}, DocSolver::use_ldlt.c_str())
+        .def("get_Va", &LDLTDCSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &LDLTDCSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &LDLTDCSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &LDLTDCSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &LDLTDCSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &LDLTDCSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &LDLTDCSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &LDLTDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // compute the powerflow
+        .def("get_timers", &LDLTDCSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &LDLTDCSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
     #if defined(KLU_SOLVER_AVAILABLE) || defined(_READ_THE_DOCS)
         py::class_<KLUSolver>(m, "KLUSolver", DocSolver::KLUSolver.c_str())
             .def(py::init<>())
@@ -204,8 +367,45 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_timers", &GaussSeidelSynchSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
         .def("solve", &GaussSeidelSynchSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
 
+    py::class_<GaussSeidelColoredSolver>(m, "GaussSeidelColoredSolver", DocSolver::GaussSeidelColoredSolver.c_str())
+        .def(py::init<>())
+        .def("set_nb_thread", &GaussSeidelColoredSolver::set_nb_thread, DocSolver::set_nb_thread_gs.c_str())
+        .def("get_nb_thread", &GaussSeidelColoredSolver::get_nb_thread, DocSolver::get_nb_thread_gs.c_str())
+        .def("set_sor", &GaussSeidelColoredSolver::set_sor, py::arg("omega"), py::arg("adaptive"), DocSolver::set_sor.c_str())
+        .def("get_sor", &GaussSeidelColoredSolver::get_sor, DocSolver::get_sor.c_str())
+        .def("get_omega", &GaussSeidelColoredSolver::get_omega, DocSolver::get_omega.c_str())
+        .def("get_nb_color", &GaussSeidelColoredSolver::get_nb_color, DocSolver::get_nb_color.c_str())
+        .def("get_Va", &GaussSeidelColoredSolver::get_Va, DocSolver::get_Va.c_str())  // get the voltage angle vector (vector of double)
+        .def("get_Vm", &GaussSeidelColoredSolver::get_Vm, DocSolver::get_Vm.c_str())  // get the voltage magnitude vector (vector of double)
+        .def("get_V", &GaussSeidelColoredSolver::get_V, DocSolver::get_V.c_str()) 
+        .def("get_error", &GaussSeidelColoredSolver::get_error, DocSolver::get_error.c_str())  // get the error message, see the definition of "err_" for more information
+        .def("get_nb_iter", &GaussSeidelColoredSolver::get_nb_iter, DocSolver::get_nb_iter.c_str())  // return the number of iteration performed at the last optimization
+        .def("reset", &GaussSeidelColoredSolver::reset, DocSolver::reset.c_str())  // reset the solver to its original state
+        .def("converged", &GaussSeidelColoredSolver::converged, DocSolver::converged.c_str())  // whether the solver has converged
+        .def("compute_pf", &GaussSeidelColoredSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str())  // compute the powerflow
+        .def("get_timers", &GaussSeidelColoredSolver::get_timers, DocSolver::get_timers.c_str())  // returns the timers corresponding to times the solver spent in different part
+        .def("solve", &GaussSeidelColoredSolver::compute_pf, py::call_guard<py::gil_scoped_release>(), DocSolver::compute_pf.c_str());  // perform the newton raphson optimization
+
     // Only "const" method are exported
     // it is so that i cannot modify the internal solver of a gridmodel python side
+    py::class_<KLUSolverConfig>(m, "KLUSolverConfig", DocSolver::KLUSolverConfig.c_str())
+        .def(py::init<>())
+        .def_readwrite("ordering", &KLUSolverConfig::ordering, "fill reducing ordering: 0 AMD (default), 1 COLAMD")
+        .def_readwrite("btf", &KLUSolverConfig::btf, "whether to use the block triangular form (default True)")
+        .def_readwrite("scale", &KLUSolverConfig::scale, "row scaling: -1 none (and no check of the matrix), 0 none, 1 sum, 2 max (default)")
+        .def_readwrite("tol", &KLUSolverConfig::tol, "partial pivoting tolerance (default 0.001)")
+        .def_readwrite("check_refactor", &KLUSolverConfig::check_refactor, "whether to check the quality of each refactorization (default True)")
+        .def_readwrite("rcond_ratio", &KLUSolverConfig::rcond_ratio, "a full factorization is performed if rcond after a refactorization is lower than `rcond_ratio` times rcond after the last full factorization (default 1e-3)");
+
+    py::class_<KLUSolverStats>(m, "KLUSolverStats", DocSolver::KLUSolverStats.c_str())
+        .def_readonly("lnz", &KLUSolverStats::lnz, "number of non zeros in L (including the diagonal), for the last factorization")
+        .def_readonly("unz", &KLUSolverStats::unz, "number of non zeros in U (including the diagonal), for the last factorization")
+        .def_readonly("flops", &KLUSolverStats::flops, "number of floating point operations of the last full factorization")
+        .def_readonly("rcond", &KLUSolverStats::rcond, "cheap estimate of the reciprocal of the condition number, for the last factorization")
+        .def_readonly("nb_factor", &KLUSolverStats::nb_factor, "number of full factorizations (including the fallbacks)")
+        .def_readonly("nb_refactor", &KLUSolverStats::nb_refactor, "number of refactorizations")
+        .def_readonly("nb_fallback", &KLUSolverStats::nb_fallback, "number of refactorizations replaced by a full factorization");
+
     py::class_<ChooseSolver>(m, "AnySolver", DocSolver::AnySolver.c_str())
         .def(py::init<>())
         .def("get_type", &ChooseSolver::get_type, DocSolver::get_type.c_str())
@@ -220,6 +420,10 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_error", &ChooseSolver::get_error, DocSolver::get_V.c_str()) 
         .def("get_nb_iter", &ChooseSolver::get_nb_iter, DocSolver::get_nb_iter.c_str()) 
         .def("converged", &ChooseSolver::converged, DocSolver::converged.c_str()) 
+        .def("solve_many", &ChooseSolver::solve_many_python, py::arg("B"), py::arg("nb_thread") = 1, py::call_guard<py::gil_scoped_release>(), DocSolver::solve_many.c_str())
+        .def("get_klu_config", &ChooseSolver::get_klu_config, DocSolver::get_klu_config.c_str())
+        .def("get_klu_stats", &ChooseSolver::get_klu_stats, DocSolver::get_klu_stats.c_str())
+        .def("get_gauss_seidel_colored_config", &ChooseSolver::get_gauss_seidel_colored_config, DocSolver::get_gauss_seidel_colored_config.c_str())
         .def("get_computation_time", &ChooseSolver::get_computation_time, DocSolver::get_computation_time.c_str());
 
     // iterator for generators
@@ -228,7 +432,21 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataGen & data, int k){return data[k]; } )
         .def("__iter__", [](const DataGen & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataGen & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_id", [](const DataGen & data) -> Eigen::Ref<const Eigen::VectorXi> {return data.get_bus_id();}, DocIterator::bus_id.c_str())
+        .def_property_readonly("is_slack", [](const DataGen & data){return bool_column(data.get_is_slack());}, DocIterator::is_slack.c_str())
+        .def_property_readonly("slack_weight", [](const DataGen & data){return data.get_slack_weight();}, DocIterator::slack_weight.c_str())
+        .def_property_readonly("target_p_mw", [](const DataGen & data){return data.get_p_mw();}, DocIterator::target_p_mw.c_str())
+        .def_property_readonly("target_vm_pu", [](const DataGen & data){return data.get_vm_pu();}, DocIterator::target_vm_pu.c_str())
+        .def_property_readonly("min_q_mvar", [](const DataGen & data){return data.get_min_q();}, DocIterator::min_q_mvar.c_str())
+        .def_property_readonly("max_q_mvar", [](const DataGen & data){return data.get_max_q();}, DocIterator::max_q_mvar.c_str())
+        .def_property_readonly("res_p_mw", [](const DataGen & data){return data.get_res_p();}, DocIterator::res_p_mw.c_str())
+        .def_property_readonly("res_q_mvar", [](const DataGen & data){return data.get_res_q();}, DocIterator::res_q_mvar.c_str())
+        .def_property_readonly("res_v_kv", [](const DataGen & data){return data.get_res_v();}, DocIterator::res_v_kv.c_str())
+        .def_property_readonly("res_theta_deg", [](const DataGen & data){return data.get_theta();}, DocIterator::res_theta_deg.c_str());
 
     py::class_<DataGen::GenInfo>(m, "GenInfo", DocIterator::GenInfo.c_str())
         .def_readonly("id", &DataGen::GenInfo::id, DocIterator::id.c_str())
@@ -252,7 +470,21 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataSGen & data, int k){return data[k]; } )
         .def("__iter__", [](const DataSGen & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataSGen & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_id", [](const DataSGen & data) -> Eigen::Ref<const Eigen::VectorXi> {return data.get_bus_id();}, DocIterator::bus_id.c_str())
+        .def_property_readonly("min_q_mvar", [](const DataSGen & data){return data.get_min_q();}, DocIterator::min_q_mvar.c_str())
+        .def_property_readonly("max_q_mvar", [](const DataSGen & data){return data.get_max_q();}, DocIterator::max_q_mvar.c_str())
+        .def_property_readonly("min_p_mw", [](const DataSGen & data){return data.get_min_p();}, DocIterator::min_p_mw.c_str())
+        .def_property_readonly("max_p_mw", [](const DataSGen & data){return data.get_max_p();}, DocIterator::max_p_mw.c_str())
+        .def_property_readonly("target_p_mw", [](const DataSGen & data){return data.get_p_mw();}, DocIterator::target_p_mw.c_str())
+        .def_property_readonly("target_q_mvar", [](const DataSGen & data){return data.get_q_mvar();}, DocIterator::target_q_mvar.c_str())
+        .def_property_readonly("res_p_mw", [](const DataSGen & data){return data.get_res_p();}, DocIterator::res_p_mw.c_str())
+        .def_property_readonly("res_q_mvar", [](const DataSGen & data){return data.get_res_q();}, DocIterator::res_q_mvar.c_str())
+        .def_property_readonly("res_v_kv", [](const DataSGen & data){return data.get_res_v();}, DocIterator::res_v_kv.c_str())
+        .def_property_readonly("res_theta_deg", [](const DataSGen & data){return data.get_theta();}, DocIterator::res_theta_deg.c_str());
 
     py::class_<DataSGen::SGenInfo>(m, "SGenInfo", DocIterator::SGenInfo.c_str())
         .def_readonly("id", &DataSGen::SGenInfo::id, DocIterator::id.c_str())
@@ -276,7 +508,17 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataLoad & data, int k){return data[k]; } )
         .def("__iter__", [](const DataLoad & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataLoad & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_id", [](const DataLoad & data) -> Eigen::Ref<const Eigen::VectorXi> {return data.get_bus_id();}, DocIterator::bus_id.c_str())
+        .def_property_readonly("target_p_mw", [](const DataLoad & data){return data.get_p_mw();}, DocIterator::target_p_mw.c_str())
+        .def_property_readonly("target_q_mvar", [](const DataLoad & data){return data.get_q_mvar();}, DocIterator::target_q_mvar.c_str())
+        .def_property_readonly("res_p_mw", [](const DataLoad & data){return data.get_res_p();}, DocIterator::res_p_mw.c_str())
+        .def_property_readonly("res_q_mvar", [](const DataLoad & data){return data.get_res_q();}, DocIterator::res_q_mvar.c_str())
+        .def_property_readonly("res_v_kv", [](const DataLoad & data){return data.get_res_v();}, DocIterator::res_v_kv.c_str())
+        .def_property_readonly("res_theta_deg", [](const DataLoad & data){return data.get_theta();}, DocIterator::res_theta_deg.c_str());
 
     py::class_<DataLoad::LoadInfo>(m, "LoadInfo", DocIterator::LoadInfo.c_str())
         .def_readonly("id", &DataLoad::LoadInfo::id, DocIterator::id.c_str())
@@ -296,7 +538,17 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataShunt & data, int k){return data[k]; } )
         .def("__iter__", [](const DataShunt & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataShunt & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_id", [](const DataShunt & data) -> Eigen::Ref<const Eigen::VectorXi> {return data.get_bus_id();}, DocIterator::bus_id.c_str())
+        .def_property_readonly("target_p_mw", [](const DataShunt & data){return data.get_p_mw();}, DocIterator::target_p_mw.c_str())
+        .def_property_readonly("target_q_mvar", [](const DataShunt & data){return data.get_q_mvar();}, DocIterator::target_q_mvar.c_str())
+        .def_property_readonly("res_p_mw", [](const DataShunt & data){return data.get_res_p();}, DocIterator::res_p_mw.c_str())
+        .def_property_readonly("res_q_mvar", [](const DataShunt & data){return data.get_res_q();}, DocIterator::res_q_mvar.c_str())
+        .def_property_readonly("res_v_kv", [](const DataShunt & data){return data.get_res_v();}, DocIterator::res_v_kv.c_str())
+        .def_property_readonly("res_theta_deg", [](const DataShunt & data){return data.get_theta();}, DocIterator::res_theta_deg.c_str());
 
     py::class_<DataShunt::ShuntInfo>(m, "ShuntInfo", DocIterator::ShuntInfo.c_str())
         .def_readonly("id", &DataShunt::ShuntInfo::id, DocIterator::id.c_str())
@@ -316,7 +568,28 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataTrafo & data, int k){return data[k]; } )
         .def("__iter__", [](const DataTrafo & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataTrafo & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_hv_id", [](const DataTrafo & data){return data.get_bus_from();}, DocIterator::bus_hv_id.c_str())
+        .def_property_readonly("bus_lv_id", [](const DataTrafo & data){return data.get_bus_to();}, DocIterator::bus_lv_id.c_str())
+        .def_property_readonly("r_pu", [](const DataTrafo & data){return data.get_r();}, DocIterator::r_pu.c_str())
+        .def_property_readonly("x_pu", [](const DataTrafo & data){return data.get_x();}, DocIterator::x_pu.c_str())
+        .def_property_readonly("h_pu", [](const DataTrafo & data){return data.get_h();}, DocIterator::h_pu.c_str())
+        .def_property_readonly("is_tap_hv_side", [](const DataTrafo & data){return bool_column(data.get_is_tap_hv_side());}, DocIterator::is_tap_hv_side.c_str())
+        .def_property_readonly("ratio", [](const DataTrafo & data){return data.get_ratio();}, DocIterator::ratio.c_str())
+        .def_property_readonly("shift_rad", [](const DataTrafo & data){return data.get_shift();}, DocIterator::shift_rad.c_str())
+        .def_property_readonly("res_p_hv_mw", [](const DataTrafo & data){return data.get_res_p_hv();}, DocIterator::res_p_hv_mw.c_str())
+        .def_property_readonly("res_q_hv_mvar", [](const DataTrafo & data){return data.get_res_q_hv();}, DocIterator::res_q_hv_mvar.c_str())
+        .def_property_readonly("res_v_hv_kv", [](const DataTrafo & data){return data.get_res_v_hv();}, DocIterator::res_v_hv_kv.c_str())
+        .def_property_readonly("res_a_hv_ka", [](const DataTrafo & data){return data.get_res_a_hv();}, DocIterator::res_a_hv_ka.c_str())
+        .def_property_readonly("res_p_lv_mw", [](const DataTrafo & data){return data.get_res_p_lv();}, DocIterator::res_p_lv_mw.c_str())
+        .def_property_readonly("res_q_lv_mvar", [](const DataTrafo & data){return data.get_res_q_lv();}, DocIterator::res_q_lv_mvar.c_str())
+        .def_property_readonly("res_v_lv_kv", [](const DataTrafo & data){return data.get_res_v_lv();}, DocIterator::res_v_lv_kv.c_str())
+        .def_property_readonly("res_a_lv_ka", [](const DataTrafo & data){return data.get_res_a_lv();}, DocIterator::res_a_lv_ka.c_str())
+        .def_property_readonly("res_theta_hv_deg", [](const DataTrafo & data){return data.get_theta_hv();}, DocIterator::res_theta_hv_deg.c_str())
+        .def_property_readonly("res_theta_lv_deg", [](const DataTrafo & data){return data.get_theta_lv();}, DocIterator::res_theta_lv_deg.c_str());
 
     py::class_<DataTrafo::TrafoInfo>(m, "TrafoInfo", DocIterator::TrafoInfo.c_str())
         .def_readonly("id", &DataTrafo::TrafoInfo::id, DocIterator::id.c_str())
@@ -347,7 +620,25 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("__getitem__", [](const DataLine & data, int k){return data[k]; } )
         .def("__iter__", [](const DataLine & data) {
        return py::make_iterator(data.begin(), data.end());
-    }, py::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
+    }, py::keep_alive<0, 1>()) /* Keep vector alive while iterator is used */
+
+        // columns of the table: read only numpy arrays viewing the memory of the grid model (valid until it is modified)
+        .def_property_readonly("connected", [](const DataLine & data){return bool_column(data.get_status());}, DocIterator::connected.c_str())
+        .def_property_readonly("bus_or_id", [](const DataLine & data){return data.get_bus_from();}, DocIterator::bus_or_id.c_str())
+        .def_property_readonly("bus_ex_id", [](const DataLine & data){return data.get_bus_to();}, DocIterator::bus_ex_id.c_str())
+        .def_property_readonly("r_pu", [](const DataLine & data){return data.get_r();}, DocIterator::r_pu.c_str())
+        .def_property_readonly("x_pu", [](const DataLine & data){return data.get_x();}, DocIterator::x_pu.c_str())
+        .def_property_readonly("h_pu", [](const DataLine & data){return data.get_h();}, DocIterator::h_pu.c_str())
+        .def_property_readonly("res_p_or_mw", [](const DataLine & data){return data.get_res_p_or();}, DocIterator::res_p_or_mw.c_str())
+        .def_property_readonly("res_q_or_mvar", [](const DataLine & data){return data.get_res_q_or();}, DocIterator::res_q_or_mvar.c_str())
+        .def_property_readonly("res_v_or_kv", [](const DataLine & data){return data.get_res_v_or();}, DocIterator::res_v_or_kv.c_str())
+        .def_property_readonly("res_a_or_ka", [](const DataLine & data){return data.get_res_a_or();}, DocIterator::res_a_or_ka.c_str())
+        .def_property_readonly("res_p_ex_mw", [](const DataLine & data){return data.get_res_p_ex();}, DocIterator::res_p_ex_mw.c_str())
+        .def_property_readonly("res_q_ex_mvar", [](const DataLine & data){return data.get_res_q_ex();}, DocIterator::res_q_ex_mvar.c_str())
+        .def_property_readonly("res_v_ex_kv", [](const DataLine & data){return data.get_res_v_ex();}, DocIterator::res_v_ex_kv.c_str())
+        .def_property_readonly("res_a_ex_ka", [](const DataLine & data){return data.get_res_a_ex();}, DocIterator::res_a_ex_ka.c_str())
+        .def_property_readonly("res_theta_or_deg", [](const DataLine & data){return data.get_theta_or();}, DocIterator::res_theta_or_deg.c_str())
+        .def_property_readonly("res_theta_ex_deg", [](const DataLine & data){return data.get_theta_ex();}, DocIterator::res_theta_ex_deg.c_str());
 
     py::class_<DataLine::LineInfo>(m, "LineInfo", DocIterator::LineInfo.c_str())
         .def_readonly("id", &DataLine::LineInfo::id, DocIterator::id.c_str())
@@ -377,15 +668,29 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_line_param", &PandaPowerConverter::get_line_param)
         .def("get_trafo_param", &PandaPowerConverter::get_trafo_param);
 
+    py::class_<GridModel::WardIds>(m, "WardIds", DocGridModel::ward_equivalent.c_str())
+        .def_readonly("nb_bus_full", &GridModel::WardIds::nb_bus_full, "number of buses of the full grid")
+        .def_readonly("bus", &GridModel::WardIds::bus, "id, in the full grid, of each bus of the Ward equivalent")
+        .def_readonly("line", &GridModel::WardIds::line, "id, in the full grid, of each powerline of the Ward equivalent (-1 for the equivalent branches)")
+        .def_readonly("trafo", &GridModel::WardIds::trafo, "id, in the full grid, of each transformer of the Ward equivalent")
+        .def_readonly("shunt", &GridModel::WardIds::shunt, "id, in the full grid, of each shunt of the Ward equivalent (-1 for the equivalent shunts)")
+        .def_readonly("gen", &GridModel::WardIds::gen, "id, in the full grid, of each generator of the Ward equivalent (-1 for the equivalent injections)")
+        .def_readonly("load", &GridModel::WardIds::load, "id, in the full grid, of each load of the Ward equivalent (-1 for the equivalent injections)")
+        .def_readonly("sgen", &GridModel::WardIds::sgen, "id, in the full grid, of each static generator of the Ward equivalent")
+        .def_readonly("storage", &GridModel::WardIds::storage, "id, in the full grid, of each storage unit of the Ward equivalent");
+
     py::class_<GridModel>(m, "GridModel", DocGridModel::GridModel.c_str())
         .def(py::init<>())
-        .def("copy", &GridModel::copy)
+        .def("copy", [](const GridModel & self, bool keep_solver_state){
+                // returned as a pointer, otherwise pybind would copy it again (and the solver state would be lost)
+                return new GridModel(self, keep_solver_state);
+            }, py::arg("keep_solver_state") = false, DocGridModel::copy.c_str())
 
         // pickle
         .def(py::pickle(
                         [](const GridModel &gm) { // __getstate__
-                            // Return a tuple that fully encodes the state of the object
-                            return py::make_tuple(gm.get_state());
+                            // Return a tuple that fully encodes the state of the object (compact binary representation)
+                            return py::make_tuple(py::bytes(gm.to_bytes()));
                         },
                         [](py::tuple py_state) { // __setstate__
                             if (py_state.size() != 1){
@@ -397,10 +702,32 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
                             // TODO check the size of the input tuple!
 
                             // now set the status
-                            GridModel::StateRes state = py_state[0].cast<GridModel::StateRes>();
-                            gm.set_state(state);
+                            if(py::isinstance<py::bytes>(py_state[0])){
+                                gm.from_bytes(py_state[0].cast<std::string>());
+                            }else{
+                                // grid pickled with a previous version of lightsim2grid (tuple based state)
+                                GridModel::StateRes state = py_state[0].cast<GridModel::StateRes>();
+                                gm.set_state(state);
+                            }
                             return gm;
         }))
+        // binary serialization
+        .def("to_bytes", [](const GridModel & self){return py::bytes(self.to_bytes());}, DocGridModel::to_bytes.c_str())
+        .def_static("from_bytes", [](py::bytes data){
+                std::unique_ptr<GridModel> res(new GridModel());  // not leaked if the data are not valid
+                res->from_bytes(data.cast<std::string>());
+                return res;
+            }, py::arg("data"), DocGridModel::from_bytes.c_str())
+        .def("save", &GridModel::save, py::arg("path"), DocGridModel::save.c_str())
+        .def_static("load", [](const std::string & path){
+                std::unique_ptr<GridModel> res(new GridModel());
+                res->load(path);
+                return res;
+            }, py::arg("path"), DocGridModel::load.c_str())
+        .def("snapshot", &GridModel::snapshot, DocGridModel::snapshot.c_str())
+        .def("restore", &GridModel::restore, py::arg("snapshot_id"), DocGridModel::restore.c_str())
+        .def("has_snapshot", &GridModel::has_snapshot, py::arg("snapshot_id"), DocGridModel::has_snapshot.c_str())
+        .def("clear_snapshots", &GridModel::clear_snapshots, DocGridModel::clear_snapshots.c_str())
 
         // general parameters
         // solver control
@@ -408,10 +735,24 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("available_solvers", &GridModel::available_solvers, DocGridModel::available_solvers.c_str())  // retrieve the solver available for your installation
         .def("get_computation_time", &GridModel::get_computation_time, DocGridModel::get_computation_time.c_str())  // get the computation time spent in the solver
         .def("get_dc_computation_time", &GridModel::get_dc_computation_time, DocGridModel::get_dc_computation_time.c_str())  // get the computation time spent in the solver
+        .def("get_error", &GridModel::get_error, DocGridModel::get_error.c_str())  // get the error of the last ac powerflow
+        .def("get_dc_error", &GridModel::get_dc_error, DocGridModel::get_dc_error.c_str())  // get the error of the last dc powerflow
         .def("get_solver_type", &GridModel::get_solver_type, DocGridModel::get_solver_type.c_str())  // get the type of solver used
         .def("get_dc_solver_type", &GridModel::get_dc_solver_type, DocGridModel::get_dc_solver_type.c_str())  // get the type of solver used
         .def("get_solver", &GridModel::get_solver, py::return_value_policy::reference, DocGridModel::get_solver.c_str())  // get the solver (AnySolver type python side) used
         .def("get_dc_solver", &GridModel::get_dc_solver, py::return_value_policy::reference, DocGridModel::get_dc_solver.c_str())  // get the solver (AnySolver type python side) used
+        .def("set_klu_config", &GridModel::set_klu_config, py::arg("config"), DocSolver::set_klu_config.c_str())
+        .def("get_klu_config", &GridModel::get_klu_config, DocSolver::get_klu_config.c_str())
+        .def("set_gauss_seidel_colored_config", &GridModel::set_gauss_seidel_colored_config, py::arg("nb_thread"), py::arg("omega"), py::arg("adaptive"), DocSolver::set_gauss_seidel_colored_config.c_str())
+        .def("get_gauss_seidel_colored_config", &GridModel::get_gauss_seidel_colored_config, DocSolver::get_gauss_seidel_colored_config.c_str())
+        .def("set_kron_reduction", &GridModel::set_kron_reduction, py::arg("kron_reduction"), DocGridModel::kron_reduction.c_str())
+        .def("get_kron_reduction", &GridModel::get_kron_reduction, DocGridModel::kron_reduction.c_str())
+        .def("nb_kron_eliminated", &GridModel::nb_kron_eliminated, DocGridModel::kron_reduction.c_str())
+        .def("ward_equivalent", &GridModel::ward_equivalent, py::arg("internal_buses"), py::arg("V_full"), py::arg("extended")=false, DocGridModel::ward_equivalent.c_str())
+        .def("refit_ward_injections", &GridModel::refit_ward_injections, py::arg("V_full"), DocGridModel::ward_equivalent.c_str())
+        .def("get_ward_boundary_buses", &GridModel::get_ward_boundary_buses, DocGridModel::ward_equivalent.c_str())
+        .def("get_ward_injections", &GridModel::get_ward_injections, DocGridModel::ward_equivalent.c_str())
+        .def("get_ward_ids", &GridModel::get_ward_ids, py::return_value_policy::reference_internal, DocGridModel::ward_equivalent.c_str())
 
         // init the grid
         .def("init_bus", &GridModel::init_bus, DocGridModel::_internal_do_not_use.c_str())
@@ -432,13 +773,13 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("remove_gen_slackbus", &GridModel::remove_gen_slackbus, DocGridModel::_internal_do_not_use.c_str())  // same
 
         // inspect the grid
-        .def("get_lines", &GridModel::get_lines, DocGridModel::get_lines.c_str())
-        .def("get_trafos", &GridModel::get_trafos, DocGridModel::get_trafos.c_str())
-        .def("get_generators", &GridModel::get_generators, DocGridModel::get_generators.c_str())
-        .def("get_static_generators", &GridModel::get_static_generators, DocGridModel::get_static_generators.c_str())
-        .def("get_shunts", &GridModel::get_shunts, DocGridModel::get_shunts.c_str())
-        .def("get_storages", &GridModel::get_storages, DocGridModel::get_storages.c_str())
-        .def("get_loads", &GridModel::get_loads, DocGridModel::get_loads.c_str())
+        .def("get_lines", &GridModel::get_lines, py::return_value_policy::reference_internal, DocGridModel::get_lines.c_str())
+        .def("get_trafos", &GridModel::get_trafos, py::return_value_policy::reference_internal, DocGridModel::get_trafos.c_str())
+        .def("get_generators", &GridModel::get_generators, py::return_value_policy::reference_internal, DocGridModel::get_generators.c_str())
+        .def("get_static_generators", &GridModel::get_static_generators, py::return_value_policy::reference_internal, DocGridModel::get_static_generators.c_str())
+        .def("get_shunts", &GridModel::get_shunts, py::return_value_policy::reference_internal, DocGridModel::get_shunts.c_str())
+        .def("get_storages", &GridModel::get_storages, py::return_value_policy::reference_internal, DocGridModel::get_storages.c_str())
+        .def("get_loads", &GridModel::get_loads, py::return_value_policy::reference_internal, DocGridModel::get_loads.c_str())
 
         // modify the grid
         .def("deactivate_bus", &GridModel::deactivate_bus, DocGridModel::_internal_do_not_use.c_str())
@@ -504,6 +845,20 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("id_dc_solver_to_me", &GridModel::id_dc_solver_to_me, DocGridModel::id_dc_solver_to_me.c_str())
         .def("total_bus", &GridModel::total_bus, DocGridModel::total_bus.c_str())
         .def("nb_bus", &GridModel::nb_bus, DocGridModel::nb_bus.c_str())
+        .def("nb_connected_components", &GridModel::nb_connected_components, DocGridModel::connectivity.c_str())
+        .def("get_bus_islands", &GridModel::get_bus_islands, DocGridModel::connectivity.c_str())
+        .def("get_bridges", &GridModel::get_bridges, DocGridModel::connectivity.c_str())
+        .def("get_articulation_points", &GridModel::get_articulation_points, DocGridModel::connectivity.c_str())
+        .def("is_islanding", &GridModel::is_islanding, py::arg("branch_ids"), DocGridModel::connectivity.c_str())
+        .def("init_node_breaker", &GridModel::init_node_breaker, py::arg("node_to_sub"), py::arg("sub_buses"), py::arg("switch_node_1"), py::arg("switch_node_2"), py::arg("switch_closed"), DocGridModel::node_breaker.c_str())
+        .def("set_node_breaker_terminals", &GridModel::set_node_breaker_terminals, py::arg("terminal_type"), py::arg("nodes"), DocGridModel::node_breaker.c_str())
+        .def("set_switch", &GridModel::set_switch, py::arg("switch_id"), py::arg("closed"), DocGridModel::node_breaker.c_str())
+        .def("set_switches", &GridModel::set_switches, py::arg("switch_ids"), py::arg("closed"), DocGridModel::node_breaker.c_str())
+        .def("update_switches", &GridModel::update_switches, py::arg("has_changed"), py::arg("new_values"), DocGridModel::node_breaker.c_str())
+        .def("get_switches", &GridModel::get_switches, DocGridModel::node_breaker.c_str())
+        .def("get_node_bus", &GridModel::get_node_bus, DocGridModel::node_breaker.c_str())
+        .def("set_values", &GridModel::set_values, py::call_guard<py::gil_scoped_release>(), py::arg("element_type"), py::arg("attribute"), py::arg("el_ids"), py::arg("values"), DocGridModel::set_values.c_str())
+        .def("set_values_mask", &GridModel::set_values_mask, py::call_guard<py::gil_scoped_release>(), py::arg("element_type"), py::arg("attribute"), py::arg("has_changed"), py::arg("new_values"), DocGridModel::set_values.c_str())
         .def("get_pv", &GridModel::get_pv, DocGridModel::get_pv.c_str())
         .def("get_pq", &GridModel::get_pq, DocGridModel::get_pq.c_str())
         .def("get_slack_ids", &GridModel::get_slack_ids, DocGridModel::get_slack_ids.c_str())
@@ -513,6 +868,7 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_Sbus", &GridModel::get_Sbus, DocGridModel::get_Sbus.c_str())
 
         .def("check_solution", &GridModel::check_solution, DocGridModel::check_solution.c_str())
+        .def("check_solutions", &GridModel::check_solutions, py::call_guard<py::gil_scoped_release>(), py::arg("Vs"), py::arg("check_q_limits"), DocGridModel::check_solutions.c_str())
 
         // TODO optimize that for speed, results are copied apparently
         .def("get_loads_res", &GridModel::get_loads_res, DocGridModel::_internal_do_not_use.c_str())
@@ -545,6 +901,9 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         // .def("init_Ybus", &DataModel::init_Ybus) // temporary
         .def("deactivate_result_computation", &GridModel::deactivate_result_computation, DocGridModel::deactivate_result_computation.c_str())
         .def("reactivate_result_computation", &GridModel::reactivate_result_computation, DocGridModel::reactivate_result_computation.c_str())
+        .def("set_result_mask", [](GridModel & self, ResultType result_mask){self.set_result_mask(result_mask);}, py::arg("result_mask"), DocGridModel::set_result_mask.c_str())
+        .def("set_result_mask", &GridModel::set_result_mask, py::arg("result_mask"), DocGridModel::set_result_mask.c_str())
+        .def("get_result_mask", &GridModel::get_result_mask, DocGridModel::set_result_mask.c_str())
         .def("dc_pf", &GridModel::dc_pf, DocGridModel::dc_pf.c_str())
         .def("ac_pf", &GridModel::ac_pf, DocGridModel::ac_pf.c_str())
         .def("unset_topo_changed", &GridModel::unset_topo_changed, DocGridModel::_internal_do_not_use.c_str())
@@ -560,6 +919,8 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("update_loads_q", &GridModel::update_loads_q, DocGridModel::_internal_do_not_use.c_str())
         .def("update_topo", &GridModel::update_topo, DocGridModel::_internal_do_not_use.c_str())
         .def("update_storages_p", &GridModel::update_storages_p, DocGridModel::_internal_do_not_use.c_str())
+        .def("update_shunts", &GridModel::update_shunts, DocGridModel::_internal_do_not_use.c_str())
+        .def("apply_action_packed", &GridModel::apply_action_packed, py::call_guard<py::gil_scoped_release>(), DocGridModel::apply_action_packed.c_str())
 
         // auxiliary functions
         .def("set_n_sub", &GridModel::set_n_sub, DocGridModel::_internal_do_not_use.c_str())
@@ -577,6 +938,25 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("set_trafo_hv_to_subid", &GridModel::set_trafo_hv_to_subid, DocGridModel::_internal_do_not_use.c_str())
         .def("set_trafo_lv_to_subid", &GridModel::set_trafo_lv_to_subid, DocGridModel::_internal_do_not_use.c_str())
         .def("set_storage_to_subid", &GridModel::set_storage_to_subid, DocGridModel::_internal_do_not_use.c_str())
+        .def("set_shunt_to_subid", &GridModel::set_shunt_to_subid, DocGridModel::_internal_do_not_use.c_str())
+        // the buffers (numpy arrays) are kept alive as long as the GridModel
+        .def("set_line_res_buffers", &GridModel::set_line_res_buffers,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), py::keep_alive<1, 5>(), py::keep_alive<1, 6>(),
+             py::keep_alive<1, 7>(), py::keep_alive<1, 8>(), py::keep_alive<1, 9>(), py::keep_alive<1, 10>(), py::keep_alive<1, 11>(),
+             DocGridModel::set_res_buffers.c_str())
+        .def("set_load_res_buffers", &GridModel::set_load_res_buffers,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), py::keep_alive<1, 5>(),
+             DocGridModel::set_res_buffers.c_str())
+        .def("set_gen_res_buffers", &GridModel::set_gen_res_buffers,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), py::keep_alive<1, 5>(),
+             DocGridModel::set_res_buffers.c_str())
+        .def("set_storage_res_buffers", &GridModel::set_storage_res_buffers,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), py::keep_alive<1, 5>(),
+             DocGridModel::set_res_buffers.c_str())
+        .def("set_shunt_res_buffers", &GridModel::set_shunt_res_buffers,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), py::keep_alive<1, 5>(),
+             DocGridModel::set_res_buffers.c_str())
+        .def("clear_res_buffers", &GridModel::clear_res_buffers, DocGridModel::set_res_buffers.c_str())
         ;
 
     py::class_<Computers>(m, "Computers", DocComputers::Computers.c_str())
@@ -598,7 +978,20 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_status", &Computers::get_status, DocComputers::get_status.c_str())
 
         // perform the computations
-        .def("compute_Vs", &Computers::compute_Vs, py::call_guard<py::gil_scoped_release>(), DocComputers::compute_Vs.c_str())
+        .def("compute_Vs", &Computers::compute_Vs,
+             py::arg("gen_p"), py::arg("sgen_p"), py::arg("load_p"), py::arg("load_q"),
+             py::arg("Vinit"), py::arg("max_iter"), py::arg("tol"),
+             py::arg("gen_v") = Computers::RealMat(), py::arg("sgen_q") = Computers::RealMat(),
+             py::arg("storage_p") = Computers::RealMat(), py::arg("storage_q") = Computers::RealMat(),
+             py::arg("shunt_p") = Computers::RealMat(), py::arg("shunt_q") = Computers::RealMat(),
+             py::call_guard<py::gil_scoped_release>(), DocComputers::compute_Vs.c_str())
+        .def("start_compute_Vs", &Computers::start_compute_Vs,
+             py::arg("gen_p"), py::arg("sgen_p"), py::arg("load_p"), py::arg("load_q"),
+             py::arg("Vinit"), py::arg("max_iter"), py::arg("tol"),
+             py::arg("gen_v") = Computers::RealMat(), py::arg("sgen_q") = Computers::RealMat(),
+             py::arg("storage_p") = Computers::RealMat(), py::arg("storage_q") = Computers::RealMat(),
+             py::arg("shunt_p") = Computers::RealMat(), py::arg("shunt_q") = Computers::RealMat(),
+             DocComputers::start_compute_Vs.c_str())  // the GIL is needed to copy the input data
         .def("compute_flows", &Computers::compute_flows, py::call_guard<py::gil_scoped_release>(), DocComputers::compute_flows.c_str())
         .def("compute_power_flows", &Computers::compute_power_flows, DocComputers::compute_power_flows.c_str())  // need to be done after "compute_Vs"  and "compute_flows"
         
@@ -607,6 +1000,14 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("get_power_flows", &Computers::get_power_flows, DocComputers::get_power_flows.c_str())  // need to be done after "compute_Vs"  and "compute_flows"
         .def("get_voltages", &Computers::get_voltages, DocComputers::get_voltages.c_str())  // need to be done after "compute_Vs" 
         .def("get_sbuses", &Computers::get_sbuses, DocComputers::get_sbuses.c_str())  // need to be done after "compute_Vs" 
+
+        // asynchronous computation
+        .def("is_running", &Computers::is_running, DocComputers::is_running.c_str())
+        .def("cancel", &Computers::cancel, DocComputers::cancel.c_str())
+        .def("wait", &Computers::wait, py::call_guard<py::gil_scoped_release>(), DocComputers::wait.c_str())
+        .def("result", [](Computers & computer){computer.wait(); return computer.get_status();},
+             py::call_guard<py::gil_scoped_release>(), DocComputers::result.c_str())
+        .def("get_progress", &Computers::get_progress, DocComputers::get_progress.c_str())
         ;
 
     py::class_<SecurityAnalysis>(m, "SecurityAnalysisCPP", DocSecurityAnalysis::SecurityAnalysis.c_str())
@@ -634,6 +1035,7 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
 
         // perform the computation
         .def("compute", &SecurityAnalysis::compute, py::call_guard<py::gil_scoped_release>(), DocSecurityAnalysis::compute.c_str())
+        .def("start_compute", &SecurityAnalysis::start_compute, DocSecurityAnalysis::start_compute.c_str())
         .def("compute_flows", &SecurityAnalysis::compute_flows, py::call_guard<py::gil_scoped_release>(), DocSecurityAnalysis::compute_flows.c_str())
         .def("compute_power_flows", &SecurityAnalysis::compute_power_flows, DocSecurityAnalysis::compute_power_flows.c_str())
 
@@ -649,5 +1051,11 @@ PYBIND11_MODULE(lightsim2grid_cpp, m)
         .def("amps_computation_time", &SecurityAnalysis::amps_computation_time, DocComputers::amps_computation_time.c_str())
         .def("modif_Ybus_time", &SecurityAnalysis::modif_Ybus_time, DocSecurityAnalysis::modif_Ybus_time.c_str())
         .def("nb_solved", &SecurityAnalysis::nb_solved, DocComputers::nb_solved.c_str())
+
+        // asynchronous computation
+        .def("is_running", &SecurityAnalysis::is_running, DocComputers::is_running.c_str())
+        .def("cancel", &SecurityAnalysis::cancel, DocComputers::cancel.c_str())
+        .def("wait", &SecurityAnalysis::wait, py::call_guard<py::gil_scoped_release>(), DocComputers::wait.c_str())
+        .def("get_progress", &SecurityAnalysis::get_progress, DocComputers::get_progress.c_str())
         ;
 }